@@ -0,0 +1,12 @@
+#pragma once
+
+#include <cstdint>
+
+namespace trybench {
+
+// Запуск AssetDatabase на artifacts папках GUID во временном каталоге: полный обход против загрузки индекса,
+// плюс инкрементальное обновление одной папки. Код выхода 1 — индекс меньше чем в 10 раз быстрее обхода
+// или базы разошлись
+int RunArtifactIndexBenchmark(uint32_t artifacts);
+
+}  // namespace trybench
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <cstdint>
+
+namespace trybench {
+
+// Путь отправки кадра без GPU: RenderSystem::ClearQueue, Submit команд и ExtractSceneLights, frames кадров
+// подряд с FrameArena::NextFrame между ними. Считает выделения operator new на главном потоке после прогрева
+// и проверяет, что очередь каждого кадра лежит в арене этого кадра. Возвращает 1, если в установившемся
+// режиме была хоть одна аллокация в куче или очередь осталась в арене другого кадра
+int RunFrameArenaBenchmark(uint32_t frames);
+
+}  // namespace trybench
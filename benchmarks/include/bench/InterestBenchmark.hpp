@@ -0,0 +1,12 @@
+#pragma once
+
+#include <cstdint>
+
+namespace trybench {
+
+// Синтетическая нагрузка на interest management: client_count клиентов с петлевым (in-process) транспортом,
+// потерями пакетов и подтверждениями. Клиенты декодируют снапшоты и сверяют их с тем, что собрал сервер.
+// threads > 1 — клиенты раздаются по JobSystem. Печатает сводку, возвращает код выхода
+int RunInterestBenchmark(uint32_t client_count, uint32_t threads);
+
+}  // namespace trybench
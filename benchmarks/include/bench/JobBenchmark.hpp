@@ -0,0 +1,12 @@
+#pragma once
+
+#include <cstdint>
+
+namespace trybench {
+
+// Пропускная способность JobSystem против наивного пула std::thread (одна очередь std::function под мьютексом)
+// на threads потоках: job_count мелких задач, ParallelFor с мелким grain и задачи разной стоимости.
+// Печатает таблицу, возвращает 1, если результаты пулов расходятся
+int RunJobBenchmark(uint32_t job_count, uint32_t threads);
+
+}  // namespace trybench
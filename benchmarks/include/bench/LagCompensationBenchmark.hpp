@@ -0,0 +1,11 @@
+#pragma once
+
+#include <cstdint>
+
+namespace trybench {
+
+// LagCompensation на синтетической комнате: запись кадра за тик и queries_per_tick запросов лучом и сферой
+// на случайных тиках в пределах истории. Попадания сверяются с перебором. Печатает таблицу, возвращает код выхода
+int RunLagCompensationBenchmark(uint32_t queries_per_tick);
+
+}  // namespace trybench
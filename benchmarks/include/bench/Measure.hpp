@@ -0,0 +1,61 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <entt/entity/registry.hpp>
+#include <type_traits>
+#include <vector>
+
+namespace trybench {
+
+inline double MsSince(std::chrono::steady_clock::time_point start) {
+    const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+// Лучшее время из repeats прогонов, мс
+template <typename Fn>
+double BestMs(int repeats, Fn&& fn) {
+    double best = 1e300;
+    for (int i = 0; i < repeats; ++i) {
+        const auto start = std::chrono::steady_clock::now();
+        fn();
+        best = std::min(best, MsSince(start));
+    }
+    return best;
+}
+
+// Медианное время из runs прогонов, мс
+template <typename Fn>
+double MedianMs(int runs, Fn&& fn) {
+    std::vector<double> times;
+    for (int i = 0; i < runs; ++i) {
+        const auto start = std::chrono::steady_clock::now();
+        fn();
+        times.push_back(MsSince(start));
+    }
+    std::sort(times.begin(), times.end());
+    return times[times.size() / 2];
+}
+
+// Текущая резидентная память процесса (VmRSS), КБ; 0 — не Linux
+uint64_t RssKb();
+// Пик резидентной памяти процесса (VmHWM), КБ; 0 — не Linux
+uint64_t PeakRssKb();
+// Сбрасывает VmHWM до текущего RSS (Linux 4.0+)
+void ResetPeakRss();
+
+// Байты пула: sparse-массив по id сущностей, плотный массив сущностей и массив значений по емкости
+template <typename T>
+size_t PoolBytes(entt::registry& reg) {
+    const auto& storage = reg.storage<T>();
+    size_t bytes = (storage.extent() + storage.size()) * sizeof(entt::entity);
+    if constexpr (!std::is_empty_v<T> && !std::is_same_v<T, entt::entity>) {
+        bytes += storage.capacity() * sizeof(T);
+    }
+    return bytes;
+}
+
+}  // namespace trybench
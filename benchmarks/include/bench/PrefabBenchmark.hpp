@@ -0,0 +1,13 @@
+#pragma once
+
+#include <cstdint>
+
+namespace trybench {
+
+// instances деревьев из одного префаба (ствол и крона) против тех же деревьев, полностью скопированных в сущности.
+// Часть экземпляров переопределяет материал, часть развернута. Печатает память на экземпляр (RSS и байты пулов
+// по компонентам) и сверяет, что рендер увидит в обоих мирах одно и то же. Код выхода 1 — экземпляр префаба
+// дороже половины копии или миры разошлись
+int RunPrefabBenchmark(uint32_t instances);
+
+}  // namespace trybench
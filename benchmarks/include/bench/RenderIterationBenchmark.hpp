@@ -0,0 +1,12 @@
+#pragma once
+
+#include <cstdint>
+
+namespace trybench {
+
+// Цикл отправки кадра по renderables сущностям с мешами среди вдвое большего числа сущностей: прежний
+// Transform с матрицей внутри через view против WorldMatrix во владеющей группе, как в SubmitSceneFromEnTT;
+// плюс проход только по TRS. Печатает таблицу, возвращает 1, если циклы прочитали разные данные
+int RunRenderIterationBenchmark(uint32_t renderables);
+
+}  // namespace trybench
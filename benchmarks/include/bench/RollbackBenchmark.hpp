@@ -0,0 +1,11 @@
+#pragma once
+
+#include <cstdint>
+
+namespace trybench {
+
+// Откат на rollback_ticks тиков и повторная симуляция для entity_count предсказываемых сущностей.
+// Печатает времена, возвращает 1, если p99 не уложился в бюджет или повторная симуляция разошлась с исходной
+int RunRollbackBenchmark(uint32_t entity_count, uint32_t rollback_ticks, double budget_ms);
+
+}  // namespace trybench
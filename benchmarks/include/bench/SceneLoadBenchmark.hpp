@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstdint>
+
+namespace trybench {
+
+// Загрузка сцены из entity_count сущностей: старый путь (ifstream + cereal) против запеченной сцены
+// из отображенного файла, в одном потоке и пулами по threads потокам. Реестры сверяются.
+// Печатает таблицу и время по пулам, возвращает код выхода (1 — однопоточное ускорение меньше 10x)
+int RunSceneLoadBenchmark(uint32_t entity_count, uint32_t threads);
+
+// SceneManager::LoadSceneAsync на запеченной сцене примерно в megabytes МБ: замена активной, аддитивная загрузка
+// второй копии и ее выгрузка. Главный поток крутит кадры с Update по бюджету; печатает паузы кадров и
+// возвращает код выхода (1 — пауза дольше половины кадра 60 Гц или сцена собралась не так)
+int RunSceneAsyncBenchmark(uint32_t megabytes, uint32_t threads);
+
+}  // namespace trybench
@@ -0,0 +1,11 @@
+#pragma once
+
+#include <cstdint>
+
+namespace trybench {
+
+// Размер и скорость SnapshotCodec против сериализации сцены через cereal BinaryOutputArchive
+// на entity_count сущностях с Transform. Печатает таблицу, возвращает код выхода
+int RunSnapshotBenchmark(uint32_t entity_count);
+
+}  // namespace trybench
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <cstdint>
+
+namespace trybench {
+
+// Стриминг мира ячейками: уровень side x side ячеек запекается через CookWorldPartition, камера пролетает
+// его по диагонали с 60 Гц, WorldStreamer грузит и выгружает ячейки вокруг нее в пределах бюджета памяти.
+// Печатает рывки кадров, ячейки, которых не оказалось под камерой, и пик памяти; возвращает код выхода
+// (1 — был рывок, дыра под камерой, выход за бюджет или мир собрался не так)
+int RunStreamingBenchmark(uint32_t side, uint32_t threads);
+
+}  // namespace trybench
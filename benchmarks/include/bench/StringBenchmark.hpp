@@ -0,0 +1,13 @@
+#pragma once
+
+#include <cstdint>
+
+namespace trybench {
+
+// Tag на entities сущностях: прежний std::string против интернированного StringId, для имен узлов моделей
+// (повторяются) и для уникальных имен. Печатает память на сущность (пул, куча строк или доля StringTable, RSS),
+// время сравнения тегов и поиска в Addressables. Код выхода 1 — на повторяющихся именах Tag меньше чем вдвое
+// дешевле прежнего или текст тегов разошелся
+int RunStringBenchmark(uint32_t entities);
+
+}  // namespace trybench
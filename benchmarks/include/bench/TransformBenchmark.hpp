@@ -0,0 +1,12 @@
+#pragma once
+
+#include <cstdint>
+
+namespace trybench {
+
+// Масштабирование UpdateTransformSystem: entity_count сущностей в деревьях моделей (как импортированный glTF),
+// все корни сдвигаются каждый прогон. Меряет 1, 4 и 16 потоков, сверяет матрицы с однопоточным проходом.
+// Печатает таблицу, возвращает 1 при расхождении матриц
+int RunTransformBenchmark(uint32_t entity_count);
+
+}  // namespace trybench
@@ -0,0 +1,12 @@
+#pragma once
+
+#include <cstdint>
+
+namespace trybench {
+
+// Сборка count мировых матриц из TRS и матрицы родителя: glm (translate * mat4_cast * scale и полное
+// умножение на родителя), Transform::GetLocalMatrix и пакетное ядро ComposeWorldMatrices.
+// Печатает таблицу, возвращает 1, если результаты ядра расходятся с glm
+int RunTransformKernelBenchmark(uint32_t count);
+
+}  // namespace trybench
@@ -0,0 +1,12 @@
+#pragma once
+
+#include <cstdint>
+
+namespace trybench {
+
+// Транспорт на 127.0.0.1: пакеты в секунду мелкими датаграммами с пачками sendmmsg и без,
+// затем megabytes по надежному каналу на чистом и на имитированном плохом канале с проверкой порядка.
+// Печатает таблицу, возвращает код выхода
+int RunTransportBenchmark(uint32_t megabytes);
+
+}  // namespace trybench
@@ -0,0 +1,104 @@
+#include "bench/ArtifactIndexBenchmark.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <system_error>
+
+#include "bench/Measure.hpp"
+#include "engine/core/AssetDatabase.hpp"
+
+namespace trybench {
+
+using namespace tryengine;
+
+namespace {
+
+constexpr uint64_t kFirstId = 1000000;
+constexpr double kMinSpeedup = 10.0;
+
+// Папка GUID с главным артефактом, как после импорта
+void WriteArtifact(const std::filesystem::path& artifacts_dir, uint64_t id) {
+    const auto dir = artifacts_dir / std::to_string(id);
+    std::filesystem::create_directories(dir);
+    std::ofstream os(dir / std::to_string(id), std::ios::binary);
+    os << id;
+}
+
+bool SamePaths(const core::AssetDatabase& a, const core::AssetDatabase& b, uint64_t first, uint64_t count) {
+    for (uint64_t id = first; id < first + count; ++id) {
+        const auto path = a.GetPath(id);
+        if (path.empty() || path != b.GetPath(id))
+            return false;
+    }
+    return true;
+}
+
+int Run(uint32_t artifacts, const std::filesystem::path& artifacts_dir) {
+    // Обход: каталог на ассет, stat на каждый файл
+    auto start = std::chrono::steady_clock::now();
+    core::AssetDatabase walked;
+    walked.Rescan();
+    const double rescan_ms = MsSince(start);
+
+    start = std::chrono::steady_clock::now();
+    walked.SaveIndex();
+    const double save_ms = MsSince(start);
+
+    start = std::chrono::steady_clock::now();
+    core::AssetDatabase indexed;
+    indexed.Refresh();
+    const double load_ms = MsSince(start);
+
+    // Конвейер импорта добавил ассет: одна папка вместо обхода, индекс остается действительным
+    const uint64_t added_id = kFirstId + artifacts;
+    WriteArtifact(artifacts_dir, added_id);
+    start = std::chrono::steady_clock::now();
+    indexed.UpdateArtifactDir(artifacts_dir / std::to_string(added_id));
+    indexed.SaveIndex();
+    const double update_ms = MsSince(start);
+
+    core::AssetDatabase restarted;
+    restarted.Refresh();
+
+    const double speedup = rescan_ms / load_ms;
+    std::printf("%-24s %10.2f ms\n", "rescan artifacts", rescan_ms);
+    std::printf("%-24s %10.2f ms\n", "write index", save_ms);
+    std::printf("%-24s %10.2f ms\n", "load index", load_ms);
+    std::printf("%-24s %10.2f ms\n", "update one asset", update_ms);
+    std::printf("index startup is %.1fx faster than the walk\n", speedup);
+
+    if (!SamePaths(walked, indexed, kFirstId, artifacts) || !SamePaths(indexed, restarted, kFirstId, artifacts + 1)) {
+        std::printf("indexed database differs from the walked one\n");
+        return 1;
+    }
+    return speedup >= kMinSpeedup ? 0 : 1;
+}
+
+}  // namespace
+
+int RunArtifactIndexBenchmark(uint32_t artifacts) {
+    // AssetDatabase ищет artifacts от текущего каталога — подменяем его временным проектом
+    const auto original_dir = std::filesystem::current_path();
+    const auto stamp = std::chrono::steady_clock::now().time_since_epoch().count();
+    const auto project_dir = std::filesystem::temp_directory_path() / ("tryengine_artifacts_" + std::to_string(stamp));
+    const auto artifacts_dir = project_dir / "game" / "artifacts";
+    std::filesystem::create_directories(project_dir / "engine_content" / "artifacts");
+
+    std::printf("%u artifacts in %s\n", artifacts, artifacts_dir.string().c_str());
+    for (uint32_t i = 0; i < artifacts; ++i) {
+        WriteArtifact(artifacts_dir, kFirstId + i);
+    }
+
+    std::filesystem::current_path(project_dir);
+    const int result = Run(artifacts, artifacts_dir);
+    std::filesystem::current_path(original_dir);
+
+    std::error_code error;
+    std::filesystem::remove_all(project_dir, error);
+    return result;
+}
+
+}  // namespace trybench
@@ -0,0 +1,116 @@
+#include "bench/FrameArenaBenchmark.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <entt/entity/registry.hpp>
+#include <new>
+
+#include "engine/core/Components.hpp"
+#include "engine/core/FrameArena.hpp"
+#include "engine/graphics/May.hpp"
+#include "engine/graphics/RenderSystem.hpp"
+
+namespace {
+
+// Счетчик выделений в куче. Замена глобального operator new действует на весь бинарник benchmarks
+// (редактор и игра работают со стандартным), но считает только поток, включивший tls_counting
+thread_local bool tls_counting = false;
+thread_local uint64_t tls_heap_allocations = 0;
+
+}  // namespace
+
+void* operator new(std::size_t size) {
+    if (tls_counting) {
+        ++tls_heap_allocations;
+    }
+    if (void* memory = std::malloc(size == 0 ? 1 : size))
+        return memory;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept { std::free(memory); }
+
+void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+
+namespace trybench {
+
+using namespace tryengine;
+
+namespace {
+
+constexpr uint32_t kCommands = 20000;
+constexpr uint32_t kLights = 64;
+// Маленький блок: первые кадры арена растет несколькими блоками, после слияния в Reset — одним
+constexpr size_t kBlockSize = 64 * 1024;
+// Оба буфера арены прошли слияние блоков, вектор ламп вырос
+constexpr uint32_t kWarmupFrames = 4;
+
+}  // namespace
+
+int RunFrameArenaBenchmark(uint32_t frames) {
+    frames = std::max(frames, kWarmupFrames + 1);
+
+    core::FrameArena frame_arena(kBlockSize);
+    // Без устройства: очередь не исполняется, пайплайны не создаются
+    graphics::RenderSystem render_system(nullptr, frame_arena);
+
+    entt::registry reg;
+    reg.ctx().emplace<graphics::SceneLights>();
+    for (uint32_t i = 0; i < kLights; ++i) {
+        const auto entity = reg.create();
+        reg.emplace<Transform>(entity, Transform{glm::vec3(static_cast<float>(i), 2.0f, 0.0f)});
+        reg.emplace<LightComponent>(entity);
+    }
+
+    graphics::DrawCommand command;
+    command.num_indices = 36;
+    command.model_matrix = glm::mat4(1.0f);
+
+    uint64_t steady_allocations = 0;
+    uint32_t foreign_frames = 0;
+    double steady_ms = 0.0;
+    for (uint32_t frame = 0; frame < frames; ++frame) {
+        frame_arena.NextFrame();
+        const bool steady = frame >= kWarmupFrames;
+
+        tls_heap_allocations = 0;
+        tls_counting = steady;
+        const auto start = std::chrono::steady_clock::now();
+
+        render_system.ClearQueue();
+        for (uint32_t i = 0; i < kCommands; ++i) {
+            command.sorting_key = i;
+            command.model_matrix[3].x = static_cast<float>(i);
+            render_system.Submit(command);
+        }
+        graphics::ExtractSceneLights(reg);
+
+        const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        tls_counting = false;
+
+        if (steady) {
+            steady_allocations += tls_heap_allocations;
+            steady_ms += elapsed.count();
+        }
+        // Очередь должна расти в арене текущего кадра: арену прошлого кадра NextFrame сбросит, пока она читается
+        if (frame_arena.Local().GetUsed() < kCommands * sizeof(graphics::DrawCommand)) {
+            ++foreign_frames;
+        }
+    }
+
+    const auto stats = frame_arena.GetStats();
+    const uint32_t steady_frames = frames - kWarmupFrames;
+    std::printf("%u frames of %u draw commands and %u lights, first %u frames are warmup\n", frames, kCommands,
+                kLights, kWarmupFrames);
+    std::printf("%-28s %10.3f ms\n", "submission per frame", steady_ms / steady_frames);
+    std::printf("%-28s %10zu KB\n", "arena capacity", stats.capacity / 1024);
+    std::printf("%-28s %10llu\n", "arena block allocations", static_cast<unsigned long long>(stats.heap_allocations));
+    std::printf("%-28s %10llu\n", "heap allocations, steady", static_cast<unsigned long long>(steady_allocations));
+    std::printf("%-28s %10u\n", "queue outside frame arena", foreign_frames);
+
+    return steady_allocations == 0 && foreign_frames == 0 ? 0 : 1;
+}
+
+}  // namespace trybench
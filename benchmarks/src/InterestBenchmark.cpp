@@ -0,0 +1,303 @@
+#include "bench/InterestBenchmark.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "engine/core/BaseSystem.hpp"
+#include "engine/core/ComponentRegistry.hpp"
+#include "engine/core/Components.hpp"
+#include "engine/core/JobSystem.hpp"
+#include "engine/core/SnapshotCodec.hpp"
+#include "server/ClientInterest.hpp"
+#include "server/InterestGrid.hpp"
+
+namespace trybench {
+
+using namespace tryengine;
+using namespace tryserver;
+
+namespace {
+
+constexpr uint32_t kEntities = 10000;
+constexpr float kWorldSize = 2000.0f;
+constexpr float kCellSize = 32.0f;
+constexpr uint32_t kTicks = 300;
+constexpr float kTickDt = 1.0f / 60.0f;
+// Доля сущностей, которые стоят на месте: для них работает "у клиента уже актуально"
+constexpr float kStaticFraction = 0.5f;
+// Потери в обе стороны
+constexpr float kLossRate = 0.05f;
+// Движущихся сущностей, уничтоженных и созданных заново за тик: индексы переиспользуются со следующей версией
+constexpr uint32_t kChurnPerTick = 20;
+// Скольким клиентам снапшоты еще и применяются к реестру (Apply), со сверкой состава
+constexpr uint32_t kAppliedClients = 8;
+
+struct SimClient {
+    explicit SimClient(const InterestConfig& config) : interest(config) {}
+
+    // Серверная сторона
+    ClientInterest interest;
+    core::BitWriter writer;
+
+    // Петля: пакет текущего тика или пусто, если потерян
+    std::vector<uint8_t> inbox;
+
+    // Клиентская сторона: декодированные снапшоты, база ищется по заголовку
+    std::array<core::Snapshot, ClientInterest::kHistorySize> received;
+    // Только у первых kAppliedClients: реестр клиента и последний примененный к нему снапшот
+    std::unique_ptr<entt::registry> world;
+    core::Snapshot applied;
+    glm::vec2 velocity{0.0f};
+    std::minstd_rand rng;
+
+    size_t bytes = 0;
+    size_t max_packet = 0;
+    uint32_t over_budget = 0;
+    uint32_t mismatches = 0;
+    uint32_t decode_failures = 0;
+    uint32_t apply_mismatches = 0;
+    uint64_t visible = 0;
+    uint64_t updated = 0;
+    uint64_t deferred = 0;
+};
+
+// Значения на клиенте квантованы, поэтому сверяем состав: те же сущности и те же компоненты
+bool SameContents(const core::Snapshot& a, const core::Snapshot& b) {
+    if (a.entities != b.entities || a.pools.size() != b.pools.size())
+        return false;
+    for (size_t t = 0; t < a.pools.size(); ++t) {
+        if (a.pools[t].entities != b.pools[t].entities)
+            return false;
+    }
+    return true;
+}
+
+// Реестр после Apply: живы ровно сущности снапшота, пулы совпадают с его пулами по составу
+bool AppliedMatches(const core::ComponentRegistry& components, const entt::registry& world,
+                    const core::Snapshot& snapshot) {
+    if (world.storage<entt::entity>().free_list() != snapshot.entities.size())
+        return false;
+    for (const auto entity : snapshot.entities) {
+        if (!world.valid(entity))
+            return false;
+    }
+
+    const auto& types = components.GetReplicatedComponents();
+    std::vector<entt::entity> entities;
+    std::vector<std::byte> values;
+    for (size_t t = 0; t < types.size(); ++t) {
+        types[t].capture(world, entities, values);
+        const bool empty = t >= snapshot.pools.size() || snapshot.pools[t].entities.empty();
+        if (empty ? !entities.empty() : entities != snapshot.pools[t].entities)
+            return false;
+    }
+    return true;
+}
+
+float Clamp(float value) { return std::clamp(value, -kWorldSize * 0.5f, kWorldSize * 0.5f); }
+
+}  // namespace
+
+int RunInterestBenchmark(uint32_t client_count, uint32_t threads) {
+    using Clock = std::chrono::steady_clock;
+
+    core::ComponentRegistry components;
+    core::RegisterEngineComponents(components);
+    const core::SnapshotCodec codec(components);
+
+    std::unique_ptr<core::JobSystem> jobs;
+    if (threads > 1) {
+        jobs = std::make_unique<core::JobSystem>(threads - 1);
+    }
+    const auto for_each_client = [&](auto&& fn) {
+        if (jobs) {
+            jobs->ParallelFor(client_count, 16, [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i) {
+                    fn(i);
+                }
+            });
+        } else {
+            for (size_t i = 0; i < client_count; ++i) {
+                fn(i);
+            }
+        }
+    };
+
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> coordinate(-kWorldSize * 0.5f, kWorldSize * 0.5f);
+    std::uniform_real_distribution<float> speed(-8.0f, 8.0f);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+    entt::registry server;
+    core::AcquireTransformHierarchy(server);
+    InterestGrid grid(kCellSize);
+    grid.Attach(server);
+
+    std::vector<entt::entity> movers;
+    std::vector<glm::vec2> velocities;
+    for (uint32_t i = 0; i < kEntities; ++i) {
+        const auto entity = server.create();
+        server.emplace<Transform>(entity, Transform{glm::vec3(coordinate(rng), 0.0f, coordinate(rng)),
+                                                    glm::quat(1.0f, 0.0f, 0.0f, 0.0f), glm::vec3(1.0f)});
+        if (unit(rng) >= kStaticFraction) {
+            movers.push_back(entity);
+            velocities.emplace_back(speed(rng), speed(rng));
+        }
+    }
+
+    const InterestConfig config;
+    std::vector<std::unique_ptr<SimClient>> clients;
+    clients.reserve(client_count);
+    for (uint32_t i = 0; i < client_count; ++i) {
+        auto& client = clients.emplace_back(std::make_unique<SimClient>(config));
+        client->interest.SetPosition(glm::vec3(coordinate(rng), 0.0f, coordinate(rng)));
+        client->velocity = glm::vec2(speed(rng), speed(rng));
+        client->rng.seed(i + 1);
+        if (i < kAppliedClients) {
+            client->world = std::make_unique<entt::registry>();
+        }
+    }
+
+    std::uniform_int_distribution<size_t> pick_mover(0, movers.empty() ? 0 : movers.size() - 1);
+    uint64_t recycled = 0;
+
+    core::Snapshot current;
+    double world_ms = 0.0;
+    double send_ms = 0.0;
+    double receive_ms = 0.0;
+
+    for (uint32_t sequence = 1; sequence <= kTicks; ++sequence) {
+        auto start = Clock::now();
+        for (uint32_t i = 0; i < kChurnPerTick && !movers.empty(); ++i) {
+            entt::entity& mover = movers[pick_mover(rng)];
+            const glm::vec3 position = server.get<Transform>(mover).position;
+            server.destroy(mover);
+            mover = server.create();
+            recycled += entt::to_version(mover) != 0 ? 1 : 0;
+            server.emplace<Transform>(mover, Transform{position});
+        }
+        for (size_t i = 0; i < movers.size(); ++i) {
+            server.patch<Transform>(movers[i], [&](Transform& transform) {
+                glm::vec2& velocity = velocities[i];
+                transform.position.x += velocity.x * kTickDt;
+                transform.position.z += velocity.y * kTickDt;
+                if (std::abs(transform.position.x) > kWorldSize * 0.5f) {
+                    velocity.x = -velocity.x;
+                }
+                if (std::abs(transform.position.z) > kWorldSize * 0.5f) {
+                    velocity.y = -velocity.y;
+                }
+            });
+        }
+        if (jobs) {
+            core::UpdateTransformSystem(server, *jobs);
+        } else {
+            core::UpdateTransformSystem(server);
+        }
+        grid.Update(server);
+        codec.Capture(server, sequence, current);
+        world_ms += std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+        // Сервер: видимость, приоритеты, кодирование, "отправка" по петле
+        start = Clock::now();
+        for_each_client([&](size_t index) {
+            SimClient& client = *clients[index];
+            const core::Snapshot& built = client.interest.Build(grid, codec, current);
+
+            client.writer.Clear();
+            codec.Encode(built, client.interest.GetBaseline(), client.writer);
+            const auto packet = client.writer.Finish();
+            client.interest.ReportEncoded(packet.size());
+
+            client.bytes += packet.size();
+            client.max_packet = std::max(client.max_packet, packet.size());
+            client.over_budget += packet.size() > config.byte_budget ? 1 : 0;
+            client.visible += client.interest.GetVisibleCount();
+            client.updated += client.interest.GetUpdatedCount();
+            client.deferred += client.interest.GetDeferredCount();
+
+            client.inbox.clear();
+            if (std::uniform_real_distribution<float>(0.0f, 1.0f)(client.rng) >= kLossRate) {
+                client.inbox.assign(packet.begin(), packet.end());
+            }
+        });
+        send_ms += std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+        // Клиенты: декодирование по своей базе, сверка, подтверждение, движение
+        start = Clock::now();
+        for_each_client([&](size_t index) {
+            SimClient& client = *clients[index];
+
+            if (!client.inbox.empty()) {
+                core::BitReader reader(client.inbox);
+                const auto header = core::SnapshotCodec::ReadHeader(reader);
+                const core::Snapshot& candidate = client.received[header.baseline % ClientInterest::kHistorySize];
+                const core::Snapshot* baseline =
+                    header.baseline != 0 && candidate.sequence == header.baseline ? &candidate : nullptr;
+
+                core::Snapshot& decoded = client.received[header.sequence % ClientInterest::kHistorySize];
+                if (codec.Decode(reader, header, baseline, decoded)) {
+                    const core::Snapshot* sent = client.interest.GetSent(header.sequence);
+                    client.mismatches += sent && SameContents(decoded, *sent) ? 0 : 1;
+                    if (client.world) {
+                        const bool first = client.applied.sequence == 0;
+                        codec.Apply(*client.world, decoded, first ? nullptr : &client.applied);
+                        client.applied = decoded;
+                        client.apply_mismatches += AppliedMatches(components, *client.world, decoded) ? 0 : 1;
+                    }
+                    if (std::uniform_real_distribution<float>(0.0f, 1.0f)(client.rng) >= kLossRate) {
+                        client.interest.Acknowledge(header.sequence);
+                    }
+                } else {
+                    decoded.sequence = 0;
+                    ++client.decode_failures;
+                }
+            }
+
+            glm::vec3 position = client.interest.GetPosition();
+            position.x = Clamp(position.x + client.velocity.x * kTickDt);
+            position.z = Clamp(position.z + client.velocity.y * kTickDt);
+            client.interest.SetPosition(position);
+        });
+        receive_ms += std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    SimClient total(config);
+    for (const auto& client : clients) {
+        total.bytes += client->bytes;
+        total.max_packet = std::max(total.max_packet, client->max_packet);
+        total.over_budget += client->over_budget;
+        total.mismatches += client->mismatches;
+        total.decode_failures += client->decode_failures;
+        total.apply_mismatches += client->apply_mismatches;
+        total.visible += client->visible;
+        total.updated += client->updated;
+        total.deferred += client->deferred;
+    }
+
+    const double client_ticks = static_cast<double>(client_count) * kTicks;
+    std::printf("%u clients, %u entities (%zu moving), %u ticks, %u thread(s), grid %zu cells\n", client_count,
+                kEntities, movers.size(), kTicks, threads, grid.GetCellCount());
+    std::printf("per tick: world %.3f ms, build+encode %.3f ms, decode %.3f ms\n", world_ms / kTicks,
+                send_ms / kTicks, receive_ms / kTicks);
+    std::printf("per client per tick: %.1f bytes (max packet %zu, budget %u, over budget %u), visible %.1f, "
+                "updated %.1f, deferred %.1f\n",
+                static_cast<double>(total.bytes) / client_ticks, total.max_packet, config.byte_budget,
+                total.over_budget, static_cast<double>(total.visible) / client_ticks,
+                static_cast<double>(total.updated) / client_ticks, static_cast<double>(total.deferred) / client_ticks);
+    std::printf("churn: %u entities per tick, %llu recycled indices\n", kChurnPerTick,
+                static_cast<unsigned long long>(recycled));
+    std::printf("decode failures %u, mismatches %u, apply mismatches %u (%u clients)\n", total.decode_failures,
+                total.mismatches, total.apply_mismatches, std::min(client_count, kAppliedClients));
+
+    grid.Detach();
+    return total.decode_failures == 0 && total.mismatches == 0 && total.apply_mismatches == 0 ? 0 : 1;
+}
+
+}  // namespace trybench
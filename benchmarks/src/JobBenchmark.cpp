@@ -0,0 +1,212 @@
+#include "bench/JobBenchmark.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "bench/Measure.hpp"
+#include "engine/core/JobSystem.hpp"
+
+namespace trybench {
+
+using namespace tryengine;
+
+namespace {
+
+constexpr int kRuns = 15;
+constexpr uint32_t kTinyIterations = 64;
+// ParallelFor: элементов на задачу и элементов в чанке
+constexpr uint32_t kElementsPerJob = 64;
+constexpr size_t kGrain = 256;
+// Каждая 64-я задача в 100 раз дороже остальных
+constexpr uint32_t kHeavyEvery = 64;
+constexpr uint32_t kHeavyFactor = 100;
+
+// Наивный пул: общая очередь std::function под одним мьютексом, вызывающий поток только ждет
+class NaivePool {
+public:
+    explicit NaivePool(uint32_t thread_count) {
+        for (uint32_t i = 0; i < thread_count; ++i) {
+            threads_.emplace_back([this] { WorkerLoop(); });
+        }
+    }
+
+    ~NaivePool() {
+        {
+            std::lock_guard lock(mutex_);
+            stop_ = true;
+        }
+        wake_cv_.notify_all();
+        for (auto& thread : threads_) {
+            thread.join();
+        }
+    }
+
+    void Submit(std::function<void()> fn) {
+        pending_.fetch_add(1, std::memory_order_relaxed);
+        {
+            std::lock_guard lock(mutex_);
+            tasks_.push_back(std::move(fn));
+        }
+        wake_cv_.notify_one();
+    }
+
+    void WaitIdle() {
+        std::unique_lock lock(mutex_);
+        done_cv_.wait(lock, [this] { return pending_.load(std::memory_order_acquire) == 0; });
+    }
+
+private:
+    void WorkerLoop() {
+        for (;;) {
+            std::function<void()> fn;
+            {
+                std::unique_lock lock(mutex_);
+                wake_cv_.wait(lock, [this] { return stop_ || !tasks_.empty(); });
+                if (tasks_.empty())
+                    return;
+                fn = std::move(tasks_.front());
+                tasks_.pop_front();
+            }
+            fn();
+            if (pending_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                std::lock_guard lock(mutex_);
+                done_cv_.notify_all();
+            }
+        }
+    }
+
+    std::vector<std::thread> threads_;
+    std::mutex mutex_;
+    std::condition_variable wake_cv_;
+    std::condition_variable done_cv_;
+    std::deque<std::function<void()>> tasks_;
+    std::atomic<uint32_t> pending_{0};
+    bool stop_ = false;
+};
+
+// Детерминированная работа, которую компилятор не выбросит
+uint64_t Work(uint64_t seed, uint32_t iterations) {
+    uint64_t x = seed * 0x9E3779B97F4A7C15ull + 1;
+    for (uint32_t i = 0; i < iterations; ++i) {
+        x ^= x >> 31;
+        x *= 0xBF58476D1CE4E5B9ull;
+        x ^= x >> 27;
+    }
+    return x;
+}
+
+uint32_t Cost(uint32_t job) { return job % kHeavyEvery == 0 ? kTinyIterations * kHeavyFactor : kTinyIterations; }
+
+uint64_t Checksum(const std::vector<uint64_t>& results) {
+    uint64_t sum = 0;
+    for (const uint64_t value : results) {
+        sum += value;
+    }
+    return sum;
+}
+
+void PrintRow(const char* name, uint32_t jobs, double naive_ms, double stealing_ms) {
+    std::printf("%-20s %12.3f %12.3f %14.2f %14.2f %9.2fx\n", name, naive_ms, stealing_ms, jobs / naive_ms / 1000.0,
+                jobs / stealing_ms / 1000.0, naive_ms / stealing_ms);
+}
+
+}  // namespace
+
+int RunJobBenchmark(uint32_t job_count, uint32_t threads) {
+    threads = std::max(threads, 1u);
+    // Наивный пул получает все потоки под воркеры: вызывающий в нем только ждет
+    NaivePool naive(threads);
+    // В JobSystem главный поток работает сам
+    core::JobSystem jobs(threads - 1);
+
+    std::printf("%u jobs on %u threads, %u hardware threads, median of %d runs\n", job_count, threads,
+                std::thread::hardware_concurrency(), kRuns);
+    std::printf("%-20s %12s %12s %14s %14s %10s\n", "workload", "naive ms", "stealing ms", "naive Mjobs/s",
+                "steal Mjobs/s", "speedup");
+
+    bool same = true;
+    std::vector<uint64_t> naive_results(job_count);
+    std::vector<uint64_t> stealing_results(job_count);
+
+    // Мелкие задачи: стоимость постановки и синхронизации
+    {
+        const double naive_ms = MedianMs(kRuns, [&] {
+            for (uint32_t i = 0; i < job_count; ++i) {
+                naive.Submit([&naive_results, i] { naive_results[i] = Work(i, kTinyIterations); });
+            }
+            naive.WaitIdle();
+        });
+        const double stealing_ms = MedianMs(kRuns, [&] {
+            core::JobCounter counter;
+            for (uint32_t i = 0; i < job_count; ++i) {
+                jobs.Run([&stealing_results, i] { stealing_results[i] = Work(i, kTinyIterations); }, &counter);
+            }
+            jobs.Wait(counter);
+        });
+        same = same && Checksum(naive_results) == Checksum(stealing_results);
+        PrintRow("tiny jobs", job_count, naive_ms, stealing_ms);
+    }
+
+    // Задачи разной стоимости: балансировка
+    {
+        const double naive_ms = MedianMs(kRuns, [&] {
+            for (uint32_t i = 0; i < job_count; ++i) {
+                naive.Submit([&naive_results, i] { naive_results[i] = Work(i, Cost(i)); });
+            }
+            naive.WaitIdle();
+        });
+        const double stealing_ms = MedianMs(kRuns, [&] {
+            core::JobCounter counter;
+            for (uint32_t i = 0; i < job_count; ++i) {
+                jobs.Run([&stealing_results, i] { stealing_results[i] = Work(i, Cost(i)); }, &counter);
+            }
+            jobs.Wait(counter);
+        });
+        same = same && Checksum(naive_results) == Checksum(stealing_results);
+        PrintRow("unbalanced jobs", job_count, naive_ms, stealing_ms);
+    }
+
+    // ParallelFor: наивный пул получает задачу на каждый чанк
+    {
+        const size_t elements = static_cast<size_t>(job_count) * kElementsPerJob;
+        const uint32_t chunks = static_cast<uint32_t>((elements + kGrain - 1) / kGrain);
+        naive_results.assign(elements, 0);
+        stealing_results.assign(elements, 0);
+
+        const double naive_ms = MedianMs(kRuns, [&] {
+            for (size_t begin = 0; begin < elements; begin += kGrain) {
+                const size_t end = std::min(begin + kGrain, elements);
+                naive.Submit([&naive_results, begin, end] {
+                    for (size_t i = begin; i < end; ++i) {
+                        naive_results[i] = Work(i, 4);
+                    }
+                });
+            }
+            naive.WaitIdle();
+        });
+        const double stealing_ms = MedianMs(kRuns, [&] {
+            jobs.ParallelFor(elements, kGrain, [&stealing_results](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i) {
+                    stealing_results[i] = Work(i, 4);
+                }
+            });
+        });
+        same = same && Checksum(naive_results) == Checksum(stealing_results);
+        PrintRow("parallel for chunks", chunks, naive_ms, stealing_ms);
+    }
+
+    if (!same) {
+        std::printf("results differ between pools\n");
+        return 1;
+    }
+    return 0;
+}
+
+}  // namespace trybench
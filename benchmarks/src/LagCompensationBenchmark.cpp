@@ -0,0 +1,222 @@
+#include "bench/LagCompensationBenchmark.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "engine/core/BaseSystem.hpp"
+#include "engine/core/Components.hpp"
+#include "engine/core/TransformHierarchy.hpp"
+#include "server/LagCompensation.hpp"
+#include "server/TickStats.hpp"
+
+namespace trybench {
+
+using namespace tryengine;
+using namespace tryserver;
+
+namespace {
+
+constexpr uint32_t kEntities = 2000;
+constexpr float kWorldSize = 400.0f;
+constexpr uint32_t kTicks = 300;
+constexpr float kTickDt = 1.0f / 60.0f;
+// Столько первых тиков с запросами сверяются с перебором
+constexpr uint32_t kVerifyTicks = 20;
+constexpr float kRayDistance = 150.0f;
+constexpr float kSphereRadius = 3.0f;
+// Каждый пятый запрос — сфера (взрыв), остальные — лучи (выстрелы)
+constexpr uint32_t kSphereEvery = 5;
+
+struct Query {
+    uint64_t tick = 0;
+    uint32_t shooter = 0;
+    glm::vec3 origin{0.0f};
+    glm::vec3 direction{0.0f};
+    bool sphere = false;
+};
+
+struct Result {
+    bool hit = false;
+    float distance = 0.0f;
+    std::vector<entt::entity> overlaps;
+};
+
+bool BruteRay(const glm::vec3& origin, const glm::vec3& dir, const glm::vec3& min, const glm::vec3& max,
+              float& distance) {
+    float t_near = 0.0f;
+    float t_far = kRayDistance;
+    for (int axis = 0; axis < 3; ++axis) {
+        if (dir[axis] == 0.0f) {
+            if (origin[axis] < min[axis] || origin[axis] > max[axis])
+                return false;
+            continue;
+        }
+        float t0 = (min[axis] - origin[axis]) / dir[axis];
+        float t1 = (max[axis] - origin[axis]) / dir[axis];
+        if (t0 > t1) {
+            std::swap(t0, t1);
+        }
+        t_near = std::max(t_near, t0);
+        t_far = std::min(t_far, t1);
+        if (t_near > t_far)
+            return false;
+    }
+    distance = t_near;
+    return true;
+}
+
+}  // namespace
+
+int RunLagCompensationBenchmark(uint32_t queries_per_tick) {
+    using Clock = std::chrono::steady_clock;
+
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<float> coordinate(-kWorldSize * 0.5f, kWorldSize * 0.5f);
+    std::uniform_real_distribution<float> speed(-6.0f, 6.0f);
+    std::uniform_real_distribution<float> extent(0.3f, 1.5f);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+
+    entt::registry reg;
+    core::AcquireTransformHierarchy(reg);
+
+    std::vector<entt::entity> entities(kEntities);
+    std::vector<glm::vec3> velocities(kEntities);
+    std::vector<glm::vec3> half_extents(kEntities);
+    for (uint32_t i = 0; i < kEntities; ++i) {
+        entities[i] = reg.create();
+        reg.emplace<Transform>(entities[i], Transform{glm::vec3(coordinate(rng), 0.0f, coordinate(rng)),
+                                                      glm::quat(1.0f, 0.0f, 0.0f, 0.0f), glm::vec3(1.0f)});
+        half_extents[i] = glm::vec3(extent(rng) * 0.5f, extent(rng), extent(rng) * 0.5f);
+        reg.emplace<LagCompensated>(entities[i], LagCompensated{half_extents[i]});
+        velocities[i] = glm::vec3(speed(rng), 0.0f, speed(rng));
+    }
+
+    LagCompensationConfig config;
+    LagCompensation lag(config);
+
+    // Эталон для сверки: позиции каждого тика истории в порядке entities
+    std::vector<std::vector<glm::vec3>> history(config.history_ticks, std::vector<glm::vec3>(kEntities));
+
+    TickStats record_stats(1000.0 * kTickDt);
+    TickStats query_stats(1000.0 * kTickDt);
+    std::vector<Query> queries(queries_per_tick);
+    std::vector<Result> results(queries_per_tick);
+    uint64_t hits = 0;
+    uint64_t query_count = 0;
+    uint32_t mismatches = 0;
+    uint32_t verified_ticks = 0;
+
+    for (uint64_t tick = 0; tick < kTicks; ++tick) {
+        for (uint32_t i = 0; i < kEntities; ++i) {
+            reg.patch<Transform>(entities[i], [&](Transform& transform) {
+                transform.position += velocities[i] * kTickDt;
+                if (std::abs(transform.position.x) > kWorldSize * 0.5f) {
+                    velocities[i].x = -velocities[i].x;
+                }
+                if (std::abs(transform.position.z) > kWorldSize * 0.5f) {
+                    velocities[i].z = -velocities[i].z;
+                }
+                history[tick % config.history_ticks][i] = transform.position;
+            });
+        }
+        core::UpdateTransformSystem(reg);
+
+        auto start = Clock::now();
+        lag.Record(reg, tick);
+        record_stats.Add(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+
+        if (tick + 1 < config.history_ticks)
+            continue;
+
+        // Выстрелы клиентов с разным пингом: каждый смотрит в свой тик в пределах истории
+        for (uint32_t q = 0; q < queries_per_tick; ++q) {
+            Query& query = queries[q];
+            query.tick = tick - rng() % config.history_ticks;
+            query.shooter = static_cast<uint32_t>(rng() % kEntities);
+            query.origin = history[query.tick % config.history_ticks][query.shooter] + glm::vec3(0.0f, 0.5f, 0.0f);
+            query.direction = glm::vec3(unit(rng), unit(rng) * 0.05f, unit(rng));
+            query.sphere = q % kSphereEvery == 0;
+        }
+
+        start = Clock::now();
+        for (uint32_t q = 0; q < queries_per_tick; ++q) {
+            const Query& query = queries[q];
+            Result& result = results[q];
+            if (query.sphere) {
+                result.overlaps.clear();
+                lag.OverlapSphere(query.tick, query.origin, kSphereRadius, result.overlaps);
+                result.hit = !result.overlaps.empty();
+            } else {
+                RewindHit hit;
+                result.hit = lag.Raycast(query.tick, query.origin, query.direction, kRayDistance,
+                                         entities[query.shooter], hit);
+                result.distance = hit.distance;
+            }
+            hits += result.hit;
+        }
+        query_stats.Add(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+        query_count += queries_per_tick;
+
+        if (verified_ticks >= kVerifyTicks)
+            continue;
+        ++verified_ticks;
+
+        for (uint32_t q = 0; q < queries_per_tick; ++q) {
+            const Query& query = queries[q];
+            const auto& positions = history[query.tick % config.history_ticks];
+
+            if (query.sphere) {
+                std::vector<entt::entity> expected;
+                for (uint32_t i = 0; i < kEntities; ++i) {
+                    const glm::vec3 min = positions[i] - half_extents[i];
+                    const glm::vec3 max = positions[i] + half_extents[i];
+                    const glm::vec3 closest = glm::clamp(query.origin, min, max);
+                    const glm::vec3 delta = query.origin - closest;
+                    if (glm::dot(delta, delta) <= kSphereRadius * kSphereRadius) {
+                        expected.push_back(entities[i]);
+                    }
+                }
+                auto actual = results[q].overlaps;
+                std::sort(expected.begin(), expected.end());
+                std::sort(actual.begin(), actual.end());
+                mismatches += expected != actual;
+                continue;
+            }
+
+            const glm::vec3 dir = glm::normalize(query.direction);
+            bool expected_hit = false;
+            float expected_distance = kRayDistance;
+            for (uint32_t i = 0; i < kEntities; ++i) {
+                float distance = 0.0f;
+                if (i != query.shooter &&
+                    BruteRay(query.origin, dir, positions[i] - half_extents[i], positions[i] + half_extents[i],
+                             distance) &&
+                    distance <= expected_distance) {
+                    expected_hit = true;
+                    expected_distance = distance;
+                }
+            }
+            mismatches += expected_hit != results[q].hit ||
+                          (expected_hit && std::abs(expected_distance - results[q].distance) > 1e-3f);
+        }
+    }
+
+    const auto record = record_stats.Summarize();
+    const auto batch = query_stats.Summarize();
+    std::printf("%u hitboxes, history %u ticks, %u queries/tick (1/%u spheres)\n", kEntities, config.history_ticks,
+                queries_per_tick, kSphereEvery);
+    std::printf("record:  mean %.3f ms, p99 %.3f ms per tick\n", record.mean_ms, record.p99_ms);
+    std::printf("queries: mean %.3f ms, p99 %.3f ms per tick (%.2f us/query, %.1f%% hit)\n", batch.mean_ms,
+                batch.p99_ms, batch.mean_ms * 1000.0 / std::max(queries_per_tick, 1u),
+                100.0 * static_cast<double>(hits) / static_cast<double>(std::max<uint64_t>(query_count, 1)));
+    std::printf("history memory %zu KiB, overflow %llu\n", lag.GetMemoryBytes() / 1024,
+                static_cast<unsigned long long>(lag.GetOverflowCount()));
+    std::printf("verified %u ticks against brute force: %u mismatches\n", verified_ticks, mismatches);
+
+    return mismatches == 0 ? 0 : 1;
+}
+
+}  // namespace trybench
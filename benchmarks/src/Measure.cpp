@@ -0,0 +1,33 @@
+#include "bench/Measure.hpp"
+
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <string_view>
+
+namespace trybench {
+
+namespace {
+
+uint64_t ReadStatusKb(std::string_view field) {
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.rfind(field, 0) == 0)
+            return std::strtoull(line.c_str() + field.size(), nullptr, 10);
+    }
+    return 0;
+}
+
+}  // namespace
+
+uint64_t RssKb() { return ReadStatusKb("VmRSS:"); }
+
+uint64_t PeakRssKb() { return ReadStatusKb("VmHWM:"); }
+
+void ResetPeakRss() {
+    std::ofstream clear_refs("/proc/self/clear_refs");
+    clear_refs << "5";
+}
+
+}  // namespace trybench
@@ -0,0 +1,256 @@
+#include "bench/PrefabBenchmark.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <utility>
+#include <vector>
+
+#include "bench/Measure.hpp"
+#include "engine/core/BaseSystem.hpp"
+#include "engine/core/Components.hpp"
+#include "engine/core/Prefab.hpp"
+#include "engine/core/SceneGraph.hpp"
+#include "engine/core/TransformHierarchy.hpp"
+
+namespace trybench {
+
+using namespace tryengine;
+
+namespace {
+
+constexpr uint64_t kTrunkMesh = 101;
+constexpr uint64_t kCrownMesh = 102;
+constexpr uint64_t kBarkMaterial = 201;
+constexpr uint64_t kLeavesMaterial = 202;
+constexpr uint64_t kBirchMaterial = 203;
+constexpr uint64_t kAutumnMaterial = 204;
+
+// У каждого сотого дерева свой материал ствола, каждое тысячное развернуто: крона перекрашена и увеличена
+constexpr uint32_t kOverrideEvery = 100;
+constexpr uint32_t kExpandEvery = 1000;
+constexpr double kMaxPrefabShare = 0.5;
+
+struct DrawItem {
+    uint64_t mesh = 0;
+    uint64_t material = 0;
+    glm::mat4 matrix{1.0f};
+};
+
+entt::entity BuildTree(entt::registry& reg) {
+    auto& graph = core::AcquireSceneGraph(reg);
+
+    const auto trunk = reg.create();
+    reg.emplace<Tag>(trunk, "Tree");
+    reg.emplace<Transform>(trunk);
+    reg.emplace<Relationship>(trunk);
+    reg.emplace<MeshFilter>(trunk).asset_id = kTrunkMesh;
+    reg.emplace<MeshRenderer>(trunk).asset_id = kBarkMaterial;
+
+    const auto crown = reg.create();
+    reg.emplace<Tag>(crown, "Crown");
+    reg.emplace<Transform>(crown).position = glm::vec3(0.0f, 4.0f, 0.0f);
+    reg.emplace<Relationship>(crown);
+    reg.emplace<MeshFilter>(crown).asset_id = kCrownMesh;
+    reg.emplace<MeshRenderer>(crown).asset_id = kLeavesMaterial;
+    graph.SetParent(reg, crown, trunk);
+    return trunk;
+}
+
+// Обычная копия: все компоненты обоих узлов на каждой сущности, вставка пачкой как в Spawner::SpawnBatch.
+// Возвращает стволы, крона дерева i — следующая за стволом сущность
+std::vector<entt::entity> DuplicateTrees(entt::registry& reg, const entt::registry& source, entt::entity trunk,
+                                         const std::vector<Transform>& transforms) {
+    const auto crown = source.get<Relationship>(trunk).first;
+    const size_t count = transforms.size() * 2;
+    auto& graph = core::AcquireSceneGraph(reg);
+
+    std::vector<entt::entity> entities(count);
+    reg.create(entities.begin(), entities.end());
+
+    std::vector<Tag> tags;
+    std::vector<Transform> locals;
+    std::vector<Relationship> relationships(count);
+    std::vector<MeshFilter> filters;
+    std::vector<MeshRenderer> renderers;
+    tags.reserve(count);
+    locals.reserve(count);
+    filters.reserve(count);
+    renderers.reserve(count);
+
+    for (size_t i = 0; i < transforms.size(); ++i) {
+        for (const auto node : {trunk, crown}) {
+            tags.push_back(source.get<Tag>(node));
+            filters.push_back(source.get<MeshFilter>(node));
+            renderers.push_back(source.get<MeshRenderer>(node));
+        }
+        locals.push_back(transforms[i]);
+        locals.push_back(source.get<Transform>(crown));
+
+        relationships[i * 2].children = 1;
+        relationships[i * 2].first = entities[i * 2 + 1];
+        relationships[i * 2 + 1].parent = entities[i * 2];
+    }
+
+    reg.insert<Tag>(entities.begin(), entities.end(), tags.begin());
+    reg.insert<Transform>(entities.begin(), entities.end(), locals.begin());
+    reg.insert<Relationship>(entities.begin(), entities.end(), relationships.begin());
+    reg.insert<MeshFilter>(entities.begin(), entities.end(), filters.begin());
+    reg.insert<MeshRenderer>(entities.begin(), entities.end(), renderers.begin());
+    graph.AddFromRelationships(reg, entities);
+
+    std::vector<entt::entity> trunks(transforms.size());
+    for (size_t i = 0; i < transforms.size(); ++i) {
+        trunks[i] = entities[i * 2];
+    }
+    return trunks;
+}
+
+template <typename... T>
+std::vector<size_t> PoolsBytes(entt::registry& reg) {
+    return {PoolBytes<T>(reg)...};
+}
+
+// Пулы, которые есть хотя бы в одном из миров
+std::vector<size_t> MeasurePools(entt::registry& reg) {
+    return PoolsBytes<entt::entity, Transform, WorldMatrix, TransformDirty, Relationship, Tag, MeshFilter,
+                      MeshRenderer, PrefabInstance, PrefabExpanded>(reg);
+}
+
+constexpr const char* kPoolNames[] = {"entities", "Transform",  "WorldMatrix",  "TransformDirty", "Relationship",
+                                      "Tag",      "MeshFilter", "MeshRenderer", "PrefabInstance", "PrefabExpanded"};
+
+// Что отправится в рендер: обычные сущности с мешем и экземпляры префабов, по тем же правилам, что в
+// SubmitSceneFromEnTT. Сортировка делает список независимым от порядка пулов
+std::vector<DrawItem> CollectDraws(entt::registry& reg) {
+    std::vector<DrawItem> draws;
+    const auto add = [&](const glm::mat4& matrix, const MeshFilter& filter, const MeshRenderer& renderer) {
+        draws.push_back({filter.asset_id, renderer.asset_id, matrix});
+    };
+
+    for (const auto [entity, world, filter, renderer] :
+         reg.view<const WorldMatrix, const MeshFilter, const MeshRenderer>().each()) {
+        add(world.value, filter, renderer);
+    }
+    core::ForEachPrefabMesh(reg, add);
+
+    std::sort(draws.begin(), draws.end(), [](const DrawItem& a, const DrawItem& b) {
+        if (a.mesh != b.mesh)
+            return a.mesh < b.mesh;
+        if (a.material != b.material)
+            return a.material < b.material;
+        // Позиции из двух миров считаются разными путями — сравниваем с округлением до сантиметра
+        const auto key = [](const DrawItem& item) {
+            return std::pair(std::lround(item.matrix[3].x * 100.0f), std::lround(item.matrix[3].z * 100.0f));
+        };
+        return key(a) < key(b);
+    });
+    return draws;
+}
+
+bool SameDraws(const std::vector<DrawItem>& a, const std::vector<DrawItem>& b) {
+    if (a.size() != b.size())
+        return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].mesh != b[i].mesh || a[i].material != b[i].material)
+            return false;
+        for (int column = 0; column < 4; ++column) {
+            if (glm::length(a[i].matrix[column] - b[i].matrix[column]) > 1e-3f)
+                return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
+int RunPrefabBenchmark(uint32_t instances) {
+    entt::registry source;
+    const auto trunk = BuildTree(source);
+
+    // Деревья сеткой; каждое повернуто, чтобы матрицы кроны зависели от трансформа экземпляра
+    std::vector<Transform> transforms(instances);
+    for (uint32_t i = 0; i < instances; ++i) {
+        transforms[i].position =
+            glm::vec3(static_cast<float>(i % 1000) * 5.0f, 0.0f, static_cast<float>(i / 1000) * 5.0f);
+        transforms[i].rotation =
+            glm::angleAxis(glm::radians(static_cast<float>(i % 360)), glm::vec3(0.0f, 1.0f, 0.0f));
+    }
+
+    std::printf("%u trees of 2 nodes (trunk + crown), every %u-th overrides its bark, every %u-th is expanded\n",
+                instances, kOverrideEvery, kExpandEvery);
+
+    // Префабный мир меряем первым: память, освобожденная после него, может уйти копии и занизить ее, не наоборот
+    const uint64_t rss_start_kb = RssKb();
+    auto start = std::chrono::steady_clock::now();
+    entt::registry prefab_world;
+    core::AcquireTransformHierarchy(prefab_world);
+    const uint32_t tree = core::AcquirePrefabLibrary(prefab_world).AddFromHierarchy(source, trunk);
+    const auto roots = core::InstantiatePrefab(prefab_world, tree, transforms);
+    for (uint32_t i = 0; i < instances; i += kOverrideEvery) {
+        core::OverridePrefabComponent<MeshRenderer>(prefab_world, roots[i]).asset_id = kBirchMaterial;
+    }
+    for (uint32_t i = 1; i < instances; i += kExpandEvery) {
+        const auto nodes = core::ExpandPrefabInstance(prefab_world, roots[i]);
+        core::OverridePrefabComponent<MeshRenderer>(prefab_world, nodes[1]).asset_id = kAutumnMaterial;
+        prefab_world.patch<Transform>(nodes[1], [](Transform& transform) { transform.scale = glm::vec3(1.5f); });
+    }
+    core::UpdateTransformSystem(prefab_world);
+    const double prefab_ms = MsSince(start);
+    const uint64_t rss_prefab_kb = RssKb();
+
+    start = std::chrono::steady_clock::now();
+    entt::registry copy_world;
+    core::AcquireTransformHierarchy(copy_world);
+    const auto trunks = DuplicateTrees(copy_world, source, trunk, transforms);
+    for (uint32_t i = 0; i < instances; i += kOverrideEvery) {
+        copy_world.get<MeshRenderer>(trunks[i]).asset_id = kBirchMaterial;
+    }
+    for (uint32_t i = 1; i < instances; i += kExpandEvery) {
+        const auto crown = copy_world.get<Relationship>(trunks[i]).first;
+        copy_world.get<MeshRenderer>(crown).asset_id = kAutumnMaterial;
+        copy_world.patch<Transform>(crown, [](Transform& transform) { transform.scale = glm::vec3(1.5f); });
+    }
+    core::UpdateTransformSystem(copy_world);
+    const double copy_ms = MsSince(start);
+    const uint64_t rss_copy_kb = RssKb();
+
+    const auto prefab_pools = MeasurePools(prefab_world);
+    const auto copy_pools = MeasurePools(copy_world);
+    size_t prefab_bytes = 0;
+    size_t copy_bytes = 0;
+
+    const double per_instance = 1.0 / static_cast<double>(instances);
+    std::printf("%-16s %14s %14s\n", "bytes/instance", "copy", "prefab");
+    for (size_t i = 0; i < copy_pools.size(); ++i) {
+        std::printf("%-16s %14.1f %14.1f\n", kPoolNames[i], static_cast<double>(copy_pools[i]) * per_instance,
+                    static_cast<double>(prefab_pools[i]) * per_instance);
+        prefab_bytes += prefab_pools[i];
+        copy_bytes += copy_pools[i];
+    }
+    std::printf("%-16s %14.1f %14.1f\n", "pools total", static_cast<double>(copy_bytes) * per_instance,
+                static_cast<double>(prefab_bytes) * per_instance);
+
+    // RSS включает и то, что пулы не показывают: TransformHierarchy, SceneGraph, временные буферы вставки
+    const auto rss_growth = [&](uint64_t from_kb, uint64_t to_kb) {
+        return (static_cast<double>(to_kb) - static_cast<double>(from_kb)) * 1024.0 * per_instance;
+    };
+    const double copy_rss = rss_growth(rss_prefab_kb, rss_copy_kb);
+    const double prefab_rss = rss_growth(rss_start_kb, rss_prefab_kb);
+    std::printf("%-16s %14.1f %14.1f\n", "RSS growth", copy_rss, prefab_rss);
+    std::printf("%-16s %14zu %14zu\n", "entities", copy_world.storage<entt::entity>().free_list(),
+                prefab_world.storage<entt::entity>().free_list());
+    std::printf("%-16s %11.2f ms %11.2f ms\n", "build + update", copy_ms, prefab_ms);
+
+    const double share = static_cast<double>(prefab_bytes) / static_cast<double>(copy_bytes);
+    std::printf("prefab instance costs %.0f%% of a copy (pools)\n", share * 100.0);
+
+    if (!SameDraws(CollectDraws(prefab_world), CollectDraws(copy_world))) {
+        std::printf("prefab world renders differently from the copy\n");
+        return 1;
+    }
+    return share <= kMaxPrefabShare ? 0 : 1;
+}
+
+}  // namespace trybench
@@ -0,0 +1,155 @@
+#include "bench/RenderIterationBenchmark.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <entt/entity/registry.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <random>
+#include <vector>
+
+#include "bench/Measure.hpp"
+#include "engine/core/Components.hpp"
+
+namespace trybench {
+
+using namespace tryengine;
+
+namespace {
+
+constexpr int kRepeats = 20;
+
+// Transform до разделения: TRS и мировая матрица в одном компоненте
+struct LegacyTransform {
+    glm::vec3 position{0.0f};
+    glm::quat rotation{1.0f, 0.0f, 0.0f, 0.0f};
+    glm::vec3 scale{1.0f};
+    glm::mat4 world_matrix{1.0f};
+};
+
+struct Checksum {
+    double translation = 0.0;
+    uint64_t assets = 0;
+};
+
+// Что читает цикл отправки: позицию из матрицы и оба asset_id
+void Accumulate(Checksum& sum, const glm::mat4& world, const MeshFilter& filter, const MeshRenderer& renderer) {
+    sum.translation += world[3].x + world[3].y + world[3].z;
+    sum.assets += filter.asset_id ^ renderer.asset_id;
+}
+
+}  // namespace
+
+int RunRenderIterationBenchmark(uint32_t renderables) {
+    const uint32_t entity_count = renderables * 2;
+
+    // Меши достаются сущностям вразброс, как после импорта нескольких моделей и правок сцены
+    std::vector<uint32_t> mesh_order(entity_count);
+    for (uint32_t i = 0; i < entity_count; ++i) {
+        mesh_order[i] = i;
+    }
+    std::mt19937 rng(9);
+    std::shuffle(mesh_order.begin(), mesh_order.end(), rng);
+    mesh_order.resize(renderables);
+
+    std::uniform_real_distribution<float> coordinate(-100.0f, 100.0f);
+    std::vector<glm::vec3> positions(entity_count);
+    for (auto& position : positions) {
+        position = glm::vec3(coordinate(rng), coordinate(rng), coordinate(rng));
+    }
+
+    entt::registry legacy;
+    entt::registry split;
+    // Группа создается до заполнения, как в редакторе: пулы сразу упорядочены
+    auto group = split.group<WorldMatrix, MeshFilter, MeshRenderer>();
+
+    std::vector<entt::entity> legacy_entities(entity_count);
+    std::vector<entt::entity> split_entities(entity_count);
+    legacy.create(legacy_entities.begin(), legacy_entities.end());
+    split.create(split_entities.begin(), split_entities.end());
+    for (uint32_t i = 0; i < entity_count; ++i) {
+        const glm::mat4 world = glm::translate(glm::mat4(1.0f), positions[i]);
+        legacy.emplace<LegacyTransform>(legacy_entities[i], LegacyTransform{positions[i], {1.0f, 0.0f, 0.0f, 0.0f},
+                                                                            glm::vec3(1.0f), world});
+        split.emplace<Transform>(split_entities[i], Transform{positions[i]});
+        split.emplace<WorldMatrix>(split_entities[i], WorldMatrix{world});
+    }
+    for (const uint32_t index : mesh_order) {
+        const uint64_t mesh = 1000 + index % 64;
+        const uint64_t material = 2000 + index % 16;
+        legacy.emplace<MeshFilter>(legacy_entities[index]).asset_id = mesh;
+        legacy.emplace<MeshRenderer>(legacy_entities[index]).asset_id = material;
+        split.emplace<MeshFilter>(split_entities[index]).asset_id = mesh;
+        split.emplace<MeshRenderer>(split_entities[index]).asset_id = material;
+    }
+
+    Checksum legacy_sum;
+    const double legacy_ms = BestMs(kRepeats, [&] {
+        legacy_sum = {};
+        for (const auto [entity, transform, filter, renderer] :
+             legacy.view<LegacyTransform, MeshFilter, MeshRenderer>().each()) {
+            Accumulate(legacy_sum, transform.world_matrix, filter, renderer);
+        }
+    });
+
+    Checksum view_sum;
+    const double view_ms = BestMs(kRepeats, [&] {
+        view_sum = {};
+        for (const auto [entity, world, filter, renderer] :
+             split.view<WorldMatrix, MeshFilter, MeshRenderer>().each()) {
+            Accumulate(view_sum, world.value, filter, renderer);
+        }
+    });
+
+    Checksum group_sum;
+    const double group_ms = BestMs(kRepeats, [&] {
+        group_sum = {};
+        for (const auto [entity, world, filter, renderer] : group.each()) {
+            Accumulate(group_sum, world.value, filter, renderer);
+        }
+    });
+
+    // Системы, которым нужен только TRS (скрипты, сериализация), больше не тащат матрицу через кэш
+    double legacy_trs = 0.0;
+    const double legacy_trs_ms = BestMs(kRepeats, [&] {
+        legacy_trs = 0.0;
+        for (const auto [entity, transform] : legacy.view<LegacyTransform>().each()) {
+            legacy_trs += transform.position.x + transform.scale.y;
+        }
+    });
+    double split_trs = 0.0;
+    const double split_trs_ms = BestMs(kRepeats, [&] {
+        split_trs = 0.0;
+        for (const auto [entity, transform] : split.view<Transform>().each()) {
+            split_trs += transform.position.x + transform.scale.y;
+        }
+    });
+
+    const auto ns_per = [](double ms, uint32_t count) { return ms * 1e6 / count; };
+    std::printf("%u renderables among %u entities, sizeof: LegacyTransform %zu, Transform %zu, WorldMatrix %zu\n",
+                renderables, entity_count, sizeof(LegacyTransform), sizeof(Transform), sizeof(WorldMatrix));
+    std::printf("%-40s %10s %12s %10s\n", "loop", "ms", "ns/entity", "speedup");
+    std::printf("%-40s %10.3f %12.2f %9.2fx\n", "draw: view<LegacyTransform, mesh>", legacy_ms,
+                ns_per(legacy_ms, renderables), 1.0);
+    std::printf("%-40s %10.3f %12.2f %9.2fx\n", "draw: view<WorldMatrix, mesh>", view_ms, ns_per(view_ms, renderables),
+                legacy_ms / view_ms);
+    std::printf("%-40s %10.3f %12.2f %9.2fx\n", "draw: owning group<WorldMatrix, mesh>", group_ms,
+                ns_per(group_ms, renderables), legacy_ms / group_ms);
+    std::printf("%-40s %10.3f %12.2f %9.2fx\n", "TRS only: LegacyTransform", legacy_trs_ms,
+                ns_per(legacy_trs_ms, entity_count), 1.0);
+    std::printf("%-40s %10.3f %12.2f %9.2fx\n", "TRS only: Transform", split_trs_ms, ns_per(split_trs_ms, entity_count),
+                legacy_trs_ms / split_trs_ms);
+
+    // Порядок обхода у путей разный — сумма с плавающей точкой сверяется с допуском
+    const auto close = [](double a, double b) { return std::abs(a - b) <= 1e-6 * std::max(1.0, std::abs(a)); };
+    const bool same = legacy_sum.assets == view_sum.assets && legacy_sum.assets == group_sum.assets &&
+                      close(legacy_sum.translation, view_sum.translation) &&
+                      close(legacy_sum.translation, group_sum.translation) && close(legacy_trs, split_trs);
+    if (!same) {
+        std::printf("loops read different data\n");
+        return 1;
+    }
+    return 0;
+}
+
+}  // namespace trybench
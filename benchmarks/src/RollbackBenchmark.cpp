@@ -0,0 +1,131 @@
+#include "bench/RollbackBenchmark.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "bench/Measure.hpp"
+#include "engine/core/BaseSystem.hpp"
+#include "engine/core/Components.hpp"
+#include "engine/core/RollbackBuffer.hpp"
+#include "engine/core/TransformHierarchy.hpp"
+
+namespace trybench {
+
+using namespace tryengine;
+
+namespace {
+
+constexpr float kTickDt = 1.0f / 60.0f;
+constexpr uint32_t kIterations = 200;
+// Сколько сущностей сервер поправил в пришедшем состоянии
+constexpr uint32_t kCorrectedEntities = 64;
+
+// Предсказываемое состояние помимо Transform
+struct PredictedBody {
+    glm::vec3 velocity{0.0f};
+    float drag = 0.0f;
+};
+
+// Шаг симуляции клиента: интегрирование и пересчет мировых матриц
+void Simulate(entt::registry& reg) {
+    auto view = reg.view<PredictedBody>();
+    for (const auto entity : view) {
+        auto& body = view.get<PredictedBody>(entity);
+        body.velocity *= 1.0f - body.drag * kTickDt;
+        reg.patch<Transform>(entity, [&](Transform& transform) { transform.position += body.velocity * kTickDt; });
+    }
+    core::UpdateTransformSystem(reg);
+}
+
+std::vector<Transform> CopyTransforms(const entt::registry& reg, const std::vector<entt::entity>& entities) {
+    std::vector<Transform> result;
+    result.reserve(entities.size());
+    for (const auto entity : entities) {
+        result.push_back(reg.get<Transform>(entity));
+    }
+    return result;
+}
+
+}  // namespace
+
+int RunRollbackBenchmark(uint32_t entity_count, uint32_t rollback_ticks, double budget_ms) {
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> coordinate(-200.0f, 200.0f);
+    std::uniform_real_distribution<float> speed(-5.0f, 5.0f);
+
+    entt::registry reg;
+    core::AcquireTransformHierarchy(reg);
+
+    std::vector<entt::entity> entities;
+    entities.reserve(entity_count);
+    for (uint32_t i = 0; i < entity_count; ++i) {
+        const auto entity = reg.create();
+        reg.emplace<Transform>(entity, Transform{glm::vec3(coordinate(rng), 0.0f, coordinate(rng)),
+                                                 glm::quat(1.0f, 0.0f, 0.0f, 0.0f), glm::vec3(1.0f)});
+        reg.emplace<PredictedBody>(entity, PredictedBody{glm::vec3(speed(rng), 0.0f, speed(rng)), 0.1f});
+        entities.push_back(entity);
+    }
+
+    core::RollbackBuffer rollback(rollback_ticks * 2);
+    rollback.Track<Transform>();
+    rollback.Track<PredictedBody>();
+
+    const auto simulate = [](entt::registry& registry, uint32_t) { Simulate(registry); };
+
+    uint32_t tick = 0;
+    core::UpdateTransformSystem(reg);
+    rollback.Save(reg, tick);
+    while (tick < rollback_ticks) {
+        ++tick;
+        Simulate(reg);
+        rollback.Save(reg, tick);
+    }
+
+    // Без поправки повторная симуляция обязана дать то же состояние — детерминизм отката
+    const auto expected = CopyTransforms(reg, entities);
+    rollback.Resimulate(reg, tick - rollback_ticks, tick, {}, simulate);
+    const auto replayed = CopyTransforms(reg, entities);
+    const bool deterministic = std::memcmp(expected.data(), replayed.data(), expected.size() * sizeof(Transform)) == 0;
+
+    std::vector<double> samples;
+    samples.reserve(kIterations);
+    double save_ms = 0.0;
+    for (uint32_t iteration = 0; iteration < kIterations; ++iteration) {
+        // Обычный тик предсказания
+        ++tick;
+        Simulate(reg);
+        auto start = std::chrono::steady_clock::now();
+        rollback.Save(reg, tick);
+        save_ms += MsSince(start);
+
+        // Пришло состояние сервера на rollback_ticks назад: часть сущностей стоит не там, где мы предсказали
+        const auto correct = [&](entt::registry& registry) {
+            for (uint32_t i = 0; i < kCorrectedEntities; ++i) {
+                const auto entity = entities[(iteration * kCorrectedEntities + i) % entities.size()];
+                registry.patch<Transform>(entity, [](Transform& transform) { transform.position.y += 0.01f; });
+            }
+        };
+
+        start = std::chrono::steady_clock::now();
+        rollback.Resimulate(reg, tick - rollback_ticks, tick, correct, simulate);
+        samples.push_back(MsSince(start));
+    }
+
+    std::sort(samples.begin(), samples.end());
+    const double p50 = samples[samples.size() / 2];
+    const double p99 = samples[std::min(samples.size() - 1, samples.size() * 99 / 100)];
+    const double max = samples.back();
+
+    std::printf("%u entities, rollback %u ticks, %u iterations\n", entity_count, rollback_ticks, kIterations);
+    std::printf("save %.3f ms/tick, restore+resimulate p50 %.3f ms, p99 %.3f ms, max %.3f ms (budget %.2f ms)\n",
+                save_ms / kIterations, p50, p99, max, budget_ms);
+    std::printf("deterministic replay: %s\n", deterministic ? "yes" : "NO");
+
+    return deterministic && p99 <= budget_ms ? 0 : 1;
+}
+
+}  // namespace trybench
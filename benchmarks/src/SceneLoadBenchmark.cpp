@@ -0,0 +1,442 @@
+#include "bench/SceneLoadBenchmark.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "bench/Measure.hpp"
+#include "engine/core/ComponentRegistry.hpp"
+#include "engine/core/Components.hpp"
+#include "engine/core/JobSystem.hpp"
+#include "engine/core/MappedFile.hpp"
+#include "engine/core/ResourceManager.hpp"
+#include "engine/core/SceneFormat.hpp"
+#include "engine/core/SceneGraph.hpp"
+#include "engine/core/SceneManager.hpp"
+#include "engine/graphics/Types.hpp"
+#include "engine/resources/MeshDataLoader.hpp"
+
+namespace trybench {
+
+using namespace tryengine;
+
+namespace {
+
+constexpr int kRepeats = 3;
+constexpr double kRequiredSpeedup = 10.0;
+
+// Асинхронная загрузка: бюджет Update на кадр и допустимая пауза главного потока (половина кадра 60 Гц)
+constexpr double kFrameBudgetMs = 2.0;
+constexpr double kMaxStallMs = 8.0;
+constexpr uint32_t kProbeEntities = 10000;
+constexpr uint64_t kBaseSceneId = 1;
+constexpr uint64_t kAdditiveSceneId = 2;
+// Меши сцен грузятся с диска настоящим MeshDataLoader, пока главный поток берет из кэша уже загруженный
+constexpr uint64_t kMeshBase = 1000;
+constexpr uint64_t kAdditiveMeshBase = 1100;
+constexpr uint64_t kProbeMeshId = 900;
+constexpr uint32_t kMeshVertices = 65536;
+constexpr uint32_t kMeshVariants = 7;
+
+// Похоже на уровень: у всех Transform и Relationship, у части имена и меши
+constexpr uint32_t kTagEvery = 10;
+constexpr uint32_t kMeshEvery = 20;
+// Каждая kChildEvery-я сущность — корень, следующие за ней — ее дети
+constexpr uint32_t kChildEvery = 4;
+
+void BuildScene(entt::registry& reg, uint32_t entity_count, uint64_t mesh_base = kMeshBase) {
+    std::mt19937 rng(17);
+    std::uniform_real_distribution<float> position(-500.0f, 500.0f);
+    std::uniform_real_distribution<float> angle(-3.14159f, 3.14159f);
+
+    entt::entity previous = entt::null;
+    for (uint32_t i = 0; i < entity_count; ++i) {
+        const auto entity = reg.create();
+        const glm::vec3 axis = glm::normalize(glm::vec3(position(rng), position(rng), position(rng)) + 1e-3f);
+        reg.emplace<Transform>(entity, Transform{glm::vec3(position(rng), position(rng), position(rng)),
+                                                 glm::angleAxis(angle(rng), axis), glm::vec3(1.0f)});
+
+        auto& relationship = reg.emplace<Relationship>(entity);
+        if (i % kChildEvery != 0 && previous != entt::null) {
+            auto& parent = reg.get<Relationship>(previous);
+            relationship.parent = previous;
+            relationship.next = parent.first;
+            if (parent.first != entt::null) {
+                reg.get<Relationship>(parent.first).prev = entity;
+            }
+            parent.first = entity;
+            ++parent.children;
+        }
+        if (i % kChildEvery == 0) {
+            previous = entity;
+        }
+
+        if (i % kTagEvery == 0) {
+            reg.emplace<Tag>(entity, "Entity_" + std::to_string(i));
+        }
+        if (i % kMeshEvery == 0) {
+            reg.emplace<MeshFilter>(entity).asset_id = mesh_base + i % kMeshVariants;
+            reg.emplace<MeshRenderer>(entity).asset_id = 2000 + i % 5;
+        }
+    }
+
+    const auto camera = reg.create();
+    reg.emplace<Transform>(camera);
+    reg.emplace<Relationship>(camera);
+    reg.emplace<Camera>(camera);
+    reg.emplace<MainCameraTag>(camera);
+
+    // Пара удаленных сущностей: их версии тоже должны пережить загрузку
+    reg.destroy(reg.create());
+    reg.destroy(reg.create());
+}
+
+bool SameTransform(const Transform& a, const Transform& b) {
+    return a.position == b.position && a.rotation == b.rotation && a.scale == b.scale;
+}
+
+bool SameRelationship(const Relationship& a, const Relationship& b) {
+    return a.children == b.children && a.first == b.first && a.prev == b.prev && a.next == b.next &&
+           a.parent == b.parent;
+}
+
+template <typename T>
+size_t PoolSize(const entt::registry& reg) {
+    const auto* storage = reg.storage<T>();
+    return storage ? storage->size() : 0;
+}
+
+// Реестры совпадают по пулам и данным сущностей
+bool SameScene(const entt::registry& a, const entt::registry& b) {
+    if (PoolSize<Transform>(a) != PoolSize<Transform>(b) || PoolSize<Relationship>(a) != PoolSize<Relationship>(b) ||
+        PoolSize<Tag>(a) != PoolSize<Tag>(b) || PoolSize<MeshFilter>(a) != PoolSize<MeshFilter>(b) ||
+        PoolSize<MeshRenderer>(a) != PoolSize<MeshRenderer>(b) || PoolSize<Camera>(a) != PoolSize<Camera>(b) ||
+        PoolSize<MainCameraTag>(a) != PoolSize<MainCameraTag>(b))
+        return false;
+
+    for (const auto [entity, transform] : a.view<Transform>().each()) {
+        if (!b.all_of<Transform, Relationship>(entity) || !SameTransform(transform, b.get<Transform>(entity)) ||
+            !SameRelationship(a.get<Relationship>(entity), b.get<Relationship>(entity)))
+            return false;
+    }
+    for (const auto [entity, tag] : a.view<Tag>().each()) {
+        if (!b.all_of<Tag>(entity) || b.get<Tag>(entity).tag != tag.tag)
+            return false;
+    }
+    for (const auto [entity, filter] : a.view<MeshFilter>().each()) {
+        if (!b.all_of<MeshFilter>(entity) || b.get<MeshFilter>(entity).asset_id != filter.asset_id)
+            return false;
+    }
+    return true;
+}
+
+// Артефакт меша в формате MeshDataLoader: число вершин, число индексов, вершины, индексы
+bool WriteMeshArtifact(const std::filesystem::path& path, uint32_t vertex_count) {
+    std::vector<resources::Vertex> vertices(vertex_count);
+    for (uint32_t i = 0; i < vertex_count; ++i) {
+        const float t = static_cast<float>(i);
+        vertices[i] = {t, t * 0.5f, -t, 0.0f, 1.0f, 0.0f, 1.0f, 1.0f, 1.0f, 1.0f, t / vertex_count, 0.0f};
+    }
+    std::vector<uint32_t> indices(static_cast<size_t>(vertex_count) * 3);
+    for (size_t i = 0; i < indices.size(); ++i) {
+        indices[i] = static_cast<uint32_t>(i % vertex_count);
+    }
+
+    const auto index_count = static_cast<uint32_t>(indices.size());
+    std::ofstream os(path, std::ios::binary | std::ios::trunc);
+    os.write(reinterpret_cast<const char*>(&vertex_count), sizeof(uint32_t));
+    os.write(reinterpret_cast<const char*>(&index_count), sizeof(uint32_t));
+    os.write(reinterpret_cast<const char*>(vertices.data()),
+             static_cast<std::streamsize>(vertices.size() * sizeof(resources::Vertex)));
+    os.write(reinterpret_cast<const char*>(indices.data()),
+             static_cast<std::streamsize>(indices.size() * sizeof(uint32_t)));
+    return static_cast<bool>(os);
+}
+
+// MeshLoader без устройства: те же данные через Get<MeshData> (чтение артефакта с диска), но без загрузки на GPU
+class HeadlessMeshLoader {
+public:
+    using result_type = std::shared_ptr<graphics::Mesh>;
+
+    explicit HeadlessMeshLoader(core::ResourceManager& resources) : resources_(&resources) {}
+
+    result_type operator()(uint64_t id, const std::string&) const {
+        const auto data = resources_->Get<resources::MeshData>(id);
+        if (!data)
+            return nullptr;
+        return std::make_shared<graphics::Mesh>(
+            graphics::Mesh{nullptr, nullptr, static_cast<uint32_t>(data->indexBuffer.size())});
+    }
+
+private:
+    core::ResourceManager* resources_;
+};
+
+}  // namespace
+
+int RunSceneLoadBenchmark(uint32_t entity_count, uint32_t threads) {
+    core::ComponentRegistry components;
+    core::RegisterEngineComponents(components);
+
+    entt::registry source;
+    BuildScene(source, entity_count);
+
+    const auto directory = std::filesystem::temp_directory_path();
+    const auto cereal_path = directory / "tryengine_bench.scene.cereal";
+    const auto cooked_path = directory / "tryengine_bench.scene.cooked";
+
+    {
+        std::ofstream os(cereal_path, std::ios::binary | std::ios::trunc);
+        cereal::BinaryOutputArchive archive(os);
+        components.Serialize(source, archive);
+    }
+    if (!core::WriteCookedScene(cooked_path, source, components)) {
+        std::printf("failed to write %s\n", cooked_path.string().c_str());
+        return 1;
+    }
+
+    // Реестр создается внутри замера: у SceneManager каждая сцена тоже загружается в новый
+    entt::registry cereal_scene;
+    const double cereal_ms = BestMs(kRepeats, [&] {
+        std::ifstream is(cereal_path, std::ios::binary);
+        cereal::BinaryInputArchive archive(is);
+        entt::registry loaded;
+        components.Deserialize(loaded, archive);
+        cereal_scene = std::move(loaded);
+    });
+
+    entt::registry cooked_scene;
+    bool ok = true;
+    const double cooked_ms = BestMs(kRepeats, [&] {
+        core::MappedFile file;
+        ok &= file.Open(cooked_path);
+        entt::registry loaded;
+        ok &= core::ReadCookedScene(file.GetData(), loaded, components);
+        cooked_scene = std::move(loaded);
+    });
+
+    // Те же пулы задачами по потокам, с временем по каждому
+    std::unique_ptr<core::JobSystem> jobs;
+    if (threads > 1) {
+        jobs = std::make_unique<core::JobSystem>(threads - 1);
+    }
+    entt::registry parallel_scene;
+    core::SceneLoadStats stats;
+    const double parallel_ms = BestMs(kRepeats, [&] {
+        core::MappedFile file;
+        ok &= file.Open(cooked_path);
+        entt::registry loaded;
+        ok &= core::ReadCookedScene(file.GetData(), loaded, components, {jobs.get(), nullptr}, &stats);
+        parallel_scene = std::move(loaded);
+    });
+
+    ok &= SameScene(source, cereal_scene) && SameScene(source, cooked_scene) && SameScene(source, parallel_scene);
+
+    // Следующая созданная сущность совпадает — состояние пула сущностей тоже восстановлено
+    ok &= cereal_scene.create() == cooked_scene.create();
+
+    const double speedup = cereal_ms / cooked_ms;
+    std::printf("%u entities\n", entity_count);
+    std::printf("%-18s %12s %10s %14s\n", "path", "bytes", "ms", "Ment/s");
+    std::printf("%-18s %12ju %10.2f %14.2f\n", "cereal (ifstream)",
+                static_cast<uintmax_t>(std::filesystem::file_size(cereal_path)), cereal_ms,
+                entity_count / cereal_ms / 1000.0);
+    std::printf("%-18s %12ju %10.2f %14.2f\n", "cooked (mmap)",
+                static_cast<uintmax_t>(std::filesystem::file_size(cooked_path)), cooked_ms,
+                entity_count / cooked_ms / 1000.0);
+    char label[32];
+    std::snprintf(label, sizeof(label), "cooked (%u threads)", threads);
+    std::printf("%-18s %12s %10.2f %14.2f\n", label, "", parallel_ms, entity_count / parallel_ms / 1000.0);
+    std::printf("speedup %.1fx (required %.0fx)\n", speedup, kRequiredSpeedup);
+
+    // Последний из повторов; самый медленный пул — нижняя граница параллельной загрузки
+    std::printf("%-18s %12s %10s\n", "pool", "entities", "ms");
+    for (const auto& pool : stats.pools) {
+        std::printf("%-18s %12zu %10.3f\n", pool.name.c_str(), pool.count, pool.ms);
+    }
+
+    std::filesystem::remove(cereal_path);
+    std::filesystem::remove(cooked_path);
+
+    if (!ok) {
+        std::printf("loaded scenes differ from the source\n");
+        return 1;
+    }
+    return speedup >= kRequiredSpeedup ? 0 : 1;
+}
+
+int RunSceneAsyncBenchmark(uint32_t megabytes, uint32_t threads) {
+    using Clock = std::chrono::steady_clock;
+
+    core::ComponentRegistry components;
+    core::RegisterEngineComponents(components);
+
+    const auto directory = std::filesystem::temp_directory_path();
+    const auto path = directory / "tryengine_bench_async.scene";
+    const auto additive_path = directory / "tryengine_bench_async_additive.scene";
+
+    // Сколько байт занимает сущность в запеченном виде — по пробной сцене
+    uint64_t entity_count = 0;
+    {
+        entt::registry probe;
+        BuildScene(probe, kProbeEntities);
+        if (!core::WriteCookedScene(path, probe, components)) {
+            std::printf("failed to write %s\n", path.string().c_str());
+            return 1;
+        }
+        const double bytes_per_entity =
+            static_cast<double>(std::filesystem::file_size(path)) / static_cast<double>(kProbeEntities);
+        entity_count = static_cast<uint64_t>(static_cast<double>(megabytes) * 1024.0 * 1024.0 / bytes_per_entity);
+    }
+    {
+        entt::registry source;
+        BuildScene(source, static_cast<uint32_t>(entity_count));
+        entt::registry additive_source;
+        BuildScene(additive_source, static_cast<uint32_t>(entity_count), kAdditiveMeshBase);
+        if (!core::WriteCookedScene(path, source, components) ||
+            !core::WriteCookedScene(additive_path, additive_source, components)) {
+            std::printf("failed to write %s\n", path.string().c_str());
+            return 1;
+        }
+    }
+
+    std::vector<std::pair<uint64_t, std::filesystem::path>> meshes{
+        {kProbeMeshId, directory / ("tryengine_bench_mesh_" + std::to_string(kProbeMeshId))}};
+    for (const uint64_t base : {kMeshBase, kAdditiveMeshBase}) {
+        for (uint64_t id = base; id < base + kMeshVariants; ++id) {
+            meshes.emplace_back(id, directory / ("tryengine_bench_mesh_" + std::to_string(id)));
+        }
+    }
+    for (const auto& [id, mesh_path] : meshes) {
+        if (!WriteMeshArtifact(mesh_path, kMeshVertices)) {
+            std::printf("failed to write %s\n", mesh_path.string().c_str());
+            return 1;
+        }
+    }
+
+    // Асинхронной загрузке нужен хотя бы один воркер
+    core::JobSystem jobs(std::max(threads, 2u) - 1);
+    core::ResourceManager resources;
+    resources.GetAssetDatabase().Register(kBaseSceneId, path);
+    resources.GetAssetDatabase().Register(kAdditiveSceneId, additive_path);
+    for (const auto& [id, mesh_path] : meshes) {
+        resources.GetAssetDatabase().Register(id, mesh_path);
+    }
+
+    core::SceneManager scenes(components, resources);
+    scenes.SetJobSystem(&jobs);
+
+    const auto alive = [&] {
+        const auto& entities = scenes.GetActiveScene().GetRegistry().storage<entt::entity>();
+        return static_cast<uint64_t>(entities.free_list());
+    };
+
+    std::printf("%llu entities, %.1f MB cooked, %u threads, budget %.1f ms per frame\n",
+                static_cast<unsigned long long>(entity_count),
+                static_cast<double>(std::filesystem::file_size(path)) / (1024.0 * 1024.0), std::max(threads, 2u),
+                kFrameBudgetMs);
+    std::printf("%-22s %8s %10s %12s %12s %12s\n", "step", "frames", "wall ms", "p99 stall", "max stall",
+                "max Get");
+
+    // Блокирующая загрузка — до регистрации лоадеров: иначе меши базовой сцены уже были бы в кэше
+    const auto blocking_start = Clock::now();
+    bool ok = scenes.LoadScene(kBaseSceneId);
+    const std::chrono::duration<double, std::milli> blocking = Clock::now() - blocking_start;
+    std::printf("%-22s %8d %10.1f %12.1f %12.1f %12s\n", "LoadScene (blocking)", 1, blocking.count(),
+                blocking.count(), blocking.count(), "");
+
+    resources.RegisterLoader<resources::MeshData>(resources::MeshDataLoader(resources));
+    resources.RegisterLoader<graphics::Mesh>(HeadlessMeshLoader(resources));
+    ok &= static_cast<bool>(resources.Get<graphics::Mesh>(kProbeMeshId));
+
+    // Главный поток крутит кадры: Update с бюджетом, Get уже загруженного меша (как рендер или инспектор),
+    // остальное время кадра спит. Get не должен ждать, пока воркер читает меши сцены
+    double worst_stall = 0.0;
+    double worst_get = 0.0;
+    const auto run_frames = [&](const char* label) {
+        std::vector<double> stalls;
+        double max_get = 0.0;
+        const auto start = Clock::now();
+        while (scenes.IsBusy()) {
+            const double update_ms = scenes.Update(kFrameBudgetMs);
+            const auto get_start = Clock::now();
+            ok &= static_cast<bool>(resources.Get<graphics::Mesh>(kProbeMeshId));
+            const double get_ms = MsSince(get_start);
+            max_get = std::max(max_get, get_ms);
+            stalls.push_back(update_ms + get_ms);
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        const std::chrono::duration<double, std::milli> wall = Clock::now() - start;
+
+        std::sort(stalls.begin(), stalls.end());
+        const double p99 = stalls.empty() ? 0.0 : stalls[std::min(stalls.size() - 1, stalls.size() * 99 / 100)];
+        const double max = stalls.empty() ? 0.0 : stalls.back();
+        worst_stall = std::max(worst_stall, max);
+        worst_get = std::max(worst_get, max_get);
+        std::printf("%-22s %8zu %10.1f %12.3f %12.3f %12.3f\n", label, stalls.size(), wall.count(), p99, max,
+                    max_get);
+    };
+
+    const auto single = scenes.LoadSceneAsync(kBaseSceneId);
+    run_frames("async single");
+    ok &= single->GetState() == core::SceneLoadOperation::State::Done && alive() == entity_count;
+
+    // Меши сцены резолвятся в воркере и приходят с диска, а не пустыми хэндлами
+    for (const auto [entity, filter] : scenes.GetActiveScene().GetRegistry().view<MeshFilter>().each()) {
+        if (!filter.mesh || filter.mesh->num_indices != kMeshVertices * 3) {
+            ok = false;
+            break;
+        }
+    }
+
+    // Граф иерархии мира уже создан (как в редакторе) — аддитивная сцена вносится в него порциями слияния
+    const auto& graph = core::AcquireSceneGraph(scenes.GetActiveScene().GetRegistry());
+    const auto additive = scenes.LoadSceneAsync(kAdditiveSceneId, core::SceneLoadMode::Additive);
+    run_frames("async additive");
+    ok &= additive->GetState() == core::SceneLoadOperation::State::Done && alive() == entity_count * 2;
+
+    // Ссылки иерархии у добавленных сущностей переписаны на новые идентификаторы, граф с ними согласован
+    const auto& world = scenes.GetActiveScene().GetRegistry();
+    for (const auto [entity, relationship] : world.view<Relationship>().each()) {
+        if ((relationship.parent != entt::null && !world.valid(relationship.parent)) ||
+            graph.GetParent(entity) != relationship.parent ||
+            graph.GetChildren(entity).size() != relationship.children) {
+            ok = false;
+            break;
+        }
+    }
+
+    ok &= scenes.UnloadScene(kAdditiveSceneId);
+    run_frames("unload additive");
+    ok &= alive() == entity_count && !scenes.IsSceneLoaded(kAdditiveSceneId);
+
+    std::printf("%-22s", "decode per pool");
+    for (const auto& pool : single->GetStats().pools) {
+        std::printf(" %s %.1f ms", pool.name.c_str(), pool.ms);
+    }
+    std::printf("\nworst main-thread stall %.3f ms (limit %.1f ms), worst Get %.3f ms, blocking load %.1f ms\n",
+                worst_stall, kMaxStallMs, worst_get, blocking.count());
+
+    std::filesystem::remove(path);
+    std::filesystem::remove(additive_path);
+    for (const auto& [id, mesh_path] : meshes) {
+        std::filesystem::remove(mesh_path);
+    }
+
+    if (!ok) {
+        std::printf("scene contents differ from the expected\n");
+        return 1;
+    }
+    return worst_stall <= kMaxStallMs ? 0 : 1;
+}
+
+}  // namespace trybench
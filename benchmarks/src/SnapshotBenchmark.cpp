@@ -0,0 +1,185 @@
+#include "bench/SnapshotBenchmark.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <sstream>
+#include <vector>
+
+#include "bench/Measure.hpp"
+#include "engine/core/ComponentRegistry.hpp"
+#include "engine/core/Components.hpp"
+#include "engine/core/SnapshotCodec.hpp"
+
+namespace trybench {
+
+using namespace tryengine;
+
+namespace {
+
+// Повторов на замер; берется лучший — меньше шума от планировщика
+constexpr int kRepeats = 5;
+// Доля сущностей, сдвинувшихся за тик, для дельты
+constexpr float kMovedFraction = 0.1f;
+// Доля сущностей, уничтоженных и созданных заново за тик: индексы переиспользуются со следующей версией
+constexpr float kChurnFraction = 0.01f;
+
+void PrintRow(const char* label, size_t bytes, uint32_t entities, double encode_ms, double decode_ms) {
+    std::printf("%-22s %10zu %10.2f %14.1f %14.1f\n", label, bytes, static_cast<double>(bytes) / entities,
+                entities / encode_ms / 1000.0, entities / decode_ms / 1000.0);
+}
+
+}  // namespace
+
+int RunSnapshotBenchmark(uint32_t entity_count) {
+    core::ComponentRegistry components;
+    core::RegisterEngineComponents(components);
+    core::SnapshotCodec codec(components);
+
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> position(-500.0f, 500.0f);
+    std::uniform_real_distribution<float> angle(-3.14159f, 3.14159f);
+
+    entt::registry server;
+    for (uint32_t i = 0; i < entity_count; ++i) {
+        const auto entity = server.create();
+        const glm::vec3 axis = glm::normalize(glm::vec3(position(rng), position(rng), position(rng)) + 1e-3f);
+        server.emplace<Transform>(entity, Transform{glm::vec3(position(rng), position(rng) * 0.1f, position(rng)),
+                                                    glm::angleAxis(angle(rng), axis), glm::vec3(1.0f)});
+    }
+
+    std::printf("%u entities with Transform\n", entity_count);
+    std::printf("%-22s %10s %10s %14s %14s\n", "path", "bytes", "bytes/ent", "enc Ment/s", "dec Ment/s");
+
+    // cereal: полная сцена, как ее пишет SceneManager
+    std::string cereal_bytes;
+    const double cereal_encode = BestMs(kRepeats, [&] {
+        std::ostringstream os;
+        cereal::BinaryOutputArchive archive(os);
+        components.Serialize(server, archive);
+        cereal_bytes = os.str();
+    });
+    const double cereal_decode = BestMs(kRepeats, [&] {
+        std::istringstream is(cereal_bytes);
+        cereal::BinaryInputArchive archive(is);
+        entt::registry loaded;
+        components.Deserialize(loaded, archive);
+    });
+    PrintRow("cereal binary (full)", cereal_bytes.size(), entity_count, cereal_encode, cereal_decode);
+
+    // Снапшот без базы: снятие с реестра + кодирование, декодирование + применение к пустому реестру
+    core::Snapshot baseline;
+    core::BitWriter writer;
+    const double full_encode = BestMs(kRepeats, [&] {
+        codec.Capture(server, 1, baseline);
+        writer.Clear();
+        codec.Encode(baseline, nullptr, writer);
+    });
+    const auto full_packet = writer.Finish();
+    const std::vector<uint8_t> full_bytes(full_packet.begin(), full_packet.end());
+
+    core::Snapshot client_baseline;
+    entt::registry client;
+    bool ok = true;
+    const double full_decode = BestMs(kRepeats, [&] {
+        core::BitReader reader(full_bytes);
+        const auto header = core::SnapshotCodec::ReadHeader(reader);
+        ok &= codec.Decode(reader, header, nullptr, client_baseline);
+        client.clear();
+        codec.Apply(client, client_baseline, nullptr);
+    });
+    PrintRow("snapshot (full)", full_bytes.size(), entity_count, full_encode, full_decode);
+
+    // Погрешность квантования на клиенте
+    float max_position_error = 0.0f;
+    float max_angle_error = 0.0f;
+    for (const auto [entity, transform] : server.view<Transform>().each()) {
+        const auto& replicated = client.get<Transform>(entity);
+        max_position_error = std::max(max_position_error, glm::length(replicated.position - transform.position));
+        const float dot = std::min(1.0f, std::abs(glm::dot(replicated.rotation, transform.rotation)));
+        max_angle_error = std::max(max_angle_error, glm::degrees(2.0f * std::acos(dot)));
+    }
+
+    // Дельта: часть сущностей сдвинулась за тик
+    const auto moved = static_cast<uint32_t>(static_cast<float>(entity_count) * kMovedFraction);
+    auto view = server.view<Transform>();
+    uint32_t patched = 0;
+    for (const auto entity : view) {
+        if (patched++ == moved)
+            break;
+        server.patch<Transform>(entity, [](Transform& transform) { transform.position.x += 0.25f; });
+    }
+
+    core::Snapshot current;
+    const double delta_encode = BestMs(kRepeats, [&] {
+        codec.Capture(server, 2, current);
+        writer.Clear();
+        codec.Encode(current, &baseline, writer);
+    });
+    const auto delta_packet = writer.Finish();
+    const std::vector<uint8_t> delta_bytes(delta_packet.begin(), delta_packet.end());
+
+    core::Snapshot client_current;
+    const double delta_decode = BestMs(kRepeats, [&] {
+        core::BitReader reader(delta_bytes);
+        const auto header = core::SnapshotCodec::ReadHeader(reader);
+        ok &= codec.Decode(reader, header, &client_baseline, client_current);
+    });
+    codec.Apply(client, client_current, &client_baseline);
+
+    char label[64];
+    std::snprintf(label, sizeof(label), "snapshot (delta %d%%)", static_cast<int>(kMovedFraction * 100.0f));
+    PrintRow(label, delta_bytes.size(), entity_count, delta_encode, delta_decode);
+
+    // Смена сущностей: клиент должен получить новые версии индексов, а не потерять их
+    const auto churn_target = static_cast<uint32_t>(static_cast<float>(entity_count) * kChurnFraction);
+    const uint32_t churned = std::max<uint32_t>(1, churn_target);
+    std::vector<entt::entity> destroyed(view.begin(), view.end());
+    destroyed.resize(std::min<size_t>(destroyed.size(), churned));
+    server.destroy(destroyed.begin(), destroyed.end());
+    uint32_t recycled = 0;
+    for (uint32_t i = 0; i < churned; ++i) {
+        const auto entity = server.create();
+        recycled += entt::to_version(entity) != 0;
+        server.emplace<Transform>(entity, Transform{glm::vec3(position(rng), 0.0f, position(rng))});
+    }
+
+    core::Snapshot churn;
+    codec.Capture(server, 3, churn);
+    writer.Clear();
+    codec.Encode(churn, &current, writer);
+    const auto churn_packet = writer.Finish();
+    const std::vector<uint8_t> churn_bytes(churn_packet.begin(), churn_packet.end());
+
+    core::Snapshot client_churn;
+    core::BitReader churn_reader(churn_bytes);
+    const auto churn_header = core::SnapshotCodec::ReadHeader(churn_reader);
+    ok &= codec.Decode(churn_reader, churn_header, &client_current, client_churn);
+    codec.Apply(client, client_churn, &client_current);
+
+    bool churn_same = client.storage<Transform>().size() == server.storage<Transform>().size();
+    for (const auto entity : server.view<Transform>()) {
+        churn_same = churn_same && client.valid(entity) && client.all_of<Transform>(entity);
+    }
+    for (const auto entity : destroyed) {
+        churn_same = churn_same && !client.valid(entity);
+    }
+    std::printf("churn: %u entities replaced (%u recycled indices), %zu bytes, client %s\n", churned, recycled,
+                churn_bytes.size(), churn_same ? "matches" : "DIFFERS");
+
+    std::printf("max error: position %.5f m, rotation %.3f deg\n", max_position_error, max_angle_error);
+
+    if (!churn_same) {
+        std::printf("client registry differs from server after churn\n");
+        return 1;
+    }
+    if (!ok) {
+        std::printf("decode failed\n");
+        return 1;
+    }
+    return 0;
+}
+
+}  // namespace trybench
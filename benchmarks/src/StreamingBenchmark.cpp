@@ -0,0 +1,252 @@
+#include "bench/StreamingBenchmark.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "bench/Measure.hpp"
+#include "engine/core/ComponentRegistry.hpp"
+#include "engine/core/Components.hpp"
+#include "engine/core/JobSystem.hpp"
+#include "engine/core/ResourceManager.hpp"
+#include "engine/core/SceneManager.hpp"
+#include "engine/core/WorldPartition.hpp"
+
+namespace trybench {
+
+using namespace tryengine;
+
+namespace {
+
+constexpr float kCellSize = 64.0f;
+constexpr uint32_t kRootsPerCell = 16;
+constexpr uint32_t kChildrenPerRoot = 3;
+constexpr uint32_t kMeshEvery = 2;
+
+// Грузим в полутора ячейках от камеры, выгружаем дальше двух; бюджет — kBudgetCells самых больших ячеек
+constexpr float kLoadRadius = kCellSize * 1.5f;
+constexpr float kUnloadRadius = kCellSize * 2.0f;
+constexpr uint32_t kBudgetCells = 32;
+
+// Пролет по диагонали за kFlightSeconds при 60 Гц; рывок — кадр, где стриминг занял больше половины кадра
+constexpr double kFrameMs = 1000.0 / 60.0;
+constexpr double kFlightSeconds = 12.0;
+constexpr double kUpdateBudgetMs = 2.0;
+constexpr double kHitchMs = 8.0;
+constexpr uint32_t kMaxSettleFrames = 600;
+
+void BuildLevel(entt::registry& reg, uint32_t side) {
+    std::mt19937 rng(29);
+    std::uniform_real_distribution<float> inside(0.0f, kCellSize);
+    std::uniform_real_distribution<float> offset(-2.0f, 2.0f);
+
+    for (uint32_t x = 0; x < side; ++x) {
+        for (uint32_t z = 0; z < side; ++z) {
+            for (uint32_t r = 0; r < kRootsPerCell; ++r) {
+                const auto root = reg.create();
+                const glm::vec3 position(static_cast<float>(x) * kCellSize + inside(rng), 0.0f,
+                                         static_cast<float>(z) * kCellSize + inside(rng));
+                reg.emplace<Transform>(root, Transform{position, glm::quat(1.0f, 0.0f, 0.0f, 0.0f), glm::vec3(1.0f)});
+                reg.emplace<Tag>(root, "Prop_" + std::to_string(x) + "_" + std::to_string(z) + "_" + std::to_string(r));
+                auto& parent = reg.emplace<Relationship>(root);
+
+                for (uint32_t c = 0; c < kChildrenPerRoot; ++c) {
+                    const auto child = reg.create();
+                    reg.emplace<Transform>(child, Transform{glm::vec3(offset(rng), offset(rng), offset(rng)),
+                                                            glm::quat(1.0f, 0.0f, 0.0f, 0.0f), glm::vec3(1.0f)});
+                    auto& relationship = reg.emplace<Relationship>(child);
+                    relationship.parent = root;
+                    relationship.next = parent.first;
+                    if (parent.first != entt::null) {
+                        reg.get<Relationship>(parent.first).prev = child;
+                    }
+                    parent.first = child;
+                    ++parent.children;
+
+                    if (c % kMeshEvery == 0) {
+                        reg.emplace<MeshFilter>(child).asset_id = 1000 + (x + z) % 7;
+                        reg.emplace<MeshRenderer>(child).asset_id = 2000 + (x * z) % 5;
+                    }
+                }
+            }
+        }
+    }
+
+    // Без Transform — уходит в постоянную ячейку
+    const auto settings = reg.create();
+    reg.emplace<Tag>(settings, "LevelSettings");
+}
+
+}  // namespace
+
+int RunStreamingBenchmark(uint32_t side, uint32_t threads) {
+    using Clock = std::chrono::steady_clock;
+
+    core::ComponentRegistry components;
+    core::RegisterEngineComponents(components);
+
+    const auto directory = std::filesystem::temp_directory_path() / "tryengine_bench_stream";
+    std::filesystem::remove_all(directory);
+
+    uint64_t level_entities = 0;
+    {
+        entt::registry level;
+        BuildLevel(level, side);
+        level_entities = level.storage<entt::entity>().free_list();
+        if (!core::CookWorldPartition(level, components, kCellSize, directory)) {
+            std::printf("failed to cook %s\n", directory.string().c_str());
+            return 1;
+        }
+    }
+    // Пик запекания не должен закрыть пик стриминга
+    ResetPeakRss();
+    const uint64_t rss_before_kb = PeakRssKb();
+
+    // Загрузкам нужен хотя бы один воркер
+    core::JobSystem jobs(std::max(threads, 2u) - 1);
+    core::ResourceManager resources;
+    core::SceneManager scenes(components, resources);
+    scenes.SetJobSystem(&jobs);
+
+    core::WorldPartitionManifest manifest;
+    if (!core::ReadWorldPartition(directory / core::kWorldPartitionManifest, manifest))
+        return 1;
+    uint64_t max_cell_bytes = 0;
+    uint64_t total_bytes = 0;
+    for (const auto& cell : manifest.cells) {
+        max_cell_bytes = std::max(max_cell_bytes, cell.bytes);
+        total_bytes += cell.bytes;
+    }
+
+    core::WorldStreamerConfig config;
+    config.load_radius = kLoadRadius;
+    config.unload_radius = kUnloadRadius;
+    config.memory_budget = max_cell_bytes * kBudgetCells;
+    core::WorldStreamer streamer(scenes, resources, config);
+    if (!streamer.Open(directory / core::kWorldPartitionManifest))
+        return 1;
+
+    const float world_size = static_cast<float>(side) * kCellSize;
+    const glm::vec3 start(kCellSize * 0.5f, 2.0f, kCellSize * 0.5f);
+    const glm::vec3 finish(world_size - kCellSize * 0.5f, 2.0f, world_size - kCellSize * 0.5f);
+    const auto flight_frames = static_cast<uint32_t>(kFlightSeconds * 1000.0 / kFrameMs);
+
+    std::printf("%u x %u cells of %.0f m, %llu entities, %.1f MB cooked, budget %.1f MB (%u cells), %u threads\n",
+                side, side, kCellSize, static_cast<unsigned long long>(level_entities),
+                static_cast<double>(total_bytes) / (1024.0 * 1024.0),
+                static_cast<double>(config.memory_budget) / (1024.0 * 1024.0), kBudgetCells, std::max(threads, 2u));
+    std::printf("flight %.0f m in %.0f s (%.1f cells/s), load radius %.0f m, unload radius %.0f m\n",
+                glm::length(finish - start), kFlightSeconds,
+                glm::length(finish - start) / kCellSize / static_cast<float>(kFlightSeconds), kLoadRadius,
+                kUnloadRadius);
+
+    std::vector<double> frame_ms;
+    uint32_t hitches = 0;
+    uint32_t holes = 0;
+    auto next_frame = Clock::now();
+    const auto run_frame = [&](auto&& update) {
+        const auto frame_start = Clock::now();
+        update();
+        scenes.Update(kUpdateBudgetMs);
+        const std::chrono::duration<double, std::milli> elapsed = Clock::now() - frame_start;
+        frame_ms.push_back(elapsed.count());
+        if (elapsed.count() > kHitchMs) {
+            ++hitches;
+        }
+
+        next_frame += std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double, std::milli>(kFrameMs));
+        std::this_thread::sleep_until(next_frame);
+    };
+
+    // Прогрев: постоянная ячейка становится активной сценой, стартовые ячейки подгружаются
+    uint32_t warmup_frames = 0;
+    while ((!scenes.HasActiveScene() || !streamer.IsLoadedAt(start) || scenes.IsBusy()) &&
+           warmup_frames < kMaxSettleFrames) {
+        run_frame([&] { streamer.Update(start); });
+        ++warmup_frames;
+    }
+    if (!scenes.HasActiveScene()) {
+        std::printf("level did not load\n");
+        return 1;
+    }
+
+    // Камера создается в мире, а не в уровне: ее не выгрузит ни одна ячейка. Дальше стример следит за ней сам
+    auto& world = scenes.GetActiveScene().GetRegistry();
+    const auto camera = world.create();
+    world.emplace<Transform>(camera).position = start;
+    world.emplace<Camera>(camera);
+    world.emplace<MainCameraTag>(camera);
+
+    const size_t warmup_samples = frame_ms.size();
+    for (uint32_t frame = 0; frame <= flight_frames; ++frame) {
+        const float t = static_cast<float>(frame) / static_cast<float>(flight_frames);
+        const glm::vec3 position = start + (finish - start) * t;
+        world.get<Transform>(camera).position = position;
+        run_frame([&] { streamer.Update(); });
+        if (!streamer.IsLoadedAt(position)) {
+            ++holes;
+        }
+    }
+
+    uint32_t settle_frames = 0;
+    while ((scenes.IsBusy() || streamer.GetStats().loading > 0) && settle_frames < kMaxSettleFrames) {
+        run_frame([&] { streamer.Update(); });
+        ++settle_frames;
+    }
+
+    // В мире ровно постоянная ячейка, загруженные ячейки и камера, иерархия без висячих ссылок
+    bool ok = !scenes.IsBusy();
+    uint64_t expected = 1;
+    for (const auto& cell : manifest.cells) {
+        const glm::vec3 center((static_cast<float>(cell.x) + 0.5f) * kCellSize, 0.0f,
+                               (static_cast<float>(cell.z) + 0.5f) * kCellSize);
+        if (cell.persistent || streamer.IsLoadedAt(center)) {
+            expected += cell.entity_count;
+        }
+    }
+    ok &= world.storage<entt::entity>().free_list() == expected;
+    for (const auto [entity, relationship] : world.view<Relationship>().each()) {
+        if (relationship.parent != entt::null && !world.valid(relationship.parent)) {
+            ok = false;
+            break;
+        }
+    }
+
+    const auto& stats = streamer.GetStats();
+    std::vector<double> flight(frame_ms.begin() + static_cast<std::ptrdiff_t>(warmup_samples), frame_ms.end());
+    std::sort(flight.begin(), flight.end());
+    const double p99 = flight.empty() ? 0.0 : flight[std::min(flight.size() - 1, flight.size() * 99 / 100)];
+    const double max = flight.empty() ? 0.0 : flight.back();
+
+    std::printf("%-26s %10u\n", "warm-up frames", warmup_frames);
+    std::printf("%-26s %10zu\n", "flight + settle frames", flight.size());
+    std::printf("%-26s %10.3f ms\n", "frame p99 (stream+merge)", p99);
+    std::printf("%-26s %10.3f ms\n", "frame max", max);
+    std::printf("%-26s %10u (> %.1f ms)\n", "hitches", hitches, kHitchMs);
+    std::printf("%-26s %10u\n", "frames over unloaded cell", holes);
+    std::printf("%-26s %10llu / %llu\n", "cell loads / unloads", static_cast<unsigned long long>(stats.loads),
+                static_cast<unsigned long long>(stats.unloads));
+    std::printf("%-26s %10llu\n", "budget skips", static_cast<unsigned long long>(stats.budget_skips));
+    std::printf("%-26s %10llu\n", "resource purges", static_cast<unsigned long long>(stats.purges));
+    std::printf("%-26s %10.2f MB (budget %.2f MB)\n", "peak resident cells",
+                static_cast<double>(stats.peak_resident_bytes) / (1024.0 * 1024.0),
+                static_cast<double>(config.memory_budget) / (1024.0 * 1024.0));
+    std::printf("%-26s %10.1f MB (%.1f MB before streaming)\n", "peak RSS", static_cast<double>(PeakRssKb()) / 1024.0,
+                static_cast<double>(rss_before_kb) / 1024.0);
+
+    std::filesystem::remove_all(directory);
+
+    if (!ok) {
+        std::printf("streamed world differs from the expected\n");
+        return 1;
+    }
+    return hitches == 0 && holes == 0 && stats.peak_resident_bytes <= config.memory_budget ? 0 : 1;
+}
+
+}  // namespace trybench
@@ -0,0 +1,203 @@
+#include "bench/StringBenchmark.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <entt/entity/registry.hpp>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "bench/Measure.hpp"
+#include "engine/core/Addressables.hpp"
+#include "engine/core/Components.hpp"
+#include "engine/core/StringId.hpp"
+
+namespace trybench {
+
+using namespace tryengine;
+
+namespace {
+
+// Сцена из экземпляров нескольких десятков моделей: разных имен узлов немного
+constexpr uint32_t kDistinctNodeNames = 2000;
+constexpr uint32_t kAddressGroups = 8;
+constexpr uint32_t kAddressesPerGroup = 1000;
+constexpr double kMinMemoryGain = 2.0;
+
+// Tag до интернирования
+struct LegacyTag {
+    std::string tag;
+};
+
+struct TagResult {
+    // Во сколько раз Tag дешевле LegacyTag (пул и текст)
+    double gain = 0.0;
+    bool same = false;
+};
+
+// Имена узлов из glTF обычно длиннее SSO-буфера std::string
+std::string NodeName(uint32_t i) {
+    char name[32];
+    std::snprintf(name, sizeof(name), "SM_Prop_Node_%04u", i % kDistinctNodeNames);
+    return name;
+}
+
+std::string UniqueName(uint32_t i) {
+    return "Entity_" + std::to_string(i);
+}
+
+size_t TableBytes() {
+    const auto stats = core::StringTable::Get().GetStats();
+    return stats.arena_bytes + stats.index_bytes;
+}
+
+template <typename MakeName>
+TagResult CompareTags(const char* title, uint32_t entities, MakeName make_name) {
+    const double per_entity = 1.0 / static_cast<double>(entities);
+
+    // Интернированный мир меряем первым: память, освобожденная после него, может уйти прежнему, не наоборот
+    const uint64_t rss_start_kb = RssKb();
+    const size_t table_start = TableBytes();
+    entt::registry interned;
+    interned.storage<Tag>().reserve(entities);
+    for (uint32_t i = 0; i < entities; ++i) {
+        interned.emplace<Tag>(interned.create(), make_name(i));
+    }
+    const size_t table_bytes = TableBytes() - table_start;
+    const uint64_t rss_interned_kb = RssKb();
+
+    entt::registry legacy;
+    legacy.storage<LegacyTag>().reserve(entities);
+    for (uint32_t i = 0; i < entities; ++i) {
+        legacy.emplace<LegacyTag>(legacy.create(), make_name(i));
+    }
+    const uint64_t rss_legacy_kb = RssKb();
+
+    // Строка вне SSO-буфера — отдельный блок в куче
+    const size_t sso_capacity = std::string().capacity();
+    size_t heap_bytes = 0;
+    for (const auto [entity, tag] : legacy.view<LegacyTag>().each()) {
+        if (tag.tag.capacity() > sso_capacity) {
+            heap_bytes += tag.tag.capacity() + 1;
+        }
+    }
+
+    // Сущности созданы в том же порядке — id совпадают
+    bool same = true;
+    for (const auto [entity, tag] : legacy.view<LegacyTag>().each()) {
+        if (!interned.all_of<Tag>(entity) || interned.get<Tag>(entity).tag.View() != tag.tag) {
+            same = false;
+            break;
+        }
+    }
+
+    const std::string target = make_name(42);
+    auto start = std::chrono::steady_clock::now();
+    size_t legacy_matches = 0;
+    for (const auto [entity, tag] : legacy.view<LegacyTag>().each()) {
+        legacy_matches += tag.tag == target;
+    }
+    const double legacy_scan_ms = MsSince(start);
+
+    start = std::chrono::steady_clock::now();
+    const auto target_id = core::StringId::Hash(target);
+    size_t interned_matches = 0;
+    for (const auto [entity, tag] : interned.view<Tag>().each()) {
+        interned_matches += tag.tag == target_id;
+    }
+    const double interned_scan_ms = MsSince(start);
+    same = same && legacy_matches == interned_matches;
+
+    const double legacy_pool = static_cast<double>(PoolBytes<LegacyTag>(legacy)) * per_entity;
+    const double interned_pool = static_cast<double>(PoolBytes<Tag>(interned)) * per_entity;
+    const double legacy_text = static_cast<double>(heap_bytes) * per_entity;
+    const double interned_text = static_cast<double>(table_bytes) * per_entity;
+    const auto rss_growth = [&](uint64_t from_kb, uint64_t to_kb) {
+        return (static_cast<double>(to_kb) - static_cast<double>(from_kb)) * 1024.0 * per_entity;
+    };
+
+    std::printf("\n%s\n", title);
+    std::printf("%-16s %14s %14s\n", "bytes/entity", "std::string", "StringId");
+    std::printf("%-16s %14.1f %14.1f\n", "Tag pool", legacy_pool, interned_pool);
+    std::printf("%-16s %14.1f %14.1f\n", "text", legacy_text, interned_text);
+    std::printf("%-16s %14.1f %14.1f\n", "total", legacy_pool + legacy_text, interned_pool + interned_text);
+    std::printf("%-16s %14.1f %14.1f\n", "RSS growth", rss_growth(rss_interned_kb, rss_legacy_kb),
+                rss_growth(rss_start_kb, rss_interned_kb));
+    std::printf("%-16s %11.2f ms %11.2f ms\n", "tag == name", legacy_scan_ms, interned_scan_ms);
+
+    if (!same) {
+        std::printf("interned tags differ from std::string tags\n");
+    }
+    return {(legacy_pool + legacy_text) / (interned_pool + interned_text), same};
+}
+
+// Прежний Addressables::Get (std::string на каждый поиск, перебор групп) против индекса по id адреса
+bool CompareAddressables(uint32_t lookups) {
+    core::Addressables addressables;
+    std::vector<std::string> known;
+    for (uint32_t g = 0; g < kAddressGroups; ++g) {
+        core::AddressablesGroupAsset group;
+        group.name = "group_" + std::to_string(g);
+        for (uint32_t a = 0; a < kAddressesPerGroup; ++a) {
+            const uint32_t index = g * kAddressesPerGroup + a;
+            known.push_back("Assets/Props/prop_" + std::to_string(index) + ".prefab");
+            group.map.emplace(known.back(), index + 1);
+        }
+        addressables.AddGroup(group);
+    }
+    const auto& groups = addressables.GetGroups();
+
+    // Адреса вразброс по группам
+    std::vector<std::string_view> addresses(lookups);
+    for (uint32_t i = 0; i < lookups; ++i) {
+        addresses[i] = known[(static_cast<uint64_t>(i) * 7919) % known.size()];
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    uint64_t legacy_sum = 0;
+    for (const auto address : addresses) {
+        for (const auto& group : groups) {
+            const auto it = group.map.find(std::string(address));
+            if (it != group.map.end()) {
+                legacy_sum += it->second;
+                break;
+            }
+        }
+    }
+    const double legacy_ms = MsSince(start);
+
+    start = std::chrono::steady_clock::now();
+    uint64_t indexed_sum = 0;
+    for (const auto address : addresses) {
+        indexed_sum += addressables.Get(address);
+    }
+    const double indexed_ms = MsSince(start);
+
+    std::printf("\n%u Addressables lookups over %u groups of %u\n", lookups, kAddressGroups, kAddressesPerGroup);
+    std::printf("%-16s %11.2f ms %11.2f ms\n", "lookup", legacy_ms, indexed_ms);
+
+    if (legacy_sum != indexed_sum) {
+        std::printf("indexed Addressables returned different guids\n");
+        return false;
+    }
+    return true;
+}
+
+}  // namespace
+
+int RunStringBenchmark(uint32_t entities) {
+    std::printf("%u entities: node names from %u distinct vs unique names\n", entities, kDistinctNodeNames);
+
+    const auto repeated = CompareTags("model node names", entities, NodeName);
+    // Короткие уникальные имена помещаются в SSO: таблица тут дороже, выигрыш только в сравнении
+    const auto unique = CompareTags("unique names", entities, UniqueName);
+    const bool lookups_same = CompareAddressables(entities);
+
+    std::printf("\nTag with node names is %.1fx smaller, with unique names %.1fx\n", repeated.gain, unique.gain);
+    if (!repeated.same || !unique.same || !lookups_same)
+        return 1;
+    return repeated.gain >= kMinMemoryGain ? 0 : 1;
+}
+
+}  // namespace trybench
@@ -0,0 +1,128 @@
+#include "bench/TransformBenchmark.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <entt/entity/registry.hpp>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "bench/Measure.hpp"
+#include "engine/core/BaseSystem.hpp"
+#include "engine/core/Components.hpp"
+#include "engine/core/JobSystem.hpp"
+#include "engine/core/SceneGraph.hpp"
+#include "engine/core/TransformHierarchy.hpp"
+
+namespace trybench {
+
+using namespace tryengine;
+
+namespace {
+
+// Модель — полное дерево: 4 ребенка у узла, 6 уровней (1365 узлов)
+constexpr uint32_t kBranching = 4;
+constexpr uint32_t kModelNodes = 1 + 4 + 16 + 64 + 256 + 1024;
+constexpr std::array<uint32_t, 3> kThreadCounts = {1, 4, 16};
+constexpr int kRuns = 30;
+
+// Корни моделей
+std::vector<entt::entity> BuildScene(entt::registry& reg, uint32_t entity_count) {
+    auto& graph = core::AcquireSceneGraph(reg);
+    core::AcquireTransformHierarchy(reg);
+
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<float> offset(-2.0f, 2.0f);
+    std::uniform_real_distribution<float> angle(-3.14159f, 3.14159f);
+
+    std::vector<entt::entity> roots;
+    std::vector<entt::entity> model(kModelNodes);
+    for (uint32_t created = 0; created < entity_count;) {
+        const uint32_t nodes = std::min(kModelNodes, entity_count - created);
+        for (uint32_t i = 0; i < nodes; ++i) {
+            model[i] = reg.create();
+            const glm::vec3 axis = glm::normalize(glm::vec3(offset(rng), offset(rng), offset(rng)) + 1e-3f);
+            reg.emplace<Transform>(model[i], Transform{glm::vec3(offset(rng), offset(rng), offset(rng)),
+                                                       glm::angleAxis(angle(rng), axis), glm::vec3(1.0f)});
+            reg.emplace<Relationship>(model[i]);
+            if (i > 0) {
+                graph.SetParent(reg, model[i], model[(i - 1) / kBranching]);
+            }
+        }
+        roots.push_back(model[0]);
+        created += nodes;
+    }
+    return roots;
+}
+
+}  // namespace
+
+int RunTransformBenchmark(uint32_t entity_count) {
+    entt::registry reg;
+    const auto roots = BuildScene(reg, entity_count);
+    // Первый проход строит плоскую иерархию — вне замера
+    core::UpdateTransformSystem(reg);
+
+    const auto& hierarchy = core::AcquireTransformHierarchy(reg);
+    std::printf("%u entities in %zu models, %zu levels, %u hardware threads\n", entity_count, roots.size(),
+                hierarchy.GetLevelCount(), std::thread::hardware_concurrency());
+    std::printf("%-8s %12s %12s %14s %10s\n", "threads", "median ms", "best ms", "Mentities/s", "speedup");
+
+    std::vector<glm::mat4> reference;
+    double single_ms = 0.0;
+    bool same = true;
+    for (const uint32_t threads : kThreadCounts) {
+        std::unique_ptr<core::JobSystem> jobs;
+        if (threads > 1) {
+            jobs = std::make_unique<core::JobSystem>(threads - 1);
+        }
+
+        std::vector<double> times;
+        for (int run = 0; run < kRuns; ++run) {
+            // Одинаковые значения для всех вариантов: результаты сверяются побитово
+            for (const auto root : roots) {
+                reg.patch<Transform>(root, [&](Transform& transform) { transform.position.y = 0.01f * run; });
+            }
+
+            const auto start = std::chrono::steady_clock::now();
+            if (jobs) {
+                core::UpdateTransformSystem(reg, *jobs);
+            } else {
+                core::UpdateTransformSystem(reg);
+            }
+            times.push_back(MsSince(start));
+        }
+        same = same && core::GetUpdatedTransformCount(reg) == entity_count;
+
+        std::vector<glm::mat4> matrices;
+        matrices.reserve(entity_count);
+        for (const auto [entity, world] : reg.view<WorldMatrix>().each()) {
+            matrices.push_back(world.value);
+        }
+        if (reference.empty()) {
+            reference = std::move(matrices);
+        } else {
+            same = same && std::memcmp(reference.data(), matrices.data(), reference.size() * sizeof(glm::mat4)) == 0;
+        }
+
+        std::sort(times.begin(), times.end());
+        const double median = times[times.size() / 2];
+        if (threads == 1) {
+            single_ms = median;
+        }
+        std::printf("%-8u %12.3f %12.3f %14.1f %9.2fx\n", threads, median, times.front(),
+                    entity_count / median / 1000.0, single_ms / median);
+    }
+
+    if (!same) {
+        std::printf("world matrices differ between thread counts\n");
+        return 1;
+    }
+    return 0;
+}
+
+}  // namespace trybench
@@ -0,0 +1,113 @@
+#include "bench/TransformKernelBenchmark.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <random>
+#include <vector>
+
+#include "bench/Measure.hpp"
+#include "engine/core/Components.hpp"
+#include "engine/core/TransformMath.hpp"
+
+namespace trybench {
+
+using namespace tryengine;
+
+namespace {
+
+constexpr int kRepeats = 5;
+// Допустимое расхождение с glm относительно величины элемента: порядок умножений у путей разный
+constexpr float kTolerance = 1e-4f;
+
+float MaxError(const std::vector<glm::mat4>& result, const std::vector<glm::mat4>& reference) {
+    float error = 0.0f;
+    for (size_t i = 0; i < result.size(); ++i) {
+        for (int c = 0; c < 4; ++c) {
+            for (int r = 0; r < 4; ++r) {
+                const float expected = reference[i][c][r];
+                error = std::max(error, std::abs(result[i][c][r] - expected) / std::max(1.0f, std::abs(expected)));
+            }
+        }
+    }
+    return error;
+}
+
+}  // namespace
+
+int RunTransformKernelBenchmark(uint32_t count) {
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+    std::uniform_real_distribution<float> angle(-3.14159f, 3.14159f);
+    std::uniform_real_distribution<float> scale(0.5f, 2.0f);
+
+    const auto random_transform = [&] {
+        const glm::vec3 axis = glm::normalize(glm::vec3(position(rng), position(rng), position(rng)) + 1e-3f);
+        return Transform{glm::vec3(position(rng), position(rng), position(rng)), glm::angleAxis(angle(rng), axis),
+                         glm::vec3(scale(rng), scale(rng), scale(rng))};
+    };
+
+    std::vector<Transform> transforms(count);
+    std::vector<glm::mat4> parents(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        transforms[i] = random_transform();
+        parents[i] = random_transform().GetLocalMatrix();
+    }
+
+    std::vector<glm::mat4> reference(count);
+    const double glm_ms = BestMs(kRepeats, [&] {
+        for (uint32_t i = 0; i < count; ++i) {
+            const Transform& transform = transforms[i];
+            const glm::mat4 local = glm::translate(glm::mat4(1.0f), transform.position) *
+                                    glm::mat4_cast(transform.rotation) * glm::scale(glm::mat4(1.0f), transform.scale);
+            reference[i] = parents[i] * local;
+        }
+    });
+
+    std::vector<glm::mat4> local_path(count);
+    const double local_ms = BestMs(kRepeats, [&] {
+        for (uint32_t i = 0; i < count; ++i) {
+            local_path[i] = parents[i] * transforms[i].GetLocalMatrix();
+        }
+    });
+
+    // Как в UpdateTransformSystem: указатели копятся пачкой и отдаются ядру
+    std::vector<glm::mat4> kernel_path(count);
+    const double kernel_ms = BestMs(kRepeats, [&] {
+        const Transform* batch_transforms[core::kTransformBatchSize];
+        const glm::mat4* batch_parents[core::kTransformBatchSize];
+        glm::mat4* batch_out[core::kTransformBatchSize];
+        for (uint32_t begin = 0; begin < count; begin += core::kTransformBatchSize) {
+            const size_t size = std::min<size_t>(core::kTransformBatchSize, count - begin);
+            for (size_t k = 0; k < size; ++k) {
+                batch_transforms[k] = &transforms[begin + k];
+                batch_parents[k] = &parents[begin + k];
+                batch_out[k] = &kernel_path[begin + k];
+            }
+            core::ComposeWorldMatrices(size, batch_transforms, batch_parents, batch_out);
+        }
+    });
+
+    const float local_error = MaxError(local_path, reference);
+    const float kernel_error = MaxError(kernel_path, reference);
+
+    const auto ns_per_matrix = [&](double ms) { return ms * 1e6 / count; };
+    std::printf("%u transforms with parents, kernel: %s\n", count, core::GetTransformKernelName());
+    std::printf("%-32s %10s %10s %10s %12s\n", "path", "ms", "ns/matrix", "speedup", "max error");
+    std::printf("%-32s %10.3f %10.2f %9.2fx %12s\n", "glm translate*mat4_cast*scale", glm_ms, ns_per_matrix(glm_ms),
+                1.0, "-");
+    std::printf("%-32s %10.3f %10.2f %9.2fx %12.2e\n", "Transform::GetLocalMatrix", local_ms,
+                ns_per_matrix(local_ms), glm_ms / local_ms, local_error);
+    std::printf("%-32s %10.3f %10.2f %9.2fx %12.2e\n", "ComposeWorldMatrices", kernel_ms, ns_per_matrix(kernel_ms),
+                glm_ms / kernel_ms, kernel_error);
+
+    if (local_error > kTolerance || kernel_error > kTolerance) {
+        std::printf("matrices differ from glm by more than %.0e\n", kTolerance);
+        return 1;
+    }
+    return 0;
+}
+
+}  // namespace trybench
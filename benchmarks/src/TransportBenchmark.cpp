@@ -0,0 +1,194 @@
+#include "bench/TransportBenchmark.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include "engine/network/Transport.hpp"
+
+namespace trybench {
+
+using namespace tryengine;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr double kPacketRateSeconds = 1.0;
+// Мелкие датаграммы: MTU подобран так, чтобы в пакет влезало ровно одно такое сообщение
+constexpr size_t kSmallMessage = 64;
+constexpr uint32_t kBurst = 256;
+// Дольше — считаем, что надежный канал встал
+constexpr double kStreamTimeoutSeconds = 60.0;
+
+struct Pair {
+    explicit Pair(const network::TransportConfig& config) : client(config), server(config) {}
+
+    bool Open() {
+        if (!client.Open() || !server.Open())
+            return false;
+        to_server = client.Connect(server.GetLocalAddress());
+        return true;
+    }
+
+    void Update() {
+        client.Update();
+        server.Update();
+    }
+
+    network::Transport client;
+    network::Transport server;
+    network::ConnectionId to_server = 0;
+};
+
+double Seconds(Clock::time_point since) { return std::chrono::duration<double>(Clock::now() - since).count(); }
+
+// Остаток в полете дочитывается несколько миллисекунд
+template <typename Fn>
+void Drain(Pair& pair, Fn&& on_received) {
+    for (int i = 0; i < 20; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        pair.Update();
+        on_received();
+    }
+}
+
+bool MeasurePacketRate(uint32_t batch_size) {
+    network::TransportConfig config;
+    config.batch_size = batch_size;
+    config.mtu = network::Connection::kPacketHeaderSize + network::Connection::kMessageHeaderSize + kSmallMessage;
+
+    Pair pair(config);
+    if (!pair.Open())
+        return false;
+
+    const std::vector<std::byte> message(kSmallMessage, std::byte{0x5A});
+    uint64_t received = 0;
+    const auto count = [&] { received += pair.server.GetReceived().size(); };
+
+    uint64_t sent = 0;
+    const auto start = Clock::now();
+    while (Seconds(start) < kPacketRateSeconds) {
+        for (uint32_t i = 0; i < kBurst; ++i) {
+            pair.client.Send(pair.to_server, network::Channel::Unreliable, message);
+        }
+        sent += kBurst;
+        pair.Update();
+        count();
+    }
+    const double elapsed = Seconds(start);
+    Drain(pair, count);
+
+    const auto& stats = pair.client.GetStats();
+    std::printf("%-26s %12.0f %12.0f %10.2f %9.2f%%\n", batch_size == 1 ? "unreliable, 1/syscall" : "unreliable, batched",
+                static_cast<double>(stats.packets_sent) / elapsed, static_cast<double>(received) / elapsed,
+                static_cast<double>(stats.syscalls) / static_cast<double>(std::max<uint64_t>(stats.packets_sent, 1)),
+                100.0 * static_cast<double>(sent - std::min(sent, received)) / static_cast<double>(sent));
+    return true;
+}
+
+// Сообщение index: номер в первых 8 байтах, дальше узор от номера — получатель проверяет и порядок, и содержимое
+void FillMessage(std::vector<std::byte>& message, uint64_t index) {
+    std::memcpy(message.data(), &index, sizeof(index));
+    for (size_t i = sizeof(index); i < message.size(); ++i) {
+        message[i] = static_cast<std::byte>(index * 31 + i);
+    }
+}
+
+bool CheckMessage(std::span<const std::byte> message, uint64_t index) {
+    uint64_t stored = 0;
+    if (message.size() < sizeof(stored))
+        return false;
+    std::memcpy(&stored, message.data(), sizeof(stored));
+    return stored == index && message.back() == static_cast<std::byte>(index * 31 + message.size() - 1);
+}
+
+bool MeasureReliableStream(const char* label, const network::LinkConditions& link, uint64_t total_bytes) {
+    network::TransportConfig config;
+    config.link = link;
+
+    Pair pair(config);
+    if (!pair.Open())
+        return false;
+
+    std::vector<std::byte> message(pair.client.GetMaxMessageSize());
+    const uint64_t total_messages = (total_bytes + message.size() - 1) / message.size();
+
+    uint64_t next_send = 0;
+    uint64_t next_receive = 0;
+    uint64_t sequenced_sent = 0;
+    uint64_t sequenced_received = 0;
+    uint64_t sequenced_last = 0;
+    bool ordered = true;
+
+    const auto receive = [&] {
+        for (const auto& received : pair.server.GetReceived()) {
+            const auto payload = pair.server.GetPayload(received);
+            if (received.channel == network::Channel::ReliableOrdered) {
+                ordered = ordered && CheckMessage(payload, next_receive);
+                ++next_receive;
+            } else if (received.channel == network::Channel::UnreliableSequenced) {
+                uint64_t value = 0;
+                std::memcpy(&value, payload.data(), sizeof(value));
+                ordered = ordered && (sequenced_received == 0 || value > sequenced_last);
+                sequenced_last = value;
+                ++sequenced_received;
+            }
+        }
+    };
+
+    const auto start = Clock::now();
+    while (next_receive < total_messages && Seconds(start) < kStreamTimeoutSeconds) {
+        while (next_send < total_messages) {
+            FillMessage(message, next_send);
+            if (!pair.client.Send(pair.to_server, network::Channel::ReliableOrdered, message))
+                break;
+            ++next_send;
+        }
+
+        // Параллельно — поток состояния по каналу с отбрасыванием устаревшего
+        const uint64_t value = ++sequenced_sent;
+        pair.client.Send(pair.to_server, network::Channel::UnreliableSequenced,
+                         std::as_bytes(std::span(&value, 1)));
+
+        pair.Update();
+        receive();
+
+        if (!link.IsPerfect()) {
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+    }
+    const double elapsed = Seconds(start);
+
+    const auto& connection = pair.client.GetConnection(pair.to_server);
+    const bool complete = next_receive == total_messages;
+    std::printf("%-26s %10.1f MB/s %8.1f ms rtt %8llu resent %6.1f%% seq delivered  %s\n", label,
+                static_cast<double>(next_receive * message.size()) / elapsed / (1024.0 * 1024.0),
+                connection.GetRtt() * 1000.0, static_cast<unsigned long long>(connection.GetResentCount()),
+                100.0 * static_cast<double>(sequenced_received) / static_cast<double>(std::max<uint64_t>(sequenced_sent, 1)),
+                !complete ? "STALLED" : ordered ? "ok" : "ORDER BROKEN");
+    return complete && ordered;
+}
+
+}  // namespace
+
+int RunTransportBenchmark(uint32_t megabytes) {
+    std::printf("%-26s %12s %12s %10s %10s\n", "packet rate", "sent pkt/s", "recv pkt/s", "sys/pkt", "lost");
+    if (!MeasurePacketRate(1) || !MeasurePacketRate(network::UdpSocket::kMaxBatchSize)) {
+        std::printf("failed to open loopback sockets\n");
+        return 1;
+    }
+
+    const uint64_t total = static_cast<uint64_t>(megabytes) * 1024 * 1024;
+    std::printf("\nreliable-ordered stream, %u MB\n", megabytes);
+
+    bool ok = MeasureReliableStream("loopback", {}, total);
+    ok = MeasureReliableStream("20 ms, 5 ms jitter, 5% loss", {20.0, 5.0, 0.05}, total) && ok;
+    return ok ? 0 : 1;
+}
+
+}  // namespace trybench
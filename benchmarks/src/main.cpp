@@ -0,0 +1,108 @@
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string_view>
+
+#include "bench/ArtifactIndexBenchmark.hpp"
+#include "bench/FrameArenaBenchmark.hpp"
+#include "bench/InterestBenchmark.hpp"
+#include "bench/JobBenchmark.hpp"
+#include "bench/LagCompensationBenchmark.hpp"
+#include "bench/PrefabBenchmark.hpp"
+#include "bench/RenderIterationBenchmark.hpp"
+#include "bench/RollbackBenchmark.hpp"
+#include "bench/SceneLoadBenchmark.hpp"
+#include "bench/SnapshotBenchmark.hpp"
+#include "bench/StreamingBenchmark.hpp"
+#include "bench/StringBenchmark.hpp"
+#include "bench/TransformBenchmark.hpp"
+#include "bench/TransformKernelBenchmark.hpp"
+#include "bench/TransportBenchmark.hpp"
+
+namespace {
+
+using namespace trybench;
+
+struct Benchmark {
+    std::string_view name;
+    uint32_t default_count;
+    const char* description;
+    int (*run)(uint32_t count, uint32_t threads);
+};
+
+// Каждый замер печатает таблицу и возвращает код выхода: 1 — результат не сошелся или не уложился в порог
+constexpr Benchmark kBenchmarks[] = {
+    {"jobs", 200000, "n jobs on JobSystem and a naive std::thread pool",
+     [](uint32_t n, uint32_t threads) { return RunJobBenchmark(n, threads); }},
+    {"transforms", 200000, "n hierarchy transforms updated on 1, 4 and 16 threads",
+     [](uint32_t n, uint32_t) { return RunTransformBenchmark(n); }},
+    {"transform-kernel", 1000000, "n world matrices composed with glm and the batched kernel",
+     [](uint32_t n, uint32_t) { return RunTransformKernelBenchmark(n); }},
+    {"renderables", 100000, "n renderables iterated via legacy Transform and the owning group",
+     [](uint32_t n, uint32_t) { return RunRenderIterationBenchmark(n); }},
+    {"frame-arena", 600, "n frames of draw submission through FrameArena without a GPU, heap allocations",
+     [](uint32_t n, uint32_t) { return RunFrameArenaBenchmark(n); }},
+    {"snapshot", 100000, "snapshot codec against cereal binary on n entities, with id churn",
+     [](uint32_t n, uint32_t) { return RunSnapshotBenchmark(n); }},
+    {"interest", 1000, "n clients on lossy loopback against interest management",
+     [](uint32_t n, uint32_t threads) { return RunInterestBenchmark(n, threads); }},
+    {"lag", 5000, "n rewound hit queries per tick against lag compensation",
+     [](uint32_t n, uint32_t) { return RunLagCompensationBenchmark(n); }},
+    {"transport", 64, "UDP packet rate and n MB over the reliable channel on 127.0.0.1",
+     [](uint32_t n, uint32_t) { return RunTransportBenchmark(n); }},
+    {"scene", 500000, "n-entity scene through cereal and the cooked format",
+     [](uint32_t n, uint32_t threads) { return RunSceneLoadBenchmark(n, threads); }},
+    {"scene-async", 200, "async and additive load of an n MB scene, main-thread stalls",
+     [](uint32_t n, uint32_t threads) { return RunSceneAsyncBenchmark(n, threads); }},
+    {"stream", 16, "camera flight over n x n streamed world cells, hitches and peak memory",
+     [](uint32_t n, uint32_t threads) { return RunStreamingBenchmark(n, threads); }},
+    {"prefab", 100000, "memory of n prefab instances against plain copies",
+     [](uint32_t n, uint32_t) { return RunPrefabBenchmark(n); }},
+    {"strings", 1000000, "memory of n interned tags against std::string",
+     [](uint32_t n, uint32_t) { return RunStringBenchmark(n); }},
+    {"artifacts", 100000, "AssetDatabase startup on n artifacts by walking and from the index",
+     [](uint32_t n, uint32_t) { return RunArtifactIndexBenchmark(n); }},
+    {"rollback", 5000, "8-tick rollback and resimulation of n predicted entities, 2 ms budget",
+     [](uint32_t n, uint32_t) { return RunRollbackBenchmark(n, 8, 2.0); }},
+};
+
+void PrintUsage(const char* program) {
+    std::cout << "Usage: " << program << " <benchmark> [n] [--threads <n>]\n"
+              << "  --threads <n>  threads including main, for benchmarks that use JobSystem (default 1)\n\n";
+    for (const Benchmark& benchmark : kBenchmarks) {
+        std::cout << "  " << benchmark.name << std::string_view("                  ").substr(benchmark.name.size())
+                  << benchmark.description << " (n = " << benchmark.default_count << ")\n";
+    }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    const Benchmark* selected = nullptr;
+    uint32_t count = 0;
+    uint32_t threads = 1;
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        if (arg == "--threads" && i + 1 < argc) {
+            threads = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (!selected) {
+            for (const Benchmark& benchmark : kBenchmarks) {
+                if (benchmark.name == arg)
+                    selected = &benchmark;
+            }
+            if (!selected) {
+                std::cerr << "Unknown benchmark " << arg << std::endl;
+                PrintUsage(argv[0]);
+                return 2;
+            }
+        } else {
+            count = static_cast<uint32_t>(std::strtoul(argv[i], nullptr, 10));
+        }
+    }
+
+    if (!selected || threads == 0) {
+        PrintUsage(argv[0]);
+        return 2;
+    }
+    return selected->run(count == 0 ? selected->default_count : count, threads);
+}
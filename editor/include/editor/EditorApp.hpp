@@ -1,12 +1,21 @@
 #pragma once
 
+#include <filesystem>
 #include <memory>
 
 #include "editor/Editor.hpp"
 #include "engine/core/Engine.hpp"
 #include "engine/core/InputState.hpp"
+#include "engine/core/SystemScheduler.hpp"
 #include "engine/graphics/RenderSystem.hpp"
 
+namespace tryengine::core {
+class Clock;
+class FrameArena;
+class JobSystem;
+class SceneManager;
+}  // namespace tryengine::core
+
 namespace tryeditor {
 class EditorApp {
 public:
@@ -16,13 +25,26 @@ public:
     void Init();
     void Run();
     void Shutdown();
+    // Граф систем кадра в Graphviz DOT; вызывать между Init и Shutdown
+    bool DumpSchedulerGraph(const std::filesystem::path& path);
 
 private:
     void UpdateInput();
+    // Системы кадра с объявленным доступом к данным; порядок и параллельность считает SystemScheduler
+    void RegisterFrameSystems();
+
     std::unique_ptr<tryengine::graphics::GraphicsContext> graphics_context_;
-    std::unique_ptr<tryengine::graphics::RenderSystem> render_system_;
     std::unique_ptr<tryengine::core::Engine> engine_;
+    // После engine_: очередь рендера живет в FrameArena движка
+    std::unique_ptr<tryengine::graphics::RenderSystem> render_system_;
     std::unique_ptr<Editor> editor_;
+    std::unique_ptr<tryengine::core::SystemScheduler> scheduler_;
     tryengine::core::InputState input_state_;
+
+    // Резолвятся один раз в Init
+    tryengine::core::Clock* clock_ = nullptr;
+    tryengine::core::SceneManager* scene_manager_ = nullptr;
+    tryengine::core::JobSystem* job_system_ = nullptr;
+    tryengine::core::FrameArena* frame_arena_ = nullptr;
 };
 }  // namespace tryeditor
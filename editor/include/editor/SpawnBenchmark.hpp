@@ -0,0 +1,13 @@
+#pragma once
+
+#include <cstdint>
+
+namespace tryeditor {
+
+// Спавн модели instances раз без GPU: синтетическая модель кладется в кэш импорта, затем спавнится прежним
+// путем (разбор hierarchy.json и компоненты по одному на каждый спавн), через Spawn с кэшем шаблона
+// и одним SpawnBatch. Сверяет пулы и граф сцены; возвращает 1, если SpawnBatch быстрее прежнего пути
+// меньше чем в 10 раз или сцены разошлись. Запускать из корня репозитория
+int RunSpawnBenchmark(uint32_t instances);
+
+}  // namespace tryeditor
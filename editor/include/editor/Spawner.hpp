@@ -1,6 +1,14 @@
 #pragma once
 
-#include "engine/graphics/GraphicsContext.hpp"
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "engine/core/Components.hpp"
 #include "entt/entity/fwd.hpp"
 
 namespace tryengine::core {
@@ -8,18 +16,58 @@ class ResourceManager;
 }
 namespace tryeditor {
 class ImportSystem;
+struct ModelAssetMap;
+
+// Модель, разобранная для спавна: значения компонентов узлов подряд и связи иерархии по индексам узлов.
+// Ресурсы резолвятся один раз при сборке шаблона
+struct ModelTemplate {
+    struct Links {
+        size_t children = 0;
+        int32_t first = -1;
+        int32_t prev = -1;
+        int32_t next = -1;
+        int32_t parent = -1;
+    };
+
+    std::vector<tryengine::Tag> tags;
+    std::vector<tryengine::Transform> transforms;
+    std::vector<Links> links;
+
+    // Узлы с мешем и их компоненты
+    std::vector<uint32_t> mesh_nodes;
+    std::vector<tryengine::MeshFilter> filters;
+    std::vector<tryengine::MeshRenderer> renderers;
+
+    // Время записи файла кэша, из которого собран шаблон: переимпорт модели его меняет
+    std::filesystem::file_time_type stamp;
+};
+
 class Spawner {
 public:
-    Spawner(tryengine::graphics::GraphicsContext& graphics_context, tryengine::core::ResourceManager& resource_manager,
-            ImportSystem& import_system)
-        : resource_manager_(resource_manager), graphics_context_(graphics_context), import_system_(import_system) {};
+    Spawner(tryengine::core::ResourceManager& resource_manager, ImportSystem& import_system)
+        : resource_manager_(resource_manager), import_system_(import_system) {};
 
     void Spawn(entt::registry& reg, uint64_t asset_id) const;
 
+    // transforms.size() экземпляров модели: сущности создаются пачкой, каждый пул заполняется одним insert.
+    // Трансформ экземпляра применяется к корневым узлам. Возвращает сущности по экземплярам подряд
+    // (узлы экземпляра i — [i * узлов, (i + 1) * узлов)); пусто, если кэша модели нет
+    std::vector<entt::entity> SpawnBatch(entt::registry& reg, uint64_t asset_id,
+                                         std::span<const tryengine::Transform> transforms) const;
+
+    // Шаблоны держат ресурсы моделей — сбросить, чтобы ResourceManager::UpdatePurge мог их отпустить
+    void ClearCache() const { templates_.clear(); }
+
 private:
+    // Шаблон из памяти; при устаревшем кэше — из hierarchy.bin, при его отсутствии — из hierarchy.json
+    // (тогда же запекается hierarchy.bin). nullptr — модель не импортирована
+    std::shared_ptr<const ModelTemplate> GetTemplate(uint64_t asset_id) const;
+    std::shared_ptr<ModelTemplate> BuildTemplate(const ModelAssetMap& asset_map) const;
+
     tryengine::core::ResourceManager& resource_manager_;
-    tryengine::graphics::GraphicsContext& graphics_context_;
     ImportSystem& import_system_;
+    // Кэш не меняет наблюдаемого поведения Spawn, поэтому mutable
+    mutable std::unordered_map<uint64_t, std::shared_ptr<const ModelTemplate>> templates_;
 };
 
 }  // namespace tryeditor
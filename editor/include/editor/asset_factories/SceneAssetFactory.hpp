@@ -9,6 +9,7 @@
 #include "engine/core/Components.hpp"
 #include "engine/core/RandomUtil.hpp"
 #include "engine/core/Scene.hpp"
+#include "engine/core/SceneFormat.hpp"
 #include "editor/Components.hpp"
 
 namespace tryeditor {
@@ -64,14 +65,11 @@ public:
         return true;
     }
 
+    // Артефакт — запеченная сцена (SceneFormat): рантайм читает ее из отображенного файла без разбора
     bool SaveArtifact(const std::filesystem::path& path, const tryengine::core::Scene& scene) override {
-        std::ofstream os(path, std::ios::binary);
-        if (os.is_open()) {
-            cereal::BinaryOutputArchive archive(os);
-            component_registry_.Serialize(scene.GetRegistry(), archive);
+        if (tryengine::core::WriteCookedScene(path, scene.GetRegistry(), component_registry_))
             return true;
-        } else
-            std::cerr << "[SceneManager]: Serialization error: BinaryOutputArchive" << std::endl;
+        std::cerr << "[SceneManager]: Serialization error: cooked scene" << std::endl;
         return false;
     }
 
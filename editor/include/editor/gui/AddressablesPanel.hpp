@@ -47,10 +47,10 @@ public:
                 ImGui::TableSetupColumn("GUID", ImGuiTableColumnFlags_WidthFixed, 150.0f);
                 ImGui::TableHeadersRow();
 
-                auto& groups = addressables_provider_.GetAddressables().GetGroups();
+                const auto& groups = addressables_provider_.GetAddressables().GetGroups();
 
                 for (size_t g_idx = 0; g_idx < groups.size(); ++g_idx) {
-                    auto& group = groups[g_idx];
+                    const auto& group = groups[g_idx];
                     ImGui::PushID(group.name.c_str());
 
                     ImGui::TableNextRow();
@@ -77,7 +77,7 @@ public:
                         std::string new_key_name = "";
                         std::string key_to_delete = "";
 
-                        for (auto& [address, guid] : group.map) {
+                        for (const auto& [address, guid] : group.map) {
                             ImGui::PushID(address.c_str());
                             ImGui::TableNextRow();
                             ImGui::TableNextColumn();
@@ -112,17 +112,13 @@ public:
 
                         // Обработка удаления ассета
                         if (!key_to_delete.empty()) {
-                            group.map.erase(key_to_delete);
-                            addressables_provider_.SaveGroup(group);
+                            addressables_provider_.RemoveAssetFromGroup(group.name, key_to_delete);
                             dirty = true;
                         }
 
                         // Обработка переименования
                         if (!key_to_rename.empty()) {
-                            uint64_t val = group.map[key_to_rename];
-                            group.map.erase(key_to_rename);
-                            group.map[new_key_name] = val;
-                            addressables_provider_.SaveGroup(group);
+                            addressables_provider_.RenameAssetInGroup(group.name, key_to_rename, new_key_name);
                             dirty = true;
                         }
 
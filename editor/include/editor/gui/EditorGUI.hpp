@@ -7,6 +7,13 @@
 #include "engine/core/Engine.hpp"
 #include "engine/graphics/GraphicsContext.hpp"
 
+namespace tryengine::core {
+class Clock;
+class InputService;
+class SceneManager;
+class ScriptSystem;
+}  // namespace tryengine::core
+
 namespace tryeditor {
 class ControllerManager;
 class SceneManagerController;
@@ -24,10 +31,9 @@ public:
         AddressablesProvider& addressables_provider,
         ControllerManager& controller_manager);
     ~EditorGUI();
-    void UpdatePanels(const tryengine::core::Engine& engine) const;
-    void RecordPanelsGpuCommands(const tryengine::core::Engine& engine, bool& is_playing);
-    void RenderToPanel(SDL_GPUCommandBuffer* cmd, tryengine::graphics::RenderSystem& render_system,
-                       const tryengine::core::Engine& engine) const;
+    void UpdatePanels() const;
+    void RecordPanelsGpuCommands(bool& is_playing);
+    void RenderToPanel(SDL_GPUCommandBuffer* cmd, tryengine::graphics::RenderSystem& render_system) const;
     void RenderPanelsToSwapchain(SDL_GPUTexture* swapchainTexture, SDL_GPUCommandBuffer* cmd);
 
 private:
@@ -36,6 +42,11 @@ private:
     void DrawMainMenu();
 
     tryengine::core::Engine& engine_;
+    // Сервисы движка резолвятся один раз в конструкторе, а не через Engine::Get каждый кадр
+    tryengine::core::SceneManager& scene_manager_;
+    tryengine::core::Clock& clock_;
+    tryengine::core::InputService& input_service_;
+    tryengine::core::ScriptSystem& script_system_;
     SelectionManager& selection_manager_;
     ControllerManager& controller_manager_;
 
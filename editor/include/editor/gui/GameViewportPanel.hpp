@@ -2,7 +2,7 @@
 
 #include <imgui.h>
 
-#include <vector>
+#include <span>
 
 #include "BaseViewport.hpp"
 #include "engine/core/Components.hpp"
@@ -58,24 +58,15 @@ public:
         camera_data.proj = glm::perspective(glm::radians(camera.fov), aspect, camera.near_plane, camera.far_plane);
         camera_data.position = cam_transform.position;
 
-        std::vector<tryengine::graphics::PointLightGPU> scene_lights;
-
-        auto light_view = reg.view<tryengine::Transform, tryengine::LightComponent>();
-        for (auto entity : light_view) {
-            const auto& t = light_view.get<tryengine::Transform>(entity);
-            const auto& l = light_view.get<tryengine::LightComponent>(entity);
-
-            tryengine::graphics::PointLightGPU render_light;
-            // Упаковываем радиус в позицию
-            render_light.position_radius = glm::vec4(t.position, l.radius);
-            // Упаковываем интенсивность в цвет
-            render_light.color_intensity = glm::vec4(l.color, l.intensity);
-
-            scene_lights.push_back(render_light);
+        // Источники света собраны системой ExtractSceneLights до рендера
+        const auto* scene_lights = reg.ctx().find<tryengine::graphics::SceneLights>();
+        std::span<const tryengine::graphics::PointLightGPU> lights;
+        if (scene_lights) {
+            lights = scene_lights->lights;
         }
 
         // Шаг 4: Отрисовка
-        rs.ExecuteCommands(cmd, *target_, camera_data, scene_lights);
+        rs.ExecuteCommands(cmd, *target_, camera_data, lights);
     }
 };
 }  // namespace tryeditor
\ No newline at end of file
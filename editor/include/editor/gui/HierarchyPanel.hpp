@@ -1,10 +1,15 @@
 #pragma once
 
 #include <entt/entity/entity.hpp>
+#include <utility>
 #include <vector>
 
 #include "IPanel.hpp"
 
+namespace tryengine::core {
+class SceneGraph;
+}
+
 namespace tryeditor {
 class SelectionManager;
 class HierarchyPanel : public IPanel {
@@ -17,7 +22,7 @@ class HierarchyPanel : public IPanel {
 
    private:
     SelectionManager& selection_manager_;
-    void DrawEntityNode(entt::entity entity, entt::registry& reg);
+    void DrawEntityNode(entt::entity entity, entt::registry& reg, const tryengine::core::SceneGraph& graph);
     void HandleShortcuts(entt::registry& reg);
 
     void ReparentEntity(entt::entity child, entt::entity newParent, entt::registry& reg);
@@ -28,6 +33,8 @@ class HierarchyPanel : public IPanel {
     // Состояние панели (UI State)
     std::vector<entt::entity> entities_to_destroy_;
     std::vector<entt::entity> clipboard_entities_;
+    // (сущность, новый родитель) из drag-and-drop, применяются после отрисовки дерева
+    std::vector<std::pair<entt::entity, entt::entity>> pending_reparents_;
 
     entt::entity entity_to_rename_ = entt::null;
     char rename_buffer_[256] = "";
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <entt/entity/entity.hpp>
 #include <entt/meta/meta.hpp>
 #include <filesystem>
 
@@ -31,7 +32,8 @@ private:
 
 
     void DrawMetaComponent(entt::registry& reg, entt::entity entity, entt::meta_type type);
-    void DrawMetaField(entt::meta_any& instance, entt::meta_data data);
+    // Возвращает true, если значение поля изменено
+    bool DrawMetaField(entt::meta_any& instance, entt::meta_data data);
     void DrawUnregisteredComponent(entt::registry& reg, entt::entity entity, entt::id_type id);
     void DrawAddComponentButton(entt::registry& reg, entt::entity entity);
 
@@ -40,5 +42,9 @@ private:
     SelectionManager& selection_manager_;
     AddressablesProvider& addressables_provider_;
     bool show_settings_window_ = false;
+    // Редактируемый Tag выбранной сущности
+    char tag_buffer_[256] = "";
+    entt::entity tag_entity_ = entt::null;
+    bool tag_editing_ = false;
 };
 }  // namespace tryeditor
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <string>
+
+#include "IPanel.hpp"
+#include "engine/core/Profiler.hpp"
+
+namespace tryengine::core {
+class FrameArena;
+}
+
+namespace tryeditor {
+
+// Флейм-граф последнего кадра по потокам и экспорт в Chrome trace
+class ProfilerPanel : public IPanel {
+public:
+    explicit ProfilerPanel(tryengine::core::FrameArena& frame_arena) : frame_arena_(frame_arena) {}
+
+    const char* GetName() const override { return "Profiler"; }
+
+    void OnImGuiRender(entt::registry& reg) override;
+
+private:
+    void DrawFlameGraph() const;
+
+    tryengine::core::FrameArena& frame_arena_;
+
+    // Копия кадра: на паузе держим ее, а не последний кадр профайлера
+    tryengine::core::ProfileFrame frame_;
+    bool paused_ = false;
+    float zoom_ = 1.0f;
+    std::string export_status_;
+};
+
+}  // namespace tryeditor
@@ -66,6 +66,7 @@ public:
                 archive(asset);
             }
         }
+        UpdateArtifacts(context, header.guid);
     }
 
     template <typename TSettings>
@@ -83,6 +84,7 @@ public:
         if (it != importers_by_settings_type_.end()) {
             auto* typed = static_cast<ITypedImporter<TSettings>*>(it->second);
             typed->GenerateArtifact(context, header, settings);
+            UpdateArtifacts(context, header.guid);
         }
     }
 
@@ -93,10 +95,12 @@ public:
         archive(cereal::make_nvp("data", out_data));
     }
 
+    // Папка кэша импорта ассета: hierarchy.json и его запеченная копия
+    std::filesystem::path GetCacheDir(const uint64_t id) const { return game_cache_dir_ / std::to_string(id); }
+
     template <typename AssetData>
     AssetData LoadFromCache(const uint64_t id, std::string_view key) {
-        auto path = game_cache_dir_;
-        path /= std::to_string(id);
+        auto path = GetCacheDir(id);
         path /= "hierarchy.json";
 
         AssetData data;
@@ -151,6 +155,8 @@ public:
 
 private:
     void DeleteArtifactsAndCache(uint64_t id);
+    // Папка артефактов ассета изменилась — запись в индексе AssetDatabase обновляется без обхода artifacts
+    void UpdateArtifacts(const AssetContext& ctx, uint64_t guid) const;
     void ProcessDirectory(const std::filesystem::path& assets_dir);
     bool ValidateArtifacts(uint64_t guid, const AssetContext& ctx) const;
 
@@ -169,6 +175,9 @@ private:
     const std::filesystem::path engine_artifacts_dir_ = root_path_ / "engine_content" / "artifacts";
     const std::filesystem::path engine_cache_dir_ = root_path_ / "engine_content" / ".cache";
 
+    // Refresh и DeleteDirectory пишут индекс артефактов один раз в конце, а не после каждого ассета
+    bool batching_ = false;
+
     std::vector<std::unique_ptr<IAssetImporter>> importers_;
     std::unordered_map<std::string, IAssetImporter*> importers_by_ext_;
     std::unordered_map<std::string, IAssetImporter*> importers_by_name_;
@@ -1,5 +1,9 @@
 #pragma once
+#include <cereal/archives/binary.hpp>
 #include <cereal/cereal.hpp>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
 #include <string>
 #include <vector>
 #include <cereal/types/string.hpp>
@@ -39,4 +43,37 @@ struct ModelAssetMap {
     }
 };
 
+// Запеченная копия hierarchy.json рядом с ним (hierarchy.bin): Spawner читает ее без разбора JSON.
+// Раскладка следует за полями ModelAssetMap — при их изменении поднять версию
+inline constexpr uint32_t kModelAssetMapBinaryVersion = 1;
+
+inline bool SaveModelAssetMapBinary(const std::filesystem::path& path, const ModelAssetMap& asset_map) {
+    std::ofstream os(path, std::ios::binary | std::ios::trunc);
+    if (!os.is_open())
+        return false;
+    {
+        cereal::BinaryOutputArchive archive(os);
+        archive(kModelAssetMapBinaryVersion, asset_map);
+    }
+    return static_cast<bool>(os);
+}
+
+// false — файла нет, он другой версии или битый
+inline bool LoadModelAssetMapBinary(const std::filesystem::path& path, ModelAssetMap& asset_map) {
+    std::ifstream is(path, std::ios::binary);
+    if (!is.is_open())
+        return false;
+    try {
+        cereal::BinaryInputArchive archive(is);
+        uint32_t version = 0;
+        archive(version);
+        if (version != kModelAssetMapBinaryVersion)
+            return false;
+        archive(asset_map);
+    } catch (const cereal::Exception&) {
+        return false;
+    }
+    return true;
+}
+
 }  // namespace tryeditor
\ No newline at end of file
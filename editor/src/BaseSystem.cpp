@@ -45,6 +45,9 @@ void UpdateEditorCameraSystem(entt::registry& reg, const double delta_time, cons
                 transform.position += up * moveSpeed;
             if (input.IsDown(tryengine::core::Key::Q))
                 transform.position -= up * moveSpeed;
+
+            // Помечаем Transform измененным, иначе world_matrix камеры не пересчитается
+            reg.patch<tryengine::Transform>(entity);
         }
     }
 }
@@ -22,6 +22,7 @@
 #include "editor/import/GltfImporter.hpp"
 #include "editor/import/NativeImporter.hpp"
 #include "engine/core/Addressables.hpp"
+#include "engine/core/ComponentRegistry.hpp"
 #include "engine/core/Components.hpp"
 #include "engine/core/ResourceManager.hpp"
 #include "engine/core/SceneManager.hpp"
@@ -45,8 +46,7 @@ Editor::Editor(tryengine::core::Engine& engine, tryengine::graphics::GraphicsCon
     addressables_provider_ =
         std::make_unique<AddressablesProvider>(engine_.Get<tryengine::core::ResourceManager>().GetAddressables());
 
-    spawner_ =
-        std::make_unique<Spawner>(graphics_context_, engine_.Get<tryengine::core::ResourceManager>(), *import_system_);
+    spawner_ = std::make_unique<Spawner>(engine_.Get<tryengine::core::ResourceManager>(), *import_system_);
     reflection_system_ = std::make_unique<ReflectionSystem>();
     gui_controller_manager_ = std::make_unique<ControllerManager>();
 
@@ -66,10 +66,9 @@ void Editor::Init() {
         engine_.Get<tryengine::core::SceneManager>(), *import_system_,
         *assets_factory_->GetFactory<SceneAssetFactory>(), *addressables_provider_);
 
+    // Обновляет и AssetDatabase: индекс артефактов загружается и правится по импортированным ассетам
     GetImportSystem().Refresh();
 
-    engine_.Get<tryengine::core::ResourceManager>().GetAssetDatabase().Refresh();
-
     LoadGameLibrary("build/game/libgame.so");
     LoadDefaultScene();
 
@@ -81,15 +80,9 @@ Editor::~Editor() {
 }
 
 void Editor::RegisterComponents() const {
-    auto reg = engine_.Get<tryengine::core::ComponentRegistry>();
-    reg.Register<tryengine::Tag>("Tag");
-    reg.Register<tryengine::Transform>("Transform");
-    reg.Register<tryengine::Relationship>("Relationship");
-    reg.Register<tryengine::Camera>("Camera");
-    reg.Register<tryengine::MainCameraTag>("MainCameraTag");
+    auto& reg = engine_.Get<tryengine::core::ComponentRegistry>();
+    tryengine::core::RegisterEngineComponents(reg);
     reg.Register<EditorCameraTag>("EditorCameraTag");
-    reg.Register<tryengine::MeshFilter>("MeshFilter");
-    reg.Register<tryengine::MeshRenderer>("MeshRenderer");
 }
 
 void Editor::RegisterAssetsFactories() const {
@@ -1,5 +1,6 @@
 #include "editor/EditorApp.hpp"
 
+#include <fstream>
 #include <imgui_impl_sdl3.h>
 
 #include "editor/AppBootstrap.hpp"
@@ -9,27 +10,40 @@
 #include "engine/core/BaseSystem.hpp"
 #include "engine/core/Clock.hpp"
 #include "engine/core/ComponentRegistry.hpp"
+#include "engine/core/Components.hpp"
 #include "engine/core/Engine.hpp"
+#include "engine/core/FrameArena.hpp"
 #include "engine/core/InputService.hpp"
+#include "engine/core/JobSystem.hpp"
+#include "engine/core/Profiler.hpp"
 #include "engine/core/ResourceManager.hpp"
+#include "engine/core/SceneGraph.hpp"
 #include "engine/core/SceneManager.hpp"
 #include "engine/core/ScriptSystem.hpp"
 #include "engine/core/SpawnPoint.hpp"
+#include "engine/core/TransformHierarchy.hpp"
+#include "engine/graphics/May.hpp"
 
+// Нативный daslang-модуль редактора, подключается в ScriptSystem при создании
+DECLARE_MODULE(Module_TryEditor);
 
 namespace tryeditor {
 
 void EditorApp::Init() {
     AppBootstrap::CheckBaseProjectData();
+    TRYENGINE_PROFILE_THREAD("Main");
 
     engine_ = std::make_unique<tryengine::core::Engine>();
 
     auto& resource_manager_ = engine_->RegisterSystem<tryengine::core::ResourceManager>();
     auto& component_registry_ = engine_->RegisterSystem<tryengine::core::ComponentRegistry>();
     engine_->RegisterSystem<tryengine::core::Clock>();
-    engine_->RegisterSystem<tryengine::core::SceneManager>(component_registry_, resource_manager_);
-    engine_->RegisterSystem<tryengine::core::ScriptSystem>();
+    auto& scene_manager =
+        engine_->RegisterSystem<tryengine::core::SceneManager>(component_registry_, resource_manager_);
+    engine_->RegisterSystem<tryengine::core::ScriptSystem>([] { NEED_MODULE(Module_TryEditor); });
     engine_->RegisterSystem<tryengine::core::InputService>(this->input_state_);
+    scene_manager.SetJobSystem(&engine_->RegisterSystem<tryengine::core::JobSystem>());
+    auto& frame_arena = engine_->RegisterSystem<tryengine::core::FrameArena>();
 
     graphics_context_ = std::make_unique<tryengine::graphics::GraphicsContext>();
     if (!graphics_context_->Initialize(1280, 720, "tryengine")) {
@@ -37,7 +51,7 @@ void EditorApp::Init() {
         return;
     }
 
-    render_system_ = std::make_unique<tryengine::graphics::RenderSystem>(graphics_context_->GetDevice());
+    render_system_ = std::make_unique<tryengine::graphics::RenderSystem>(graphics_context_->GetDevice(), frame_arena);
     editor_ = std::make_unique<Editor>(*engine_, *graphics_context_);
 
     editor_->Init();
@@ -59,40 +73,120 @@ void EditorApp::Init() {
     for (auto& spawnPoint : vector) {
         std::cout << spawnPoint.x << " " << spawnPoint.y << "\n";
     }
+
+    clock_ = &engine_->Get<tryengine::core::Clock>();
+    scene_manager_ = &engine_->Get<tryengine::core::SceneManager>();
+    job_system_ = &engine_->Get<tryengine::core::JobSystem>();
+    frame_arena_ = &frame_arena;
+
+    RegisterFrameSystems();
 }
 
-void EditorApp::Run() {
-    while (editor_->running) {
-        UpdateInput();
-        const auto time_state = engine_->Get<tryengine::core::Clock>().Update();
-        float dt = static_cast<float>(time_state.delta_time);
+bool EditorApp::DumpSchedulerGraph(const std::filesystem::path& path) {
+    if (!scheduler_)
+        return false;
 
-        editor_->GetEditorGUI().UpdatePanels(*engine_);
+    std::ofstream os(path, std::ios::trunc);
+    if (!os.is_open()) {
+        std::cerr << "[EditorApp] Failed to open " << path << std::endl;
+        return false;
+    }
+    os << scheduler_->DumpGraph();
+    return static_cast<bool>(os);
+}
 
-        tryengine::core::UpdateTransformSystem(
-            engine_->Get<tryengine::core::SceneManager>().GetActiveScene().GetRegistry());
-        tryengine::core::UpdateCameraMatrices(
-            engine_->Get<tryengine::core::SceneManager>().GetActiveScene().GetRegistry());
+void EditorApp::RegisterFrameSystems() {
+    using namespace tryengine;
+
+    scheduler_ = std::make_unique<core::SystemScheduler>(*job_system_);
+
+    auto& jobs = *job_system_;
+    scheduler_->Add("UpdateTransforms",
+                    core::SystemAccess()
+                        .Read<Transform, Relationship>()
+                        .Write<WorldMatrix, TransformDirty>()
+                        .WriteResource<core::SceneGraph, core::TransformHierarchy>()
+                        .Prepare([](entt::registry& reg) {
+                            core::AcquireSceneGraph(reg);
+                            core::AcquireTransformHierarchy(reg);
+                        }),
+                    [&jobs](entt::registry& reg, float) { core::UpdateTransformSystem(reg, jobs); });
+
+    scheduler_->Add("UpdateCameraMatrices", core::SystemAccess().Read<WorldMatrix>().Write<Camera>(),
+                    [](entt::registry& reg, float) { core::UpdateCameraMatrices(reg); });
+
+    scheduler_->Add("ExtractSceneLights",
+                    core::SystemAccess()
+                        .Read<Transform, LightComponent>()
+                        .WriteResource<graphics::SceneLights>()
+                        .Prepare([](entt::registry& reg) {
+                            if (!reg.ctx().contains<graphics::SceneLights>()) {
+                                reg.ctx().emplace<graphics::SceneLights>();
+                            }
+                        }),
+                    [](entt::registry& reg, float) { graphics::ExtractSceneLights(reg); });
+
+    // Скрипты работают со своим миром (decs), поэтому с системами выше не пересекаются
+    auto& script_system = engine_->Get<core::ScriptSystem>();
+    auto* editor = editor_.get();
+    scheduler_->Add("ScriptUpdate", core::SystemAccess().WriteResource<core::ScriptSystem>().OnMainThread(),
+                    [&script_system, editor](entt::registry&, float dt) {
+                        script_system.CheckForReload(dt);
+                        if (editor->play_mode) {
+                            script_system.InvokeUpdate(dt);
+                        }
+                    });
+}
 
-        engine_->Get<tryengine::core::ScriptSystem>().CheckForReload(dt);
+void EditorApp::Run() {
+    auto& gui = editor_->GetEditorGUI();
 
-        if (editor_->play_mode) {
-            engine_->Get<tryengine::core::ScriptSystem>().InvokeUpdate(dt);
+    while (editor_->running) {
+        // Граница кадра профайлера: все, что ниже, попадает в следующий кадр панели
+        TRYENGINE_PROFILE_FRAME();
+        TRYENGINE_PROFILE_ZONE("EditorApp::Run");
+        // Временные данные позапрошлого кадра больше никто не читает
+        frame_arena_->NextFrame();
+
+        {
+            TRYENGINE_PROFILE_ZONE("Input");
+            UpdateInput();
+            // Задачи, которым нужен главный поток (SDL, GPU, скрипты), поставленные из воркеров
+            job_system_->PumpMainThread();
         }
+        const auto time_state = clock_->Update();
+        float dt = static_cast<float>(time_state.delta_time);
 
-        editor_->GetEditorGUI().RecordPanelsGpuCommands(*engine_, editor_->play_mode);
+        gui.UpdatePanels();
+        // Асинхронные загрузки и выгрузки сцен — порция в пределах бюджета кадра
+        scene_manager_->Update();
+
+        {
+            TRYENGINE_PROFILE_ZONE("Systems");
+            scheduler_->Run(scene_manager_->GetActiveScene().GetRegistry(), dt);
+        }
+        {
+            TRYENGINE_PROFILE_ZONE("EditorGUI");
+            gui.RecordPanelsGpuCommands(editor_->play_mode);
+        }
 
         const auto cmd = SDL_AcquireGPUCommandBuffer(graphics_context_->GetDevice());
 
         SDL_GPUTexture* swapchainTexture = nullptr;
         uint32_t w, h;
-        if (!SDL_WaitAndAcquireGPUSwapchainTexture(cmd, graphics_context_->GetWindow(), &swapchainTexture, &w, &h)) {
-            SDL_SubmitGPUCommandBuffer(cmd);
-            continue;
+        {
+            TRYENGINE_PROFILE_ZONE("AcquireSwapchain");
+            if (!SDL_WaitAndAcquireGPUSwapchainTexture(cmd, graphics_context_->GetWindow(), &swapchainTexture, &w,
+                                                      &h)) {
+                SDL_SubmitGPUCommandBuffer(cmd);
+                continue;
+            }
+        }
+        {
+            TRYENGINE_PROFILE_ZONE("Render");
+            gui.RenderToPanel(cmd, *render_system_);
+            gui.RenderPanelsToSwapchain(swapchainTexture, cmd);
         }
-        editor_->GetEditorGUI().RenderToPanel(cmd, *render_system_, *engine_);
-
-        editor_->GetEditorGUI().RenderPanelsToSwapchain(swapchainTexture, cmd);
     }
 }
 
@@ -18,10 +18,13 @@
 #include "editor/gui/GameViewportPanel.hpp"
 #include "editor/gui/HierarchyPanel.hpp"
 #include "editor/gui/InspectorPanel.hpp"
+#include "editor/gui/ProfilerPanel.hpp"
 #include "editor/gui/SceneViewportPanel.hpp"
 #include "engine/core/Clock.hpp"
 #include "engine/core/Engine.hpp"
+#include "engine/core/FrameArena.hpp"
 #include "engine/core/InputService.hpp"
+#include "engine/core/SceneManager.hpp"
 #include "engine/core/ScriptSystem.hpp"
 
 namespace tryeditor {
@@ -30,7 +33,13 @@ EditorGUI::EditorGUI(tryengine::core::Engine& engine, tryengine::graphics::Graph
                      ImportSystem& import_system, Spawner& spawner, SelectionManager& editor_context,
                      AssetsFactoryManager& factory_manager, AssetInspectorManager& inspector_manager,
                      AddressablesProvider& addressables_provider, ControllerManager& controller_manager)
-    : engine_(engine), selection_manager_(editor_context), controller_manager_(controller_manager) {
+    : engine_(engine),
+      scene_manager_(engine.Get<tryengine::core::SceneManager>()),
+      clock_(engine.Get<tryengine::core::Clock>()),
+      input_service_(engine.Get<tryengine::core::InputService>()),
+      script_system_(engine.Get<tryengine::core::ScriptSystem>()),
+      selection_manager_(editor_context),
+      controller_manager_(controller_manager) {
     IMGUI_CHECKVERSION();
     ImGui::CreateContext();
     ImGuiIO& io = ImGui::GetIO();
@@ -77,8 +86,9 @@ EditorGUI::EditorGUI(tryengine::core::Engine& engine, tryengine::graphics::Graph
         std::make_unique<InspectorPanel>(editor_context, import_system, inspector_manager, addressables_provider));
     panels_.emplace_back(std::make_unique<HierarchyPanel>(selection_manager_));
     panels_.emplace_back(
-        std::make_unique<FileBrowserPanel>(import_system, editor_context, factory_manager, engine_.Get<tryengine::core::SceneManager>()));
+        std::make_unique<FileBrowserPanel>(import_system, editor_context, factory_manager, scene_manager_));
     panels_.emplace_back(std::make_unique<AddressablesPanel>(addressables_provider));
+    panels_.emplace_back(std::make_unique<ProfilerPanel>(engine.Get<tryengine::core::FrameArena>()));
 }
 
 EditorGUI::~EditorGUI() {
@@ -87,36 +97,35 @@ EditorGUI::~EditorGUI() {
     ImGui::DestroyContext();
 }
 
-void EditorGUI::UpdatePanels(const tryengine::core::Engine& engine) const {
+void EditorGUI::UpdatePanels() const {
     for (const auto& panel : panels_) {
-        panel->OnUpdate(engine.Get<tryengine::core::Clock>().GetDeltaTime(), engine.Get<tryengine::core::InputService>().GetInputState(),
-                        engine.Get<tryengine::core::SceneManager>().GetActiveScene().GetRegistry());
+        panel->OnUpdate(clock_.GetDeltaTime(), input_service_.GetInputState(),
+                        scene_manager_.GetActiveScene().GetRegistry());
     }
 }
 
-void EditorGUI::RecordPanelsGpuCommands(const tryengine::core::Engine& engine, bool& is_playing) {
+void EditorGUI::RecordPanelsGpuCommands(bool& is_playing) {
     ImGui_ImplSDLGPU3_NewFrame();
     ImGui_ImplSDL3_NewFrame();
     ImGui::NewFrame();
     ImGuizmo::BeginFrame();
 
-    engine_.Get<tryengine::core::ScriptSystem>().InvokeFunction("ren");
+    script_system_.InvokeFunction("ren");
 
     DrawMainMenu();
     DrawPlayToolbar(is_playing);
     DrawDockSpace();
 
     for (const auto& panel : panels_) {
-        panel->OnImGuiRender(engine.Get<tryengine::core::SceneManager>().GetActiveScene().GetRegistry());
+        panel->OnImGuiRender(scene_manager_.GetActiveScene().GetRegistry());
     }
 
     ImGui::Render();
 }
 
-void EditorGUI::RenderToPanel(SDL_GPUCommandBuffer* cmd, tryengine::graphics::RenderSystem& render_system,
-                              const tryengine::core::Engine& engine) const {
+void EditorGUI::RenderToPanel(SDL_GPUCommandBuffer* cmd, tryengine::graphics::RenderSystem& render_system) const {
     for (const auto& panel : panels_) {
-        panel->OnRender(cmd, render_system, engine.Get<tryengine::core::SceneManager>().GetActiveScene().GetRegistry());
+        panel->OnRender(cmd, render_system, scene_manager_.GetActiveScene().GetRegistry());
     }
 }
 
@@ -0,0 +1,211 @@
+#include "editor/SpawnBenchmark.hpp"
+
+#include <cereal/archives/json.hpp>
+#include <chrono>
+#include <cstdio>
+#include <entt/entity/registry.hpp>
+#include <filesystem>
+#include <fstream>
+#include <glm/geometric.hpp>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "editor/Spawner.hpp"
+#include "editor/import/ImportSystem.hpp"
+#include "editor/meta/ModelAssetMap.hpp"
+#include "engine/core/ResourceManager.hpp"
+#include "engine/core/SceneGraph.hpp"
+#include "engine/graphics/Types.hpp"
+
+namespace tryeditor {
+
+using namespace tryengine;
+
+namespace {
+
+// Guid ассетов — случайные 64 бита, малое число с ними практически не совпадет
+constexpr uint64_t kBenchAssetId = 0xBE4C;
+constexpr double kRequiredSpeedup = 10.0;
+
+// Похоже на импортированную модель: двоичное дерево узлов, меши на каждом третьем
+constexpr int32_t kNodes = 24;
+constexpr int32_t kMeshEvery = 3;
+
+ModelAssetMap BuildModel() {
+    std::mt19937 rng(41);
+    std::uniform_real_distribution<float> offset(-1.0f, 1.0f);
+
+    ModelAssetMap asset_map;
+    asset_map.main_guid = kBenchAssetId;
+    asset_map.scene_roots.push_back(0);
+    asset_map.nodes.resize(kNodes);
+    for (int32_t i = 0; i < kNodes; ++i) {
+        auto& node = asset_map.nodes[i];
+        node.name = i % 5 == 0 ? std::string() : "Node_" + std::to_string(i);
+        node.local_transform.position = glm::vec3(offset(rng), offset(rng), offset(rng));
+        for (const int32_t child : {2 * i + 1, 2 * i + 2}) {
+            if (child < kNodes) {
+                node.children_indices.push_back(child);
+            }
+        }
+        if (i % kMeshEvery == 0) {
+            node.mesh_id = 1000 + static_cast<uint64_t>(i);
+            node.material_id = 2000 + static_cast<uint64_t>(i % 4);
+        }
+    }
+    return asset_map;
+}
+
+// Spawn до кэша шаблонов: hierarchy.json разбирается заново, компоненты и ресурсы — по узлу
+void LegacySpawn(entt::registry& reg, ImportSystem& import_system, core::ResourceManager& resource_manager,
+                 uint64_t asset_id) {
+    const auto asset_map = import_system.LoadFromCache<ModelAssetMap>(asset_id, "asset_map");
+
+    std::vector<entt::entity> entities;
+    entities.reserve(asset_map.nodes.size());
+    for (size_t i = 0; i < asset_map.nodes.size(); ++i) {
+        entities.push_back(reg.create());
+    }
+
+    auto& graph = core::AcquireSceneGraph(reg);
+    for (size_t i = 0; i < asset_map.nodes.size(); ++i) {
+        const auto entity = entities[i];
+        const auto& node_data = asset_map.nodes[i];
+
+        reg.emplace<Tag>(entity, node_data.name.empty() ? "New Node" : node_data.name);
+        reg.emplace<Transform>(entity, node_data.local_transform);
+        reg.get_or_emplace<Relationship>(entity);
+
+        for (const int32_t child : node_data.children_indices) {
+            graph.SetParent(reg, entities[child], entity);
+        }
+
+        if (node_data.mesh_id != 0) {
+            reg.emplace<MeshFilter>(entity, resource_manager.Get<graphics::Mesh>(node_data.mesh_id),
+                                    node_data.mesh_id);
+            reg.emplace<MeshRenderer>(entity, resource_manager.Get<graphics::Material>(node_data.material_id),
+                                      node_data.material_id);
+        }
+    }
+}
+
+template <typename Fn>
+double TimeMs(Fn&& fn) {
+    const auto start = std::chrono::steady_clock::now();
+    fn();
+    const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+template <typename T>
+size_t PoolSize(const entt::registry& reg) {
+    const auto* storage = reg.storage<T>();
+    return storage ? storage->size() : 0;
+}
+
+// Пулы совпадают с эталоном, у каждого узла столько детей в графе, сколько в Relationship
+bool Matches(const entt::registry& reg, const entt::registry& reference) {
+    if (PoolSize<Tag>(reg) != PoolSize<Tag>(reference) || PoolSize<Transform>(reg) != PoolSize<Transform>(reference) ||
+        PoolSize<Relationship>(reg) != PoolSize<Relationship>(reference) ||
+        PoolSize<MeshFilter>(reg) != PoolSize<MeshFilter>(reference) ||
+        PoolSize<MeshRenderer>(reg) != PoolSize<MeshRenderer>(reference))
+        return false;
+
+    const auto* graph = reg.ctx().find<core::SceneGraph>();
+    if (!graph)
+        return false;
+    for (const auto [entity, relationship] : reg.view<Relationship>().each()) {
+        const auto children = graph->GetChildren(entity);
+        if (children.size() != relationship.children)
+            return false;
+        for (const auto child : children) {
+            if (reg.get<Relationship>(child).parent != entity)
+                return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
+int RunSpawnBenchmark(uint32_t instances) {
+    core::ResourceManager resource_manager;
+    ImportSystem import_system(resource_manager);
+    Spawner spawner(resource_manager, import_system);
+
+    const auto cache_dir = import_system.GetCacheDir(kBenchAssetId);
+    std::filesystem::remove_all(cache_dir);
+    std::filesystem::create_directories(cache_dir);
+    {
+        std::ofstream os(cache_dir / "hierarchy.json");
+        cereal::JSONOutputArchive archive(os);
+        archive(cereal::make_nvp("asset_map", BuildModel()));
+    }
+
+    std::vector<Transform> transforms(instances);
+    for (uint32_t i = 0; i < instances; ++i) {
+        transforms[i].position =
+            glm::vec3(static_cast<float>(i % 100) * 4.0f, 0.0f, static_cast<float>(i / 100) * 4.0f);
+    }
+
+    std::printf("%u instances of a %d-node model (%d with meshes), %u entities\n", instances, kNodes,
+                (kNodes + kMeshEvery - 1) / kMeshEvery, instances * static_cast<uint32_t>(kNodes));
+
+    entt::registry legacy;
+    const double legacy_ms = TimeMs([&] {
+        for (uint32_t i = 0; i < instances; ++i) {
+            LegacySpawn(legacy, import_system, resource_manager, kBenchAssetId);
+        }
+    });
+
+    // Первый вызов разбирает JSON и запекает hierarchy.bin — вне замера, как после импорта модели
+    spawner.ClearCache();
+    {
+        entt::registry warmup;
+        spawner.Spawn(warmup, kBenchAssetId);
+    }
+
+    entt::registry cached;
+    const double cached_ms = TimeMs([&] {
+        for (uint32_t i = 0; i < instances; ++i) {
+            spawner.Spawn(cached, kBenchAssetId);
+        }
+    });
+
+    entt::registry batch;
+    std::vector<entt::entity> spawned;
+    const double batch_ms = TimeMs([&] { spawned = spawner.SpawnBatch(batch, kBenchAssetId, transforms); });
+
+    // Холодный шаблон из hierarchy.bin: сколько стоит первый спавн после запуска редактора
+    spawner.ClearCache();
+    entt::registry cold;
+    const double cold_ms = TimeMs([&] { spawner.Spawn(cold, kBenchAssetId); });
+    spawner.ClearCache();
+
+    std::filesystem::remove_all(cache_dir);
+
+    bool ok = spawned.size() == static_cast<size_t>(instances) * kNodes;
+    ok &= Matches(legacy, legacy) && Matches(cached, legacy) && Matches(batch, legacy);
+    // Поворот и масштаб экземпляров единичные: корень сдвигается на позицию экземпляра
+    const glm::vec3 root_position = BuildModel().nodes[0].local_transform.position;
+    for (uint32_t i = 0; ok && i < instances; ++i) {
+        const auto& root = batch.get<Transform>(spawned[static_cast<size_t>(i) * kNodes]);
+        ok &= glm::length(root.position - (transforms[i].position + root_position)) < 1e-4f;
+    }
+
+    const auto per_instance_us = [&](double ms) { return ms * 1000.0 / static_cast<double>(instances); };
+    std::printf("%-28s %10.2f ms %8.2f us/instance\n", "Spawn, hierarchy.json", legacy_ms, per_instance_us(legacy_ms));
+    std::printf("%-28s %10.2f ms %8.2f us/instance\n", "Spawn, cached template", cached_ms, per_instance_us(cached_ms));
+    std::printf("%-28s %10.2f ms %8.2f us/instance\n", "SpawnBatch", batch_ms, per_instance_us(batch_ms));
+    std::printf("%-28s %10.3f ms\n", "first Spawn, hierarchy.bin", cold_ms);
+    std::printf("%-28s %10.1fx\n", "speedup", legacy_ms / batch_ms);
+
+    if (!ok) {
+        std::printf("spawned scenes differ\n");
+        return 1;
+    }
+    return legacy_ms / batch_ms >= kRequiredSpeedup ? 0 : 1;
+}
+
+}  // namespace tryeditor
@@ -1,60 +1,188 @@
 #include "editor/Spawner.hpp"
 
 #include <entt/entity/registry.hpp>
+#include <iostream>
 
 #include "editor/import/ImportSystem.hpp"
 #include "editor/meta/ModelAssetMap.hpp"
+#include "engine/core/SceneGraph.hpp"
+#include "engine/graphics/Types.hpp"
 
 namespace tryeditor {
 
+namespace {
+
+// Трансформ экземпляра поверх локального трансформа корня модели
+tryengine::Transform Compose(const tryengine::Transform& parent, const tryengine::Transform& local) {
+    tryengine::Transform out;
+    out.position = parent.position + parent.rotation * (parent.scale * local.position);
+    out.rotation = parent.rotation * local.rotation;
+    out.scale = parent.scale * local.scale;
+    return out;
+}
+
+}  // namespace
+
 void Spawner::Spawn(entt::registry& reg, const uint64_t asset_id) const {
-    const auto asset_map = import_system_.LoadFromCache<ModelAssetMap>(asset_id, "asset_map");
+    const tryengine::Transform identity;
+    SpawnBatch(reg, asset_id, std::span(&identity, 1));
+}
+
+std::vector<entt::entity> Spawner::SpawnBatch(entt::registry& reg, const uint64_t asset_id,
+                                              std::span<const tryengine::Transform> transforms) const {
+    const auto model = GetTemplate(asset_id);
+    if (!model || model->tags.empty() || transforms.empty())
+        return {};
+
+    const size_t nodes = model->tags.size();
+    const size_t count = nodes * transforms.size();
+
+    // Граф берем до вставки: если его еще нет, он построится по сцене без новых сущностей
+    auto& graph = tryengine::core::AcquireSceneGraph(reg);
+
+    std::vector<entt::entity> entities(count);
+    reg.create(entities.begin(), entities.end());
 
-    std::vector<entt::entity> entities(asset_map.nodes.size());
+    // Значения всех экземпляров подряд — каждый пул заполняется одним insert
+    std::vector<tryengine::Tag> tags;
+    std::vector<tryengine::Transform> locals;
+    std::vector<tryengine::Relationship> relationships;
+    tags.reserve(count);
+    locals.reserve(count);
+    relationships.reserve(count);
 
-    for (size_t i = 0; i < asset_map.nodes.size(); ++i) {
-        entities[i] = reg.create();
+    for (size_t i = 0; i < transforms.size(); ++i) {
+        const size_t base = i * nodes;
+        const auto entity = [&](int32_t node) {
+            return node < 0 ? entt::entity{entt::null} : entities[base + static_cast<size_t>(node)];
+        };
+
+        tags.insert(tags.end(), model->tags.begin(), model->tags.end());
+        for (size_t n = 0; n < nodes; ++n) {
+            const auto& links = model->links[n];
+            locals.push_back(links.parent < 0 ? Compose(transforms[i], model->transforms[n]) : model->transforms[n]);
+
+            tryengine::Relationship& relationship = relationships.emplace_back();
+            relationship.children = links.children;
+            relationship.first = entity(links.first);
+            relationship.prev = entity(links.prev);
+            relationship.next = entity(links.next);
+            relationship.parent = entity(links.parent);
+        }
     }
 
-    // 2. Итерируемся по данным и настраиваем компоненты
-    for (size_t i = 0; i < asset_map.nodes.size(); ++i) {
-        const auto& node_data = asset_map.nodes[i];
-        entt::entity entity = entities[i];
+    reg.insert<tryengine::Tag>(entities.begin(), entities.end(), tags.begin());
+    reg.insert<tryengine::Transform>(entities.begin(), entities.end(), locals.begin());
+    reg.insert<tryengine::Relationship>(entities.begin(), entities.end(), relationships.begin());
+
+    if (!model->mesh_nodes.empty()) {
+        std::vector<entt::entity> mesh_entities;
+        std::vector<tryengine::MeshFilter> filters;
+        std::vector<tryengine::MeshRenderer> renderers;
+        mesh_entities.reserve(model->mesh_nodes.size() * transforms.size());
+        filters.reserve(mesh_entities.capacity());
+        renderers.reserve(mesh_entities.capacity());
+
+        for (size_t i = 0; i < transforms.size(); ++i) {
+            for (const uint32_t node : model->mesh_nodes) {
+                mesh_entities.push_back(entities[i * nodes + node]);
+            }
+            filters.insert(filters.end(), model->filters.begin(), model->filters.end());
+            renderers.insert(renderers.end(), model->renderers.begin(), model->renderers.end());
+        }
 
-        // Имя и Трансформ
-        reg.emplace<tryengine::Tag>(entity, node_data.name.empty() ? "New Node" : node_data.name);
-        reg.emplace<tryengine::Transform>(entity, node_data.local_transform);
+        reg.insert<tryengine::MeshFilter>(mesh_entities.begin(), mesh_entities.end(), filters.begin());
+        reg.insert<tryengine::MeshRenderer>(mesh_entities.begin(), mesh_entities.end(), renderers.begin());
+    }
+
+    graph.AddFromRelationships(reg, entities);
+    return entities;
+}
 
-        auto& rel = reg.get_or_emplace<tryengine::Relationship>(entity);
-        entt::entity last_child = entt::null;
+std::shared_ptr<const ModelTemplate> Spawner::GetTemplate(const uint64_t asset_id) const {
+    const auto cache_dir = import_system_.GetCacheDir(asset_id);
+    const auto json_path = cache_dir / "hierarchy.json";
+    const auto binary_path = cache_dir / "hierarchy.bin";
+
+    // Один stat на вызов: переимпорт переписывает кэш, и шаблон из памяти перестает ему соответствовать
+    std::error_code json_error;
+    std::error_code binary_error;
+    const auto json_time = std::filesystem::last_write_time(json_path, json_error);
+    const auto binary_time = std::filesystem::last_write_time(binary_path, binary_error);
+    const bool binary_fresh = !binary_error && (json_error || binary_time >= json_time);
+    if (!binary_fresh && json_error) {
+        std::cerr << "[Spawner] Model " << asset_id << " is not imported: " << json_path << std::endl;
+        return nullptr;
+    }
 
-        for (int32_t child_idx : node_data.children_indices) {
-            if (child_idx >= 0 && child_idx < entities.size()) {
-                entt::entity child_entity = entities[child_idx];
-                auto& childRel = reg.get_or_emplace<tryengine::Relationship>(child_entity);
+    auto stamp = binary_fresh ? binary_time : json_time;
+    if (const auto it = templates_.find(asset_id); it != templates_.end() && it->second->stamp == stamp)
+        return it->second;
 
-                childRel.parent = entity;
-                rel.children++;
+    ModelAssetMap asset_map;
+    if (!binary_fresh || !LoadModelAssetMapBinary(binary_path, asset_map)) {
+        // Модель импортирована до hierarchy.bin или файл другой версии — запекаем, дальше JSON не читается
+        asset_map = import_system_.LoadFromCache<ModelAssetMap>(asset_id, "asset_map");
+        if (SaveModelAssetMapBinary(binary_path, asset_map)) {
+            stamp = std::filesystem::last_write_time(binary_path, binary_error);
+        }
+    }
+
+    auto model = BuildTemplate(asset_map);
+    model->stamp = stamp;
+    templates_[asset_id] = model;
+    return model;
+}
 
-                // Выстраиваем цепочку сиблингов (next/prev)
-                if (last_child == entt::null) {
-                    rel.first = child_entity;
-                } else {
-                    reg.get<tryengine::Relationship>(last_child).next = child_entity;
-                    childRel.prev = last_child;
+std::shared_ptr<ModelTemplate> Spawner::BuildTemplate(const ModelAssetMap& asset_map) const {
+    auto model = std::make_shared<ModelTemplate>();
+    const auto count = static_cast<int32_t>(asset_map.nodes.size());
+    model->tags.reserve(asset_map.nodes.size());
+    model->transforms.reserve(asset_map.nodes.size());
+    model->links.resize(asset_map.nodes.size());
+
+    std::vector<int32_t> last_child(asset_map.nodes.size(), -1);
+    for (int32_t i = 0; i < count; ++i) {
+        const auto& node_data = asset_map.nodes[i];
+        model->tags.emplace_back(node_data.name.empty() ? "New Node" : node_data.name);
+        model->transforms.push_back(node_data.local_transform);
+
+        // Дети в порядке glTF. Ребенок с уже найденным родителем или замыкающий цикл пропускается
+        for (const int32_t child : node_data.children_indices) {
+            if (child < 0 || child >= count || child == i || model->links[child].parent != -1)
+                continue;
+
+            bool cycle = false;
+            for (int32_t curr = model->links[i].parent; curr != -1; curr = model->links[curr].parent) {
+                if (curr == child) {
+                    cycle = true;
+                    break;
                 }
-                last_child = child_entity;
             }
+            if (cycle)
+                continue;
+
+            auto& parent = model->links[i];
+            model->links[child].parent = i;
+            if (last_child[i] == -1) {
+                parent.first = child;
+            } else {
+                model->links[last_child[i]].next = child;
+                model->links[child].prev = last_child[i];
+            }
+            last_child[i] = child;
+            ++parent.children;
         }
 
-        // Рендер компоненты (если есть меш)
         if (node_data.mesh_id != 0) {
-            auto mesh_resource = resource_manager_.Get<tryengine::graphics::Mesh>(node_data.mesh_id);
-            reg.emplace<tryengine::MeshFilter>(entity, mesh_resource, node_data.mesh_id);
-
-            auto material_resource = resource_manager_.Get<tryengine::graphics::Material>(node_data.material_id);
-            reg.emplace<tryengine::MeshRenderer>(entity, material_resource, node_data.material_id);
+            model->mesh_nodes.push_back(static_cast<uint32_t>(i));
+            model->filters.push_back(
+                {resource_manager_.Get<tryengine::graphics::Mesh>(node_data.mesh_id), node_data.mesh_id});
+            model->renderers.push_back({resource_manager_.Get<tryengine::graphics::Material>(node_data.material_id),
+                                        node_data.material_id});
         }
     }
+    return model;
 }
+
 }  // namespace tryeditor
@@ -5,6 +5,8 @@
 #include "editor/Components.hpp"
 #include "editor/SelectionManager.hpp"
 #include "engine/core/Components.hpp"
+#include "engine/core/Prefab.hpp"
+#include "engine/core/SceneGraph.hpp"
 #include "imgui_internal.h"
 
 namespace tryeditor {
@@ -12,6 +14,8 @@ namespace tryeditor {
 void HierarchyPanel::OnImGuiRender(entt::registry& reg) {
     ImGui::Begin("Hierarchy");
 
+    auto& graph = tryengine::core::AcquireSceneGraph(reg);
+
     HandleShortcuts(reg);
     bool isMouseCaptured = SDL_GetWindowRelativeMouseMode(SDL_GL_GetCurrentWindow());
 
@@ -32,23 +36,25 @@ void HierarchyPanel::OnImGuiRender(entt::registry& reg) {
     if (ImGui::BeginDragDropTargetCustom(ImGui::GetCurrentWindow()->Rect(), ImGui::GetID("Hierarchy"))) {
         if (const ImGuiPayload* payload = ImGui::AcceptDragDropPayload("HIERARCHY_ENTITY")) {
             entt::entity droppedEntity = *(entt::entity*)payload->Data;
-            ReparentEntity(droppedEntity, entt::null, reg);
+            pending_reparents_.emplace_back(droppedEntity, entt::null);
         }
         ImGui::EndDragDropTarget();
     }
 
     // Отрисовка корневых сущностей
     for (auto [entity] : reg.storage<entt::entity>().each()) {
-        bool isRoot = true;
-        if (auto* rel = reg.try_get<tryengine::Relationship>(entity)) {
-            if (rel->parent != entt::null) {
-                isRoot = false;
-            }
+        if (graph.GetParent(entity) == entt::null) {
+            DrawEntityNode(entity, reg, graph);
         }
-        if (isRoot) {
-            DrawEntityNode(entity, reg);
+    }
+
+    // Перепривязка меняет массивы детей, по которым шла отрисовка, поэтому применяем ее после обхода
+    for (const auto [entity, new_parent] : pending_reparents_) {
+        if (reg.valid(entity) && (new_parent == entt::null || reg.valid(new_parent))) {
+            ReparentEntity(entity, new_parent, reg);
         }
     }
+    pending_reparents_.clear();
 
     if (ImGui::IsMouseDown(0) && ImGui::IsWindowHovered() && !ImGui::IsAnyItemHovered()) {
         reg.clear<SelectedTag>();
@@ -66,19 +72,19 @@ void HierarchyPanel::OnImGuiRender(entt::registry& reg) {
     ImGui::End();
 }
 
-void HierarchyPanel::DrawEntityNode(entt::entity entity, entt::registry& reg) {
+void HierarchyPanel::DrawEntityNode(entt::entity entity, entt::registry& reg, const tryengine::core::SceneGraph& graph) {
     bool isSelected = reg.all_of<SelectedTag>(entity);
     ImGuiTreeNodeFlags flags = (isSelected ? ImGuiTreeNodeFlags_Selected : 0);
     flags |= ImGuiTreeNodeFlags_OpenOnArrow | ImGuiTreeNodeFlags_SpanAvailWidth;
 
-    auto* rel = reg.try_get<tryengine::Relationship>(entity);
-    bool hasChildren = rel && (rel->children > 0);
+    const auto children = graph.GetChildren(entity);
+    bool hasChildren = !children.empty();
 
     if (!hasChildren) flags |= ImGuiTreeNodeFlags_Leaf;
 
     std::string label = "Entity [" + std::to_string(static_cast<uint32_t>(entity)) + "]";
-    if (auto* tag = reg.try_get<tryengine::Tag>(entity)) {
-        label = tag->tag;
+    if (const auto* tag = tryengine::core::GetPrefabComponent<tryengine::Tag>(reg, entity)) {
+        label = tag->tag.View();
     }
 
     if (entity_to_rename_ == entity) {
@@ -86,8 +92,9 @@ void HierarchyPanel::DrawEntityNode(entt::entity entity, entt::registry& reg) {
         ImGui::SetKeyboardFocusHere();
         if (ImGui::InputText("##rename", rename_buffer_, sizeof(rename_buffer_),
                              ImGuiInputTextFlags_EnterReturnsTrue | ImGuiInputTextFlags_AutoSelectAll)) {
-            if (!reg.all_of<tryengine::Tag>(entity)) reg.emplace<tryengine::Tag>(entity);
-            reg.get<tryengine::Tag>(entity).tag = rename_buffer_;
+            // У экземпляра префаба имя общее — переименование кладет на сущность свой Tag
+            tryengine::core::OverridePrefabComponent<tryengine::Tag>(reg, entity).tag =
+                tryengine::core::StringId(rename_buffer_);
             entity_to_rename_ = entt::null;
         }
         if (ImGui::IsItemDeactivated() && ImGui::IsKeyPressed(ImGuiKey_Escape)) {
@@ -116,7 +123,7 @@ void HierarchyPanel::DrawEntityNode(entt::entity entity, entt::registry& reg) {
         if (ImGui::BeginDragDropTarget()) {
             if (const ImGuiPayload* payload = ImGui::AcceptDragDropPayload("HIERARCHY_ENTITY")) {
                 entt::entity droppedEntity = *(entt::entity*)payload->Data;
-                ReparentEntity(droppedEntity, entity, reg);
+                pending_reparents_.emplace_back(droppedEntity, entity);
             }
             ImGui::EndDragDropTarget();
         }
@@ -128,14 +135,10 @@ void HierarchyPanel::DrawEntityNode(entt::entity entity, entt::registry& reg) {
             ImGui::EndPopup();
         }
 
-        // РЕКУРСИВНАЯ ОТРИСОВКА ЧЕРЕЗ СВЯЗНЫЙ СПИСОК (Гораздо быстрее)
+        // Рекурсивная отрисовка по непрерывному массиву детей
         if (opened) {
-            if (hasChildren) {
-                entt::entity curr = rel->first;
-                while (curr != entt::null) {
-                    DrawEntityNode(curr, reg);
-                    curr = reg.get<tryengine::Relationship>(curr).next;
-                }
+            for (const auto child : children) {
+                DrawEntityNode(child, reg, graph);
             }
             ImGui::TreePop();
         }
@@ -194,59 +197,16 @@ void HierarchyPanel::HandleShortcuts(entt::registry& reg) {
 }
 
 void HierarchyPanel::ReparentEntity(entt::entity entity, entt::entity newParent, entt::registry& reg) {
-    if (entity == newParent) return;
-
-    auto& rel = reg.get_or_emplace<tryengine::Relationship>(entity);
-
-    // --- защита от циклов ---
-    entt::entity check = newParent;
-    while (check != entt::null) {
-        if (check == entity) return;
-        auto* parentRel = reg.try_get<tryengine::Relationship>(check);
-        if (!parentRel) break;
-        check = parentRel->parent;
-    }
-
-    // 1. Отвязываем от старого родителя
-    if (rel.parent != entt::null) {
-        auto& oldParentRel = reg.get<tryengine::Relationship>(rel.parent);
-        oldParentRel.children--;
-
-        if (rel.prev != entt::null) {
-            reg.get<tryengine::Relationship>(rel.prev).next = rel.next;
-        } else {
-            // Если предыдущего нет, значит это был первый ребенок
-            oldParentRel.first = rel.next;
-        }
-
-        if (rel.next != entt::null) {
-            reg.get<tryengine::Relationship>(rel.next).prev = rel.prev;
-        }
-    }
-
-    // 2. Сбрасываем старые связи
-    rel.parent = newParent;
-    rel.prev = entt::null;
-    rel.next = entt::null;
-
-    // 3. Привязываем к новому родителю (вставляем в начало списка для скорости)
-    if (newParent != entt::null) {
-        auto& newParentRel = reg.get_or_emplace<tryengine::Relationship>(newParent);
-        newParentRel.children++;
-
-        if (newParentRel.first != entt::null) {
-            reg.get<tryengine::Relationship>(newParentRel.first).prev = entity;
-            rel.next = newParentRel.first;
-        }
-        newParentRel.first = entity;
-    }
+    // Защита от циклов, обновление Relationship и patch — внутри SceneGraph
+    tryengine::core::AcquireSceneGraph(reg).SetParent(reg, entity, newParent);
 }
 
 entt::entity HierarchyPanel::CloneEntity(entt::entity source, entt::registry& reg) {
     entt::entity newEntity = reg.create();
 
     for (auto [id, storage] : reg.storage()) {
-        if (storage.contains(source)) {
+        // Сигналы (например, on_construct<Transform> -> TransformDirty) могли уже добавить компонент
+        if (storage.contains(source) && !storage.contains(newEntity)) {
             storage.push(newEntity, storage.value(source));
         }
     }
@@ -254,22 +214,18 @@ entt::entity HierarchyPanel::CloneEntity(entt::entity source, entt::registry& re
     return newEntity;
 }
 void HierarchyPanel::DestroyEntityRecursive(entt::entity entity, entt::registry& reg) {
-    // Сначала отвязываем корень удаляемой ветки от дерева, чтобы избежать битых ссылок у родителя
-    ReparentEntity(entity, entt::null, reg);
-
-    // Внутренняя рекурсивная лямбда для полного уничтожения ветви
-    auto destroy_recursive = [&](auto& self, entt::entity e) -> void {
-        if (auto* rel = reg.try_get<tryengine::Relationship>(e)) {
-            entt::entity curr = rel->first;
-            while (curr != entt::null) {
-                entt::entity next = reg.get<tryengine::Relationship>(curr).next; // Сохраняем next до удаления
-                self(self, curr);
-                curr = next;
-            }
-        }
-        reg.destroy(e);
-    };
+    const auto& graph = tryengine::core::AcquireSceneGraph(reg);
 
-    destroy_recursive(destroy_recursive, entity);
+    // Сначала собираем ветвь: удаление меняет массивы детей, по которым идет обход
+    std::vector<entt::entity> subtree{entity};
+    for (size_t i = 0; i < subtree.size(); ++i) {
+        const auto children = graph.GetChildren(subtree[i]);
+        subtree.insert(subtree.end(), children.begin(), children.end());
+    }
+
+    // Листья раньше родителей — каждое удаление отвязывает от еще живого родителя
+    for (auto it = subtree.rbegin(); it != subtree.rend(); ++it) {
+        reg.destroy(*it);
+    }
 }
 }  // namespace tryeditor
@@ -61,12 +61,12 @@ void InspectorPanel::DrawAssetFooter() {
     uint64_t asset_guid = header->guid;
 
     // 2. Ищем ассет в группах
-    auto& groups = addressables_provider_.GetAddressables().GetGroups();
-    tryengine::core::AddressablesGroupAsset* found_group = nullptr;
+    const auto& groups = addressables_provider_.GetAddressables().GetGroups();
+    const tryengine::core::AddressablesGroupAsset* found_group = nullptr;
     std::string current_address = "";
 
-    for (auto& group : groups) {
-        for (auto& [addr, guid] : group.map) {
+    for (const auto& group : groups) {
+        for (const auto& [addr, guid] : group.map) {
             if (guid == asset_guid) {
                 found_group = &group;
                 current_address = addr;
@@ -105,9 +105,7 @@ void InspectorPanel::DrawAssetFooter() {
             ImGui::Text("Group: %s", found_group->name.c_str());
             ImGui::Text("Address: %s", current_address.c_str());
             if (ImGui::Button("Remove", ImVec2(-1, 0))) {
-                found_group->map.erase(current_address);
-                addressables_provider_.SaveGroup(*found_group);
-                addressables_provider_.GetAddressables().Refresh();
+                addressables_provider_.RemoveAssetFromGroup(found_group->name, current_address);
             }
         } else {
             // Логика выбора группы для нового ассета
@@ -135,9 +133,7 @@ void InspectorPanel::DrawAssetFooter() {
                 }
 
                 if (ImGui::Button("Confirm Registration", ImVec2(-1, 0))) {
-                    groups[sel_idx].map[addr_buffer] = asset_guid;
-                    addressables_provider_.SaveGroup(groups[sel_idx]);
-                    addressables_provider_.GetAddressables().Refresh();
+                    addressables_provider_.AddAssetInGroup(groups[sel_idx].name, addr_buffer, asset_guid);
                     addr_buffer[0] = '\0';          // сброс
                     show_settings_window_ = false;  // закрываем после успеха
                 }
@@ -184,12 +180,23 @@ void InspectorPanel::DrawEntityInspector(entt::registry& reg) {
         ImGui::Text("Entity ID: %u", static_cast<uint32_t>(entity));
 
         if (auto* tag = reg.try_get<tryengine::Tag>(entity)) {
-            char buffer[256];
-            memset(buffer, 0, sizeof(buffer));
-            strncpy(buffer, tag->tag.c_str(), sizeof(buffer) - 1);
-            if (ImGui::InputText("Tag", buffer, sizeof(buffer))) {
-                tag->tag = std::string(buffer);
+            // Пока поле не редактируется, буфер повторяет Tag. Интернируется только итоговая строка,
+            // а не каждый набранный префикс
+            if (!tag_editing_) {
+                memset(tag_buffer_, 0, sizeof(tag_buffer_));
+                strncpy(tag_buffer_, tag->tag.CStr(), sizeof(tag_buffer_) - 1);
+                tag_entity_ = entity;
             }
+            ImGui::InputText("Tag", tag_buffer_, sizeof(tag_buffer_));
+            tag_editing_ = ImGui::IsItemActive();
+            // Выделение могло смениться кликом, который и завершил ввод: строка принадлежит tag_entity_
+            if (ImGui::IsItemDeactivatedAfterEdit() && reg.valid(tag_entity_)) {
+                if (auto* edited = reg.try_get<tryengine::Tag>(tag_entity_)) {
+                    edited->tag = tryengine::core::StringId(tag_buffer_);
+                }
+            }
+        } else {
+            tag_editing_ = false;
         }
 
         ImGui::Separator();
@@ -216,14 +223,14 @@ void InspectorPanel::DrawEntityInspector(entt::registry& reg) {
 
 }
 
-void InspectorPanel::DrawMetaField(entt::meta_any& instance, entt::meta_data data) {
+bool InspectorPanel::DrawMetaField(entt::meta_any& instance, entt::meta_data data) {
     const char* name = data.name();
     if (!name)
-        return;
+        return false;
 
     entt::meta_any value = data.get(instance);
     if (!value)
-        return;
+        return false;
 
     ImGui::PushID(name);
     bool changed = false;
@@ -292,6 +299,7 @@ void InspectorPanel::DrawMetaField(entt::meta_any& instance, entt::meta_data dat
     }
 
     ImGui::PopID();
+    return changed;
 }
 void InspectorPanel::DrawMetaComponent(entt::registry& reg, entt::entity entity, entt::meta_type type) {
     auto id = type.id();
@@ -328,8 +336,14 @@ void InspectorPanel::DrawMetaComponent(entt::registry& reg, entt::entity entity,
         entt::meta_any instance = type.from_void(dataPtr);
 
         if (instance) {
+            bool changed = false;
             for (auto [field_id, data_member] : type.data()) {
-                DrawMetaField(instance, data_member);  // Передаем как &
+                changed |= DrawMetaField(instance, data_member);  // Передаем как &
+            }
+
+            // Правка идет мимо реестра, поэтому для Transform сигналим вручную (TransformDirty)
+            if (changed && id == entt::type_hash<tryengine::Transform>::value()) {
+                reg.patch<tryengine::Transform>(entity);
             }
         }
         ImGui::TreePop();
@@ -0,0 +1,112 @@
+#include "editor/gui/ProfilerPanel.hpp"
+
+#include <imgui.h>
+
+#include <algorithm>
+#include <filesystem>
+
+#include "engine/core/FrameArena.hpp"
+
+namespace tryeditor {
+
+using tryengine::core::Profiler;
+
+void ProfilerPanel::OnImGuiRender(entt::registry& reg) {
+    ImGui::Begin("Profiler");
+
+    // Арена не зависит от TRYENGINE_PROFILER: heap allocs должен стоять на месте в установившемся кадре
+    const auto arena = frame_arena_.GetStats();
+    ImGui::Text("Frame arena: %.1f / %.1f KB, threads: %u, heap allocs: %llu", static_cast<double>(arena.used) / 1024.0,
+                static_cast<double>(arena.capacity) / 1024.0, arena.thread_count,
+                static_cast<unsigned long long>(arena.heap_allocations));
+
+    if constexpr (!Profiler::IsCompiledIn()) {
+        ImGui::TextDisabled("Built without TRYENGINE_PROFILER");
+        ImGui::End();
+        return;
+    }
+
+    auto& profiler = Profiler::Get();
+    if (!paused_) {
+        frame_ = profiler.GetLastFrame();
+    }
+
+    ImGui::Checkbox("Pause", &paused_);
+    ImGui::SameLine();
+    if (ImGui::Button("Export Chrome Trace")) {
+        const auto path = std::filesystem::current_path() / "editor" / "profile_trace.json";
+        export_status_ = (profiler.ExportChromeTrace(path) ? "Saved " : "Failed to write ") + path.string();
+    }
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth(120.0f);
+    ImGui::SliderFloat("Zoom", &zoom_, 1.0f, 50.0f, "%.1fx", ImGuiSliderFlags_Logarithmic);
+
+    ImGui::Text("Frame: %.3f ms, zones: %zu", static_cast<double>(frame_.end_ns - frame_.begin_ns) / 1e6,
+                frame_.zones.size());
+    if (!export_status_.empty()) {
+        ImGui::TextDisabled("%s", export_status_.c_str());
+    }
+
+    ImGui::Separator();
+    ImGui::BeginChild("FlameGraph", ImVec2(0, 0), ImGuiChildFlags_None, ImGuiWindowFlags_HorizontalScrollbar);
+    DrawFlameGraph();
+    ImGui::EndChild();
+
+    ImGui::End();
+}
+
+void ProfilerPanel::DrawFlameGraph() const {
+    if (frame_.zones.empty() || frame_.end_ns <= frame_.begin_ns)
+        return;
+
+    const auto frame_ns = static_cast<double>(frame_.end_ns - frame_.begin_ns);
+    const float width = ImGui::GetContentRegionAvail().x * zoom_;
+    const float row_height = ImGui::GetTextLineHeight() + 4.0f;
+    ImDrawList* draw_list = ImGui::GetWindowDrawList();
+
+    // Зоны отсортированы по потоку — рисуем поток за потоком, глубина вложенности идет вниз
+    for (size_t first = 0; first < frame_.zones.size();) {
+        const uint32_t thread = frame_.zones[first].thread;
+        size_t last = first;
+        uint32_t max_depth = 0;
+        while (last < frame_.zones.size() && frame_.zones[last].thread == thread) {
+            max_depth = std::max(max_depth, frame_.zones[last].depth);
+            ++last;
+        }
+
+        ImGui::TextUnformatted(Profiler::Get().GetThreadName(thread).c_str());
+        const ImVec2 origin = ImGui::GetCursorScreenPos();
+
+        for (size_t i = first; i < last; ++i) {
+            const auto& zone = frame_.zones[i];
+
+            // Зона могла начаться в прошлом кадре
+            const auto begin_ns = static_cast<double>(std::max(zone.begin_ns, frame_.begin_ns) - frame_.begin_ns);
+            const auto end_ns = static_cast<double>(zone.end_ns - frame_.begin_ns);
+
+            const ImVec2 min(origin.x + static_cast<float>(begin_ns / frame_ns) * width,
+                             origin.y + static_cast<float>(zone.depth) * row_height);
+            const ImVec2 max(std::max(origin.x + static_cast<float>(end_ns / frame_ns) * width, min.x + 1.0f),
+                             min.y + row_height - 1.0f);
+
+            const float hue = static_cast<float>(tryengine::core::HashZoneName(zone.name) % 360) / 360.0f;
+            draw_list->AddRectFilled(min, max, ImColor::HSV(hue, 0.45f, 0.75f));
+
+            const char* name_begin = zone.name.data();
+            const char* name_end = name_begin + zone.name.size();
+            if (ImGui::CalcTextSize(name_begin, name_end).x + 4.0f < max.x - min.x) {
+                draw_list->AddText(ImVec2(min.x + 2.0f, min.y + 2.0f), IM_COL32_BLACK, name_begin, name_end);
+            }
+
+            if (ImGui::IsMouseHoveringRect(min, max)) {
+                ImGui::SetTooltip("%.*s\n%.3f ms", static_cast<int>(zone.name.size()), name_begin,
+                                  static_cast<double>(zone.end_ns - zone.begin_ns) / 1e6);
+            }
+        }
+
+        ImGui::Dummy(ImVec2(width, static_cast<float>(max_depth + 1) * row_height));
+        first = last;
+    }
+}
+
+}  // namespace tryeditor
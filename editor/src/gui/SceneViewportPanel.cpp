@@ -32,7 +32,7 @@ void SceneViewportPanel::HandleGizmos(entt::registry& reg) {
         }
     }
 
-    const auto view = reg.view<SelectedTag, tryengine::Transform, tryengine::Relationship>();
+    const auto view = reg.view<SelectedTag, tryengine::Transform, tryengine::WorldMatrix, tryengine::Relationship>();
     const auto selected_entity = view.front();
     if (selected_entity == entt::null || !reg.valid(selected_entity))
         return;
@@ -62,7 +62,7 @@ void SceneViewportPanel::HandleGizmos(entt::registry& reg) {
     glm::mat4 view_mat = camera.view_matrix;
     const float aspect = static_cast<float>(target_->GetWidth()) / static_cast<float>(target_->GetHeight());
     glm::mat4 proj_mat = glm::perspective(glm::radians(camera.fov), aspect, camera.near_plane, camera.far_plane);
-    glm::mat4 model_matrix = transform.world_matrix;
+    glm::mat4 model_matrix = reg.get<tryengine::WorldMatrix>(selected_entity).value;
 
     // Привязка к сетке (Snapping) по зажатому Ctrl
     bool snap = ImGui::IsKeyDown(ImGuiKey_LeftCtrl);
@@ -81,9 +81,9 @@ void SceneViewportPanel::HandleGizmos(entt::registry& reg) {
     if (ImGuizmo::IsUsing()) {
         glm::mat4 localMatrix = model_matrix;
 
-        if (relationship.parent != entt::null && reg.all_of<tryengine::Transform>(relationship.parent)) {
-            const auto& parent_transform = reg.get<tryengine::Transform>(relationship.parent);
-            localMatrix = glm::inverse(parent_transform.world_matrix) * model_matrix;
+        if (relationship.parent != entt::null && reg.all_of<tryengine::WorldMatrix>(relationship.parent)) {
+            const auto& parent_world = reg.get<tryengine::WorldMatrix>(relationship.parent);
+            localMatrix = glm::inverse(parent_world.value) * model_matrix;
         }
 
         glm::vec3 skew;
@@ -97,6 +97,7 @@ void SceneViewportPanel::HandleGizmos(entt::registry& reg) {
         transform.position = translation;
         transform.rotation = glm::normalize(orientation);
         transform.scale = scale;
+        reg.patch<tryengine::Transform>(selected_entity);
     }
 };
 }  // namespace tryeditor
\ No newline at end of file
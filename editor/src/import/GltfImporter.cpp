@@ -155,6 +155,7 @@ bool GltfImporter::GenerateArtifact(const AssetContext& asset_context, AssetMeta
         cereal::JSONOutputArchive archive(os);
         archive(cereal::make_nvp("asset_map", asset_map));
     }
+    SaveModelAssetMapBinary(asset_context.cache_dir / std::to_string(header.guid) / "hierarchy.bin", asset_map);
 
     for (const auto& key : asset_map.sub_assets | std::views::keys) {
         header.sub_assets.push_back(key);
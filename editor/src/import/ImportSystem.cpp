@@ -5,6 +5,7 @@
 #include "editor/asset_factories/AssetsFactoryManager.hpp"
 #include "editor/meta/MetaSerializer.hpp"
 #include "engine/core/RandomUtil.hpp"
+#include "engine/core/ResourceManager.hpp"
 
 namespace tryeditor {
 
@@ -61,11 +62,18 @@ void ImportSystem::Refresh() {
     ensure_dirs(game_assets_dir_, game_artifacts_dir_, game_cache_dir_);
     ensure_dirs(engine_assets_dir_, engine_artifacts_dir_, engine_cache_dir_);
 
+    // Индекс артефактов загружается до импорта: дальше он правится по папкам ассетов
+    auto& asset_database = resource_manager_.GetAssetDatabase();
+    asset_database.Refresh();
+
     id_to_path_.clear();
     path_to_id_.clear();
 
+    batching_ = true;
     ProcessDirectory(game_assets_dir_);
     ProcessDirectory(engine_assets_dir_);
+    batching_ = false;
+    asset_database.SaveIndex();
 }
 
 void ImportSystem::ProcessDirectory(const std::filesystem::path& assets_dir) {
@@ -115,6 +123,7 @@ void ImportSystem::ImportNewAsset(const AssetContext& ctx, IAssetImporter* impor
         id_to_path_[new_guid] = relative_path;
         path_to_id_[relative_path] = new_guid;
         std::cout << "[ImportSystem] Импортирован новый ассет: " << relative_path << " (GUID: " << new_guid << ")\n";
+        UpdateArtifacts(ctx, new_guid);
     }
 }
 
@@ -124,6 +133,15 @@ void ImportSystem::ReimportAsset(const AssetContext& ctx, const AssetMetaHeader&
 
     if (importer->Reimport(ctx)) {
         std::cout << "[ImportSystem] Пересобран артефакт для: " << ctx.asset_path.filename() << "\n";
+        UpdateArtifacts(ctx, header.guid);
+    }
+}
+
+void ImportSystem::UpdateArtifacts(const AssetContext& ctx, uint64_t guid) const {
+    auto& asset_database = resource_manager_.GetAssetDatabase();
+    asset_database.UpdateArtifactDir(ctx.GetArtifactDir(guid));
+    if (!batching_) {
+        asset_database.SaveIndex();
     }
 }
 
@@ -140,6 +158,13 @@ void ImportSystem::DeleteArtifactsAndCache(uint64_t id) {
             std::filesystem::remove_all(dir);
         }
     }
+
+    auto& asset_database = resource_manager_.GetAssetDatabase();
+    asset_database.RemoveArtifactDir(game_artifacts_dir_ / std::to_string(id));
+    asset_database.RemoveArtifactDir(engine_artifacts_dir_ / std::to_string(id));
+    if (!batching_) {
+        asset_database.SaveIndex();
+    }
 }
 
 void ImportSystem::DeleteAsset(const std::filesystem::path& asset_path) {
@@ -174,11 +199,14 @@ void ImportSystem::DeleteAsset(const std::filesystem::path& asset_path) {
 void ImportSystem::DeleteDirectory(const std::filesystem::path& dir_path) {
     if (!std::filesystem::exists(dir_path)) return;
 
+    batching_ = true;
     for (const auto& entry : std::filesystem::recursive_directory_iterator(dir_path)) {
         if (entry.is_regular_file() && entry.path().extension() != ".meta") {
             DeleteAsset(entry.path());
         }
     }
+    batching_ = false;
+    resource_manager_.GetAssetDatabase().SaveIndex();
     std::error_code ec;
     std::filesystem::remove_all(dir_path, ec);
 }
@@ -1,8 +1,28 @@
+#include <cstdlib>
+#include <string_view>
+
 #include "editor/EditorApp.hpp"
+#include "editor/SpawnBenchmark.hpp"
+
+int main(int argc, char** argv) {
+    const char* dump_systems = nullptr;
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        const uint32_t value = i + 1 < argc ? static_cast<uint32_t>(std::strtoul(argv[i + 1], nullptr, 10)) : 0;
+        if (arg == "--bench-spawn") {
+            return tryeditor::RunSpawnBenchmark(value == 0 ? 10000 : value);
+        }
+        if (arg == "--dump-systems" && i + 1 < argc) {
+            dump_systems = argv[++i];
+        }
+    }
 
-int main() {
     tryeditor::EditorApp editor_app;
     editor_app.Init();
     editor_app.Run();
+    // После Run: в графе тайминги последнего кадра
+    if (dump_systems) {
+        editor_app.DumpSchedulerGraph(dump_systems);
+    }
     editor_app.Shutdown();
-}
\ No newline at end of file
+}
@@ -9,6 +9,8 @@
 #include <vector>
 
 #include "engine/core/AddressablesGroupAsset.hpp"
+#include "engine/core/AddressablesIndex.hpp"
+#include "engine/core/StringId.hpp"
 
 namespace tryengine::core {
 
@@ -21,44 +23,39 @@ struct AddressablesManifestAsset {
     }
 };
 
+// Адрес -> guid ассета. Источник — JSON-манифест и файлы групп в game/project_data/addressables; для
+// рантайма они запекаются в один индекс (game/.cache/addressables.index), который при старте отображается
+// в память без разбора JSON
 class Addressables {
 public:
-    void Refresh() {
-        addressables_groups_.clear();
-        auto proj_dir = std::filesystem::current_path() / "game" / "project_data";
+    // Запеченный индекс, если он собран из текущих JSON; иначе разбор манифеста и групп и перезапись индекса
+    void Refresh();
 
-        AddressablesManifestAsset asset;
-        {
-            std::ifstream is(proj_dir / "addressables" / "addressables.addressables");
-            cereal::JSONInputArchive archive(is);
-            archive(asset);
-        }
-        for (auto& asset_group_name : asset.asset_groups) {
-            AddressablesGroupAsset asset_group_asset;
-            {
-                std::ifstream is(proj_dir / "addressables" / "asset_groups" / (asset_group_name + ".asset_group"));
-                cereal::JSONInputArchive archive(is);
-                archive(asset_group_asset);
-            }
-            std::cout << "[Addressables]: added asset group " << asset_group_asset.name << std::endl;
-            addressables_groups_.push_back(asset_group_asset);
-        }
-    }
+    uint64_t Get(std::string_view address) const;
+    // Без строки: "level_1"_sid считается при компиляции. 0 — адреса нет
+    [[nodiscard]] uint64_t Get(StringId address) const { return index_.Find(address); }
 
-    uint64_t Get(std::string_view address) {
-        for (const auto& group : addressables_groups_) {
-            auto it = group.map.find(std::string(address));
-            if (it != group.map.end()) {
-                return it->second;
-            }
-        }
-        std::cerr << "[Addressables]: Could not find " << address << std::endl;
-        return 0;
-    }
+    // Группы в порядке манифеста. После старта с запеченного индекса JSON групп читается при первом обращении
+    const std::vector<AddressablesGroupAsset>& GetGroups();
+    const AddressablesGroupAsset* FindGroup(std::string_view name);
 
-    std::vector<AddressablesGroupAsset>& GetGroups() { return addressables_groups_; }
+    // Правки редактора: группы в памяти и индекс меняются на месте, файлы не перечитываются.
+    // Сохранять JSON — дело вызывающего
+    void AddGroup(const AddressablesGroupAsset& group);
+    void RemoveGroup(std::string_view name);
+    // Группы name нет — создается в конце
+    void SetAddress(std::string_view group, std::string_view address, uint64_t guid);
+    void RemoveAddress(std::string_view group, std::string_view address);
 
 private:
+    void LoadGroups();
+    // Индекс после правки адреса: guid из первой группы, где адрес есть
+    void UpdateAddress(std::string_view address);
+    AddressablesGroupAsset* FindGroupMutable(std::string_view name);
+
     std::vector<AddressablesGroupAsset> addressables_groups_;
+    // Без Refresh групп нет, а не "еще не прочитаны"
+    bool groups_loaded_ = true;
+    AddressablesIndex index_;
 };
 }  // namespace tryengine::core
\ No newline at end of file
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "engine/core/AddressablesGroupAsset.hpp"
+#include "engine/core/MappedFile.hpp"
+#include "engine/core/StringId.hpp"
+
+namespace tryengine::core {
+
+// Запеченный индекс адресов: заголовок, таблица слотов с открытой адресацией (ключ — HashString адреса,
+// заполнена не больше чем наполовину), затем текст адресов. Секции выровнены на 64 байта, файл
+// читается из отображения без разбора
+inline constexpr uint32_t kCookedAddressablesVersion = 1;
+
+struct CookedAddressablesHeader {
+    char magic[4] = {'T', 'A', 'D', 'R'};
+    uint32_t version = kCookedAddressablesVersion;
+    // Отпечаток исходных JSON (имена, размеры, время записи): не совпал — индекс устарел
+    uint64_t source_stamp = 0;
+    uint64_t entry_count = 0;
+    // Степень двойки
+    uint64_t slot_count = 0;
+    uint64_t slots_offset = 0;
+    uint64_t text_offset = 0;
+    uint64_t text_size = 0;
+};
+
+struct CookedAddressSlot {
+    // 0 — пустой слот
+    uint64_t id = 0;
+    uint64_t guid = 0;
+    uint32_t text_offset = 0;
+    uint32_t text_size = 0;
+};
+
+// Адрес -> guid по всем группам сразу. Поиск — одна цепочка проб без выделений памяти. Открывается
+// из запеченного файла или строится из групп; правки (Set/Erase) переносят таблицу из отображения в память
+class AddressablesIndex {
+public:
+    // Адрес из нескольких групп берется из первой
+    void Build(std::span<const AddressablesGroupAsset> groups);
+
+    // false — файла нет, он битый, другой версии или собран из других исходников
+    bool Open(const std::filesystem::path& path, uint64_t source_stamp);
+    bool Write(const std::filesystem::path& path, uint64_t source_stamp) const;
+
+    // 0 — адреса нет. Поиск по строке сверяет и текст, по StringId — только id
+    [[nodiscard]] uint64_t Find(std::string_view address) const;
+    [[nodiscard]] uint64_t Find(StringId address) const;
+
+    void Set(std::string_view address, uint64_t guid);
+    void Erase(std::string_view address);
+
+    [[nodiscard]] size_t Size() const { return count_; }
+
+private:
+    static constexpr size_t kNoSlot = static_cast<size_t>(-1);
+
+    [[nodiscard]] size_t FindIndex(uint64_t id) const;
+    [[nodiscard]] std::string_view SlotText(const CookedAddressSlot& slot) const;
+    void Detach();
+    void Grow(size_t slot_count);
+    void Insert(uint64_t id, std::string_view address, uint64_t guid);
+    // Слоты и текст в памяти могли переехать — обновляет представления
+    void Rebind();
+
+    // Представления над отображенным файлом или над own_slots_ и own_text_
+    std::span<const CookedAddressSlot> slots_;
+    std::string_view text_;
+    size_t count_ = 0;
+
+    MappedFile file_;
+    bool owned_ = false;
+    std::vector<CookedAddressSlot> own_slots_;
+    // Текст удаленных адресов остается до записи в файл
+    std::vector<char> own_text_;
+};
+
+}  // namespace tryengine::core
@@ -10,24 +10,77 @@ namespace tryengine::core {
 
 using AssetID = uint64_t;
 
+// Индекс артефактов на диске: заголовок, записи (ArtifactIndexEntry), затем текст путей. Секции выровнены
+// на 64 байта
+inline constexpr uint32_t kArtifactIndexVersion = 1;
+
+struct ArtifactIndexHeader {
+    char magic[4] = {'T', 'A', 'R', 'T'};
+    uint32_t version = kArtifactIndexVersion;
+    // Отпечаток корней artifacts (путь и время записи каталога): папку GUID создали или удалили в обход
+    // конвейера импорта — индекс устарел
+    uint64_t roots_stamp = 0;
+    uint64_t entry_count = 0;
+    uint64_t entries_offset = 0;
+    uint64_t text_offset = 0;
+    uint64_t text_size = 0;
+};
+
+struct ArtifactIndexEntry {
+    uint64_t id = 0;
+    uint64_t size = 0;
+    // file_time_type::time_since_epoch().count()
+    int64_t write_time = 0;
+    uint32_t path_offset = 0;
+    uint32_t path_size = 0;
+};
+
 class AssetDatabase {
 public:
     AssetDatabase() = default;
 
+    // Индекс из game/.cache, если корни artifacts не менялись с его записи; иначе обход папок и новый индекс.
+    // Изменения внутри папок GUID видит только конвейер импорта — через UpdateArtifactDir
     void Refresh();
+    // Полный обход папок artifacts
+    void Rescan();
+
+    // Инкрементальное обновление после импорта: записи папки GUID заменяются ее текущими файлами
+    void UpdateArtifactDir(const std::filesystem::path& dir);
+    void RemoveArtifactDir(const std::filesystem::path& dir);
+    // Пишет индекс, если что-то менялось с загрузки или прошлой записи
+    bool SaveIndex();
+
+    // Артефакт вне папок artifacts (сгенерированные сцены бенчмарков). В индекс не попадает, Refresh сбрасывает
+    void Register(AssetID id, const std::filesystem::path& path) { artifacts_[id] = {path.string(), 0, 0, false}; }
 
     std::string GetPath(AssetID id) const {
-        auto it = id_to_path_.find(id);
+        auto it = artifacts_.find(id);
 
-        if (it == id_to_path_.end()) {
+        if (it == artifacts_.end()) {
             std::cerr << "ASSET DATABASE: Warning: Path to asset with id = " << id << " not found!" << std::endl;
             return "";
         }
 
-        return it->second;
+        return it->second.path;
     }
 
 private:
+    struct Artifact {
+        // Относительно корня проекта
+        std::string path;
+        uint64_t size = 0;
+        int64_t write_time = 0;
+        bool indexed = true;
+    };
+
+    bool LoadIndex();
+    uint64_t GetRootsStamp() const;
+    // Файлы одной папки GUID; prefix — ее путь относительно корня проекта с разделителем на конце
+    void ScanArtifactDir(const std::filesystem::path& dir, const std::string& prefix);
+    void EraseArtifactDir(const std::string& prefix);
+    [[nodiscard]] std::string GetRelativeDir(const std::filesystem::path& dir) const;
+
     const std::filesystem::path root_path_ = std::filesystem::current_path();
 
     // Массив директорий для поиска артефактов
@@ -35,8 +88,10 @@ private:
         root_path_ / "game" / "artifacts",
         root_path_ / "engine_content" / "artifacts"
     };
+    const std::filesystem::path index_path_ = root_path_ / "game" / ".cache" / "artifacts.index";
 
-    std::unordered_map<AssetID, std::string> id_to_path_;
+    std::unordered_map<AssetID, Artifact> artifacts_;
+    bool index_dirty_ = false;
 };
 
-} // namespace tryengine::core
\ No newline at end of file
+} // namespace tryengine::core
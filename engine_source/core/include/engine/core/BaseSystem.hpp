@@ -1,8 +1,15 @@
 #pragma once
 
+#include <cstdint>
 #include <entt/entity/registry.hpp>
 
 namespace tryengine::core {
+class JobSystem;
+
 void UpdateTransformSystem(entt::registry& reg);
+// Уровни иерархии обрабатываются по очереди, сущности внутри уровня — параллельно в JobSystem
+void UpdateTransformSystem(entt::registry& reg, JobSystem& jobs);
+// Сколько world_matrix пересчитано последним UpdateTransformSystem (пересчитываются только помеченные TransformDirty и их потомки)
+uint32_t GetUpdatedTransformCount(const entt::registry& reg);
 void UpdateCameraMatrices(entt::registry& reg);
-}
\ No newline at end of file
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace tryengine::core {
+
+// Побитовая запись для сетевых снапшотов. Биты идут от младшего к старшему, без выравнивания по байтам
+class BitWriter {
+public:
+    // count <= 64; лишние старшие биты value отбрасываются
+    void WriteBits(uint64_t value, uint32_t count);
+    void WriteBool(bool value) { WriteBits(value ? 1 : 0, 1); }
+
+    // LEB128 поверх битов: 7 бит данных + бит продолжения. Маленькие числа — 8 бит
+    void WriteVarUint(uint64_t value);
+    // Zig-zag: малые по модулю отрицательные тоже короткие
+    void WriteVarInt(int64_t value);
+
+    // Фиксированная точка с шагом step, дальше WriteVarInt. Значения около нуля занимают мало бит
+    void WriteQuantized(float value, float step);
+    // [min, max] в bits бит. Значения вне диапазона прижимаются к краям
+    void WriteRanged(float value, float min, float max, uint32_t bits);
+
+    // Дописывает неполный байт. После Finish писать можно дальше, но с новой границы байта
+    std::span<const uint8_t> Finish();
+
+    [[nodiscard]] size_t GetBitCount() const { return bytes_.size() * 8 + scratch_bits_; }
+    void Clear();
+
+private:
+    std::vector<uint8_t> bytes_;
+    uint64_t scratch_ = 0;
+    uint32_t scratch_bits_ = 0;
+};
+
+// Чтение того, что записал BitWriter. Данные из сети: при выходе за конец буфера чтение возвращает нули
+// и выставляет IsOverflowed — проверять после разбора, а не на каждом поле
+class BitReader {
+public:
+    explicit BitReader(std::span<const uint8_t> data) : data_(data) {}
+
+    uint64_t ReadBits(uint32_t count);
+    bool ReadBool() { return ReadBits(1) != 0; }
+
+    uint64_t ReadVarUint();
+    int64_t ReadVarInt();
+
+    float ReadQuantized(float step);
+    float ReadRanged(float min, float max, uint32_t bits);
+
+    [[nodiscard]] bool IsOverflowed() const { return overflowed_; }
+    [[nodiscard]] size_t GetBitPosition() const { return position_; }
+    [[nodiscard]] size_t GetBitsLeft() const { return data_.size() * 8 - position_; }
+
+private:
+    std::span<const uint8_t> data_;
+    size_t position_ = 0;
+    bool overflowed_ = false;
+};
+
+}  // namespace tryengine::core
@@ -1,14 +1,82 @@
 #pragma once
 
+#include <algorithm>
 #include <cereal/archives/binary.hpp>
 #include <cereal/archives/json.hpp>
+#include <cstddef>
+#include <cstring>
 #include <entt/entt.hpp>
 #include <functional>
+#include <istream>
+#include <span>
+#include <sstream>
 #include <string>
+#include <type_traits>
 #include <vector>
 
+#include "engine/core/BitStream.hpp"
+#include "engine/core/MappedFile.hpp"
+
 namespace tryengine::core {
 
+class ResourceManager;
+
+// Компонент, который реплицируется снапшотами (SnapshotCodec). Значения хранятся в снапшоте как байты T,
+// поэтому T тривиально копируемый; на горячем пути вызовы идут через указатели на функции, без std::function
+struct ReplicatedComponent {
+    std::string name;
+    size_t size = 0;
+    // Сущности пула по возрастанию и их значения подряд
+    void (*capture)(const entt::registry&, std::vector<entt::entity>&, std::vector<std::byte>&) = nullptr;
+    void (*write)(BitWriter&, const std::byte*) = nullptr;
+    void (*read)(BitReader&, std::byte*) = nullptr;
+    void (*assign)(entt::registry&, entt::entity, const std::byte*) = nullptr;
+    void (*remove)(entt::registry&, entt::entity) = nullptr;
+};
+
+// Сущности исходного реестра (по индексу) -> сущности целевого, для аддитивной загрузки сцены.
+// Компоненты со ссылками на сущности переписывают их в RemapEntities(remap)
+struct EntityRemap {
+    std::vector<entt::entity> table;
+
+    [[nodiscard]] entt::entity operator()(entt::entity entity) const {
+        if (entity == entt::null)
+            return entt::null;
+        const auto index = static_cast<size_t>(entt::to_entity(entity));
+        return index < table.size() ? table[index] : entt::null;
+    }
+};
+
+// Тип пишется в запеченную сцену байтами. Тривиально копируемый тип может отказаться
+// (static constexpr bool kCookAsBytes = false), если байтов мало для восстановления: Tag хранит только id,
+// а текст должен попасть в StringTable при загрузке
+template <typename T>
+constexpr bool kCookAsBytes = std::is_trivially_copyable_v<T> && !requires { requires !T::kCookAsBytes; };
+
+// Пул компонента в запеченной сцене (SceneFormat). Типы с kCookAsBytes лежат в файле массивом
+// как есть и вставляются в EnTT пачкой (копируются все поля, не только те, что пишет serialize);
+// остальные (Tag, ссылки на ресурсы) — поэлементно через cereal
+struct CookedComponent {
+    std::string name;
+    // FNV-1a от имени — ключ пула в файле
+    uint32_t name_hash = 0;
+    bool raw = false;
+    // sizeof(T) для сырых непустых типов, иначе 0
+    uint32_t size = 0;
+    // Сущности в порядке упакованного массива и данные для них
+    void (*save)(const entt::registry&, std::vector<entt::entity>&, std::vector<std::byte>&) = nullptr;
+    // false — данные битые
+    bool (*load)(entt::registry&, std::span<const entt::entity>, std::span<const std::byte>) = nullptr;
+    // Создает пул заранее: пока пулы грузятся параллельно, набор пулов в реестре меняться не должен
+    void (*prepare)(entt::registry&) = nullptr;
+    // Резолв ссылок на ресурсы у только что загруженных сущностей; nullptr — у типа нет Resolve
+    void (*resolve)(entt::registry&, std::span<const entt::entity>, ResourceManager&) = nullptr;
+    // Копирует компонент тех entities из from, у которых он есть, в to; сущности — через remap.
+    // Аддитивная загрузка зовет частями между кадрами, нарезка уровня на ячейки — по сущностям ячейки
+    void (*merge)(const entt::registry& from, entt::registry& to, std::span<const entt::entity> entities,
+                  const EntityRemap& remap) = nullptr;
+};
+
 class ComponentRegistry {
 public:
     template <typename T>
@@ -52,8 +120,24 @@ public:
                 }
             });
         }
+
+        if constexpr (requires(const T& t, T& m, BitWriter& w, BitReader& r) {
+                          t.NetWrite(w);
+                          m.NetRead(r);
+                      }) {
+            static_assert(std::is_trivially_copyable_v<T> && !std::is_empty_v<T>,
+                          "Replicated components are stored as raw bytes in snapshots");
+            replicated_.push_back(MakeReplicated<T>(name));
+        }
+
+        cooked_.push_back(MakeCooked<T>(name));
     }
 
+    [[nodiscard]] const std::vector<CookedComponent>& GetCookedComponents() const { return cooked_; }
+
+    // Порядок — часть сетевого протокола: у клиента и сервера регистрация должна совпадать
+    [[nodiscard]] const std::vector<ReplicatedComponent>& GetReplicatedComponents() const { return replicated_; }
+
     void ResolveAll(entt::registry& reg, ResourceManager& rm, entt::entity target_entity = entt::null) const {
         for (const auto& resolve_fn : resolvers_) {
             resolve_fn(reg, rm, target_entity);
@@ -110,6 +194,161 @@ public:
     }
 
 private:
+    template <typename T>
+    static ReplicatedComponent MakeReplicated(const std::string& name) {
+        ReplicatedComponent info;
+        info.name = name;
+        info.size = sizeof(T);
+        info.capture = [](const entt::registry& reg, std::vector<entt::entity>& entities,
+                          std::vector<std::byte>& values) {
+            entities.clear();
+            values.clear();
+            const auto* storage = reg.storage<T>();
+            if (!storage)
+                return;
+
+            const entt::sparse_set& base = *storage;
+            entities.assign(base.begin(), base.end());
+            std::sort(entities.begin(), entities.end());
+
+            values.resize(entities.size() * sizeof(T));
+            for (size_t i = 0; i < entities.size(); ++i) {
+                std::memcpy(values.data() + i * sizeof(T), &storage->get(entities[i]), sizeof(T));
+            }
+        };
+        info.write = [](BitWriter& writer, const std::byte* data) {
+            T value;
+            std::memcpy(&value, data, sizeof(T));
+            value.NetWrite(writer);
+        };
+        info.read = [](BitReader& reader, std::byte* data) {
+            T value{};
+            value.NetRead(reader);
+            std::memcpy(data, &value, sizeof(T));
+        };
+        info.assign = [](entt::registry& reg, entt::entity entity, const std::byte* data) {
+            T value;
+            std::memcpy(&value, data, sizeof(T));
+            reg.emplace_or_replace<T>(entity, value);
+        };
+        info.remove = [](entt::registry& reg, entt::entity entity) { reg.remove<T>(entity); };
+        return info;
+    }
+
+    template <typename T>
+    static CookedComponent MakeCooked(const std::string& name) {
+        CookedComponent info;
+        info.name = name;
+        info.name_hash = HashComponentName(name);
+        info.raw = kCookAsBytes<T>;
+        info.size = kCookAsBytes<T> && !std::is_empty_v<T> ? sizeof(T) : 0;
+
+        info.save = [](const entt::registry& reg, std::vector<entt::entity>& entities, std::vector<std::byte>& data) {
+            entities.clear();
+            data.clear();
+            const auto* storage = reg.storage<T>();
+            if (!storage)
+                return;
+
+            const entt::sparse_set& base = *storage;
+            entities.assign(base.data(), base.data() + base.size());
+
+            if constexpr (std::is_empty_v<T>) {
+                return;
+            } else if constexpr (kCookAsBytes<T>) {
+                data.resize(entities.size() * sizeof(T));
+                for (size_t i = 0; i < entities.size(); ++i) {
+                    std::memcpy(data.data() + i * sizeof(T), &storage->get(entities[i]), sizeof(T));
+                }
+            } else {
+                std::ostringstream os(std::ios::binary);
+                {
+                    cereal::BinaryOutputArchive archive(os);
+                    for (const auto entity : entities) {
+                        archive(storage->get(entity));
+                    }
+                }
+                const std::string bytes = os.str();
+                data.resize(bytes.size());
+                std::memcpy(data.data(), bytes.data(), bytes.size());
+            }
+        };
+
+        info.load = [](entt::registry& reg, std::span<const entt::entity> entities, std::span<const std::byte> data) {
+            auto& storage = reg.storage<T>();
+            storage.reserve(storage.size() + entities.size());
+
+            if constexpr (std::is_empty_v<T>) {
+                reg.insert<T>(entities.begin(), entities.end());
+                return true;
+            } else if constexpr (kCookAsBytes<T>) {
+                if (data.size() != entities.size() * sizeof(T))
+                    return false;
+                // Выравнивание секций проверено при разборе файла
+                const auto* values = reinterpret_cast<const T*>(data.data());
+                reg.insert<T>(entities.begin(), entities.end(), values);
+                return true;
+            } else {
+                MemoryStreamBuf buffer(data);
+                std::istream is(&buffer);
+                try {
+                    cereal::BinaryInputArchive archive(is);
+                    for (const auto entity : entities) {
+                        T value{};
+                        archive(value);
+                        reg.emplace<T>(entity, std::move(value));
+                    }
+                } catch (const cereal::Exception&) {
+                    return false;
+                }
+                return true;
+            }
+        };
+
+        info.prepare = [](entt::registry& reg) { static_cast<void>(reg.storage<T>()); };
+
+        info.merge = [](const entt::registry& from, entt::registry& to, std::span<const entt::entity> entities,
+                        const EntityRemap& remap) {
+            const auto* storage = from.storage<T>();
+            if (!storage)
+                return;
+
+            for (const auto entity : entities) {
+                if (!storage->contains(entity))
+                    continue;
+                if constexpr (std::is_empty_v<T>) {
+                    to.emplace<T>(remap(entity));
+                } else {
+                    T value = storage->get(entity);
+                    if constexpr (requires(T& t) { t.RemapEntities(remap); }) {
+                        value.RemapEntities(remap);
+                    }
+                    to.emplace<T>(remap(entity), std::move(value));
+                }
+            }
+        };
+
+        if constexpr (requires(T& t, ResourceManager& rm) { t.Resolve(rm); }) {
+            info.resolve = [](entt::registry& reg, std::span<const entt::entity> entities, ResourceManager& rm) {
+                auto& storage = reg.storage<T>();
+                for (const auto entity : entities) {
+                    storage.get(entity).Resolve(rm);
+                }
+            };
+        }
+        return info;
+    }
+
+    // FNV-1a
+    static uint32_t HashComponentName(const std::string& name) {
+        uint32_t hash = 2166136261u;
+        for (const char c : name) {
+            hash ^= static_cast<uint8_t>(c);
+            hash *= 16777619u;
+        }
+        return hash;
+    }
+
     using JsonSaveFn = std::function<void(entt::snapshot&, cereal::JSONOutputArchive&)>;
     using JsonLoadFn = std::function<void(entt::snapshot_loader&, cereal::JSONInputArchive&)>;
     using BinSaveFn = std::function<void(entt::snapshot&, cereal::BinaryOutputArchive&)>;
@@ -123,6 +362,13 @@ private:
     std::vector<BinLoadFn> binary_deserializers_;
 
     std::vector<ResolveFn> resolvers_;  // Храним резолверы
+    std::vector<ReplicatedComponent> replicated_;
+    std::vector<CookedComponent> cooked_;
 };
 
+// Компоненты движка в каноническом порядке бинарного формата сцены.
+// Приложения (редактор) регистрируют свои компоненты после — тогда сцену прочитает и headless-сервер,
+// которому о них знать не нужно: хвост архива он просто не читает.
+void RegisterEngineComponents(ComponentRegistry& registry);
+
 }  // namespace tryengine::core
\ No newline at end of file
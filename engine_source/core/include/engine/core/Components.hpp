@@ -1,11 +1,16 @@
 #pragma once
 
+#include <cereal/types/string.hpp>
 #include <entt/entity/entity.hpp>
 #include <entt/resource/resource.hpp>
+#include <string>
+#include <string_view>
 #include <utility>
 
 #include "engine/core/GLMSerialization.hpp"
+#include "engine/core/NetQuantize.hpp"
 #include "engine/core/ResourceManager.hpp"
+#include "engine/core/StringId.hpp"
 
 namespace tryengine {
 
@@ -52,6 +57,8 @@ struct LightComponent {
     float radius{10.0f};                // Радиус освещения (Attenuation)
 };
 
+// Связный список иерархии — производное представление SceneGraph (для сериализации и инспектора).
+// Менять родителя только через SceneGraph::SetParent, иначе граф и список разойдутся.
 struct Relationship {
     std::size_t children{};
     entt::entity first{entt::null};
@@ -59,6 +66,15 @@ struct Relationship {
     entt::entity next{entt::null};
     entt::entity parent{entt::null};
 
+    // Аддитивная загрузка сцены: ссылки на сущности исходной сцены -> сущности мира
+    template <typename Remap>
+    void RemapEntities(const Remap& remap) {
+        first = remap(first);
+        prev = remap(prev);
+        next = remap(next);
+        parent = remap(parent);
+    }
+
     template <class Archive>
     void serialize(Archive& ar) {
         ar(cereal::make_nvp("children", children));
@@ -74,14 +90,11 @@ struct Transform {
     glm::quat rotation{1.0f, 0.0f, 0.0f, 0.0f};
     glm::vec3 scale{1.0f};
 
-    glm::mat4 world_matrix{1.0f};
-
+    // T * R * S без промежуточных 4x4 умножений. Пакетная версия — ComposeWorldMatrices (TransformMath.hpp)
     glm::mat4 GetLocalMatrix() const {
-        glm::mat4 model = glm::mat4(1.0f);
-        model = translate(model, position);
-        model *= mat4_cast(rotation);
-        model = glm::scale(model, scale);
-        return model;
+        const glm::mat3 rot = glm::mat3_cast(rotation);
+        return {glm::vec4(rot[0] * scale.x, 0.0f), glm::vec4(rot[1] * scale.y, 0.0f), glm::vec4(rot[2] * scale.z, 0.0f),
+                glm::vec4(position, 1.0f)};
     }
 
     template <class Archive>
@@ -89,23 +102,68 @@ struct Transform {
         archive(cereal::make_nvp("position", position), cereal::make_nvp("rotation", rotation),
                 cereal::make_nvp("scale", scale));
     }
+
+    // Репликация (SnapshotCodec): позиция с шагом kPositionStep, поворот smallest three,
+    // единичный масштаб — один бит
+    void NetWrite(core::BitWriter& writer) const {
+        core::WriteVec3(writer, position, core::kPositionStep);
+        core::WriteRotation(writer, rotation);
+
+        const bool unit_scale = scale == glm::vec3(1.0f);
+        writer.WriteBool(unit_scale);
+        if (!unit_scale) {
+            core::WriteVec3(writer, scale, kScaleStep);
+        }
+    }
+
+    void NetRead(core::BitReader& reader) {
+        position = core::ReadVec3(reader, core::kPositionStep);
+        rotation = core::ReadRotation(reader);
+        scale = reader.ReadBool() ? glm::vec3(1.0f) : core::ReadVec3(reader, kScaleStep);
+    }
+
+    static constexpr float kScaleStep = 1.0f / 1024.0f;
+};
+
+// Мировая матрица, считается UpdateTransformSystem из Transform и родителя. Живет отдельным компонентом,
+// чтобы рендер и камеры шли по плотному массиву матриц, а гизмо/скрипты/сериализация — только по TRS.
+// Добавляется и удаляется вместе с Transform автоматически (см. AcquireTransformHierarchy).
+struct WorldMatrix {
+    glm::mat4 value{1.0f};
 };
 
+// Метка "локальный трансформ изменился". Ставится сигналами on_construct/on_update<Transform>,
+// поэтому код, меняющий Transform по ссылке, должен вызвать reg.patch<Transform>(entity)
+struct TransformDirty {};
+
 struct AABB {
     glm::vec3 world_min;
     glm::vec3 world_max;
 };
 
+// Имя сущности — интернированная строка: 8 байт вместо std::string, одинаковые имена узлов моделей
+// хранятся в StringTable один раз
 struct Tag {
+    // В запеченной сцене пишется текстом: id без строки в таблице не даст View
+    static constexpr bool kCookAsBytes = false;
+
     Tag() = default;
 
-    Tag(std::string t) : tag(std::move(t)) {}
+    Tag(std::string_view t) : tag(t) {}
+    Tag(core::StringId id) : tag(id) {}
 
-    std::string tag;
+    core::StringId tag;
 
     template <class Archive>
-    void serialize(Archive& archive) {
-        archive(cereal::make_nvp("tag", tag));
+    void save(Archive& archive) const {
+        archive(cereal::make_nvp("tag", std::string(tag.View())));
+    }
+
+    template <class Archive>
+    void load(Archive& archive) {
+        std::string text;
+        archive(cereal::make_nvp("tag", text));
+        tag = core::StringId(text);
     }
 };
 
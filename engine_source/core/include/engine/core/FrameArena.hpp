@@ -0,0 +1,145 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+
+namespace tryengine::core {
+
+// Линейный (bump) аллокатор. Освобождение только целиком через Reset.
+// Не потокобезопасен — у каждого потока свой (см. FrameArena::Local).
+class LinearArena {
+public:
+    explicit LinearArena(size_t block_size);
+
+    LinearArena(const LinearArena&) = delete;
+    LinearArena& operator=(const LinearArena&) = delete;
+
+    void* Allocate(size_t size, size_t alignment);
+
+    // Сырой массив без конструирования — для тривиальных типов
+    template <typename T>
+    T* AllocateArray(size_t count) {
+        return static_cast<T*>(Allocate(sizeof(T) * count, alignof(T)));
+    }
+
+    // Если кадр не влез в один блок, блоки сливаются в один по суммарному размеру:
+    // со следующего кадра аллокаций в куче нет
+    void Reset();
+
+    [[nodiscard]] size_t GetUsed() const { return used_; }
+    [[nodiscard]] size_t GetCapacity() const { return capacity_; }
+    // Сколько раз арена ходила в кучу за блоками за все время
+    [[nodiscard]] uint64_t GetHeapAllocations() const { return heap_allocations_; }
+
+private:
+    struct Block {
+        std::unique_ptr<std::byte[]> data;
+        size_t size = 0;
+    };
+
+    void AddBlock(size_t min_size);
+
+    std::vector<Block> blocks_;
+    size_t block_size_;
+    size_t current_ = 0;
+    size_t offset_ = 0;
+    size_t used_ = 0;
+    size_t capacity_ = 0;
+    uint64_t heap_allocations_ = 0;
+};
+
+// Адаптер для контейнеров STL. deallocate ничего не делает — память вернется при Reset арены.
+// Аллокатор переезжает вместе с содержимым при присваивании и swap: vector = MakeVector() берет арену
+// нового кадра, а не продолжает выделять из старой
+template <typename T>
+class ArenaAllocator {
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    explicit ArenaAllocator(LinearArena& arena) noexcept : arena_(&arena) {}
+
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept : arena_(other.GetArena()) {}
+
+    T* allocate(size_t count) { return arena_->AllocateArray<T>(count); }
+    void deallocate(T*, size_t) noexcept {}
+
+    [[nodiscard]] LinearArena* GetArena() const noexcept { return arena_; }
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U>& other) const noexcept {
+        return arena_ == other.GetArena();
+    }
+
+private:
+    LinearArena* arena_;
+};
+
+template <typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+// Память на один кадр. Два буфера: NextFrame сбрасывает тот, что был текущим два кадра назад,
+// поэтому данные прошлого кадра еще живы, пока их дочитывает рендер.
+// У каждого потока свои арены (аллокация без блокировок), потоки регистрируются при первом обращении.
+class FrameArena {
+public:
+    static constexpr uint32_t kFrameCount = 2;
+
+    struct Stats {
+        size_t used = 0;
+        size_t capacity = 0;
+        uint64_t heap_allocations = 0;
+        uint32_t thread_count = 0;
+    };
+
+    explicit FrameArena(size_t block_size = 256 * 1024);
+    ~FrameArena();
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    // Арена текущего кадра для вызывающего потока
+    LinearArena& Local();
+
+    void* Allocate(size_t size, size_t alignment) { return Local().Allocate(size, alignment); }
+
+    template <typename T>
+    ArenaAllocator<T> MakeAllocator() {
+        return ArenaAllocator<T>(Local());
+    }
+
+    template <typename T>
+    ArenaVector<T> MakeVector() {
+        return ArenaVector<T>(MakeAllocator<T>());
+    }
+
+    // Граница кадра. Вызывать с главного потока, когда задачи кадра уже не аллоцируют
+    void NextFrame();
+
+    [[nodiscard]] uint32_t GetFrameIndex() const { return frame_; }
+    // Текущий кадр по всем потокам
+    [[nodiscard]] Stats GetStats() const;
+
+private:
+    struct ThreadArenas;
+
+    ThreadArenas& Register();
+
+    // Уникален на процесс: кэш потока не спутает арену с новой, созданной по тому же адресу
+    uint64_t id_;
+    size_t block_size_;
+    uint32_t frame_ = 0;
+
+    mutable std::mutex mutex_;
+    std::vector<std::unique_ptr<ThreadArenas>> threads_;
+};
+
+}  // namespace tryengine::core
@@ -1,8 +1,8 @@
 #pragma once
 
-#include <entt/resource/cache.hpp>
 #include <entt/resource/resource.hpp>
 #include <string>
+#include <unordered_map>
 
 namespace tryengine::core {
 class ICacheBase {
@@ -15,34 +15,49 @@ class ICacheBase {
 template <typename T>
 class ITypedCache : public ICacheBase {
    public:
-    // Возвращает хэндл. Если нет в кэше — загрузит.
-    virtual entt::resource<T> GetOrLoad(uint64_t id, uint64_t id2, const std::string& path) = 0;
+    // Ищет хэндл в кэше. false — ресурс еще не загружался (пустой хэндл после неудачной загрузки тоже хранится)
+    virtual bool Find(uint64_t id, entt::resource<T>& out) const = 0;
+    // Только вызывает лоадер, в кэш не кладет — ResourceManager зовет его без блокировки
+    virtual entt::resource<T> Load(uint64_t id, const std::string& path) const = 0;
+    virtual void Store(uint64_t id, entt::resource<T> resource) = 0;
 };
 
 template <typename T, typename Loader>
 class CacheImpl : public ITypedCache<T> {
     // Теперь используем реальный Лоадер как часть типа кэша
-    entt::resource_cache<T, Loader> cache_;
+    Loader loader_;
+    std::unordered_map<uint64_t, entt::resource<T>> resources_;
 
    public:
     // Конструируем кэш, передавая ему настроенный лоадер
-    explicit CacheImpl(Loader&& loader) : cache_(std::move(loader)) {}
+    explicit CacheImpl(Loader&& loader) : loader_(std::move(loader)) {}
 
-    entt::resource<T> GetOrLoad(uint64_t id,uint64_t id2, const std::string& path) override {
-        // .first — это итератор на ресурс, .second — флаг "был ли загружен"
-        return cache_.load(id,id, path).first->second;
+    bool Find(uint64_t id, entt::resource<T>& out) const override {
+        const auto it = resources_.find(id);
+        if (it == resources_.end())
+            return false;
+        out = it->second;
+        return true;
+    }
+
+    entt::resource<T> Load(uint64_t id, const std::string& path) const override {
+        return entt::resource<T>{loader_(id, path)};
+    }
+
+    void Store(uint64_t id, entt::resource<T> resource) override {
+        resources_.insert_or_assign(id, std::move(resource));
     }
 
     //TODO: подумать над улучшениями
     void Purge() override {
-        for (auto it = cache_.begin(); it != cache_.end();) {
+        for (auto it = resources_.begin(); it != resources_.end();) {
             // .handle() возвращает ссылку на внутренний std::shared_ptr
             if (it->second.handle().use_count() <= 1) {
-                it = cache_.erase(it);
+                it = resources_.erase(it);
             } else {
                 ++it;
             }
         }
     }
 };
-}  // namespace tryengine::resources
\ No newline at end of file
+}  // namespace tryengine::core
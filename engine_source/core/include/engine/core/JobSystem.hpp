@@ -0,0 +1,117 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace tryengine::core {
+
+class JobSystem;
+
+// Счетчик незавершенных задач. Задача, запущенная с counter, увеличивает его при постановке
+// и уменьшает по завершении. На счетчик можно ждать (JobSystem::Wait) и вешать зависимые задачи (RunAfter).
+class JobCounter {
+public:
+    JobCounter() = default;
+    JobCounter(const JobCounter&) = delete;
+    JobCounter& operator=(const JobCounter&) = delete;
+
+    [[nodiscard]] bool IsDone() const { return pending_.load(std::memory_order_acquire) == 0; }
+
+private:
+    friend class JobSystem;
+
+    std::atomic<uint32_t> pending_{0};
+    std::mutex mutex_;
+    // Задачи, ждущие обнуления счетчика
+    std::vector<std::function<void()>> continuations_;
+};
+
+// Планировщик задач с кражей работы: у каждого потока (воркеры + главный) своя очередь,
+// владелец берет задачи с конца (LIFO, теплый кэш), простаивающие потоки крадут с начала.
+// Главный поток — тот, что создал JobSystem; задачи RunOnMainThread выполняются только им
+// (в PumpMainThread или пока он ждет в Wait).
+class JobSystem {
+public:
+    using JobFn = std::function<void()>;
+    using RangeFn = std::function<void(size_t begin, size_t end)>;
+
+    // 0 — по числу ядер (минус главный поток)
+    explicit JobSystem(uint32_t worker_count = 0);
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    void Run(JobFn fn, JobCounter* counter = nullptr);
+
+    // fn стартует, когда dependency обнулится (сразу, если уже обнулен)
+    void RunAfter(JobCounter& dependency, JobFn fn, JobCounter* counter = nullptr);
+
+    void RunOnMainThread(JobFn fn, JobCounter* counter = nullptr);
+
+    // Ждет обнуления счетчика, выполняя чужие задачи. Главный поток заодно выполняет свои main-thread задачи
+    void Wait(JobCounter& counter);
+
+    // Делит [0, count) на чанки по grain элементов. Блокирующий, вызывающий поток тоже работает.
+    // Можно вызывать из задач (вложенный параллелизм).
+    void ParallelFor(size_t count, size_t grain, const RangeFn& fn);
+
+    // Выполняет накопившиеся main-thread задачи. Вызывать из главного потока раз в кадр
+    void PumpMainThread();
+
+    [[nodiscard]] uint32_t GetWorkerCount() const { return static_cast<uint32_t>(workers_.size()); }
+    [[nodiscard]] bool IsMainThread() const { return std::this_thread::get_id() == main_thread_id_; }
+
+private:
+    struct Job {
+        JobFn fn;
+        // Чанк ParallelFor — без аллокации std::function на каждый чанк
+        const RangeFn* range = nullptr;
+        size_t begin = 0;
+        size_t end = 0;
+        JobCounter* counter = nullptr;
+    };
+
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+    };
+
+    void WorkerLoop(uint32_t queue_index);
+
+    void Push(Job job);
+    void PushBatch(std::vector<Job>& jobs);
+    bool TryPop(uint32_t queue_index, Job& out);
+    bool TrySteal(uint32_t thief_index, Job& out);
+    bool TryPopMain(Job& out);
+    // Одна задача из любого доступного источника; false — работы нет
+    bool RunOne(uint32_t queue_index);
+    void Execute(Job& job);
+    void Finish(JobCounter* counter);
+    void Notify();
+
+    // Индекс очереди текущего потока: 0 — главный или сторонний поток
+    [[nodiscard]] uint32_t CurrentQueueIndex() const;
+
+    std::thread::id main_thread_id_;
+    std::vector<std::thread> workers_;
+    // queues_[0] — главного потока, queues_[i + 1] — воркера i
+    std::vector<std::unique_ptr<WorkQueue>> queues_;
+    WorkQueue main_queue_;
+
+    // Эпоха меняется при появлении работы и обнулении счетчиков — по ней просыпаются спящие
+    std::mutex sleep_mutex_;
+    std::condition_variable wake_cv_;
+    uint64_t epoch_ = 0;
+    bool stop_ = false;
+};
+
+}  // namespace tryengine::core
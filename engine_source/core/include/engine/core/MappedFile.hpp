@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <span>
+#include <streambuf>
+#include <vector>
+
+namespace tryengine::core {
+
+// Файл, отображенный в память только для чтения. На POSIX — mmap (страницы подгружаются сразу), на прочих
+// системах файл читается в буфер целиком: интерфейс тот же
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    bool Open(const std::filesystem::path& path);
+    void Close();
+
+    [[nodiscard]] bool IsOpen() const { return data_ != nullptr; }
+    [[nodiscard]] std::span<const std::byte> GetData() const { return {data_, size_}; }
+
+private:
+    const std::byte* data_ = nullptr;
+    size_t size_ = 0;
+    // Без mmap (и для пустых файлов) данные лежат здесь
+    std::vector<std::byte> buffer_;
+    bool mapped_ = false;
+};
+
+// std::istream поверх чужой памяти без копирования — для cereal по отображенному файлу
+class MemoryStreamBuf : public std::streambuf {
+public:
+    explicit MemoryStreamBuf(std::span<const std::byte> data) {
+        // streambuf хочет char*, но буфер только читается
+        auto* begin = const_cast<char*>(reinterpret_cast<const char*>(data.data()));
+        setg(begin, begin, begin + data.size());
+    }
+};
+
+}  // namespace tryengine::core
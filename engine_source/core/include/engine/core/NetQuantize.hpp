@@ -0,0 +1,23 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include "engine/core/BitStream.hpp"
+
+namespace tryengine::core {
+
+// Бит на каждую из трех младших компонент кватерниона; погрешность угла ~0.1°
+constexpr uint32_t kRotationBits = 10;
+// Шаг позиции по умолчанию — 1/512 м
+constexpr float kPositionStep = 1.0f / 512.0f;
+
+// Smallest three: индекс наибольшей по модулю компоненты (2 бита) и три остальные в
+// [-1/sqrt(2), 1/sqrt(2)]. Наибольшая восстанавливается из единичной длины, знак выбирается положительным
+void WriteRotation(BitWriter& writer, const glm::quat& rotation);
+glm::quat ReadRotation(BitReader& reader);
+
+void WriteVec3(BitWriter& writer, const glm::vec3& value, float step);
+glm::vec3 ReadVec3(BitReader& reader, float step);
+
+}  // namespace tryengine::core
@@ -0,0 +1,153 @@
+#pragma once
+
+#include <cstdint>
+#include <entt/entity/registry.hpp>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <span>
+#include <tuple>
+#include <vector>
+
+#include "engine/core/Components.hpp"
+
+namespace tryengine {
+
+// Экземпляр префаба: ссылка на узел общего шаблона из PrefabLibrary. Общие компоненты узла
+// (PrefabNode::Shared) на сущности не лежат, пока их не переопределят — см. OverridePrefabComponent
+struct PrefabInstance {
+    uint32_t prefab = 0;
+    uint32_t node = 0;
+};
+
+// Узлы-потомки экземпляра созданы сущностями (ExpandPrefabInstance) — рендер больше не рисует их из шаблона
+struct PrefabExpanded {};
+
+}  // namespace tryengine
+
+namespace tryengine::core {
+
+// Неизменяемый блок узла префаба, один на все экземпляры
+struct PrefabNode {
+    // Компоненты, которые экземпляры читают из шаблона. Переопределенный лежит на сущности и закрывает общий
+    using Shared = std::tuple<std::optional<Tag>, std::optional<MeshFilter>, std::optional<MeshRenderer>>;
+
+    static constexpr uint32_t kNoParent = std::numeric_limits<uint32_t>::max();
+
+    uint32_t parent = kNoParent;
+    Transform local;
+    // Матрица узла в пространстве корня: неразвернутый узел рисуется с WorldMatrix корня * root_from_node.
+    // Считается в PrefabLibrary::Add
+    glm::mat4 root_from_node{1.0f};
+    Shared shared;
+
+    template <typename T>
+    [[nodiscard]] const T* Find() const {
+        const auto& component = std::get<std::optional<T>>(shared);
+        return component ? &*component : nullptr;
+    }
+};
+
+// Узлы в порядке обхода в ширину: корень первый (без родителя), родитель раньше детей
+struct Prefab {
+    std::vector<PrefabNode> nodes;
+};
+
+// Шаблоны префабов реестра, живет в его контексте (AcquirePrefabLibrary). Экземпляры ссылаются на шаблон
+// по индексу, поэтому шаблоны не удаляются, пока жив реестр
+class PrefabLibrary {
+public:
+    uint32_t Add(Prefab prefab);
+
+    // Снимок поддерева root: Transform узлов становится local, компоненты из PrefabNode::Shared — общими
+    uint32_t AddFromHierarchy(const entt::registry& reg, entt::entity root);
+
+    [[nodiscard]] const Prefab& Get(uint32_t prefab) const { return *prefabs_[prefab]; }
+    [[nodiscard]] const PrefabNode& GetNode(const PrefabInstance& instance) const {
+        return prefabs_[instance.prefab]->nodes[instance.node];
+    }
+    [[nodiscard]] size_t Size() const { return prefabs_.size(); }
+
+private:
+    std::vector<std::unique_ptr<const Prefab>> prefabs_;
+};
+
+PrefabLibrary& AcquirePrefabLibrary(entt::registry& reg);
+
+// По экземпляру на трансформ: одна сущность корня с Transform и PrefabInstance, трансформ экземпляра
+// заменяет трансформ корня. Остальные узлы сущностей не получают, пока экземпляр не развернут.
+// Возвращает корни в порядке transforms; пусто, если такого префаба нет
+std::vector<entt::entity> InstantiatePrefab(entt::registry& reg, uint32_t prefab,
+                                            std::span<const Transform> transforms);
+
+// Создает сущности узлов-потомков экземпляра (дети по SceneGraph, у каждой свой PrefabInstance), чтобы
+// их можно было двигать и переопределять по отдельности. Возвращает сущности по индексам узлов, [0] — root;
+// пусто, если root не корень экземпляра или уже развернут
+std::vector<entt::entity> ExpandPrefabInstance(entt::registry& reg, entt::entity root);
+
+// Собственный компонент, если переопределен, иначе общий из шаблона; nullptr — нет ни того, ни другого
+template <typename T>
+const T* GetPrefabComponent(const entt::registry& reg, entt::entity entity) {
+    if (const auto* own = reg.try_get<T>(entity))
+        return own;
+
+    const auto* instance = reg.try_get<PrefabInstance>(entity);
+    const auto* library = reg.ctx().find<PrefabLibrary>();
+    if (!instance || !library)
+        return nullptr;
+    return library->GetNode(*instance).Find<T>();
+}
+
+// Копирование при записи: первый вызов кладет на сущность копию общего компонента, дальше возвращает ее
+template <typename T>
+T& OverridePrefabComponent(entt::registry& reg, entt::entity entity) {
+    if (auto* own = reg.try_get<T>(entity))
+        return *own;
+
+    if (const auto* shared = GetPrefabComponent<T>(reg, entity))
+        return reg.emplace<T>(entity, *shared);
+    return reg.emplace<T>(entity);
+}
+
+// Снимает переопределение: сущность снова читает общий компонент
+template <typename T>
+void RevertPrefabComponent(entt::registry& reg, entt::entity entity) {
+    reg.remove<T>(entity);
+}
+
+// Что рендер рисует у экземпляров: fn(model_matrix, mesh_filter, mesh_renderer) для сущностей с PrefabInstance,
+// у которых MeshFilter и MeshRenderer не оба свои (такие рисуются как обычные сущности), и для неразвернутых
+// узлов-потомков — от WorldMatrix корня
+template <typename Fn>
+void ForEachPrefabMesh(entt::registry& reg, Fn&& fn) {
+    const auto* library = reg.ctx().find<PrefabLibrary>();
+    if (!library)
+        return;
+
+    for (const auto [entity, world, instance] : reg.view<const WorldMatrix, const PrefabInstance>().each()) {
+        const auto& node = library->GetNode(instance);
+        const auto* own_filter = reg.try_get<MeshFilter>(entity);
+        const auto* own_renderer = reg.try_get<MeshRenderer>(entity);
+        if (!own_filter || !own_renderer) {
+            const auto* mesh_filter = own_filter ? own_filter : node.Find<MeshFilter>();
+            const auto* mesh_renderer = own_renderer ? own_renderer : node.Find<MeshRenderer>();
+            if (mesh_filter && mesh_renderer) {
+                fn(world.value, *mesh_filter, *mesh_renderer);
+            }
+        }
+
+        if (instance.node != 0 || reg.all_of<PrefabExpanded>(entity))
+            continue;
+
+        const auto& nodes = library->Get(instance.prefab).nodes;
+        for (size_t i = 1; i < nodes.size(); ++i) {
+            const auto* mesh_filter = nodes[i].Find<MeshFilter>();
+            const auto* mesh_renderer = nodes[i].Find<MeshRenderer>();
+            if (mesh_filter && mesh_renderer) {
+                fn(world.value * nodes[i].root_from_node, *mesh_filter, *mesh_renderer);
+            }
+        }
+    }
+}
+
+}  // namespace tryengine::core
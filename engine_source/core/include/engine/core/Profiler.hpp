@@ -0,0 +1,164 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace tryengine::core {
+
+// FNV-1a. В макросах зон считается на этапе компиляции
+constexpr uint32_t HashZoneName(std::string_view name) {
+    uint32_t hash = 2166136261u;
+    for (const char c : name) {
+        hash ^= static_cast<uint8_t>(c);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+// Одна закрытая зона в буфере потока
+struct ProfileEvent {
+    uint32_t zone = 0;
+    uint32_t depth = 0;
+    uint64_t begin_ns = 0;
+    uint64_t end_ns = 0;
+};
+
+// Зона кадра, уже разобранная для UI
+struct ProfileZoneRecord {
+    std::string_view name;
+    uint32_t thread = 0;
+    uint32_t depth = 0;
+    uint64_t begin_ns = 0;
+    uint64_t end_ns = 0;
+};
+
+struct ProfileFrame {
+    uint64_t begin_ns = 0;
+    uint64_t end_ns = 0;
+    // Отсортированы по потоку, затем по началу
+    std::vector<ProfileZoneRecord> zones;
+};
+
+// Профайлер зон CPU. Каждый поток пишет в свой кольцевой буфер без блокировок (один писатель),
+// читатель (EndFrame, экспорт) забирает последние события и отбрасывает те, что успели перезаписаться.
+// Инструментируется макросами TRYENGINE_PROFILE_* — без TRYENGINE_PROFILER они пустые.
+class Profiler {
+public:
+    // Событий на поток; старые перезаписываются
+    static constexpr uint32_t kThreadBufferSize = 1u << 15;
+
+    static Profiler& Get();
+
+    static uint64_t Now() noexcept {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                         std::chrono::steady_clock::now().time_since_epoch())
+                                         .count());
+    }
+
+    // Связывает хеш с именем для UI и экспорта. Макрос зовет один раз на место вызова
+    uint32_t RegisterZone(uint32_t hash, std::string_view name);
+    void SetThreadName(std::string_view name);
+
+    void Record(uint32_t zone, uint32_t depth, uint64_t begin_ns, uint64_t end_ns);
+
+    // Граница кадра. Собирает зоны всех потоков, закрывшиеся с прошлой границы. Вызывать с главного потока
+    void EndFrame();
+    [[nodiscard]] const ProfileFrame& GetLastFrame() const { return last_frame_; }
+
+    [[nodiscard]] std::string_view GetZoneName(uint32_t zone) const;
+    [[nodiscard]] std::string GetThreadName(uint32_t thread) const;
+
+    // Все события, что еще лежат в буферах, в формате Chrome Trace Event (chrome://tracing, Perfetto)
+    bool ExportChromeTrace(const std::filesystem::path& path) const;
+
+    // Собраны ли макросы зон (TRYENGINE_PROFILER) — для UI
+    static constexpr bool IsCompiledIn() {
+#if defined(TRYENGINE_PROFILER)
+        return true;
+#else
+        return false;
+#endif
+    }
+
+private:
+    struct ThreadBuffer;
+
+    Profiler();
+    ~Profiler();
+
+    ThreadBuffer& LocalBuffer();
+    // Дописывает в out события потока, закрывшиеся позже since_ns, в порядке записи.
+    // События, которые писатель успел перезаписать во время чтения, отбрасываются
+    static void Snapshot(const ThreadBuffer& buffer, uint64_t since_ns, std::vector<ProfileEvent>& out);
+
+    static thread_local ThreadBuffer* tls_buffer_;
+
+    mutable std::mutex mutex_;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers_;
+    std::unordered_map<uint32_t, std::string> zone_names_;
+
+    uint64_t frame_begin_ns_ = 0;
+    ProfileFrame last_frame_;
+};
+
+namespace detail {
+inline thread_local uint32_t profile_depth = 0;
+}  // namespace detail
+
+class ProfileScope {
+public:
+    explicit ProfileScope(uint32_t zone) noexcept
+        : zone_(zone), depth_(detail::profile_depth++), begin_ns_(Profiler::Now()) {}
+
+    ~ProfileScope() {
+        --detail::profile_depth;
+        Profiler::Get().Record(zone_, depth_, begin_ns_, Profiler::Now());
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    uint32_t zone_;
+    uint32_t depth_;
+    uint64_t begin_ns_;
+};
+
+}  // namespace tryengine::core
+
+#define TRYENGINE_PROFILE_CONCAT_IMPL(a, b) a##b
+#define TRYENGINE_PROFILE_CONCAT(a, b) TRYENGINE_PROFILE_CONCAT_IMPL(a, b)
+
+#if defined(TRYENGINE_PROFILER)
+
+// Зона до конца области видимости. name — строковый литерал
+#define TRYENGINE_PROFILE_ZONE(name)                                                                       \
+    static const uint32_t TRYENGINE_PROFILE_CONCAT(tryengine_zone_id_, __LINE__) =                         \
+        ::tryengine::core::Profiler::Get().RegisterZone(                                                   \
+            std::integral_constant<uint32_t, ::tryengine::core::HashZoneName(name)>::value, name);         \
+    const ::tryengine::core::ProfileScope TRYENGINE_PROFILE_CONCAT(tryengine_zone_, __LINE__)(             \
+        TRYENGINE_PROFILE_CONCAT(tryengine_zone_id_, __LINE__))
+
+// Зона с заранее зарегистрированным id (имена, известные только в рантайме)
+#define TRYENGINE_PROFILE_ZONE_ID(id) \
+    const ::tryengine::core::ProfileScope TRYENGINE_PROFILE_CONCAT(tryengine_zone_, __LINE__)(id)
+
+#define TRYENGINE_PROFILE_FRAME() ::tryengine::core::Profiler::Get().EndFrame()
+#define TRYENGINE_PROFILE_THREAD(name) ::tryengine::core::Profiler::Get().SetThreadName(name)
+
+#else
+
+#define TRYENGINE_PROFILE_ZONE(name) static_cast<void>(0)
+#define TRYENGINE_PROFILE_ZONE_ID(id) static_cast<void>(0)
+#define TRYENGINE_PROFILE_FRAME() static_cast<void>(0)
+#define TRYENGINE_PROFILE_THREAD(name) static_cast<void>(0)
+
+#endif
@@ -1,6 +1,11 @@
 #pragma once
 
+#include <algorithm>
+#include <condition_variable>
 #include <entt/core/type_info.hpp>
+#include <mutex>
+#include <utility>
+#include <vector>
 
 #include "engine/core/Addressables.hpp"
 #include "engine/core/AssetDatabase.hpp"
@@ -21,18 +26,48 @@ public:
         caches_[typeId] = std::make_unique<CacheImpl<T, Loader>>(std::forward<Loader>(loader));
     }
 
+    // Потокобезопасен: сцена резолвит ресурсы из задач загрузки пулов, асинхронная загрузка — из воркера.
+    // Под блокировкой только поиск и вставка в кэш; сам лоадер (диск, загрузка на GPU) работает без нее,
+    // поэтому Get главного потока не ждет чужую загрузку, а лоадеры (MaterialLoader) могут звать Get для зависимостей.
+    // Один и тот же ресурс грузится один раз: остальные потоки ждут его в loaded_
     template <typename T>
     entt::resource<T> Get(uint64_t id) {
-        auto typeId = entt::type_hash<T>::value();
-        auto path = asset_database_->GetPath(id);
+        const auto typeId = entt::type_hash<T>::value();
+        const std::pair key{typeId, id};
+        ITypedCache<T>* typedCache = nullptr;
+        std::string path;
+        {
+            std::unique_lock lock(mutex_);
+
+            // Загрузчик не зарегистрирован (GPU-ресурсы на headless-сервере) — пустой хэндл
+            const auto it = caches_.find(typeId);
+            if (it == caches_.end())
+                return {};
+            typedCache = static_cast<ITypedCache<T>*>(it->second.get());
+
+            loaded_.wait(lock, [&] { return std::find(loading_.begin(), loading_.end(), key) == loading_.end(); });
+            entt::resource<T> cached;
+            if (typedCache->Find(id, cached))
+                return cached;
 
-        auto* typedCache = static_cast<ITypedCache<T>*>(caches_[typeId].get());
-        return typedCache->GetOrLoad(id, id, path);
+            loading_.push_back(key);
+            path = asset_database_->GetPath(id);
+        }
+
+        auto resource = typedCache->Load(id, path);
+        {
+            std::lock_guard lock(mutex_);
+            typedCache->Store(id, resource);
+            loading_.erase(std::find(loading_.begin(), loading_.end(), key));
+        }
+        loaded_.notify_all();
+        return resource;
     }
 
     // Вызывать раз в несколько минут или при смене сцены
     // TODO: доделать
     void UpdatePurge() {
+        std::lock_guard lock(mutex_);
         for (auto& [id, cache] : caches_) {
             cache->Purge();
         }
@@ -45,5 +80,9 @@ private:
     std::unique_ptr<AssetDatabase> asset_database_;
     std::unique_ptr<Addressables> addressables_;
     std::unordered_map<entt::id_type, std::unique_ptr<ICacheBase>> caches_;
+    std::mutex mutex_;
+    std::condition_variable loaded_;
+    // Ресурсы, которые сейчас грузит какой-то поток: (тип, id). Одновременно их единицы, вектора хватает
+    std::vector<std::pair<entt::id_type, uint64_t>> loading_;
 };
 }  // namespace tryengine::core
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <entt/entity/registry.hpp>
+#include <functional>
+#include <type_traits>
+#include <vector>
+
+namespace tryengine::core {
+
+// Кольцо снимков выбранных пулов EnTT для предсказания на клиенте и отката. Снимок — memcpy упакованного
+// массива сущностей и страниц компонентов, без cereal. Save зовется в конце каждого тика, Resimulate —
+// когда пришло авторитетное состояние сервера для прошлого тика.
+// Откат восстанавливает только значения: сущности, созданные или удаленные за время предсказания,
+// сюда не входят (их порождает сервер), пул с изменившимся составом пересобирается медленным путем.
+class RollbackBuffer {
+public:
+    using CorrectFn = std::function<void(entt::registry&)>;
+    using SimulateFn = std::function<void(entt::registry&, uint32_t tick)>;
+
+    explicit RollbackBuffer(uint32_t capacity) : frames_(capacity) {}
+
+    // Регистрировать до первого Save
+    template <typename T>
+    void Track() {
+        static_assert(std::is_trivially_copyable_v<T> && !std::is_empty_v<T>,
+                      "Rollback copies component pages with memcpy");
+        pools_.push_back({sizeof(T), &SavePool<T>, &RestorePool<T>});
+    }
+
+    // Состояние на конец tick. Старейший снимок вытесняется
+    void Save(const entt::registry& reg, uint32_t tick);
+
+    [[nodiscard]] bool Contains(uint32_t tick) const;
+
+    // Возвращает пулы к концу tick. Изменившиеся значения помечаются через patch (on_update срабатывает,
+    // так что Transform уйдет в UpdateTransformSystem). false — снимка уже нет
+    bool Restore(entt::registry& reg, uint32_t tick);
+
+    // Откат к tick, correct (наложить состояние сервера), повторная симуляция тиков (tick, to_tick]
+    // с сохранением новых снимков
+    bool Resimulate(entt::registry& reg, uint32_t tick, uint32_t to_tick, const CorrectFn& correct,
+                    const SimulateFn& simulate);
+
+    // Значений, реально измененных последним Restore
+    [[nodiscard]] uint32_t GetRestoredCount() const { return restored_count_; }
+
+private:
+    struct PoolFrame {
+        std::vector<entt::entity> entities;
+        std::vector<std::byte> values;
+    };
+
+    struct Frame {
+        uint32_t tick = 0;
+        bool valid = false;
+        std::vector<PoolFrame> pools;
+    };
+
+    struct PoolOps {
+        size_t size = 0;
+        void (*save)(const entt::registry&, PoolFrame&) = nullptr;
+        // Возвращает число измененных значений
+        uint32_t (*restore)(entt::registry&, const PoolFrame&) = nullptr;
+    };
+
+    template <typename T>
+    static void SavePool(const entt::registry& reg, PoolFrame& out) {
+        const auto* storage = reg.storage<T>();
+        if (!storage) {
+            out.entities.clear();
+            out.values.clear();
+            return;
+        }
+
+        const entt::sparse_set& base = *storage;
+        const size_t size = base.size();
+        out.entities.assign(base.data(), base.data() + size);
+        out.values.resize(size * sizeof(T));
+
+        // Компоненты лежат страницами в порядке упакованного массива — копируем страницу целиком
+        constexpr size_t page = entt::component_traits<T>::page_size;
+        const auto pages = storage->raw();
+        for (size_t pos = 0; pos < size; pos += page) {
+            std::memcpy(out.values.data() + pos * sizeof(T), pages[pos / page], std::min(page, size - pos) * sizeof(T));
+        }
+    }
+
+    template <typename T>
+    static uint32_t RestorePool(entt::registry& reg, const PoolFrame& frame) {
+        auto& storage = reg.storage<T>();
+        const entt::sparse_set& base = storage;
+        const size_t size = frame.entities.size();
+        uint32_t restored = 0;
+
+        // Быстрый путь: состав и порядок пула не менялись — правим значения на месте
+        if (base.size() == size && std::equal(frame.entities.begin(), frame.entities.end(), base.data())) {
+            constexpr size_t page = entt::component_traits<T>::page_size;
+            const auto pages = storage.raw();
+            for (size_t i = 0; i < size; ++i) {
+                T& value = pages[i / page][i % page];
+                const std::byte* saved = frame.values.data() + i * sizeof(T);
+                if (std::memcmp(&value, saved, sizeof(T)) != 0) {
+                    std::memcpy(&value, saved, sizeof(T));
+                    reg.patch<T>(frame.entities[i]);
+                    ++restored;
+                }
+            }
+            return restored;
+        }
+
+        storage.clear();
+        for (size_t i = 0; i < size; ++i) {
+            if (!reg.valid(frame.entities[i]))
+                continue;
+            T value;
+            std::memcpy(&value, frame.values.data() + i * sizeof(T), sizeof(T));
+            reg.emplace<T>(frame.entities[i], value);
+            ++restored;
+        }
+        return restored;
+    }
+
+    [[nodiscard]] const Frame* Find(uint32_t tick) const;
+
+    std::vector<PoolOps> pools_;
+    std::vector<Frame> frames_;
+    uint32_t restored_count_ = 0;
+};
+
+}  // namespace tryengine::core
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <entt/entity/registry.hpp>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace tryengine::core {
+
+class ComponentRegistry;
+class JobSystem;
+class ResourceManager;
+
+// Запеченная сцена: заголовок, таблица пулов, затем секции (выровнены на 64 байта):
+// массив сущностей реестра и по каждому пулу — его сущности и данные (см. CookedComponent).
+// Читается из отображенного файла без разбора по элементам. Раскладка сырых пулов зависит от
+// компилятора и платформы: при несовпадении версии или размера типа сцену нужно перезапечь
+inline constexpr uint32_t kCookedSceneVersion = 1;
+
+struct CookedSceneHeader {
+    char magic[4] = {'T', 'S', 'C', 'N'};
+    uint32_t version = kCookedSceneVersion;
+    uint32_t pool_count = 0;
+    uint32_t reserved = 0;
+    // Все сущности хранилища (живые, затем освобожденные — ради версий), живых — первые alive_count
+    uint64_t entity_count = 0;
+    uint64_t alive_count = 0;
+    uint64_t entities_offset = 0;
+};
+
+struct CookedPoolHeader {
+    uint32_t name_hash = 0;
+    uint32_t raw = 0;
+    uint32_t element_size = 0;
+    uint32_t reserved = 0;
+    uint64_t count = 0;
+    uint64_t entities_offset = 0;
+    uint64_t data_offset = 0;
+    uint64_t data_size = 0;
+};
+
+struct SceneLoadOptions {
+    // Пулы разбираются задачами параллельно, каждый в свое хранилище. nullptr — по очереди в вызывающем потоке
+    JobSystem* jobs = nullptr;
+    // Ссылки на ресурсы резолвятся в той же задаче сразу после разбора пула. nullptr — без резолва
+    ResourceManager* resources = nullptr;
+    // Доля разобранных пулов, 0..1 — для индикатора загрузки из другого потока
+    std::atomic<float>* progress = nullptr;
+};
+
+struct PoolLoadStats {
+    std::string name;
+    size_t count = 0;
+    // Разбор и резолв пула
+    double ms = 0.0;
+};
+
+struct SceneLoadStats {
+    double total_ms = 0.0;
+    // В порядке пулов в файле; пулы, неизвестные реестру компонентов, не попадают
+    std::vector<PoolLoadStats> pools;
+};
+
+// Сущности без компонентов не пишутся — как orphans() после загрузки через cereal
+bool WriteCookedScene(const std::filesystem::path& path, const entt::registry& reg,
+                      const ComponentRegistry& components);
+
+[[nodiscard]] bool IsCookedScene(std::span<const std::byte> data);
+
+// Очищает reg и заполняет из data. Пулы, которых нет в components, пропускаются (компоненты редактора
+// на сервере). false — файл битый или запечен другой версией
+bool ReadCookedScene(std::span<const std::byte> data, entt::registry& reg, const ComponentRegistry& components,
+                     const SceneLoadOptions& options = {}, SceneLoadStats* stats = nullptr);
+
+}  // namespace tryengine::core
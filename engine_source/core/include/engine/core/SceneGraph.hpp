@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstdint>
+#include <entt/entity/registry.hpp>
+#include <span>
+#include <vector>
+
+namespace tryengine::core {
+
+// Пул непрерывных блоков под списки детей. Блоки размером 2^size_class лежат в одном массиве,
+// освобожденные блоки переиспользуются через free-list своего размера — рост списка детей
+// стоит одно копирование в блок вдвое больше, без аллокаций в куче на каждый reparent.
+class ChildSpanPool {
+public:
+    static constexpr uint8_t kMinSizeClass = 2;  // 4 ребенка
+
+    uint32_t Allocate(uint8_t size_class);
+    void Free(uint32_t offset, uint8_t size_class);
+    void Clear();
+
+    [[nodiscard]] entt::entity* Data(uint32_t offset) { return storage_.data() + offset; }
+    [[nodiscard]] const entt::entity* Data(uint32_t offset) const { return storage_.data() + offset; }
+
+private:
+    std::vector<entt::entity> storage_;
+    std::vector<std::vector<uint32_t>> free_lists_;
+};
+
+// Основное хранилище иерархии: у каждого родителя непрерывный массив детей в порядке сиблингов.
+// Relationship (first/prev/next) остается производным представлением для сериализации, инспектора
+// и старого кода — SceneGraph сам переписывает его у затронутых сущностей.
+// Живет в контексте реестра, см. AcquireSceneGraph.
+class SceneGraph {
+public:
+    // Span действителен до следующего изменения графа
+    [[nodiscard]] std::span<const entt::entity> GetChildren(entt::entity parent) const;
+    [[nodiscard]] entt::entity GetParent(entt::entity entity) const;
+    [[nodiscard]] bool IsAncestor(entt::entity ancestor, entt::entity entity) const;
+
+    // Переносит entity в конец детей new_parent (entt::null — в корень) за O(1): у старого родителя
+    // на ее место встает последний ребенок. Relationship у сущности и ее нового/старого окружения
+    // обновляется, у entity вызывается patch. false — если получился бы цикл.
+    bool SetParent(entt::registry& reg, entt::entity entity, entt::entity new_parent);
+
+    // Убирает сущность из графа (последний сиблинг встает на ее место), ее дети становятся корнями.
+    // Подписан на on_destroy<Relationship>
+    void Detach(entt::registry& reg, entt::entity entity);
+
+    // Полная перестройка по Relationship (после загрузки сцены)
+    void RebuildFromRelationships(const entt::registry& reg);
+
+    // Вносит в граф только что созданные сущности по их готовым Relationship (пакетный спавн) — без
+    // перестройки всей сцены. Родитель каждой из entities — среди них же или null
+    void AddFromRelationships(const entt::registry& reg, std::span<const entt::entity> entities);
+
+    // То же по частям (слияние сцены по бюджету кадра): сначала AddNodes для всех новых сущностей,
+    // затем LinkChildren для всех. Порядок частей внутри каждого шага любой
+    void AddNodes(const entt::registry& reg, std::span<const entt::entity> entities);
+    void LinkChildren(const entt::registry& reg, std::span<const entt::entity> parents);
+
+private:
+    struct Node {
+        entt::entity entity{entt::null};
+        entt::entity parent{entt::null};
+        uint32_t index_in_parent = 0;
+        uint32_t offset = 0;
+        uint32_t count = 0;
+        uint8_t size_class = 0;  // 0 — блока нет
+    };
+
+    [[nodiscard]] const Node* Find(entt::entity entity) const;
+    Node* Find(entt::entity entity);
+    Node& FindOrCreate(entt::entity entity);
+
+    void AppendChild(Node& parent, entt::entity child);
+    void RemoveFromParent(Node& node);
+    // Relationship окружения после RemoveFromParent: index — место, где стоял удаленный
+    void WriteLinksAfterRemove(entt::registry& reg, entt::entity parent, uint32_t index) const;
+
+    // Переписывает Relationship сущности по графу (без patch)
+    void WriteLinks(entt::registry& reg, entt::entity entity) const;
+
+    // Индекс — entt::to_entity(entity)
+    std::vector<Node> nodes_;
+    ChildSpanPool pool_;
+};
+
+// Создает SceneGraph в контексте реестра (строится по существующим Relationship) и подписывает его
+// на удаление Relationship. Повторный вызов ничего не делает.
+SceneGraph& AcquireSceneGraph(entt::registry& reg);
+
+}  // namespace tryengine::core
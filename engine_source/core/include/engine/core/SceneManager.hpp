@@ -1,14 +1,72 @@
 #pragma once
 
+#include <atomic>
+#include <chrono>
+#include <deque>
 #include <filesystem>
 #include <memory>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
+#include "engine/core/ComponentRegistry.hpp"
+#include "engine/core/JobSystem.hpp"
 #include "engine/core/Scene.hpp"
+#include "engine/core/SceneFormat.hpp"
 
 namespace tryengine::core {
 class ResourceManager;
-class ComponentRegistry;
+
+enum class SceneLoadMode {
+    // Сцена заменяет активную
+    Single,
+    // Сущности сцены добавляются в активную с новыми идентификаторами; выгружаются по id сцены
+    Additive,
+};
+
+// Асинхронная загрузка. Чтение, разбор и резолв ресурсов идут в задачах JobSystem во временный реестр,
+// подмена или слияние с активной сценой — в SceneManager::Update на главном потоке, частями по бюджету
+class SceneLoadOperation {
+public:
+    enum class State { Loading, Merging, Done, Failed };
+
+    [[nodiscard]] uint64_t GetSceneID() const { return scene_id_; }
+    [[nodiscard]] SceneLoadMode GetMode() const { return mode_; }
+    [[nodiscard]] State GetState() const { return state_.load(std::memory_order_acquire); }
+    [[nodiscard]] bool IsDone() const { return GetState() == State::Done || GetState() == State::Failed; }
+    // 0..1: первая половина — разбор пулов, вторая — слияние на главном потоке
+    [[nodiscard]] float GetProgress() const;
+    // Время по пулам; читать после IsDone
+    [[nodiscard]] const SceneLoadStats& GetStats() const { return stats_; }
+    // Самый долгий шаг Update, потраченный на эту загрузку, — сколько она задержала главный поток
+    [[nodiscard]] double GetMaxStallMs() const { return max_stall_ms_; }
+
+private:
+    friend class SceneManager;
+
+    uint64_t scene_id_ = 0;
+    SceneLoadMode mode_ = SceneLoadMode::Single;
+    std::atomic<State> state_{State::Loading};
+    std::atomic<float> load_progress_{0.0f};
+    std::atomic<float> merge_progress_{0.0f};
+
+    // Заполняются задачей загрузки до перехода в Merging
+    std::unique_ptr<Scene> staging_;
+    SceneLoadStats stats_;
+    // Живые сущности временного реестра
+    std::vector<entt::entity> entities_;
+
+    // Курсор слияния (главный поток). Сливается в ту активную сцену, что была при начале слияния
+    const Scene* target_ = nullptr;
+    EntityRemap remap_;
+    std::vector<entt::entity> created_entities_;
+    size_t created_ = 0;
+    size_t pool_ = 0;
+    size_t pool_offset_ = 0;
+    // Сущностей, внесенных в SceneGraph мира: [0, n) — узлы, [n, 2n) — списки детей
+    size_t graph_offset_ = 0;
+    double max_stall_ms_ = 0.0;
+};
 
 class SceneManager {
 public:
@@ -19,22 +77,73 @@ public:
     SceneManager(SceneManager&&) = delete;
     SceneManager& operator=(SceneManager&&) = delete;
 
-    ~SceneManager() = default;
+    // Дожидается незавершенных задач загрузки
+    ~SceneManager();
 
     bool LoadScene(const std::string& scene_name);
     bool LoadScene(uint64_t id);
+    // Загружает сцену, не делая ее активной: у сервера комнат много, и у каждой своя сцена. nullptr при ошибке.
+    // stats — время по пулам (только для запеченных сцен)
+    std::unique_ptr<Scene> InstantiateScene(uint64_t id, SceneLoadStats* stats = nullptr) const;
+    std::unique_ptr<Scene> InstantiateScene(const std::string& scene_name, SceneLoadStats* stats = nullptr) const;
     void SetActiveScene(std::unique_ptr<Scene> scene) {
         if (!scene) return;
         active_scene_ = std::move(scene);
+        loaded_scenes_.clear();
+        unload_queue_.clear();
     }
 
+    // Загрузка без блокировки главного потока; завершается в Update. Загрузки применяются в порядке запуска.
+    // Без JobSystem сцена читается прямо в этом вызове, а слияние все равно идет частями в Update.
+    // Additive без активной сцены работает как Single
+    std::shared_ptr<const SceneLoadOperation> LoadSceneAsync(uint64_t id, SceneLoadMode mode = SceneLoadMode::Single);
+    std::shared_ptr<const SceneLoadOperation> LoadSceneAsync(const std::string& scene_name,
+                                                             SceneLoadMode mode = SceneLoadMode::Single);
+
+    // Снимает сущности сцены, загруженной в активную (в том числе базовой), частями в Update.
+    // Сущности, уже удаленные геймплеем, пропускаются. false — сцена не загружена
+    bool UnloadScene(uint64_t id);
+    [[nodiscard]] bool IsSceneLoaded(uint64_t id) const { return loaded_scenes_.contains(id); }
+    [[nodiscard]] bool IsBusy() const { return !operations_.empty() || !unload_queue_.empty(); }
+    // Сущности выгруженных сцен еще не все удалены — их ссылки на ресурсы живы
+    [[nodiscard]] bool IsUnloading() const { return !unload_queue_.empty(); }
+
+    // Раз в кадр с главного потока: применяет готовые загрузки и выгрузки, тратя примерно budget_ms
+    // (не меньше одной порции, чтобы работа шла при любом бюджете). Возвращает потраченное время
+    double Update(double budget_ms = 2.0);
+
+    // С JobSystem пулы запеченной сцены разбираются параллельно. nullptr — в вызывающем потоке
+    void SetJobSystem(JobSystem* jobs) { jobs_ = jobs; }
+
     [[nodiscard]] Scene& GetActiveScene() const { return *active_scene_; }
+    [[nodiscard]] bool HasActiveScene() const { return active_scene_ != nullptr; }
+    // Время загрузки активной сцены по пулам
+    [[nodiscard]] const SceneLoadStats& GetLastLoadStats() const { return last_load_stats_; }
     [[nodiscard]] ComponentRegistry& GetComponentRegistry() const { return component_registry_; }
 
 private:
+    // Чтение сцены во временный реестр; progress — доля разобранных пулов
+    std::unique_ptr<Scene> ReadScene(uint64_t id, SceneLoadStats* stats, std::atomic<float>* progress) const;
+    // Задача загрузки: staging_ и entities_ операции, затем переход в Merging или Failed
+    void RunLoad(SceneLoadOperation& operation) const;
+
+    // Шаг применения загрузки до deadline (не меньше одной порции). true — операция завершена
+    bool Apply(SceneLoadOperation& operation, std::chrono::steady_clock::time_point deadline);
+    void SwapIn(SceneLoadOperation& operation);
+    // Уничтожает сцену в задаче, если есть JobSystem: большой реестр разрушается заметное время
+    void Dispose(std::unique_ptr<Scene> scene);
+
     std::unique_ptr<Scene> active_scene_ = nullptr;
     ComponentRegistry& component_registry_;
     ResourceManager& resource_manager_;
+    JobSystem* jobs_ = nullptr;
+    SceneLoadStats last_load_stats_;
+
+    std::deque<std::shared_ptr<SceneLoadOperation>> operations_;
+    JobCounter loads_;
+    // Сущности активной сцены по id загруженной в нее сцены
+    std::unordered_map<uint64_t, std::vector<entt::entity>> loaded_scenes_;
+    std::vector<entt::entity> unload_queue_;
 };
 
-}  // namespace tryengine::core
\ No newline at end of file
+}  // namespace tryengine::core
@@ -2,6 +2,7 @@
 
 #include <daScript/daScript.h>
 #include <filesystem>
+#include <functional>
 #include <iostream>
 #include <string>
 #include <unordered_map>
@@ -16,7 +17,13 @@ enum class ReloadErrorPolicy {
 
 class ScriptSystem {
 public:
-    ScriptSystem();
+    // register_extra_modules вызывается до das::Module::Initialize — там приложение делает NEED_MODULE
+    // своих нативных модулей (редактор — Module_TryEditor). Ядро про них не знает, иначе headless-сборки
+    // без этих модулей не слинкуются.
+    // Экземпляров может быть несколько (у каждого свой контекст), модули общие: их поднимает первый
+    // экземпляр (и только его register_extra_modules учитывается), гасит последний.
+    // Компиляция — с одного потока за раз; Invoke* разных экземпляров можно звать параллельно.
+    explicit ScriptSystem(const std::function<void()>& register_extra_modules = {});
     ~ScriptSystem();
 
     // Загрузка и жизненный цикл главного скрипта
@@ -43,6 +50,8 @@ public:
 
     // Геттеры и настройки
     das::Context* GetContext();
+    // Куча и строковая куча контекста — для учета памяти комнат сервера
+    [[nodiscard]] size_t GetHeapBytes() const;
     void SetReloadErrorPolicy(ReloadErrorPolicy policy) { error_policy_ = policy; }
     bool IsFrozen() const { return is_frozen_; }
 
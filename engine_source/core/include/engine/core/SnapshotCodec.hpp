@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <entt/entity/registry.hpp>
+#include <span>
+#include <vector>
+
+#include "engine/core/BitStream.hpp"
+
+namespace tryengine::core {
+
+class ComponentRegistry;
+
+// Значения одного реплицируемого типа, сущности по возрастанию
+struct SnapshotPool {
+    std::vector<entt::entity> entities;
+    std::vector<std::byte> values;
+};
+
+// Состояние реплицируемых компонентов на тик. На сервере — то, что снято с реестра, на клиенте — то,
+// что собрано из пакетов; обе стороны держат историю снапшотов, чтобы кодировать разницу к подтвержденному
+struct Snapshot {
+    // С 1; 0 в заголовке означает "без базы"
+    uint32_t sequence = 0;
+    // Сущности хотя бы с одним реплицируемым компонентом, по возрастанию
+    std::vector<entt::entity> entities;
+    // По индексу в ComponentRegistry::GetReplicatedComponents
+    std::vector<SnapshotPool> pools;
+};
+
+struct SnapshotHeader {
+    uint32_t sequence = 0;
+    uint32_t baseline = 0;
+};
+
+// Дельта-кодек снапшотов. В пакет попадают только сущности и компоненты, изменившиеся относительно
+// базы (подтвержденного клиентом снапшота), значения упакованы побитово (NetWrite/NetRead компонента),
+// id сущностей — varint-разностями. Набор типов и их порядок берутся из ComponentRegistry.
+class SnapshotCodec {
+public:
+    explicit SnapshotCodec(const ComponentRegistry& registry);
+
+    void Capture(const entt::registry& reg, uint32_t sequence, Snapshot& out) const;
+
+    // Снапшот для одного клиента: сущности fresh — со значениями из current, stale — со значениями из baseline
+    // (клиенту они не отправятся). Оба списка по возрастанию и не пересекаются; stale должны быть в baseline
+    void Compose(const Snapshot& current, const Snapshot* baseline, std::span<const entt::entity> fresh,
+                 std::span<const entt::entity> stale, uint32_t sequence, Snapshot& out) const;
+
+    // Отличается ли сущность в двух снапшотах (набор компонентов или значения)
+    [[nodiscard]] bool EntityDiffers(const Snapshot& a, const Snapshot& b, entt::entity entity) const;
+
+    // baseline == nullptr — полный снапшот
+    void Encode(const Snapshot& current, const Snapshot* baseline, BitWriter& writer) const;
+
+    // Сначала заголовок: по нему клиент находит базу в своей истории
+    static SnapshotHeader ReadHeader(BitReader& reader);
+    // false — пакет поврежден или передана не та база
+    bool Decode(BitReader& reader, const SnapshotHeader& header, const Snapshot* baseline, Snapshot& out) const;
+
+    // Приводит реестр к snapshot. applied — снапшот, примененный прошлым вызовом: тогда трогаются только отличия.
+    // Сущности создаются с теми же id, что на сервере, поэтому реплицируемые сущности клиента не должны
+    // пересекаться с локальными
+    void Apply(entt::registry& reg, const Snapshot& snapshot, const Snapshot* applied) const;
+
+private:
+    const ComponentRegistry& registry_;
+};
+
+}  // namespace tryengine::core
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <shared_mutex>
+#include <string_view>
+#include <vector>
+
+namespace tryengine::core {
+
+// 64-битный FNV-1a, пустая строка — 0. Алгоритм тот же, что у entt::hashed_string, но 32 бит на сцене
+// из миллиона разных имен дают около сотни коллизий
+constexpr uint64_t HashString(std::string_view str) {
+    if (str.empty())
+        return 0;
+
+    uint64_t hash = 14695981039346656037ull;
+    for (const char c : str) {
+        hash ^= static_cast<uint8_t>(c);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+// Интернированная строка: 8 байт, сравнение — сравнение чисел. Id — хеш текста, поэтому он одинаков
+// между запусками, а для литерала считается при компиляции ("albedo_map"_sid). Текст лежит один раз
+// в StringTable; id из Hash сравним с любым StringId, но View вернет текст, только если строку интернировали
+class StringId {
+public:
+    constexpr StringId() = default;
+
+    // Интернирует: текст попадает в StringTable
+    explicit StringId(std::string_view str);
+
+    // Только id, без записи в таблицу — для поиска и литералов
+    static constexpr StringId Hash(std::string_view str) {
+        StringId result;
+        result.id_ = HashString(str);
+        return result;
+    }
+
+    [[nodiscard]] constexpr uint64_t GetId() const { return id_; }
+    [[nodiscard]] constexpr bool IsEmpty() const { return id_ == 0; }
+
+    // Текст из таблицы (с завершающим нулем); пусто, если строка не интернирована
+    [[nodiscard]] std::string_view View() const;
+    [[nodiscard]] const char* CStr() const;
+
+    constexpr bool operator==(const StringId&) const = default;
+
+private:
+    uint64_t id_ = 0;
+};
+
+// Глобальная таблица интернированных строк. Строки не удаляются: View действителен до конца процесса.
+// Потокобезопасна — теги интернируются и из задач загрузки сцены
+class StringTable {
+public:
+    struct Stats {
+        size_t strings = 0;
+        // Выделено под текст (блоки арены целиком)
+        size_t arena_bytes = 0;
+        // Открытая адресация: по 16 байт на слот
+        size_t index_bytes = 0;
+    };
+
+    static StringTable& Get();
+
+    uint64_t Intern(std::string_view str);
+    // Пусто, если id не интернирован
+    [[nodiscard]] std::string_view Find(uint64_t id) const;
+    [[nodiscard]] Stats GetStats() const;
+
+private:
+    struct Slot {
+        uint64_t id = 0;
+        // Длина (uint32_t) и текст с нулем в арене
+        const char* entry = nullptr;
+    };
+
+    [[nodiscard]] const Slot* FindSlot(uint64_t id) const;
+    const char* Store(std::string_view str);
+    void Grow();
+
+    mutable std::shared_mutex mutex_;
+    std::vector<Slot> slots_;
+    size_t count_ = 0;
+
+    // Арена текста: блоки не перемещаются и не освобождаются
+    std::vector<std::unique_ptr<char[]>> blocks_;
+    char* block_ = nullptr;
+    size_t block_used_ = 0;
+    size_t arena_bytes_ = 0;
+};
+
+namespace literals {
+
+consteval StringId operator""_sid(const char* str, size_t size) {
+    return StringId::Hash(std::string_view(str, size));
+}
+
+}  // namespace literals
+
+}  // namespace tryengine::core
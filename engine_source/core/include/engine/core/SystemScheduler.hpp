@@ -0,0 +1,131 @@
+#pragma once
+
+#include <atomic>
+#include <entt/core/type_info.hpp>
+#include <entt/entity/registry.hpp>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace tryengine::core {
+
+class JobSystem;
+class JobCounter;
+
+// Что система читает и пишет. Компоненты (Read/Write) заодно гарантируют, что пул в реестре создан
+// до старта кадра — параллельные системы не должны менять набор пулов реестра.
+// Ресурсы (ReadResource/WriteResource) — любые разделяемые объекты: сервисы, переменные контекста.
+class SystemAccess {
+public:
+    template <typename... Components>
+    SystemAccess& Read() {
+        (Add<Components>(reads_, true), ...);
+        return *this;
+    }
+
+    template <typename... Components>
+    SystemAccess& Write() {
+        (Add<Components>(writes_, true), ...);
+        return *this;
+    }
+
+    template <typename... Resources>
+    SystemAccess& ReadResource() {
+        (Add<Resources>(reads_, false), ...);
+        return *this;
+    }
+
+    template <typename... Resources>
+    SystemAccess& WriteResource() {
+        (Add<Resources>(writes_, false), ...);
+        return *this;
+    }
+
+    // Система выполняется только на главном потоке (SDL, ImGui, скрипты)
+    SystemAccess& OnMainThread() {
+        main_thread_ = true;
+        return *this;
+    }
+
+    // Подготовка на главном потоке перед кадром: создать переменные контекста, подписаться на сигналы и т.п.
+    SystemAccess& Prepare(std::function<void(entt::registry&)> fn) {
+        prepare_.push_back(std::move(fn));
+        return *this;
+    }
+
+    [[nodiscard]] bool ConflictsWith(const SystemAccess& other) const;
+
+private:
+    friend class SystemScheduler;
+
+    struct Entry {
+        entt::id_type id;
+        std::string_view name;
+    };
+
+    template <typename T>
+    void Add(std::vector<Entry>& entries, bool component) {
+        entries.push_back({entt::type_hash<T>::value(), entt::type_name<T>::value()});
+        if (component) {
+            prepare_.emplace_back([](entt::registry& reg) { reg.storage<T>(); });
+        }
+    }
+
+    std::vector<Entry> reads_;
+    std::vector<Entry> writes_;
+    std::vector<std::function<void(entt::registry&)>> prepare_;
+    bool main_thread_ = false;
+};
+
+// Кадр как граф систем. Ребро A -> B ставится, если B зарегистрирована позже A и их доступы
+// конфликтуют (запись/запись или запись/чтение одного типа). Остальные системы идут параллельно в JobSystem.
+class SystemScheduler {
+public:
+    using SystemFn = std::function<void(entt::registry& reg, float dt)>;
+
+    struct SystemStats {
+        std::string_view name;
+        double last_ms = 0.0;
+        double average_ms = 0.0;
+    };
+
+    explicit SystemScheduler(JobSystem& jobs);
+    ~SystemScheduler();
+
+    void Add(std::string name, SystemAccess access, SystemFn fn);
+
+    // Блокирующий. Вызывать с главного потока
+    void Run(entt::registry& reg, float dt);
+
+    // Граф выполнения в формате Graphviz DOT (с последними таймингами)
+    [[nodiscard]] std::string DumpGraph();
+    [[nodiscard]] std::vector<SystemStats> GetStats() const;
+
+private:
+    struct Node {
+        std::string name;
+        SystemAccess access;
+        SystemFn fn;
+        // Зона профайлера с именем системы
+        uint32_t zone = 0;
+
+        std::vector<uint32_t> successors;
+        uint32_t predecessor_count = 0;
+        std::atomic<uint32_t> remaining{0};
+
+        double last_ms = 0.0;
+        double average_ms = 0.0;
+    };
+
+    void Build();
+    void Launch(uint32_t index, entt::registry& reg, float dt, JobCounter& frame);
+
+    JobSystem& jobs_;
+    std::vector<std::unique_ptr<Node>> nodes_;
+    std::vector<uint32_t> roots_;
+    bool dirty_ = true;
+};
+
+}  // namespace tryengine::core
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstdint>
+#include <entt/entity/registry.hpp>
+#include <limits>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace tryengine::core {
+class SceneGraph;
+
+// Плоское представление дерева трансформов: сущности сгруппированы по глубине,
+// родитель всегда лежит раньше детей. Перестраивается только при смене структуры
+// (reparent, создание/удаление Transform или Relationship), а не каждый кадр.
+class TransformHierarchy {
+public:
+    static constexpr uint32_t kNoParent = std::numeric_limits<uint32_t>::max();
+
+    void MarkDirty() { dirty_ = true; }
+    [[nodiscard]] bool IsDirty() const { return dirty_; }
+
+    // Возвращает true, если представление было перестроено
+    bool RebuildIfDirty(const entt::registry& reg, const SceneGraph& graph);
+
+    [[nodiscard]] std::span<const entt::entity> GetEntities() const { return entities_; }
+    [[nodiscard]] std::span<const uint32_t> GetParentIndices() const { return parent_indices_; }
+
+    // Индекс сущности в плоском массиве или kNoParent, если ее нет в иерархии
+    [[nodiscard]] uint32_t IndexOf(entt::entity entity) const;
+
+    // Флаги "пересчитать world_matrix" по индексам плоского массива. Заполняются перед
+    // обновлением, во время прохода по уровням флаг родителя наследуется детьми.
+    [[nodiscard]] std::span<uint8_t> GetDirtyFlags() { return dirty_flags_; }
+    void ResetDirtyFlags(bool value);
+
+    // Сколько world_matrix реально пересчитано за последнее обновление
+    [[nodiscard]] uint32_t GetUpdatedCount() const { return updated_count_; }
+    void SetUpdatedCount(uint32_t count) { updated_count_ = count; }
+
+    [[nodiscard]] size_t GetLevelCount() const { return level_offsets_.empty() ? 0 : level_offsets_.size() - 1; }
+    [[nodiscard]] std::pair<size_t, size_t> GetLevelRange(size_t level) const {
+        return {level_offsets_[level], level_offsets_[level + 1]};
+    }
+
+private:
+    void Rebuild(const entt::registry& reg, const SceneGraph& graph);
+    void BuildIndex();
+
+    std::vector<entt::entity> entities_;
+    std::vector<uint32_t> parent_indices_;
+    std::vector<size_t> level_offsets_;
+    // entt::to_entity(entity) -> индекс в entities_
+    std::vector<uint32_t> index_of_;
+    std::vector<uint8_t> dirty_flags_;
+    uint32_t updated_count_ = 0;
+    bool dirty_ = true;
+};
+
+// Создает TransformHierarchy в контексте реестра и подписывает ее на сигналы Transform/Relationship.
+// Повторный вызов ничего не делает.
+TransformHierarchy& AcquireTransformHierarchy(entt::registry& reg);
+
+// Вешает TransformDirty на сущность. Подписан на on_construct/on_update<Transform>
+void MarkTransformDirty(entt::registry& reg, entt::entity entity);
+
+// Обработчик сигналов EnTT. SceneGraph::SetParent вызывает patch<Relationship> — это тоже приведет сюда.
+void MarkHierarchyDirty(entt::registry& reg, entt::entity entity = entt::null);
+
+}  // namespace tryengine::core
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstddef>
+#include <glm/glm.hpp>
+
+namespace tryengine {
+struct Transform;
+}
+
+namespace tryengine::core {
+
+// Сколько трансформов имеет смысл копить перед вызовом ComposeWorldMatrices
+constexpr size_t kTransformBatchSize = 64;
+
+// Пакетная сборка out[i] = parents[i] * T * R * S по position/rotation/scale из transforms[i].
+// parents[i] == nullptr — родителя нет, пишется локальная матрица.
+// Кватернионы переводятся в матрицы по 4 (SSE2) или 8 (AVX2) штук за раз, умножение на родителя
+// идет по столбцам без полного 4x4 умножения. Без SIMD — скалярная версия с тем же результатом.
+// out[i] не должен совпадать с матрицей родителя другого элемента этой же пачки.
+void ComposeWorldMatrices(size_t count, const Transform* const* transforms, const glm::mat4* const* parents,
+                          glm::mat4* const* out);
+
+// Какой путь выбран при сборке: "AVX2", "SSE2" или "Scalar"
+const char* GetTransformKernelName();
+
+}  // namespace tryengine::core
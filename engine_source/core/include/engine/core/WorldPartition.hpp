@@ -0,0 +1,142 @@
+#pragma once
+
+#include <cstdint>
+#include <entt/entity/registry.hpp>
+#include <filesystem>
+#include <glm/vec3.hpp>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace tryengine::core {
+
+class ComponentRegistry;
+class ResourceManager;
+class SceneLoadOperation;
+class SceneManager;
+
+// Уровень, нарезанный на квадратные ячейки по XZ. Ячейка — отдельная запеченная сцена (SceneFormat),
+// рядом лежит манифест kWorldPartitionManifest со списком ячеек
+inline constexpr uint32_t kWorldPartitionVersion = 1;
+inline constexpr const char* kWorldPartitionManifest = "world.partition";
+
+struct WorldCell {
+    int32_t x = 0;
+    int32_t z = 0;
+    // Сущности, у корня которых нет Transform (менеджеры, настройки уровня): грузятся сразу и не выгружаются
+    bool persistent = false;
+    // Размер запеченной ячейки — оценка памяти, которую она займет
+    uint64_t bytes = 0;
+    uint64_t entity_count = 0;
+    // Относительно папки манифеста
+    std::string file;
+};
+
+struct WorldPartitionManifest {
+    float cell_size = 0.0f;
+    std::vector<WorldCell> cells;
+};
+
+// Раскладывает сущности level по ячейкам cell_size x cell_size и пишет ячейки и манифест в directory.
+// Ячейку сущности определяет позиция ее корня по Relationship, поэтому иерархия не рвется между ячейками;
+// ссылки на сущности других ячеек обнуляются
+bool CookWorldPartition(const entt::registry& level, const ComponentRegistry& components, float cell_size,
+                        const std::filesystem::path& directory);
+
+bool ReadWorldPartition(const std::filesystem::path& manifest_path, WorldPartitionManifest& manifest);
+
+struct WorldStreamerConfig {
+    // Ячейки ближе load_radius грузятся, дальше unload_radius — выгружаются. Разрыв между радиусами не дает
+    // ячейке на границе грузиться и выгружаться каждый кадр
+    float load_radius = 150.0f;
+    float unload_radius = 200.0f;
+    // Предел суммы WorldCell::bytes загруженных и грузящихся ячеек; 0 — без предела.
+    // Не влезающая ячейка вытесняет более дальние, иначе ждет
+    uint64_t memory_budget = 0;
+    uint32_t max_loads_in_flight = 4;
+};
+
+struct WorldStreamerStats {
+    uint32_t loaded = 0;
+    uint32_t loading = 0;
+    uint64_t resident_bytes = 0;
+    uint64_t peak_resident_bytes = 0;
+    uint64_t loads = 0;
+    uint64_t unloads = 0;
+    // Сколько раз ближайшая ячейка не влезла в бюджет даже после вытеснения
+    uint64_t budget_skips = 0;
+    uint64_t purges = 0;
+};
+
+// Подгружает ячейки вокруг точки интереса (камеры) аддитивно в активную сцену через SceneManager и
+// выгружает дальние. Когда выгрузка дошла до конца, ResourceManager::UpdatePurge отпускает ресурсы,
+// на которые ссылались только выгруженные ячейки. SceneManager::Update по-прежнему зовет приложение.
+// Смена активной сцены в обход стримера (LoadScene, SetActiveScene) сбрасывает его ячейки — после нее нужен Open
+class WorldStreamer {
+public:
+    WorldStreamer(SceneManager& scenes, ResourceManager& resources, WorldStreamerConfig config = {});
+
+    WorldStreamer(const WorldStreamer&) = delete;
+    WorldStreamer& operator=(const WorldStreamer&) = delete;
+
+    // Регистрирует ячейки в AssetDatabase и запускает загрузку постоянной ячейки
+    bool Open(const std::filesystem::path& manifest_path);
+
+    // Раз в кадр с главного потока, до SceneManager::Update
+    void Update(const glm::vec3& focus);
+    // Точка интереса — камера с MainCameraTag в активной сцене (пока ее нет — прошлая точка)
+    void Update();
+
+    // Ячейка под точкой загружена (или ячейки там нет) — иначе игрок видит пустое место
+    [[nodiscard]] bool IsLoadedAt(const glm::vec3& point) const;
+    [[nodiscard]] const WorldStreamerStats& GetStats() const { return stats_; }
+    [[nodiscard]] const WorldPartitionManifest& GetManifest() const { return manifest_; }
+    [[nodiscard]] const WorldStreamerConfig& GetConfig() const { return config_; }
+
+private:
+    enum class CellState { Unloaded, Loading, Loaded };
+
+    struct Cell {
+        uint64_t scene_id = 0;
+        CellState state = CellState::Unloaded;
+        // Загрузка не удалась — больше не пробуем
+        bool failed = false;
+        std::shared_ptr<const SceneLoadOperation> operation;
+    };
+
+    static uint64_t Key(int32_t x, int32_t z) {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(z);
+    }
+    // До прямоугольника ячейки по XZ; 0 — точка внутри
+    [[nodiscard]] float Distance(size_t index, const glm::vec3& point) const;
+
+    void Poll();
+    void Load(size_t index);
+    void Unload(size_t index);
+    // Выгружает загруженные ячейки дальше distance, самые дальние первыми, пока needed байт не влезут в бюджет
+    bool Evict(uint64_t needed, float distance, const glm::vec3& focus);
+
+    SceneManager& scenes_;
+    ResourceManager& resources_;
+    WorldStreamerConfig config_;
+    WorldStreamerStats stats_;
+
+    WorldPartitionManifest manifest_;
+    std::vector<Cell> cells_;
+    // (x, z) -> индекс в cells_, без постоянной ячейки
+    std::unordered_map<uint64_t, size_t> grid_;
+    // Границы сетки: кандидаты на загрузку ищутся только по клеткам вокруг точки внутри них
+    int32_t min_x_ = 0;
+    int32_t max_x_ = -1;
+    int32_t min_z_ = 0;
+    int32_t max_z_ = -1;
+    // Загруженные и грузящиеся ячейки
+    std::vector<size_t> resident_;
+    std::vector<std::pair<float, size_t>> candidates_;
+    glm::vec3 focus_{0.0f};
+    bool purge_pending_ = false;
+};
+
+}  // namespace tryengine::core
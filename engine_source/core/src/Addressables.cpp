@@ -0,0 +1,184 @@
+#include "engine/core/Addressables.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <system_error>
+
+namespace tryengine::core {
+
+namespace {
+
+std::filesystem::path GetAddressablesDir() {
+    return std::filesystem::current_path() / "game" / "project_data" / "addressables";
+}
+
+std::filesystem::path GetIndexPath() {
+    return std::filesystem::current_path() / "game" / ".cache" / "addressables.index";
+}
+
+// Отпечаток манифеста и файлов групп по именам, размерам и времени записи — без чтения содержимого
+uint64_t GetSourceStamp(const std::filesystem::path& dir) {
+    std::vector<std::string> entries;
+    const auto add = [&](const std::filesystem::path& path) {
+        std::error_code error;
+        const auto size = std::filesystem::file_size(path, error);
+        const auto time = std::filesystem::last_write_time(path, error);
+        if (error)
+            return;
+        entries.push_back(path.filename().string() + ':' + std::to_string(size) + ':' +
+                          std::to_string(time.time_since_epoch().count()));
+    };
+
+    add(dir / "addressables.addressables");
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator(dir / "asset_groups", error)) {
+        if (entry.path().extension() == ".asset_group") {
+            add(entry.path());
+        }
+    }
+
+    // Порядок обхода каталога не определен
+    std::sort(entries.begin(), entries.end());
+    std::string joined;
+    for (const auto& entry : entries) {
+        joined += entry;
+        joined += '\n';
+    }
+    return HashString(joined);
+}
+
+}  // namespace
+
+void Addressables::Refresh() {
+    addressables_groups_.clear();
+    const auto dir = GetAddressablesDir();
+    const auto index_path = GetIndexPath();
+    const uint64_t stamp = GetSourceStamp(dir);
+
+    if (index_.Open(index_path, stamp)) {
+        groups_loaded_ = false;
+        std::cout << "[Addressables]: loaded index with " << index_.Size() << " addresses" << std::endl;
+        return;
+    }
+
+    LoadGroups();
+    index_.Build(addressables_groups_);
+
+    std::error_code error;
+    std::filesystem::create_directories(index_path.parent_path(), error);
+    index_.Write(index_path, stamp);
+}
+
+uint64_t Addressables::Get(std::string_view address) const {
+    const uint64_t guid = index_.Find(address);
+    if (guid == 0) {
+        std::cerr << "[Addressables]: Could not find " << address << std::endl;
+    }
+    return guid;
+}
+
+const std::vector<AddressablesGroupAsset>& Addressables::GetGroups() {
+    if (!groups_loaded_) {
+        LoadGroups();
+    }
+    return addressables_groups_;
+}
+
+const AddressablesGroupAsset* Addressables::FindGroup(std::string_view name) {
+    return FindGroupMutable(name);
+}
+
+void Addressables::AddGroup(const AddressablesGroupAsset& group) {
+    std::vector<std::string> addresses;
+    if (auto* existing = FindGroupMutable(group.name)) {
+        for (const auto& [address, guid] : existing->map) {
+            addresses.push_back(address);
+        }
+        *existing = group;
+    } else {
+        addressables_groups_.push_back(group);
+    }
+
+    for (const auto& [address, guid] : group.map) {
+        addresses.push_back(address);
+    }
+    for (const auto& address : addresses) {
+        UpdateAddress(address);
+    }
+}
+
+void Addressables::RemoveGroup(std::string_view name) {
+    auto* target = FindGroupMutable(name);
+    if (!target)
+        return;
+
+    // name может указывать в удаляемую группу — дальше не используется
+    const AddressablesGroupAsset removed = std::move(*target);
+    addressables_groups_.erase(addressables_groups_.begin() + (target - addressables_groups_.data()));
+    for (const auto& [address, guid] : removed.map) {
+        UpdateAddress(address);
+    }
+}
+
+void Addressables::SetAddress(std::string_view group, std::string_view address, uint64_t guid) {
+    auto* target = FindGroupMutable(group);
+    if (!target) {
+        target = &addressables_groups_.emplace_back();
+        target->name = std::string(group);
+    }
+    target->map[std::string(address)] = guid;
+    UpdateAddress(address);
+}
+
+void Addressables::RemoveAddress(std::string_view group, std::string_view address) {
+    auto* target = FindGroupMutable(group);
+    if (!target)
+        return;
+    target->map.erase(std::string(address));
+    UpdateAddress(address);
+}
+
+void Addressables::LoadGroups() {
+    addressables_groups_.clear();
+    const auto dir = GetAddressablesDir();
+
+    AddressablesManifestAsset asset;
+    {
+        std::ifstream is(dir / "addressables.addressables");
+        cereal::JSONInputArchive archive(is);
+        archive(asset);
+    }
+    for (auto& asset_group_name : asset.asset_groups) {
+        AddressablesGroupAsset asset_group_asset;
+        {
+            std::ifstream is(dir / "asset_groups" / (asset_group_name + ".asset_group"));
+            cereal::JSONInputArchive archive(is);
+            archive(asset_group_asset);
+        }
+        std::cout << "[Addressables]: added asset group " << asset_group_asset.name << std::endl;
+        addressables_groups_.push_back(asset_group_asset);
+    }
+    groups_loaded_ = true;
+}
+
+void Addressables::UpdateAddress(std::string_view address) {
+    const std::string key(address);
+    for (const auto& group : addressables_groups_) {
+        const auto it = group.map.find(key);
+        if (it != group.map.end()) {
+            index_.Set(address, it->second);
+            return;
+        }
+    }
+    index_.Erase(address);
+}
+
+AddressablesGroupAsset* Addressables::FindGroupMutable(std::string_view name) {
+    GetGroups();
+    const auto it = std::find_if(addressables_groups_.begin(), addressables_groups_.end(),
+                                 [&](const AddressablesGroupAsset& group) { return group.name == name; });
+    return it != addressables_groups_.end() ? &*it : nullptr;
+}
+
+}  // namespace tryengine::core
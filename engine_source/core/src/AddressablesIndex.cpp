@@ -0,0 +1,303 @@
+#include "engine/core/AddressablesIndex.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <system_error>
+#include <utility>
+
+namespace tryengine::core {
+
+namespace {
+
+constexpr size_t kSectionAlignment = 64;
+constexpr size_t kMinSlots = 16;
+
+size_t Align(size_t offset) {
+    return (offset + kSectionAlignment - 1) & ~(kSectionAlignment - 1);
+}
+
+// Дописывает секцию с выравниванием, возвращает ее смещение
+size_t AppendSection(std::vector<std::byte>& out, const void* data, size_t size) {
+    const size_t offset = Align(out.size());
+    out.resize(offset + size);
+    if (size > 0) {
+        std::memcpy(out.data() + offset, data, size);
+    }
+    return offset;
+}
+
+bool InRange(std::span<const std::byte> data, uint64_t offset, uint64_t size) {
+    return offset % kSectionAlignment == 0 && offset <= data.size() && size <= data.size() - offset;
+}
+
+// Заполненность не выше половины — цепочки проб короткие
+size_t SlotCountFor(size_t entries) {
+    size_t slots = kMinSlots;
+    while (slots < entries * 2) {
+        slots *= 2;
+    }
+    return slots;
+}
+
+void LogCollision(std::string_view address, std::string_view existing) {
+    std::cerr << "[Addressables]: Hash collision: \"" << address << "\" and \"" << existing << "\", keeping the latter"
+              << std::endl;
+}
+
+}  // namespace
+
+void AddressablesIndex::Build(std::span<const AddressablesGroupAsset> groups) {
+    size_t total = 0;
+    for (const auto& group : groups) {
+        total += group.map.size();
+    }
+
+    file_.Close();
+    owned_ = true;
+    count_ = 0;
+    own_text_.clear();
+    own_slots_.assign(SlotCountFor(total), {});
+    Rebind();
+
+    for (const auto& group : groups) {
+        for (const auto& [address, guid] : group.map) {
+            if (address.empty())
+                continue;
+
+            const uint64_t id = HashString(address);
+            if (const size_t index = FindIndex(id); index != kNoSlot) {
+                // Тот же адрес в следующей группе не перекрывает первую
+                if (SlotText(slots_[index]) != address) {
+                    LogCollision(address, SlotText(slots_[index]));
+                }
+                continue;
+            }
+            Insert(id, address, guid);
+        }
+    }
+}
+
+bool AddressablesIndex::Open(const std::filesystem::path& path, uint64_t source_stamp) {
+    MappedFile file;
+    if (!file.Open(path))
+        return false;
+
+    const auto data = file.GetData();
+    CookedAddressablesHeader header;
+    if (data.size() < sizeof(header) || std::memcmp(data.data(), header.magic, sizeof(header.magic)) != 0)
+        return false;
+
+    std::memcpy(&header, data.data(), sizeof(header));
+    if (header.version != kCookedAddressablesVersion || header.source_stamp != source_stamp)
+        return false;
+
+    const uint64_t slot_count = header.slot_count;
+    if (slot_count == 0 || (slot_count & (slot_count - 1)) != 0 || header.entry_count * 2 > slot_count ||
+        slot_count > data.size() / sizeof(CookedAddressSlot) ||
+        !InRange(data, header.slots_offset, slot_count * sizeof(CookedAddressSlot)) ||
+        !InRange(data, header.text_offset, header.text_size)) {
+        std::cerr << "[Addressables]: Corrupted index " << path << std::endl;
+        return false;
+    }
+
+    const std::span slots(reinterpret_cast<const CookedAddressSlot*>(data.data() + header.slots_offset),
+                          static_cast<size_t>(slot_count));
+    size_t entries = 0;
+    for (const auto& slot : slots) {
+        if (slot.id == 0)
+            continue;
+        ++entries;
+        if (static_cast<uint64_t>(slot.text_offset) + slot.text_size > header.text_size) {
+            std::cerr << "[Addressables]: Corrupted index " << path << std::endl;
+            return false;
+        }
+    }
+    if (entries != header.entry_count) {
+        std::cerr << "[Addressables]: Corrupted index " << path << std::endl;
+        return false;
+    }
+
+    // Данные отображения не переезжают вместе с MappedFile
+    file_ = std::move(file);
+    owned_ = false;
+    own_slots_.clear();
+    own_text_.clear();
+    slots_ = slots;
+    text_ = {reinterpret_cast<const char*>(data.data() + header.text_offset), static_cast<size_t>(header.text_size)};
+    count_ = entries;
+    return true;
+}
+
+bool AddressablesIndex::Write(const std::filesystem::path& path, uint64_t source_stamp) const {
+    CookedAddressablesHeader header;
+    header.source_stamp = source_stamp;
+    header.entry_count = count_;
+
+    // Текст удаленных адресов в файл не попадает
+    std::vector<CookedAddressSlot> slots(slots_.begin(), slots_.end());
+    if (slots.empty()) {
+        slots.resize(kMinSlots);
+    }
+    std::string text;
+    for (auto& slot : slots) {
+        if (slot.id == 0)
+            continue;
+        const auto address = SlotText(slot);
+        slot.text_offset = static_cast<uint32_t>(text.size());
+        text.append(address);
+    }
+    header.slot_count = slots.size();
+    header.text_size = text.size();
+
+    std::vector<std::byte> out(sizeof(header));
+    header.slots_offset = AppendSection(out, slots.data(), slots.size() * sizeof(CookedAddressSlot));
+    header.text_offset = AppendSection(out, text.data(), text.size());
+    std::memcpy(out.data(), &header, sizeof(header));
+
+    // Через временный файл: другой процесс может держать старый индекс отображенным
+    auto temp_path = path;
+    temp_path += ".tmp";
+    {
+        std::ofstream os(temp_path, std::ios::binary | std::ios::trunc);
+        if (!os.is_open()) {
+            std::cerr << "[Addressables]: Failed to open " << temp_path << std::endl;
+            return false;
+        }
+        os.write(reinterpret_cast<const char*>(out.data()), static_cast<std::streamsize>(out.size()));
+        if (!os)
+            return false;
+    }
+
+    std::error_code error;
+    std::filesystem::rename(temp_path, path, error);
+    if (error) {
+        std::cerr << "[Addressables]: Failed to write " << path << ": " << error.message() << std::endl;
+        return false;
+    }
+    return true;
+}
+
+uint64_t AddressablesIndex::Find(std::string_view address) const {
+    const size_t index = FindIndex(HashString(address));
+    if (index == kNoSlot || SlotText(slots_[index]) != address)
+        return 0;
+    return slots_[index].guid;
+}
+
+uint64_t AddressablesIndex::Find(StringId address) const {
+    const size_t index = FindIndex(address.GetId());
+    return index != kNoSlot ? slots_[index].guid : 0;
+}
+
+void AddressablesIndex::Set(std::string_view address, uint64_t guid) {
+    if (address.empty())
+        return;
+
+    Detach();
+    const uint64_t id = HashString(address);
+    const size_t index = FindIndex(id);
+    if (index == kNoSlot) {
+        Insert(id, address, guid);
+        return;
+    }
+
+    if (SlotText(own_slots_[index]) != address) {
+        LogCollision(address, SlotText(own_slots_[index]));
+        return;
+    }
+    own_slots_[index].guid = guid;
+}
+
+void AddressablesIndex::Erase(std::string_view address) {
+    size_t index = FindIndex(HashString(address));
+    if (index == kNoSlot || SlotText(slots_[index]) != address)
+        return;
+
+    Detach();
+    // Удаление со сдвигом назад: слоты, чья цепочка проб проходила через удаленный, подтягиваются,
+    // и поиск по-прежнему останавливается на первом пустом слоте
+    const size_t mask = own_slots_.size() - 1;
+    for (size_t next = (index + 1) & mask; own_slots_[next].id != 0; next = (next + 1) & mask) {
+        const size_t home = static_cast<size_t>(own_slots_[next].id) & mask;
+        const bool movable = index <= next ? (home <= index || home > next) : (home <= index && home > next);
+        if (movable) {
+            own_slots_[index] = own_slots_[next];
+            index = next;
+        }
+    }
+    own_slots_[index] = {};
+    --count_;
+}
+
+size_t AddressablesIndex::FindIndex(uint64_t id) const {
+    if (id == 0 || slots_.empty())
+        return kNoSlot;
+
+    const size_t mask = slots_.size() - 1;
+    for (size_t index = static_cast<size_t>(id) & mask; slots_[index].id != 0; index = (index + 1) & mask) {
+        if (slots_[index].id == id)
+            return index;
+    }
+    return kNoSlot;
+}
+
+std::string_view AddressablesIndex::SlotText(const CookedAddressSlot& slot) const {
+    return text_.substr(slot.text_offset, slot.text_size);
+}
+
+void AddressablesIndex::Detach() {
+    if (owned_)
+        return;
+
+    own_slots_.assign(slots_.begin(), slots_.end());
+    own_text_.assign(text_.begin(), text_.end());
+    if (own_slots_.empty()) {
+        own_slots_.resize(kMinSlots);
+    }
+    owned_ = true;
+    Rebind();
+    file_.Close();
+}
+
+void AddressablesIndex::Grow(size_t slot_count) {
+    std::vector<CookedAddressSlot> slots(slot_count);
+    const size_t mask = slots.size() - 1;
+    for (const auto& slot : own_slots_) {
+        if (slot.id == 0)
+            continue;
+        size_t index = static_cast<size_t>(slot.id) & mask;
+        while (slots[index].id != 0) {
+            index = (index + 1) & mask;
+        }
+        slots[index] = slot;
+    }
+    own_slots_ = std::move(slots);
+}
+
+void AddressablesIndex::Insert(uint64_t id, std::string_view address, uint64_t guid) {
+    if ((count_ + 1) * 2 > own_slots_.size()) {
+        Grow(SlotCountFor(count_ + 1));
+    }
+
+    const auto text_offset = static_cast<uint32_t>(own_text_.size());
+    own_text_.insert(own_text_.end(), address.begin(), address.end());
+
+    const size_t mask = own_slots_.size() - 1;
+    size_t index = static_cast<size_t>(id) & mask;
+    while (own_slots_[index].id != 0) {
+        index = (index + 1) & mask;
+    }
+    own_slots_[index] = {id, guid, text_offset, static_cast<uint32_t>(address.size())};
+    ++count_;
+    Rebind();
+}
+
+void AddressablesIndex::Rebind() {
+    slots_ = own_slots_;
+    text_ = {own_text_.data(), own_text_.size()};
+}
+
+}  // namespace tryengine::core
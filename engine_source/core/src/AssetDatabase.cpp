@@ -1,44 +1,237 @@
 #include "engine/core/AssetDatabase.hpp"
-#include <iostream>
+#include <algorithm>
 #include <charconv>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <span>
+#include <system_error>
+#include <utility>
+
+#include "engine/core/MappedFile.hpp"
+#include "engine/core/StringId.hpp"
 
 namespace tryengine::core {
 
+namespace {
+
+constexpr size_t kSectionAlignment = 64;
+
+size_t Align(size_t offset) {
+    return (offset + kSectionAlignment - 1) & ~(kSectionAlignment - 1);
+}
+
+// Дописывает секцию с выравниванием, возвращает ее смещение
+size_t AppendSection(std::vector<std::byte>& out, const void* data, size_t size) {
+    const size_t offset = Align(out.size());
+    out.resize(offset + size);
+    if (size > 0) {
+        std::memcpy(out.data() + offset, data, size);
+    }
+    return offset;
+}
+
+bool InRange(std::span<const std::byte> data, uint64_t offset, uint64_t size) {
+    return offset % kSectionAlignment == 0 && offset <= data.size() && size <= data.size() - offset;
+}
+
+}  // namespace
+
 void AssetDatabase::Refresh() {
-    id_to_path_.clear();
+    if (LoadIndex()) {
+        std::cout << "Registered " << artifacts_.size() << " Artifacts from index" << std::endl;
+        return;
+    }
+
+    Rescan();
+    SaveIndex();
+}
+
+void AssetDatabase::Rescan() {
+    artifacts_.clear();
 
     for (const auto& artifact_dir : artifacts_dirs_) {
         if (!std::filesystem::exists(artifact_dir)) {
             continue;
         }
 
+        // Путь корня относительно проекта считается один раз, а не relative() на каждый файл
+        const std::string root_prefix = GetRelativeDir(artifact_dir);
+
         // Проходим по папкам GUID (например, Game/Artifacts/12345...)
         for (const auto& guidDirEntry : std::filesystem::directory_iterator(artifact_dir)) {
             if (!guidDirEntry.is_directory()) continue;
 
-            // Проходим по файлам внутри папки GUID
-            for (const auto& directory_entry : std::filesystem::directory_iterator(guidDirEntry.path())) {
-                if (!directory_entry.is_regular_file()) continue;
+            const auto& guid_dir = guidDirEntry.path();
+            ScanArtifactDir(guid_dir, (std::filesystem::path(root_prefix) / guid_dir.filename() / "").string());
+        }
+    }
+    index_dirty_ = true;
 
-                const auto& filePath = directory_entry.path();
-                std::string fileName = filePath.stem().string();
+    // Отладка
+    std::cout << "Registered "<< artifacts_.size() << " Artifacts" << std::endl;
+}
 
-                AssetID assetId = 0;
-                auto [ptr, ec] = std::from_chars(fileName.data(), fileName.data() + fileName.size(), assetId);
+void AssetDatabase::UpdateArtifactDir(const std::filesystem::path& dir) {
+    const std::string prefix = GetRelativeDir(dir);
+    EraseArtifactDir(prefix);
+    ScanArtifactDir(dir, prefix);
+    index_dirty_ = true;
+}
 
-                if (ec == std::errc()) {
-                    // Регистрируем путь относительно корня проекта
-                    std::filesystem::path relPath = std::filesystem::relative(filePath, root_path_);
-                    id_to_path_[assetId] = relPath.string();
-                } else {
-                    std::cerr << "Warning: File " << fileName << " is not a valid AssetID (not a number)" << std::endl;
-                }
-            }
+void AssetDatabase::RemoveArtifactDir(const std::filesystem::path& dir) {
+    EraseArtifactDir(GetRelativeDir(dir));
+    index_dirty_ = true;
+}
+
+bool AssetDatabase::SaveIndex() {
+    if (!index_dirty_)
+        return true;
+
+    // По id — одинаковые базы дают одинаковый файл
+    std::vector<std::pair<AssetID, const Artifact*>> sorted;
+    sorted.reserve(artifacts_.size());
+    for (const auto& [id, artifact] : artifacts_) {
+        if (artifact.indexed) {
+            sorted.emplace_back(id, &artifact);
         }
     }
+    std::sort(sorted.begin(), sorted.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
 
-    // Отладка
-    std::cout << "Registered "<< id_to_path_.size() << " Artifacts" << std::endl;
+    std::vector<ArtifactIndexEntry> entries;
+    entries.reserve(sorted.size());
+    std::string text;
+    for (const auto& [id, artifact] : sorted) {
+        entries.push_back({id, artifact->size, artifact->write_time, static_cast<uint32_t>(text.size()),
+                           static_cast<uint32_t>(artifact->path.size())});
+        text += artifact->path;
+    }
+
+    ArtifactIndexHeader header;
+    header.roots_stamp = GetRootsStamp();
+    header.entry_count = entries.size();
+    header.text_size = text.size();
+
+    std::vector<std::byte> out(sizeof(header));
+    header.entries_offset = AppendSection(out, entries.data(), entries.size() * sizeof(ArtifactIndexEntry));
+    header.text_offset = AppendSection(out, text.data(), text.size());
+    std::memcpy(out.data(), &header, sizeof(header));
+
+    std::error_code error;
+    std::filesystem::create_directories(index_path_.parent_path(), error);
+
+    // Через временный файл: сервер может читать индекс, пока редактор его переписывает
+    auto temp_path = index_path_;
+    temp_path += ".tmp";
+    {
+        std::ofstream os(temp_path, std::ios::binary | std::ios::trunc);
+        if (!os.is_open()) {
+            std::cerr << "ASSET DATABASE: Failed to open " << temp_path << std::endl;
+            return false;
+        }
+        os.write(reinterpret_cast<const char*>(out.data()), static_cast<std::streamsize>(out.size()));
+        if (!os)
+            return false;
+    }
+    std::filesystem::rename(temp_path, index_path_, error);
+    if (error) {
+        std::cerr << "ASSET DATABASE: Failed to write " << index_path_ << ": " << error.message() << std::endl;
+        return false;
+    }
+
+    index_dirty_ = false;
+    return true;
+}
+
+bool AssetDatabase::LoadIndex() {
+    MappedFile file;
+    if (!file.Open(index_path_))
+        return false;
+
+    const auto data = file.GetData();
+    ArtifactIndexHeader header;
+    if (data.size() < sizeof(header) || std::memcmp(data.data(), header.magic, sizeof(header.magic)) != 0)
+        return false;
+
+    std::memcpy(&header, data.data(), sizeof(header));
+    if (header.version != kArtifactIndexVersion || header.roots_stamp != GetRootsStamp())
+        return false;
+
+    if (header.entry_count > data.size() / sizeof(ArtifactIndexEntry) ||
+        !InRange(data, header.entries_offset, header.entry_count * sizeof(ArtifactIndexEntry)) ||
+        !InRange(data, header.text_offset, header.text_size)) {
+        std::cerr << "ASSET DATABASE: Corrupted index " << index_path_ << std::endl;
+        return false;
+    }
+
+    const std::span entries(reinterpret_cast<const ArtifactIndexEntry*>(data.data() + header.entries_offset),
+                            static_cast<size_t>(header.entry_count));
+    const std::string_view text(reinterpret_cast<const char*>(data.data() + header.text_offset),
+                                static_cast<size_t>(header.text_size));
+
+    artifacts_.clear();
+    artifacts_.reserve(entries.size());
+    for (const auto& entry : entries) {
+        if (static_cast<uint64_t>(entry.path_offset) + entry.path_size > text.size()) {
+            std::cerr << "ASSET DATABASE: Corrupted index " << index_path_ << std::endl;
+            artifacts_.clear();
+            return false;
+        }
+        artifacts_[entry.id] = {std::string(text.substr(entry.path_offset, entry.path_size)), entry.size,
+                                entry.write_time, true};
+    }
+    index_dirty_ = false;
+    return true;
+}
+
+uint64_t AssetDatabase::GetRootsStamp() const {
+    // Создание и удаление папок GUID меняет время записи корня — stat на корень вместо обхода дерева
+    std::string stamp;
+    for (const auto& artifact_dir : artifacts_dirs_) {
+        std::error_code error;
+        const auto time = std::filesystem::last_write_time(artifact_dir, error);
+        stamp += artifact_dir.string();
+        stamp += ':';
+        stamp += error ? "missing" : std::to_string(time.time_since_epoch().count());
+        stamp += '\n';
+    }
+    return HashString(stamp);
+}
+
+void AssetDatabase::ScanArtifactDir(const std::filesystem::path& dir, const std::string& prefix) {
+    std::error_code error;
+    // Проходим по файлам внутри папки GUID
+    for (const auto& directory_entry : std::filesystem::directory_iterator(dir, error)) {
+        if (!directory_entry.is_regular_file()) continue;
+
+        const auto& filePath = directory_entry.path();
+        std::string fileName = filePath.stem().string();
+
+        AssetID assetId = 0;
+        auto [ptr, ec] = std::from_chars(fileName.data(), fileName.data() + fileName.size(), assetId);
+
+        if (ec == std::errc()) {
+            // Регистрируем путь относительно корня проекта
+            Artifact artifact;
+            artifact.path = prefix + filePath.filename().string();
+            artifact.size = directory_entry.file_size(error);
+            artifact.write_time = directory_entry.last_write_time(error).time_since_epoch().count();
+            artifacts_[assetId] = std::move(artifact);
+        } else {
+            std::cerr << "Warning: File " << fileName << " is not a valid AssetID (not a number)" << std::endl;
+        }
+    }
+}
+
+void AssetDatabase::EraseArtifactDir(const std::string& prefix) {
+    std::erase_if(artifacts_, [&](const auto& item) {
+        return item.second.indexed && item.second.path.starts_with(prefix);
+    });
+}
+
+std::string AssetDatabase::GetRelativeDir(const std::filesystem::path& dir) const {
+    // Завершающий разделитель: "game/artifacts/12" не должен совпасть с "game/artifacts/123"
+    return (std::filesystem::relative(dir, root_path_) / "").string();
 }
 
-} // namespace tryengine::core
\ No newline at end of file
+} // namespace tryengine::core
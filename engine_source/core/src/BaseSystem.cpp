@@ -1,48 +1,138 @@
+#include <atomic>
 #include <entt/entt.hpp>
 
 #include "engine/core/Components.hpp"
 #include "engine/core/Engine.hpp"
+#include "engine/core/SceneGraph.hpp"
+#include "engine/core/JobSystem.hpp"
+#include "engine/core/Profiler.hpp"
+#include "engine/core/TransformHierarchy.hpp"
+#include "engine/core/TransformMath.hpp"
 
 namespace tryengine::core {
-void UpdateTransformSystem(entt::registry& reg) {
-    // Лямбда для рекурсивного обхода дерева
-    auto update_node = [&](auto& self, entt::entity entity, const glm::mat4& parentMatrix) -> void {
-        auto& transform = reg.get<Transform>(entity);
-        transform.world_matrix = parentMatrix * transform.GetLocalMatrix();
-
-        if (auto* rel = reg.try_get<Relationship>(entity)) {
-            entt::entity curr = rel->first;
-            while (curr != entt::null) {
-                // Передаем текущую мировую матрицу как родительскую для детей
-                self(self, curr, transform.world_matrix);
-                curr = reg.get<Relationship>(curr).next;
-            }
+
+namespace {
+
+// Уровни меньше порога дешевле пройти в одном потоке, чем раздавать задачи
+constexpr size_t kParallelLevelThreshold = 4096;
+constexpr size_t kTransformGrain = 1024;
+
+// Возвращает число пересчитанных матриц в диапазоне
+uint32_t UpdateTransformRange(const entt::storage_for_t<Transform>& transforms,
+                              entt::storage_for_t<WorldMatrix>& world_matrices, TransformHierarchy& hierarchy,
+                              size_t begin, size_t end) {
+    const auto entities = hierarchy.GetEntities();
+    const auto parents = hierarchy.GetParentIndices();
+    const auto dirty = hierarchy.GetDirtyFlags();
+    uint32_t updated = 0;
+
+    // Копим пачку и отдаем ее SIMD-ядру целиком
+    const Transform* batch_transforms[kTransformBatchSize];
+    const glm::mat4* batch_parents[kTransformBatchSize];
+    glm::mat4* batch_out[kTransformBatchSize];
+    size_t batch_size = 0;
+
+    for (size_t i = begin; i < end; ++i) {
+        const uint32_t parent = parents[i];
+
+        // Флаг родителя уже окончательный: он лежит на предыдущем уровне.
+        // Пишем только в свой индекс, так что чанки одного уровня не пересекаются.
+        if (parent != TransformHierarchy::kNoParent && dirty[parent]) {
+            dirty[i] = 1;
         }
-    };
+        if (!dirty[i])
+            continue;
+
+        batch_transforms[batch_size] = &transforms.get(entities[i]);
+        batch_parents[batch_size] =
+            parent == TransformHierarchy::kNoParent ? nullptr : &world_matrices.get(entities[parent]).value;
+        batch_out[batch_size] = &world_matrices.get(entities[i]).value;
 
-    // 1. Находим все сущности, у которых есть Transform и Relationship (корни дерева)
-    auto view = reg.view<Transform, Relationship>();
-    for (auto entity : view) {
-        if (view.get<Relationship>(entity).parent == entt::null) {
-            update_node(update_node, entity, glm::mat4(1.0f));
+        if (++batch_size == kTransformBatchSize) {
+            ComposeWorldMatrices(batch_size, batch_transforms, batch_parents, batch_out);
+            updated += static_cast<uint32_t>(batch_size);
+            batch_size = 0;
         }
     }
 
-    // 2. Одиночные сущности, у которых есть Transform, но нет Relationship
-    auto noRelView = reg.view<Transform>(entt::exclude<Relationship>);
-    for (auto entity : noRelView) {
-        auto& transform = noRelView.get<Transform>(entity);
-        transform.world_matrix = transform.GetLocalMatrix();
+    ComposeWorldMatrices(batch_size, batch_transforms, batch_parents, batch_out);
+    updated += static_cast<uint32_t>(batch_size);
+
+    return updated;
+}
+
+void UpdateTransforms(entt::registry& reg, JobSystem* jobs) {
+    const auto& graph = AcquireSceneGraph(reg);
+    auto& hierarchy = AcquireTransformHierarchy(reg);
+    auto& dirty_transforms = reg.storage<TransformDirty>();
+
+    const bool rebuilt = hierarchy.RebuildIfDirty(reg, graph);
+
+    // Статичная сцена: ничего не двигалось и структура не менялась
+    if (!rebuilt && dirty_transforms.empty()) {
+        hierarchy.SetUpdatedCount(0);
+        return;
     }
+
+    // После перестройки (reparent, новые сущности) проще пересчитать все один раз
+    hierarchy.ResetDirtyFlags(rebuilt);
+    if (!rebuilt) {
+        auto dirty = hierarchy.GetDirtyFlags();
+        for (const auto [entity] : dirty_transforms.each()) {
+            const uint32_t index = hierarchy.IndexOf(entity);
+            if (index != TransformHierarchy::kNoParent) {
+                dirty[index] = 1;
+            }
+        }
+    }
+    dirty_transforms.clear();
+
+    const auto& transforms = reg.storage<Transform>();
+    auto& world_matrices = reg.storage<WorldMatrix>();
+    std::atomic<uint32_t> updated{0};
+
+    for (size_t level = 0; level < hierarchy.GetLevelCount(); ++level) {
+        const auto [begin, end] = hierarchy.GetLevelRange(level);
+
+        if (!jobs || end - begin < kParallelLevelThreshold) {
+            updated.fetch_add(UpdateTransformRange(transforms, world_matrices, hierarchy, begin, end), std::memory_order_relaxed);
+            continue;
+        }
+
+        jobs->ParallelFor(end - begin, kTransformGrain, [&, offset = begin](size_t chunk_begin, size_t chunk_end) {
+            updated.fetch_add(UpdateTransformRange(transforms, world_matrices, hierarchy, offset + chunk_begin,
+                                                   offset + chunk_end),
+                              std::memory_order_relaxed);
+        });
+    }
+
+    hierarchy.SetUpdatedCount(updated.load(std::memory_order_relaxed));
+}
+
+}  // namespace
+
+void UpdateTransformSystem(entt::registry& reg) {
+    TRYENGINE_PROFILE_ZONE("UpdateTransformSystem");
+    UpdateTransforms(reg, nullptr);
+}
+
+void UpdateTransformSystem(entt::registry& reg, JobSystem& jobs) {
+    TRYENGINE_PROFILE_ZONE("UpdateTransformSystem");
+    UpdateTransforms(reg, &jobs);
+}
+
+uint32_t GetUpdatedTransformCount(const entt::registry& reg) {
+    const auto* hierarchy = reg.ctx().find<TransformHierarchy>();
+    return hierarchy ? hierarchy->GetUpdatedCount() : 0;
 }
 
 void UpdateCameraMatrices(entt::registry& reg) {
-    auto view = reg.view<Transform, Camera>();
+    auto view = reg.view<WorldMatrix, Camera>();
     for (const auto entity : view) {
-        auto& transform = view.get<Transform>(entity);
+        const auto& world = view.get<WorldMatrix>(entity);
         auto& cam = view.get<Camera>(entity);
 
-        cam.view_matrix = glm::inverse(transform.world_matrix);
+        cam.view_matrix = glm::inverse(world.value);
     }
 }
 
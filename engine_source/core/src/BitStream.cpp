@@ -0,0 +1,111 @@
+#include "engine/core/BitStream.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace tryengine::core {
+
+namespace {
+
+uint64_t LowMask(uint32_t count) { return count >= 64 ? ~0ull : (1ull << count) - 1; }
+
+}  // namespace
+
+void BitWriter::WriteBits(uint64_t value, uint32_t count) {
+    // Кладем частями по 32 бита, чтобы scratch_ (до 7 бит остатка) не переполнился
+    while (count > 0) {
+        const uint32_t chunk = std::min(count, 32u);
+        scratch_ |= (value & LowMask(chunk)) << scratch_bits_;
+        scratch_bits_ += chunk;
+        value >>= chunk;
+        count -= chunk;
+
+        while (scratch_bits_ >= 8) {
+            bytes_.push_back(static_cast<uint8_t>(scratch_));
+            scratch_ >>= 8;
+            scratch_bits_ -= 8;
+        }
+    }
+}
+
+void BitWriter::WriteVarUint(uint64_t value) {
+    while (value >= 0x80) {
+        WriteBits((value & 0x7f) | 0x80, 8);
+        value >>= 7;
+    }
+    WriteBits(value, 8);
+}
+
+void BitWriter::WriteVarInt(int64_t value) {
+    WriteVarUint((static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+}
+
+void BitWriter::WriteQuantized(float value, float step) { WriteVarInt(std::llround(value / step)); }
+
+void BitWriter::WriteRanged(float value, float min, float max, uint32_t bits) {
+    const float normalized = std::clamp((value - min) / (max - min), 0.0f, 1.0f);
+    WriteBits(static_cast<uint64_t>(std::lround(normalized * static_cast<float>(LowMask(bits)))), bits);
+}
+
+std::span<const uint8_t> BitWriter::Finish() {
+    if (scratch_bits_ > 0) {
+        bytes_.push_back(static_cast<uint8_t>(scratch_));
+        scratch_ = 0;
+        scratch_bits_ = 0;
+    }
+    return bytes_;
+}
+
+void BitWriter::Clear() {
+    bytes_.clear();
+    scratch_ = 0;
+    scratch_bits_ = 0;
+}
+
+uint64_t BitReader::ReadBits(uint32_t count) {
+    if (position_ + count > data_.size() * 8) {
+        overflowed_ = true;
+        position_ = data_.size() * 8;
+        return 0;
+    }
+
+    uint64_t value = 0;
+    uint32_t written = 0;
+    while (written < count) {
+        const size_t byte = position_ >> 3;
+        const uint32_t offset = static_cast<uint32_t>(position_ & 7);
+        const uint32_t take = std::min(8 - offset, count - written);
+
+        value |= static_cast<uint64_t>((data_[byte] >> offset) & LowMask(take)) << written;
+        written += take;
+        position_ += take;
+    }
+    return value;
+}
+
+uint64_t BitReader::ReadVarUint() {
+    uint64_t value = 0;
+    for (uint32_t shift = 0; shift < 64; shift += 7) {
+        const uint64_t byte = ReadBits(8);
+        value |= (byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0)
+            return value;
+    }
+    // Больше 10 групп — мусор на входе
+    overflowed_ = true;
+    return 0;
+}
+
+int64_t BitReader::ReadVarInt() {
+    const uint64_t value = ReadVarUint();
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+float BitReader::ReadQuantized(float step) { return static_cast<float>(ReadVarInt()) * step; }
+
+float BitReader::ReadRanged(float min, float max, uint32_t bits) {
+    const auto value = static_cast<float>(ReadBits(bits));
+    return min + value / static_cast<float>(LowMask(bits)) * (max - min);
+}
+
+}  // namespace tryengine::core
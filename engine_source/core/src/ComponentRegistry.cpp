@@ -0,0 +1,18 @@
+#include "engine/core/ComponentRegistry.hpp"
+
+#include "engine/core/Components.hpp"
+
+namespace tryengine::core {
+
+void RegisterEngineComponents(ComponentRegistry& registry) {
+    // Порядок — часть формата сцены: новые компоненты добавлять только в конец
+    registry.Register<Tag>("Tag");
+    registry.Register<Transform>("Transform");
+    registry.Register<Relationship>("Relationship");
+    registry.Register<Camera>("Camera");
+    registry.Register<MainCameraTag>("MainCameraTag");
+    registry.Register<MeshFilter>("MeshFilter");
+    registry.Register<MeshRenderer>("MeshRenderer");
+}
+
+}  // namespace tryengine::core
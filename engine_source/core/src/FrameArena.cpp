@@ -0,0 +1,134 @@
+#include "engine/core/FrameArena.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+namespace tryengine::core {
+
+namespace {
+
+std::atomic<uint64_t> next_arena_id{1};
+
+// Арены потока в последней FrameArena, к которой он обращался
+struct LocalCache {
+    uint64_t arena_id = 0;
+    void* arenas = nullptr;
+};
+thread_local LocalCache tls_cache;
+
+size_t AlignUp(size_t value, size_t alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+}  // namespace
+
+LinearArena::LinearArena(size_t block_size) : block_size_(block_size) {}
+
+void* LinearArena::Allocate(size_t size, size_t alignment) {
+    alignment = std::max<size_t>(alignment, 1);
+
+    for (;;) {
+        if (current_ < blocks_.size()) {
+            Block& block = blocks_[current_];
+            const auto base = reinterpret_cast<uintptr_t>(block.data.get());
+            const size_t start = AlignUp(base + offset_, alignment) - base;
+            if (start + size <= block.size) {
+                offset_ = start + size;
+                used_ += size;
+                return block.data.get() + start;
+            }
+
+            // Не влезло — хвост блока пропадает до Reset, идем в следующий
+            if (current_ + 1 < blocks_.size()) {
+                ++current_;
+                offset_ = 0;
+                continue;
+            }
+        }
+
+        AddBlock(size + alignment);
+        current_ = blocks_.size() - 1;
+        offset_ = 0;
+    }
+}
+
+void LinearArena::Reset() {
+    if (blocks_.size() > 1) {
+        blocks_.clear();
+        const size_t total = capacity_;
+        capacity_ = 0;
+        AddBlock(total);
+    }
+
+    current_ = 0;
+    offset_ = 0;
+    used_ = 0;
+}
+
+void LinearArena::AddBlock(size_t min_size) {
+    // Растем геометрически, чтобы число блоков за кадр оставалось логарифмическим
+    const size_t size = std::max({min_size, block_size_, capacity_});
+    blocks_.push_back({std::make_unique_for_overwrite<std::byte[]>(size), size});
+    capacity_ += size;
+    ++heap_allocations_;
+}
+
+struct FrameArena::ThreadArenas {
+    explicit ThreadArenas(size_t block_size)
+        : owner(std::this_thread::get_id()), frames{LinearArena(block_size), LinearArena(block_size)} {}
+
+    std::thread::id owner;
+    std::array<LinearArena, kFrameCount> frames;
+};
+
+FrameArena::FrameArena(size_t block_size)
+    : id_(next_arena_id.fetch_add(1, std::memory_order_relaxed)), block_size_(block_size) {}
+
+FrameArena::~FrameArena() = default;
+
+LinearArena& FrameArena::Local() {
+    if (tls_cache.arena_id != id_) {
+        tls_cache.arena_id = id_;
+        tls_cache.arenas = &Register();
+    }
+    return static_cast<ThreadArenas*>(tls_cache.arenas)->frames[frame_];
+}
+
+FrameArena::ThreadArenas& FrameArena::Register() {
+    std::lock_guard lock(mutex_);
+
+    // Поток мог уже обращаться к этой арене, а кэш с тех пор перебила другая
+    const auto self = std::this_thread::get_id();
+    for (const auto& thread : threads_) {
+        if (thread->owner == self)
+            return *thread;
+    }
+    return *threads_.emplace_back(std::make_unique<ThreadArenas>(block_size_));
+}
+
+void FrameArena::NextFrame() {
+    frame_ = (frame_ + 1) % kFrameCount;
+
+    std::lock_guard lock(mutex_);
+    for (const auto& thread : threads_) {
+        thread->frames[frame_].Reset();
+    }
+}
+
+FrameArena::Stats FrameArena::GetStats() const {
+    Stats stats;
+
+    std::lock_guard lock(mutex_);
+    stats.thread_count = static_cast<uint32_t>(threads_.size());
+    for (const auto& thread : threads_) {
+        for (const LinearArena& arena : thread->frames) {
+            stats.capacity += arena.GetCapacity();
+            stats.heap_allocations += arena.GetHeapAllocations();
+        }
+        stats.used += thread->frames[frame_].GetUsed();
+    }
+    return stats;
+}
+
+}  // namespace tryengine::core
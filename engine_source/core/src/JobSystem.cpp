@@ -0,0 +1,272 @@
+#include "engine/core/JobSystem.hpp"
+
+#include <algorithm>
+#include <string>
+
+#include "engine/core/Profiler.hpp"
+
+namespace tryengine::core {
+
+namespace {
+
+// Какому JobSystem и какой очереди принадлежит текущий поток
+thread_local const JobSystem* tls_owner = nullptr;
+thread_local uint32_t tls_queue_index = 0;
+
+}  // namespace
+
+JobSystem::JobSystem(uint32_t worker_count) : main_thread_id_(std::this_thread::get_id()) {
+    if (worker_count == 0) {
+        const uint32_t hw = std::thread::hardware_concurrency();
+        worker_count = hw > 1 ? hw - 1 : 0;
+    }
+
+    queues_.reserve(worker_count + 1);
+    for (uint32_t i = 0; i <= worker_count; ++i) {
+        queues_.push_back(std::make_unique<WorkQueue>());
+    }
+
+    workers_.reserve(worker_count);
+    for (uint32_t i = 0; i < worker_count; ++i) {
+        workers_.emplace_back([this, i] { WorkerLoop(i + 1); });
+    }
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard lock(sleep_mutex_);
+        stop_ = true;
+    }
+    wake_cv_.notify_all();
+
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+void JobSystem::Run(JobFn fn, JobCounter* counter) {
+    if (counter) {
+        counter->pending_.fetch_add(1, std::memory_order_relaxed);
+    }
+    Push(Job{std::move(fn), nullptr, 0, 0, counter});
+}
+
+void JobSystem::RunAfter(JobCounter& dependency, JobFn fn, JobCounter* counter) {
+    if (counter) {
+        counter->pending_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    {
+        std::lock_guard lock(dependency.mutex_);
+        if (!dependency.IsDone()) {
+            // Счетчик уже учтен выше, поэтому продолжение ставим напрямую через Push
+            dependency.continuations_.push_back([this, fn = std::move(fn), counter]() mutable {
+                Push(Job{std::move(fn), nullptr, 0, 0, counter});
+            });
+            return;
+        }
+    }
+
+    Push(Job{std::move(fn), nullptr, 0, 0, counter});
+}
+
+void JobSystem::RunOnMainThread(JobFn fn, JobCounter* counter) {
+    if (counter) {
+        counter->pending_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    {
+        std::lock_guard lock(main_queue_.mutex);
+        main_queue_.jobs.push_back(Job{std::move(fn), nullptr, 0, 0, counter});
+    }
+    Notify();
+}
+
+void JobSystem::Wait(JobCounter& counter) {
+    const uint32_t queue_index = CurrentQueueIndex();
+
+    while (!counter.IsDone()) {
+        uint64_t seen_epoch;
+        {
+            std::lock_guard lock(sleep_mutex_);
+            seen_epoch = epoch_;
+        }
+
+        if (RunOne(queue_index))
+            continue;
+
+        // Работы нет — спим до новой задачи или обнуления какого-нибудь счетчика
+        std::unique_lock lock(sleep_mutex_);
+        wake_cv_.wait(lock, [&] { return epoch_ != seen_epoch || counter.IsDone(); });
+    }
+
+    // Дожидаемся, пока Finish последней задачи отпустит счетчик
+    std::lock_guard lock(counter.mutex_);
+}
+
+void JobSystem::ParallelFor(size_t count, size_t grain, const RangeFn& fn) {
+    if (count == 0)
+        return;
+
+    grain = std::max<size_t>(grain, 1);
+
+    // Нет смысла раздавать один чанк
+    if (workers_.empty() || count <= grain) {
+        fn(0, count);
+        return;
+    }
+
+    JobCounter counter;
+    const size_t chunks = (count + grain - 1) / grain;
+    counter.pending_.store(static_cast<uint32_t>(chunks), std::memory_order_relaxed);
+
+    std::vector<Job> jobs;
+    jobs.reserve(chunks);
+    for (size_t begin = 0; begin < count; begin += grain) {
+        jobs.push_back(Job{nullptr, &fn, begin, std::min(begin + grain, count), &counter});
+    }
+    PushBatch(jobs);
+
+    Wait(counter);
+}
+
+void JobSystem::PumpMainThread() {
+    Job job;
+    while (TryPopMain(job)) {
+        Execute(job);
+    }
+}
+
+void JobSystem::WorkerLoop(uint32_t queue_index) {
+    tls_owner = this;
+    tls_queue_index = queue_index;
+    TRYENGINE_PROFILE_THREAD("Worker " + std::to_string(queue_index));
+
+    for (;;) {
+        uint64_t seen_epoch;
+        {
+            std::lock_guard lock(sleep_mutex_);
+            if (stop_)
+                return;
+            seen_epoch = epoch_;
+        }
+
+        if (RunOne(queue_index))
+            continue;
+
+        std::unique_lock lock(sleep_mutex_);
+        wake_cv_.wait(lock, [&] { return stop_ || epoch_ != seen_epoch; });
+    }
+}
+
+void JobSystem::Push(Job job) {
+    auto& queue = *queues_[CurrentQueueIndex()];
+    {
+        std::lock_guard lock(queue.mutex);
+        queue.jobs.push_back(std::move(job));
+    }
+    Notify();
+}
+
+void JobSystem::PushBatch(std::vector<Job>& jobs) {
+    auto& queue = *queues_[CurrentQueueIndex()];
+    {
+        std::lock_guard lock(queue.mutex);
+        for (auto& job : jobs) {
+            queue.jobs.push_back(std::move(job));
+        }
+    }
+    Notify();
+}
+
+bool JobSystem::TryPop(uint32_t queue_index, Job& out) {
+    auto& queue = *queues_[queue_index];
+    std::lock_guard lock(queue.mutex);
+    if (queue.jobs.empty())
+        return false;
+
+    out = std::move(queue.jobs.back());
+    queue.jobs.pop_back();
+    return true;
+}
+
+bool JobSystem::TrySteal(uint32_t thief_index, Job& out) {
+    const auto queue_count = static_cast<uint32_t>(queues_.size());
+
+    // Обходим жертв начиная с соседа, чтобы воркеры не толпились на одной очереди
+    for (uint32_t offset = 1; offset < queue_count; ++offset) {
+        auto& queue = *queues_[(thief_index + offset) % queue_count];
+        std::lock_guard lock(queue.mutex);
+        if (queue.jobs.empty())
+            continue;
+
+        out = std::move(queue.jobs.front());
+        queue.jobs.pop_front();
+        return true;
+    }
+    return false;
+}
+
+bool JobSystem::TryPopMain(Job& out) {
+    std::lock_guard lock(main_queue_.mutex);
+    if (main_queue_.jobs.empty())
+        return false;
+
+    out = std::move(main_queue_.jobs.front());
+    main_queue_.jobs.pop_front();
+    return true;
+}
+
+bool JobSystem::RunOne(uint32_t queue_index) {
+    Job job;
+    if ((IsMainThread() && TryPopMain(job)) || TryPop(queue_index, job) || TrySteal(queue_index, job)) {
+        Execute(job);
+        return true;
+    }
+    return false;
+}
+
+void JobSystem::Execute(Job& job) {
+    if (job.range) {
+        (*job.range)(job.begin, job.end);
+    } else {
+        job.fn();
+    }
+    Finish(job.counter);
+}
+
+void JobSystem::Finish(JobCounter* counter) {
+    if (!counter)
+        return;
+
+    // Декремент под мьютексом: Wait перед возвратом берет тот же мьютекс, поэтому счетчик
+    // на стеке ожидающего не будет уничтожен, пока мы его еще трогаем
+    std::vector<std::function<void()>> continuations;
+    {
+        std::lock_guard lock(counter->mutex_);
+        if (counter->pending_.fetch_sub(1, std::memory_order_acq_rel) != 1)
+            return;
+        continuations.swap(counter->continuations_);
+    }
+
+    // Будим тех, кто ждет этот счетчик в Wait
+    Notify();
+
+    for (auto& continuation : continuations) {
+        continuation();
+    }
+}
+
+void JobSystem::Notify() {
+    {
+        std::lock_guard lock(sleep_mutex_);
+        ++epoch_;
+    }
+    wake_cv_.notify_all();
+}
+
+uint32_t JobSystem::CurrentQueueIndex() const {
+    return tls_owner == this ? tls_queue_index : 0;
+}
+
+}  // namespace tryengine::core
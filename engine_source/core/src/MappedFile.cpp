@@ -0,0 +1,99 @@
+#include "engine/core/MappedFile.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define TRYENGINE_HAS_MMAP 1
+#endif
+
+namespace tryengine::core {
+
+MappedFile::~MappedFile() { Close(); }
+
+MappedFile::MappedFile(MappedFile&& other) noexcept { *this = std::move(other); }
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        Close();
+        data_ = std::exchange(other.data_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+        buffer_ = std::move(other.buffer_);
+        mapped_ = std::exchange(other.mapped_, false);
+        if (!mapped_ && data_) {
+            data_ = buffer_.data();
+        }
+    }
+    return *this;
+}
+
+bool MappedFile::Open(const std::filesystem::path& path) {
+    Close();
+
+#if defined(TRYENGINE_HAS_MMAP)
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    struct stat info {};
+    if (fstat(fd, &info) != 0) {
+        close(fd);
+        return false;
+    }
+
+    size_ = static_cast<size_t>(info.st_size);
+    if (size_ > 0) {
+        int flags = MAP_PRIVATE;
+#if defined(MAP_POPULATE)
+        // Сцена читается целиком — страницы подгружаем одним проходом, а не по page fault
+        flags |= MAP_POPULATE;
+#endif
+        void* address = mmap(nullptr, size_, PROT_READ, flags, fd, 0);
+        close(fd);
+        if (address == MAP_FAILED) {
+            size_ = 0;
+            return false;
+        }
+        data_ = static_cast<const std::byte*>(address);
+        mapped_ = true;
+        return true;
+    }
+    close(fd);
+#else
+    std::ifstream is(path, std::ios::binary | std::ios::ate);
+    if (!is.is_open())
+        return false;
+
+    size_ = static_cast<size_t>(is.tellg());
+    buffer_.resize(size_);
+    is.seekg(0);
+    if (!is.read(reinterpret_cast<char*>(buffer_.data()), static_cast<std::streamsize>(size_))) {
+        Close();
+        return false;
+    }
+#endif
+
+    // Пустой файл тоже открыт: data_ не должен быть nullptr
+    buffer_.resize(std::max<size_t>(buffer_.size(), 1));
+    data_ = buffer_.data();
+    return true;
+}
+
+void MappedFile::Close() {
+#if defined(TRYENGINE_HAS_MMAP)
+    if (mapped_) {
+        munmap(const_cast<std::byte*>(data_), size_);
+    }
+#endif
+    data_ = nullptr;
+    size_ = 0;
+    buffer_.clear();
+    mapped_ = false;
+}
+
+}  // namespace tryengine::core
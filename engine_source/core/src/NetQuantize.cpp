@@ -0,0 +1,63 @@
+#include "engine/core/NetQuantize.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace tryengine::core {
+
+namespace {
+
+constexpr float kSmallestThreeLimit = 0.70710678f;
+
+}  // namespace
+
+void WriteRotation(BitWriter& writer, const glm::quat& rotation) {
+    const glm::quat q = glm::normalize(rotation);
+
+    uint32_t largest = 0;
+    for (uint32_t i = 1; i < 4; ++i) {
+        if (std::abs(q[i]) > std::abs(q[largest])) {
+            largest = i;
+        }
+    }
+
+    // q и -q — один и тот же поворот: приводим наибольшую к положительной, тогда ее знак не нужен
+    const float sign = q[largest] < 0.0f ? -1.0f : 1.0f;
+
+    writer.WriteBits(largest, 2);
+    for (uint32_t i = 0; i < 4; ++i) {
+        if (i != largest) {
+            writer.WriteRanged(q[i] * sign, -kSmallestThreeLimit, kSmallestThreeLimit, kRotationBits);
+        }
+    }
+}
+
+glm::quat ReadRotation(BitReader& reader) {
+    const auto largest = static_cast<uint32_t>(reader.ReadBits(2));
+
+    glm::quat q;
+    float sum = 0.0f;
+    for (uint32_t i = 0; i < 4; ++i) {
+        if (i != largest) {
+            q[i] = reader.ReadRanged(-kSmallestThreeLimit, kSmallestThreeLimit, kRotationBits);
+            sum += q[i] * q[i];
+        }
+    }
+    q[largest] = std::sqrt(std::max(0.0f, 1.0f - sum));
+    return glm::normalize(q);
+}
+
+void WriteVec3(BitWriter& writer, const glm::vec3& value, float step) {
+    writer.WriteQuantized(value.x, step);
+    writer.WriteQuantized(value.y, step);
+    writer.WriteQuantized(value.z, step);
+}
+
+glm::vec3 ReadVec3(BitReader& reader, float step) {
+    const float x = reader.ReadQuantized(step);
+    const float y = reader.ReadQuantized(step);
+    const float z = reader.ReadQuantized(step);
+    return {x, y, z};
+}
+
+}  // namespace tryengine::core
@@ -0,0 +1,113 @@
+#include "engine/core/Prefab.hpp"
+
+#include "engine/core/SceneGraph.hpp"
+
+namespace tryengine::core {
+
+namespace {
+
+template <typename T>
+void CopyShared(const entt::registry& reg, entt::entity entity, std::optional<T>& out) {
+    if (const auto* component = reg.try_get<T>(entity)) {
+        out = *component;
+    }
+}
+
+}  // namespace
+
+uint32_t PrefabLibrary::Add(Prefab prefab) {
+    auto& nodes = prefab.nodes;
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        auto& node = nodes[i];
+        // Корень — единственный узел без родителя. Узел, чей родитель не раньше него (битый шаблон), цепляется к корню
+        if (i == 0) {
+            node.parent = PrefabNode::kNoParent;
+        } else if (node.parent >= i) {
+            node.parent = 0;
+        }
+
+        // Локальный трансформ корня заменяется трансформом экземпляра
+        node.root_from_node =
+            i == 0 ? glm::mat4(1.0f) : nodes[node.parent].root_from_node * node.local.GetLocalMatrix();
+    }
+
+    prefabs_.push_back(std::make_unique<const Prefab>(std::move(prefab)));
+    return static_cast<uint32_t>(prefabs_.size() - 1);
+}
+
+uint32_t PrefabLibrary::AddFromHierarchy(const entt::registry& reg, entt::entity root) {
+    Prefab prefab;
+    prefab.nodes.emplace_back();
+    std::vector<entt::entity> queue{root};
+    const auto* relationships = reg.storage<Relationship>();
+
+    for (size_t i = 0; i < queue.size(); ++i) {
+        const auto entity = queue[i];
+        auto& node = prefab.nodes[i];
+        if (const auto* transform = reg.try_get<Transform>(entity)) {
+            node.local = *transform;
+        }
+        std::apply([&](auto&... component) { (CopyShared(reg, entity, component), ...); }, node.shared);
+
+        if (!relationships || !relationships->contains(entity))
+            continue;
+
+        // Дети в порядке SceneGraph, обход в ширину дает родителя раньше детей. Битый список не зациклит обход:
+        // узлов не больше, чем Relationship в реестре
+        for (auto child = relationships->get(entity).first;
+             child != entt::null && relationships->contains(child) && queue.size() <= relationships->size();
+             child = relationships->get(child).next) {
+            queue.push_back(child);
+            prefab.nodes.emplace_back().parent = static_cast<uint32_t>(i);
+        }
+    }
+    return Add(std::move(prefab));
+}
+
+PrefabLibrary& AcquirePrefabLibrary(entt::registry& reg) {
+    if (auto* library = reg.ctx().find<PrefabLibrary>()) {
+        return *library;
+    }
+    return reg.ctx().emplace<PrefabLibrary>();
+}
+
+std::vector<entt::entity> InstantiatePrefab(entt::registry& reg, const uint32_t prefab,
+                                            std::span<const Transform> transforms) {
+    const auto& library = AcquirePrefabLibrary(reg);
+    if (prefab >= library.Size() || library.Get(prefab).nodes.empty())
+        return {};
+
+    std::vector<entt::entity> entities(transforms.size());
+    reg.create(entities.begin(), entities.end());
+    reg.insert<Transform>(entities.begin(), entities.end(), transforms.begin());
+    reg.insert<PrefabInstance>(entities.begin(), entities.end(), PrefabInstance{prefab, 0});
+    return entities;
+}
+
+std::vector<entt::entity> ExpandPrefabInstance(entt::registry& reg, entt::entity root) {
+    const auto* instance = reg.try_get<PrefabInstance>(root);
+    if (!instance || instance->node != 0 || reg.all_of<PrefabExpanded>(root))
+        return {};
+
+    // Дальше пул PrefabInstance растет — указатель на компонент корня не держим
+    const uint32_t prefab_id = instance->prefab;
+    const auto& prefab = AcquirePrefabLibrary(reg).Get(prefab_id);
+
+    std::vector<entt::entity> entities(prefab.nodes.size());
+    entities[0] = root;
+    reg.create(entities.begin() + 1, entities.end());
+
+    auto& graph = AcquireSceneGraph(reg);
+    reg.get_or_emplace<Relationship>(root);
+    for (size_t i = 1; i < entities.size(); ++i) {
+        const auto entity = entities[i];
+        reg.emplace<Transform>(entity, prefab.nodes[i].local);
+        reg.emplace<PrefabInstance>(entity, prefab_id, static_cast<uint32_t>(i));
+        reg.emplace<Relationship>(entity);
+        graph.SetParent(reg, entity, entities[prefab.nodes[i].parent]);
+    }
+    reg.emplace<PrefabExpanded>(root);
+    return entities;
+}
+
+}  // namespace tryengine::core
@@ -0,0 +1,184 @@
+#include "engine/core/Profiler.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <iomanip>
+
+namespace tryengine::core {
+
+struct Profiler::ThreadBuffer {
+    std::unique_ptr<ProfileEvent[]> events = std::make_unique<ProfileEvent[]>(kThreadBufferSize);
+    // Сколько событий записано за все время; слот — head % kThreadBufferSize
+    std::atomic<uint64_t> head{0};
+    uint32_t index = 0;
+    std::string name;
+};
+
+namespace {
+
+static_assert((Profiler::kThreadBufferSize & (Profiler::kThreadBufferSize - 1)) == 0);
+
+void WriteJsonString(std::ostream& os, std::string_view text) {
+    os << '"';
+    for (const char c : text) {
+        if (c == '"' || c == '\\') {
+            os << '\\';
+        }
+        os << c;
+    }
+    os << '"';
+}
+
+}  // namespace
+
+thread_local Profiler::ThreadBuffer* Profiler::tls_buffer_ = nullptr;
+
+Profiler& Profiler::Get() {
+    static Profiler profiler;
+    return profiler;
+}
+
+Profiler::Profiler() : frame_begin_ns_(Now()) {}
+
+Profiler::~Profiler() = default;
+
+uint32_t Profiler::RegisterZone(uint32_t hash, std::string_view name) {
+    std::lock_guard lock(mutex_);
+    zone_names_.try_emplace(hash, name);
+    return hash;
+}
+
+void Profiler::SetThreadName(std::string_view name) {
+    ThreadBuffer& buffer = LocalBuffer();
+    std::lock_guard lock(mutex_);
+    buffer.name = name;
+}
+
+Profiler::ThreadBuffer& Profiler::LocalBuffer() {
+    if (tls_buffer_)
+        return *tls_buffer_;
+
+    // Буферы живут до конца программы: события потока нужны и после его завершения (экспорт)
+    auto buffer = std::make_unique<ThreadBuffer>();
+    std::lock_guard lock(mutex_);
+    buffer->index = static_cast<uint32_t>(buffers_.size());
+    buffer->name = "Thread " + std::to_string(buffer->index);
+    tls_buffer_ = buffers_.emplace_back(std::move(buffer)).get();
+    return *tls_buffer_;
+}
+
+void Profiler::Record(uint32_t zone, uint32_t depth, uint64_t begin_ns, uint64_t end_ns) {
+    ThreadBuffer& buffer = LocalBuffer();
+    const uint64_t head = buffer.head.load(std::memory_order_relaxed);
+    buffer.events[head & (kThreadBufferSize - 1)] = {zone, depth, begin_ns, end_ns};
+    buffer.head.store(head + 1, std::memory_order_release);
+}
+
+void Profiler::Snapshot(const ThreadBuffer& buffer, uint64_t since_ns, std::vector<ProfileEvent>& out) {
+    const uint64_t head = buffer.head.load(std::memory_order_acquire);
+    const uint64_t oldest = head > kThreadBufferSize ? head - kThreadBufferSize : 0;
+    const size_t first = out.size();
+
+    // В буфере потока события упорядочены по времени закрытия — идем с конца до since_ns
+    for (uint64_t i = head; i-- > oldest;) {
+        const ProfileEvent& event = buffer.events[i & (kThreadBufferSize - 1)];
+        if (event.end_ns <= since_ns)
+            break;
+        out.push_back(event);
+    }
+
+    // Пока читали, писатель мог уйти вперед: слоты старше head_now - size + 1 уже переписаны или пишутся
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const uint64_t head_now = buffer.head.load(std::memory_order_relaxed);
+    const uint64_t valid = head_now + 1 > kThreadBufferSize ? head_now + 1 - kThreadBufferSize : 0;
+    const uint64_t keep = head > valid ? std::min<uint64_t>(head - valid, out.size() - first) : 0;
+
+    out.resize(first + keep);
+    std::reverse(out.begin() + static_cast<std::ptrdiff_t>(first), out.end());
+}
+
+void Profiler::EndFrame() {
+    const uint64_t now = Now();
+
+    ProfileFrame frame;
+    frame.begin_ns = frame_begin_ns_;
+    frame.end_ns = now;
+
+    std::vector<ProfileEvent> events;
+    {
+        std::lock_guard lock(mutex_);
+        for (const auto& buffer : buffers_) {
+            events.clear();
+            Snapshot(*buffer, frame_begin_ns_, events);
+
+            for (const ProfileEvent& event : events) {
+                // Воркеры могли закрыть зоны уже после границы — они попадут в следующий кадр
+                if (event.end_ns > now)
+                    break;
+
+                const auto it = zone_names_.find(event.zone);
+                const std::string_view name = it != zone_names_.end() ? std::string_view(it->second) : "?";
+                frame.zones.push_back({name, buffer->index, event.depth, event.begin_ns, event.end_ns});
+            }
+        }
+    }
+
+    std::stable_sort(frame.zones.begin(), frame.zones.end(), [](const auto& a, const auto& b) {
+        return a.thread != b.thread ? a.thread < b.thread : a.begin_ns < b.begin_ns;
+    });
+
+    last_frame_ = std::move(frame);
+    frame_begin_ns_ = now;
+}
+
+std::string_view Profiler::GetZoneName(uint32_t zone) const {
+    std::lock_guard lock(mutex_);
+    const auto it = zone_names_.find(zone);
+    return it != zone_names_.end() ? std::string_view(it->second) : std::string_view("?");
+}
+
+std::string Profiler::GetThreadName(uint32_t thread) const {
+    std::lock_guard lock(mutex_);
+    return thread < buffers_.size() ? buffers_[thread]->name : std::string("?");
+}
+
+bool Profiler::ExportChromeTrace(const std::filesystem::path& path) const {
+    std::ofstream os(path);
+    if (!os.is_open())
+        return false;
+
+    std::lock_guard lock(mutex_);
+
+    std::vector<std::vector<ProfileEvent>> per_thread(buffers_.size());
+    uint64_t origin = UINT64_MAX;
+    for (size_t i = 0; i < buffers_.size(); ++i) {
+        Snapshot(*buffers_[i], 0, per_thread[i]);
+        for (const ProfileEvent& event : per_thread[i]) {
+            origin = std::min(origin, event.begin_ns);
+        }
+    }
+
+    // ts и dur в микросекундах; от первого события, чтобы не терять точность в double
+    os << std::fixed << std::setprecision(3);
+    os << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    for (size_t i = 0; i < buffers_.size(); ++i) {
+        os << (i == 0 ? "" : ",") << "\n{\"ph\":\"M\",\"pid\":1,\"tid\":" << i
+           << ",\"name\":\"thread_name\",\"args\":{\"name\":";
+        WriteJsonString(os, buffers_[i]->name);
+        os << "}}";
+
+        for (const ProfileEvent& event : per_thread[i]) {
+            const auto it = zone_names_.find(event.zone);
+            os << ",\n{\"ph\":\"X\",\"pid\":1,\"tid\":" << i << ",\"name\":";
+            WriteJsonString(os, it != zone_names_.end() ? std::string_view(it->second) : "?");
+            os << ",\"ts\":" << static_cast<double>(event.begin_ns - origin) / 1000.0
+               << ",\"dur\":" << static_cast<double>(event.end_ns - event.begin_ns) / 1000.0 << '}';
+        }
+    }
+    os << "\n]}\n";
+
+    return static_cast<bool>(os);
+}
+
+}  // namespace tryengine::core
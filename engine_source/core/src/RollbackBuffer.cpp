@@ -0,0 +1,59 @@
+#include "engine/core/RollbackBuffer.hpp"
+
+#include "engine/core/Profiler.hpp"
+
+namespace tryengine::core {
+
+void RollbackBuffer::Save(const entt::registry& reg, uint32_t tick) {
+    TRYENGINE_PROFILE_ZONE("RollbackBuffer::Save");
+
+    Frame& frame = frames_[tick % frames_.size()];
+    frame.tick = tick;
+    frame.valid = true;
+    frame.pools.resize(pools_.size());
+    for (size_t i = 0; i < pools_.size(); ++i) {
+        pools_[i].save(reg, frame.pools[i]);
+    }
+}
+
+const RollbackBuffer::Frame* RollbackBuffer::Find(uint32_t tick) const {
+    const Frame& frame = frames_[tick % frames_.size()];
+    return frame.valid && frame.tick == tick ? &frame : nullptr;
+}
+
+bool RollbackBuffer::Contains(uint32_t tick) const { return Find(tick) != nullptr; }
+
+bool RollbackBuffer::Restore(entt::registry& reg, uint32_t tick) {
+    TRYENGINE_PROFILE_ZONE("RollbackBuffer::Restore");
+
+    restored_count_ = 0;
+    const Frame* frame = Find(tick);
+    if (!frame)
+        return false;
+
+    for (size_t i = 0; i < pools_.size(); ++i) {
+        restored_count_ += pools_[i].restore(reg, frame->pools[i]);
+    }
+    return true;
+}
+
+bool RollbackBuffer::Resimulate(entt::registry& reg, uint32_t tick, uint32_t to_tick, const CorrectFn& correct,
+                                const SimulateFn& simulate) {
+    TRYENGINE_PROFILE_ZONE("RollbackBuffer::Resimulate");
+
+    if (!Restore(reg, tick))
+        return false;
+
+    if (correct) {
+        correct(reg);
+    }
+    Save(reg, tick);
+
+    for (uint32_t t = tick + 1; t <= to_tick; ++t) {
+        simulate(reg, t);
+        Save(reg, t);
+    }
+    return true;
+}
+
+}  // namespace tryengine::core
@@ -0,0 +1,257 @@
+#include "engine/core/SceneFormat.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#include "engine/core/ComponentRegistry.hpp"
+#include "engine/core/JobSystem.hpp"
+#include "engine/core/Profiler.hpp"
+
+namespace tryengine::core {
+
+namespace {
+
+constexpr size_t kSectionAlignment = 64;
+
+size_t Align(size_t offset) { return (offset + kSectionAlignment - 1) & ~(kSectionAlignment - 1); }
+
+// Дописывает секцию с выравниванием, возвращает ее смещение
+size_t AppendSection(std::vector<std::byte>& out, const void* data, size_t size) {
+    const size_t offset = Align(out.size());
+    out.resize(offset + size);
+    if (size > 0) {
+        std::memcpy(out.data() + offset, data, size);
+    }
+    return offset;
+}
+
+// Пул, прошедший проверки, — одна задача разбора
+struct PoolTask {
+    const CookedComponent* component = nullptr;
+    std::span<const entt::entity> entities;
+    std::span<const std::byte> data;
+};
+
+bool InRange(std::span<const std::byte> data, uint64_t offset, uint64_t size) {
+    return offset % kSectionAlignment == 0 && offset <= data.size() && size <= data.size() - offset;
+}
+
+}  // namespace
+
+bool WriteCookedScene(const std::filesystem::path& path, const entt::registry& reg,
+                      const ComponentRegistry& components) {
+    TRYENGINE_PROFILE_ZONE("WriteCookedScene");
+
+    const auto& cooked = components.GetCookedComponents();
+
+    CookedSceneHeader header;
+    header.pool_count = static_cast<uint32_t>(cooked.size());
+    std::vector<CookedPoolHeader> pools(cooked.size());
+
+    std::vector<std::byte> out(sizeof(CookedSceneHeader) + pools.size() * sizeof(CookedPoolHeader));
+
+    // Живые сущности с компонентами, затем освобожденные: их версии нужны, чтобы переиспользование
+    // идентификаторов после загрузки шло так же, как до сохранения
+    std::vector<entt::entity> entities;
+    if (const auto* storage = reg.storage<entt::entity>()) {
+        const size_t alive = storage->free_list();
+        for (size_t i = 0; i < alive; ++i) {
+            if (!reg.orphan(storage->data()[i])) {
+                entities.push_back(storage->data()[i]);
+            }
+        }
+        header.alive_count = entities.size();
+        entities.insert(entities.end(), storage->data() + alive, storage->data() + storage->size());
+    }
+    header.entity_count = entities.size();
+    header.entities_offset = AppendSection(out, entities.data(), entities.size() * sizeof(entt::entity));
+
+    std::vector<entt::entity> pool_entities;
+    std::vector<std::byte> data;
+    for (size_t i = 0; i < cooked.size(); ++i) {
+        cooked[i].save(reg, pool_entities, data);
+
+        CookedPoolHeader& pool = pools[i];
+        pool.name_hash = cooked[i].name_hash;
+        pool.raw = cooked[i].raw ? 1 : 0;
+        pool.element_size = cooked[i].size;
+        pool.count = pool_entities.size();
+        pool.entities_offset =
+            AppendSection(out, pool_entities.data(), pool_entities.size() * sizeof(entt::entity));
+        pool.data_offset = AppendSection(out, data.data(), data.size());
+        pool.data_size = data.size();
+    }
+
+    std::memcpy(out.data(), &header, sizeof(header));
+    std::memcpy(out.data() + sizeof(header), pools.data(), pools.size() * sizeof(CookedPoolHeader));
+
+    std::ofstream os(path, std::ios::binary | std::ios::trunc);
+    if (!os.is_open()) {
+        std::cerr << "[SceneFormat] Failed to open " << path << std::endl;
+        return false;
+    }
+    os.write(reinterpret_cast<const char*>(out.data()), static_cast<std::streamsize>(out.size()));
+    return static_cast<bool>(os);
+}
+
+bool IsCookedScene(std::span<const std::byte> data) {
+    return data.size() >= sizeof(CookedSceneHeader) && std::memcmp(data.data(), "TSCN", 4) == 0;
+}
+
+bool ReadCookedScene(std::span<const std::byte> data, entt::registry& reg, const ComponentRegistry& components,
+                     const SceneLoadOptions& options, SceneLoadStats* stats) {
+    TRYENGINE_PROFILE_ZONE("ReadCookedScene");
+    const auto start = std::chrono::steady_clock::now();
+
+    if (!IsCookedScene(data))
+        return false;
+
+    CookedSceneHeader header;
+    std::memcpy(&header, data.data(), sizeof(header));
+    if (header.version != kCookedSceneVersion) {
+        std::cerr << "[SceneFormat] Scene version " << header.version << ", expected " << kCookedSceneVersion
+                  << ": re-cook the scene" << std::endl;
+        return false;
+    }
+
+    const uint64_t table_size = static_cast<uint64_t>(header.pool_count) * sizeof(CookedPoolHeader);
+    if (table_size > data.size() - sizeof(header) || header.alive_count > header.entity_count ||
+        header.entity_count > data.size() / sizeof(entt::entity) ||
+        !InRange(data, header.entities_offset, header.entity_count * sizeof(entt::entity))) {
+        std::cerr << "[SceneFormat] Corrupted scene header" << std::endl;
+        return false;
+    }
+
+    std::vector<CookedPoolHeader> pools(header.pool_count);
+    std::memcpy(pools.data(), data.data() + sizeof(header), table_size);
+
+    // Метка последнего списка, где встретился индекс сущности: 1 — массив сущностей, i + 2 — пул i.
+    // Повтор внутри одного списка — поврежденный файл
+    const auto* entities = reinterpret_cast<const entt::entity*>(data.data() + header.entities_offset);
+    std::vector<uint32_t> seen;
+    const auto mark = [&seen](entt::entity entity, uint32_t stamp) {
+        const size_t index = entt::to_entity(entity);
+        if (index >= seen.size())
+            seen.resize(index + 1, 0);
+        if (seen[index] == stamp)
+            return false;
+        seen[index] = stamp;
+        return true;
+    };
+    for (uint64_t i = 0; i < header.entity_count; ++i) {
+        if (entities[i] == entt::null || !mark(entities[i], 1)) {
+            std::cerr << "[SceneFormat] Corrupted entity list" << std::endl;
+            return false;
+        }
+    }
+
+    reg.clear();
+
+    auto& storage = reg.storage<entt::entity>();
+    storage.reserve(header.entity_count);
+    for (uint64_t i = 0; i < header.entity_count; ++i) {
+        storage.generate(entities[i]);
+    }
+    storage.free_list(header.alive_count);
+
+    // Все проверки до разбора: задачи только копируют данные в свои пулы
+    const auto& cooked = components.GetCookedComponents();
+    std::vector<PoolTask> tasks;
+    tasks.reserve(pools.size());
+    for (uint32_t pool_index = 0; pool_index < pools.size(); ++pool_index) {
+        const CookedPoolHeader& pool = pools[pool_index];
+        const auto it = std::find_if(cooked.begin(), cooked.end(),
+                                     [&](const CookedComponent& c) { return c.name_hash == pool.name_hash; });
+        if (it == cooked.end())
+            continue;
+
+        // Две задачи на один пул писали бы его из разных потоков
+        if (std::any_of(tasks.begin(), tasks.end(), [&](const PoolTask& task) { return task.component == &*it; })) {
+            std::cerr << "[SceneFormat] Pool " << it->name << " is listed twice" << std::endl;
+            return false;
+        }
+
+        if (pool.count > data.size() / sizeof(entt::entity) ||
+            !InRange(data, pool.entities_offset, pool.count * sizeof(entt::entity)) ||
+            !InRange(data, pool.data_offset, pool.data_size)) {
+            std::cerr << "[SceneFormat] Corrupted pool " << it->name << std::endl;
+            return false;
+        }
+        if (pool.raw != (it->raw ? 1u : 0u) || pool.element_size != it->size) {
+            std::cerr << "[SceneFormat] Layout of " << it->name << " changed: re-cook the scene" << std::endl;
+            return false;
+        }
+
+        const std::span pool_entities(
+            reinterpret_cast<const entt::entity*>(data.data() + pool.entities_offset), pool.count);
+        for (const auto entity : pool_entities) {
+            if (!reg.valid(entity)) {
+                std::cerr << "[SceneFormat] Pool " << it->name << " references a dead entity" << std::endl;
+                return false;
+            }
+            if (!mark(entity, pool_index + 2)) {
+                std::cerr << "[SceneFormat] Pool " << it->name << " lists an entity twice" << std::endl;
+                return false;
+            }
+        }
+
+        it->prepare(reg);
+        tasks.push_back({&*it, pool_entities, data.subspan(pool.data_offset, pool.data_size)});
+    }
+
+    // Задачи пишут каждая в свой пул: реестр с уже созданными пулами это допускает. Сигналы on_construct
+    // при этом срабатывают в потоках задач — у только что созданной сцены их нет
+    std::atomic<bool> ok{true};
+    std::atomic<size_t> done{0};
+    std::vector<double> pool_ms(tasks.size(), 0.0);
+    const auto run = [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const PoolTask& task = tasks[i];
+            const auto pool_start = std::chrono::steady_clock::now();
+
+            if (!task.component->load(reg, task.entities, task.data)) {
+                std::cerr << "[SceneFormat] Failed to read pool " << task.component->name << std::endl;
+                ok.store(false, std::memory_order_relaxed);
+                continue;
+            }
+            if (options.resources && task.component->resolve) {
+                task.component->resolve(reg, task.entities, *options.resources);
+            }
+
+            const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - pool_start;
+            pool_ms[i] = elapsed.count();
+
+            const size_t finished = done.fetch_add(1, std::memory_order_relaxed) + 1;
+            if (options.progress) {
+                // Задачи завершаются вразнобой: доля только растет
+                const float value = static_cast<float>(finished) / static_cast<float>(tasks.size());
+                float current = options.progress->load(std::memory_order_relaxed);
+                while (current < value && !options.progress->compare_exchange_weak(current, value)) {
+                }
+            }
+        }
+    };
+
+    if (options.jobs && tasks.size() > 1) {
+        options.jobs->ParallelFor(tasks.size(), 1, run);
+    } else {
+        run(0, tasks.size());
+    }
+
+    if (stats) {
+        stats->pools.clear();
+        for (size_t i = 0; i < tasks.size(); ++i) {
+            stats->pools.push_back({tasks[i].component->name, tasks[i].entities.size(), pool_ms[i]});
+        }
+        const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        stats->total_ms = elapsed.count();
+    }
+    return ok.load(std::memory_order_relaxed);
+}
+
+}  // namespace tryengine::core
@@ -0,0 +1,318 @@
+#include "engine/core/SceneGraph.hpp"
+
+#include <algorithm>
+#include <utility>
+
+#include "engine/core/Components.hpp"
+
+namespace tryengine::core {
+
+uint32_t ChildSpanPool::Allocate(uint8_t size_class) {
+    if (size_class < free_lists_.size() && !free_lists_[size_class].empty()) {
+        const uint32_t offset = free_lists_[size_class].back();
+        free_lists_[size_class].pop_back();
+        return offset;
+    }
+
+    const auto offset = static_cast<uint32_t>(storage_.size());
+    storage_.resize(storage_.size() + (size_t{1} << size_class), entt::null);
+    return offset;
+}
+
+void ChildSpanPool::Free(uint32_t offset, uint8_t size_class) {
+    if (size_class >= free_lists_.size()) {
+        free_lists_.resize(size_class + 1);
+    }
+    free_lists_[size_class].push_back(offset);
+}
+
+void ChildSpanPool::Clear() {
+    storage_.clear();
+    free_lists_.clear();
+}
+
+std::span<const entt::entity> SceneGraph::GetChildren(entt::entity parent) const {
+    const Node* node = Find(parent);
+    if (!node || node->count == 0)
+        return {};
+
+    return {pool_.Data(node->offset), node->count};
+}
+
+entt::entity SceneGraph::GetParent(entt::entity entity) const {
+    const Node* node = Find(entity);
+    return node ? node->parent : entt::null;
+}
+
+bool SceneGraph::IsAncestor(entt::entity ancestor, entt::entity entity) const {
+    // Ограничение по числу узлов — защита от зацикливания на битых данных
+    entt::entity curr = GetParent(entity);
+    for (size_t steps = 0; curr != entt::null && steps < nodes_.size(); ++steps) {
+        if (curr == ancestor)
+            return true;
+        curr = GetParent(curr);
+    }
+    return false;
+}
+
+bool SceneGraph::SetParent(entt::registry& reg, entt::entity entity, entt::entity new_parent) {
+    if (entity == new_parent || (new_parent != entt::null && IsAncestor(entity, new_parent)))
+        return false;
+
+    reg.get_or_emplace<Relationship>(entity);
+    FindOrCreate(entity);
+    if (new_parent != entt::null) {
+        reg.get_or_emplace<Relationship>(new_parent);
+        FindOrCreate(new_parent);
+    }
+
+    // Ссылки на узлы берем только после FindOrCreate: он может переаллоцировать nodes_
+    Node& node = *Find(entity);
+    const entt::entity old_parent = node.parent;
+
+    if (old_parent != entt::null) {
+        const uint32_t index = node.index_in_parent;
+        RemoveFromParent(node);
+        WriteLinksAfterRemove(reg, old_parent, index);
+    }
+
+    if (new_parent != entt::null) {
+        AppendChild(*Find(new_parent), entity);
+
+        const auto siblings = GetChildren(new_parent);
+        if (siblings.size() > 1)
+            WriteLinks(reg, siblings[siblings.size() - 2]);
+        WriteLinks(reg, new_parent);
+    }
+
+    WriteLinks(reg, entity);
+    reg.patch<Relationship>(entity);
+    return true;
+}
+
+void SceneGraph::Detach(entt::registry& reg, entt::entity entity) {
+    Node* node = Find(entity);
+    if (!node)
+        return;
+
+    if (const entt::entity old_parent = node->parent; old_parent != entt::null) {
+        const uint32_t index = node->index_in_parent;
+        RemoveFromParent(*node);
+        WriteLinksAfterRemove(reg, old_parent, index);
+    }
+
+    // Дети становятся корнями
+    for (const auto child : GetChildren(entity)) {
+        Node& child_node = *Find(child);
+        child_node.parent = entt::null;
+        child_node.index_in_parent = 0;
+        WriteLinks(reg, child);
+    }
+
+    if (node->size_class != 0) {
+        pool_.Free(node->offset, node->size_class);
+    }
+    *node = Node{};
+}
+
+void SceneGraph::RebuildFromRelationships(const entt::registry& reg) {
+    nodes_.clear();
+    pool_.Clear();
+
+    const auto* relationships = reg.storage<Relationship>();
+    if (!relationships)
+        return;
+
+    for (const auto [entity, rel] : relationships->each()) {
+        FindOrCreate(entity);
+    }
+
+    // Порядок детей берем из связного списка; ребенок засчитывается, только если он сам ссылается на родителя
+    for (const auto [entity, rel] : relationships->each()) {
+        entt::entity curr = rel.first;
+        for (size_t steps = 0; curr != entt::null && relationships->contains(curr) && steps < relationships->size();
+             ++steps) {
+            const auto& child_rel = relationships->get(curr);
+            if (child_rel.parent == entity && Find(curr)->parent == entt::null) {
+                AppendChild(*Find(entity), curr);
+            }
+            curr = child_rel.next;
+        }
+    }
+}
+
+void SceneGraph::AddFromRelationships(const entt::registry& reg, std::span<const entt::entity> entities) {
+    AddNodes(reg, entities);
+    LinkChildren(reg, entities);
+}
+
+void SceneGraph::AddNodes(const entt::registry& reg, std::span<const entt::entity> entities) {
+    const auto* relationships = reg.storage<Relationship>();
+    if (!relationships)
+        return;
+
+    for (const auto entity : entities) {
+        if (relationships->contains(entity)) {
+            FindOrCreate(entity);
+        }
+    }
+}
+
+void SceneGraph::LinkChildren(const entt::registry& reg, std::span<const entt::entity> parents) {
+    const auto* relationships = reg.storage<Relationship>();
+    if (!relationships)
+        return;
+
+    // Тот же обход, что в RebuildFromRelationships, но только по новым родителям
+    for (const auto entity : parents) {
+        if (!relationships->contains(entity))
+            continue;
+
+        entt::entity curr = relationships->get(entity).first;
+        for (size_t steps = 0; curr != entt::null && relationships->contains(curr) && steps < relationships->size();
+             ++steps) {
+            const auto& child_rel = relationships->get(curr);
+            const Node* child = Find(curr);
+            if (child_rel.parent == entity && child && child->parent == entt::null) {
+                AppendChild(*Find(entity), curr);
+            }
+            curr = child_rel.next;
+        }
+    }
+}
+
+const SceneGraph::Node* SceneGraph::Find(entt::entity entity) const {
+    if (entity == entt::null)
+        return nullptr;
+
+    const auto slot = static_cast<size_t>(entt::to_entity(entity));
+    return slot < nodes_.size() && nodes_[slot].entity == entity ? &nodes_[slot] : nullptr;
+}
+
+SceneGraph::Node* SceneGraph::Find(entt::entity entity) {
+    return const_cast<Node*>(std::as_const(*this).Find(entity));
+}
+
+SceneGraph::Node& SceneGraph::FindOrCreate(entt::entity entity) {
+    const auto slot = static_cast<size_t>(entt::to_entity(entity));
+    if (slot >= nodes_.size()) {
+        nodes_.resize(slot + 1);
+    }
+
+    Node& node = nodes_[slot];
+    if (node.entity != entity) {
+        // Слот мог остаться от уничтоженной сущности со старой версией
+        if (node.size_class != 0) {
+            pool_.Free(node.offset, node.size_class);
+        }
+        node = Node{};
+        node.entity = entity;
+    }
+    return node;
+}
+
+void SceneGraph::AppendChild(Node& parent, entt::entity child) {
+    const uint32_t capacity = parent.size_class == 0 ? 0 : uint32_t{1} << parent.size_class;
+
+    if (parent.count == capacity) {
+        const uint8_t size_class = std::max<uint8_t>(ChildSpanPool::kMinSizeClass, parent.size_class + 1);
+        const uint32_t offset = pool_.Allocate(size_class);
+
+        if (parent.size_class != 0) {
+            std::copy_n(pool_.Data(parent.offset), parent.count, pool_.Data(offset));
+            pool_.Free(parent.offset, parent.size_class);
+        }
+        parent.offset = offset;
+        parent.size_class = size_class;
+    }
+
+    pool_.Data(parent.offset)[parent.count] = child;
+
+    Node& child_node = *Find(child);
+    child_node.parent = parent.entity;
+    child_node.index_in_parent = parent.count;
+    ++parent.count;
+}
+
+void SceneGraph::RemoveFromParent(Node& node) {
+    if (Node* parent = Find(node.parent)) {
+        // Последний ребенок встает на место удаленного — без сдвига остальных
+        entt::entity* children = pool_.Data(parent->offset);
+        --parent->count;
+        if (node.index_in_parent != parent->count) {
+            children[node.index_in_parent] = children[parent->count];
+            Find(children[node.index_in_parent])->index_in_parent = node.index_in_parent;
+        }
+
+        if (parent->count == 0) {
+            pool_.Free(parent->offset, parent->size_class);
+            parent->offset = 0;
+            parent->size_class = 0;
+        }
+    }
+
+    node.parent = entt::null;
+    node.index_in_parent = 0;
+}
+
+void SceneGraph::WriteLinksAfterRemove(entt::registry& reg, entt::entity parent, uint32_t index) const {
+    // На месте index теперь бывший последний ребенок: меняются ссылки у него, его новых соседей
+    // и у нового последнего
+    const auto siblings = GetChildren(parent);
+    if (index > 0)
+        WriteLinks(reg, siblings[index - 1]);
+    if (index < siblings.size())
+        WriteLinks(reg, siblings[index]);
+    if (index + 1 < siblings.size())
+        WriteLinks(reg, siblings[index + 1]);
+    if (!siblings.empty() && siblings.size() - 1 > index + 1)
+        WriteLinks(reg, siblings.back());
+    WriteLinks(reg, parent);
+}
+
+void SceneGraph::WriteLinks(entt::registry& reg, entt::entity entity) const {
+    auto* rel = reg.try_get<Relationship>(entity);
+    if (!rel)
+        return;
+
+    const auto children = GetChildren(entity);
+    rel->children = children.size();
+    rel->first = children.empty() ? entt::null : children.front();
+
+    const Node* node = Find(entity);
+    rel->parent = node ? node->parent : entt::null;
+    rel->prev = entt::null;
+    rel->next = entt::null;
+
+    if (rel->parent != entt::null) {
+        const auto siblings = GetChildren(rel->parent);
+        const uint32_t index = node->index_in_parent;
+        if (index > 0)
+            rel->prev = siblings[index - 1];
+        if (index + 1 < siblings.size())
+            rel->next = siblings[index + 1];
+    }
+}
+
+namespace {
+
+void OnRelationshipDestroyed(entt::registry& reg, entt::entity entity) {
+    if (auto* graph = reg.ctx().find<SceneGraph>()) {
+        graph->Detach(reg, entity);
+    }
+}
+
+}  // namespace
+
+SceneGraph& AcquireSceneGraph(entt::registry& reg) {
+    if (auto* graph = reg.ctx().find<SceneGraph>()) {
+        return *graph;
+    }
+
+    auto& graph = reg.ctx().emplace<SceneGraph>();
+    graph.RebuildFromRelationships(reg);
+    reg.on_destroy<Relationship>().connect<&OnRelationshipDestroyed>();
+    return graph;
+}
+
+}  // namespace tryengine::core
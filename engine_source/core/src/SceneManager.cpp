@@ -1,38 +1,93 @@
 #include "engine/core/SceneManager.hpp"
 
+#include <algorithm>
 #include <cereal/archives/binary.hpp>
 #include <cereal/archives/json.hpp>
+#include <chrono>
 #include <filesystem>
-#include <fstream>
 #include <iostream>
+#include <istream>
+#include <span>
 
 #include "engine/core/ComponentRegistry.hpp"
+#include "engine/core/MappedFile.hpp"
+#include "engine/core/Profiler.hpp"
 #include "engine/core/ResourceManager.hpp"
+#include "engine/core/SceneFormat.hpp"
+#include "engine/core/SceneGraph.hpp"
 
 namespace tryengine::core {
 
-bool SceneManager::LoadScene(const uint64_t scene_id) {
+namespace {
+
+// Сущностей за одну порцию слияния и выгрузки: между порциями проверяется бюджет кадра
+constexpr size_t kSceneChunk = 1024;
+
+}  // namespace
+
+std::unique_ptr<Scene> SceneManager::ReadScene(const uint64_t scene_id, SceneLoadStats* stats,
+                                               std::atomic<float>* progress) const {
     auto path = resource_manager_.GetAssetDatabase().GetPath(scene_id);
 
     if (!std::filesystem::exists(path)) {
         std::cerr << "Error: File does not exist at path: " << path << std::endl;
-        return false;
+        return nullptr;
     }
 
-    std::ifstream is(path);
-    if (!is.is_open()) {
+    // Артефакт отображается в память: запеченная сцена читается из него напрямую, старые артефакты
+    // (cereal) — через поток поверх той же памяти
+    MappedFile file;
+    if (!file.Open(path)) {
         std::cerr << "Error: Failed to open file stream: " << path << std::endl;
-        return false;
+        return nullptr;
     }
 
     auto new_scene = std::make_unique<Scene>();
     new_scene->SetAssetID(scene_id);
 
-    cereal::BinaryInputArchive archive(is);
-    component_registry_.Deserialize(new_scene->GetRegistry(), archive);
-    component_registry_.ResolveAll(new_scene->GetRegistry(),resource_manager_);
+    if (IsCookedScene(file.GetData())) {
+        // Ресурсы резолвятся в задачах разбора пулов, отдельный проход ResolveAll не нужен
+        const SceneLoadOptions options{jobs_, &resource_manager_, progress};
+        if (!ReadCookedScene(file.GetData(), new_scene->GetRegistry(), component_registry_, options, stats)) {
+            std::cerr << "Error: Failed to read cooked scene: " << path << std::endl;
+            return nullptr;
+        }
+    } else {
+        MemoryStreamBuf buffer(file.GetData());
+        std::istream is(&buffer);
+        cereal::BinaryInputArchive archive(is);
+        component_registry_.Deserialize(new_scene->GetRegistry(), archive);
+        component_registry_.ResolveAll(new_scene->GetRegistry(), resource_manager_);
+    }
+    if (progress) {
+        progress->store(1.0f, std::memory_order_relaxed);
+    }
+
+    return new_scene;
+}
+
+std::unique_ptr<Scene> SceneManager::InstantiateScene(const uint64_t scene_id, SceneLoadStats* stats) const {
+    return ReadScene(scene_id, stats, nullptr);
+}
+
+std::unique_ptr<Scene> SceneManager::InstantiateScene(const std::string& scene_name, SceneLoadStats* stats) const {
+    return InstantiateScene(resource_manager_.GetAddressables().Get(scene_name), stats);
+}
 
+bool SceneManager::LoadScene(const uint64_t scene_id) {
+    SceneLoadStats stats;
+    auto new_scene = InstantiateScene(scene_id, &stats);
+    if (!new_scene)
+        return false;
+
+    last_load_stats_ = std::move(stats);
+    Dispose(std::move(active_scene_));
     active_scene_ = std::move(new_scene);
+
+    loaded_scenes_.clear();
+    unload_queue_.clear();
+    const auto& entities = active_scene_->GetRegistry().storage<entt::entity>();
+    loaded_scenes_[scene_id].assign(entities.data(), entities.data() + entities.free_list());
     return true;
 }
 
@@ -42,4 +97,220 @@ bool SceneManager::LoadScene(const std::string& scene_name) {
     return LoadScene(id);
 }
 
+std::shared_ptr<const SceneLoadOperation> SceneManager::LoadSceneAsync(const uint64_t scene_id,
+                                                                       const SceneLoadMode mode) {
+    auto operation = std::make_shared<SceneLoadOperation>();
+    operation->scene_id_ = scene_id;
+    operation->mode_ = mode;
+    operations_.push_back(operation);
+
+    if (jobs_) {
+        // Задача держит операцию: ее могут отпустить все, кроме SceneManager, и наоборот
+        jobs_->Run([this, operation] { RunLoad(*operation); }, &loads_);
+    } else {
+        RunLoad(*operation);
+    }
+    return operation;
+}
+
+std::shared_ptr<const SceneLoadOperation> SceneManager::LoadSceneAsync(const std::string& scene_name,
+                                                                       const SceneLoadMode mode) {
+    return LoadSceneAsync(resource_manager_.GetAddressables().Get(scene_name), mode);
+}
+
+void SceneManager::RunLoad(SceneLoadOperation& operation) const {
+    TRYENGINE_PROFILE_ZONE("SceneManager::RunLoad");
+
+    operation.staging_ = ReadScene(operation.scene_id_, &operation.stats_, &operation.load_progress_);
+    if (!operation.staging_) {
+        operation.state_.store(SceneLoadOperation::State::Failed, std::memory_order_release);
+        return;
+    }
+
+    // Все, что не трогает активную сцену, готовится здесь же, а не на главном потоке
+    const auto& entities = operation.staging_->GetRegistry().storage<entt::entity>();
+    operation.entities_.assign(entities.data(), entities.data() + entities.free_list());
+
+    if (operation.mode_ == SceneLoadMode::Additive) {
+        size_t max_index = 0;
+        for (const auto entity : operation.entities_) {
+            max_index = std::max(max_index, static_cast<size_t>(entt::to_entity(entity)));
+        }
+        operation.remap_.table.assign(operation.entities_.empty() ? 0 : max_index + 1, entt::null);
+        operation.created_entities_.resize(operation.entities_.size());
+    }
+
+    operation.state_.store(SceneLoadOperation::State::Merging, std::memory_order_release);
+}
+
+double SceneManager::Update(const double budget_ms) {
+    TRYENGINE_PROFILE_ZONE("SceneManager::Update");
+
+    using Clock = std::chrono::steady_clock;
+    const auto start = Clock::now();
+    const auto deadline = start + std::chrono::duration_cast<Clock::duration>(
+                                      std::chrono::duration<double, std::milli>(budget_ms));
+
+    // Загрузки применяются строго по порядку: следующая ждет, пока не дочитается предыдущая
+    while (!operations_.empty()) {
+        SceneLoadOperation& operation = *operations_.front();
+        if (operation.GetState() == SceneLoadOperation::State::Loading)
+            break;
+
+        const auto step_start = Clock::now();
+        const bool finished = operation.GetState() == SceneLoadOperation::State::Failed || Apply(operation, deadline);
+        const std::chrono::duration<double, std::milli> step = Clock::now() - step_start;
+        operation.max_stall_ms_ = std::max(operation.max_stall_ms_, step.count());
+
+        if (!finished)
+            break;
+        operations_.pop_front();
+        if (Clock::now() >= deadline)
+            break;
+    }
+
+    // Выгрузка — хотя бы одна порция за кадр, дальше по остатку бюджета
+    if (active_scene_) {
+        auto& reg = active_scene_->GetRegistry();
+        do {
+            const size_t count = std::min(unload_queue_.size(), kSceneChunk);
+            for (size_t i = unload_queue_.size() - count; i < unload_queue_.size(); ++i) {
+                if (reg.valid(unload_queue_[i])) {
+                    reg.destroy(unload_queue_[i]);
+                }
+            }
+            unload_queue_.resize(unload_queue_.size() - count);
+        } while (!unload_queue_.empty() && Clock::now() < deadline);
+    }
+
+    const std::chrono::duration<double, std::milli> elapsed = Clock::now() - start;
+    return elapsed.count();
+}
+
+bool SceneManager::Apply(SceneLoadOperation& operation, const std::chrono::steady_clock::time_point deadline) {
+    if (operation.mode_ == SceneLoadMode::Single || !active_scene_) {
+        SwapIn(operation);
+        return true;
+    }
+
+    if (!operation.target_) {
+        operation.target_ = active_scene_.get();
+    } else if (operation.target_ != active_scene_.get()) {
+        // Активную сцену подменили посреди слияния — созданные сущности остались в старой
+        std::cerr << "Error: Active scene changed while merging scene " << operation.scene_id_ << std::endl;
+        Dispose(std::move(operation.staging_));
+        operation.state_.store(SceneLoadOperation::State::Failed, std::memory_order_release);
+        return true;
+    }
+
+    auto& world = active_scene_->GetRegistry();
+    const auto& staging = operation.staging_->GetRegistry();
+    const auto& cooked = component_registry_.GetCookedComponents();
+    // Граф иерархии мира, если он уже создан, не видит новых Relationship — новые сущности вносятся в него
+    // такими же порциями: сначала узлы, затем списки детей
+    auto* graph = world.ctx().find<SceneGraph>();
+    const size_t count = operation.entities_.size();
+    const size_t graph_total = graph ? count * 2 : 0;
+    const size_t total = count * (1 + cooked.size()) + graph_total;
+
+    // Порции: сначала сущности (по ним строится remap), затем пулы по очереди и граф, по kSceneChunk сущностей
+    do {
+        if (operation.created_ < count) {
+            const size_t begin = operation.created_;
+            const size_t end = std::min(count, begin + kSceneChunk);
+            const auto out = operation.created_entities_.begin();
+            world.create(out + static_cast<std::ptrdiff_t>(begin), out + static_cast<std::ptrdiff_t>(end));
+            for (size_t i = begin; i < end; ++i) {
+                operation.remap_.table[entt::to_entity(operation.entities_[i])] = operation.created_entities_[i];
+            }
+            operation.created_ = end;
+        } else if (count > 0 && operation.pool_ < cooked.size()) {
+            const size_t begin = operation.pool_offset_;
+            const size_t end = std::min(count, begin + kSceneChunk);
+            const std::span<const entt::entity> chunk(operation.entities_.data() + begin, end - begin);
+            cooked[operation.pool_].merge(staging, world, chunk, operation.remap_);
+            if (end == count) {
+                ++operation.pool_;
+                operation.pool_offset_ = 0;
+            } else {
+                operation.pool_offset_ = end;
+            }
+        } else if (operation.graph_offset_ < graph_total) {
+            const size_t begin = operation.graph_offset_ % count;
+            const size_t end = std::min(count, begin + kSceneChunk);
+            const std::span<const entt::entity> chunk(operation.created_entities_.data() + begin, end - begin);
+            if (operation.graph_offset_ < count) {
+                graph->AddNodes(world, chunk);
+            } else {
+                graph->LinkChildren(world, chunk);
+            }
+            operation.graph_offset_ += end - begin;
+        } else {
+            break;
+        }
+
+        const size_t done =
+            operation.created_ + operation.pool_ * count + operation.pool_offset_ + operation.graph_offset_;
+        operation.merge_progress_.store(static_cast<float>(done) / static_cast<float>(total),
+                                        std::memory_order_relaxed);
+    } while (std::chrono::steady_clock::now() < deadline);
+
+    if (operation.created_ < count || (count > 0 && operation.pool_ < cooked.size()) ||
+        operation.graph_offset_ < graph_total)
+        return false;
+
+    auto& loaded = loaded_scenes_[operation.scene_id_];
+    loaded.insert(loaded.end(), operation.created_entities_.begin(), operation.created_entities_.end());
+
+    Dispose(std::move(operation.staging_));
+    operation.merge_progress_.store(1.0f, std::memory_order_relaxed);
+    operation.state_.store(SceneLoadOperation::State::Done, std::memory_order_release);
+    return true;
+}
+
+void SceneManager::SwapIn(SceneLoadOperation& operation) {
+    last_load_stats_ = operation.stats_;
+    Dispose(std::move(active_scene_));
+    active_scene_ = std::move(operation.staging_);
+
+    loaded_scenes_.clear();
+    unload_queue_.clear();
+    loaded_scenes_[operation.scene_id_] = std::move(operation.entities_);
+
+    operation.merge_progress_.store(1.0f, std::memory_order_relaxed);
+    operation.state_.store(SceneLoadOperation::State::Done, std::memory_order_release);
+}
+
+void SceneManager::Dispose(std::unique_ptr<Scene> scene) {
+    if (!scene || !jobs_)
+        return;
+
+    // std::function копируемый — сцена едет в shared_ptr
+    auto garbage = std::make_shared<std::unique_ptr<Scene>>(std::move(scene));
+    jobs_->Run([garbage] { garbage->reset(); }, &loads_);
+}
+
+bool SceneManager::UnloadScene(const uint64_t scene_id) {
+    const auto it = loaded_scenes_.find(scene_id);
+    if (it == loaded_scenes_.end())
+        return false;
+
+    unload_queue_.insert(unload_queue_.end(), it->second.begin(), it->second.end());
+    loaded_scenes_.erase(it);
+    return true;
+}
+
+float SceneLoadOperation::GetProgress() const {
+    if (IsDone())
+        return 1.0f;
+    return 0.5f * load_progress_.load(std::memory_order_relaxed) +
+           0.5f * merge_progress_.load(std::memory_order_relaxed);
+}
+
+SceneManager::~SceneManager() {
+    if (jobs_ && !loads_.IsDone()) {
+        jobs_->Wait(loads_);
+    }
+}
+
 }  // namespace tryengine::core
\ No newline at end of file
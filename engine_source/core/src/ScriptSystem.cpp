@@ -4,19 +4,32 @@
 #include <daScript/simulate/aot.h>
 #include <daScript/simulate/runtime_array.h>
 #include <iostream>
+#include <mutex>
 #include <set>
 
+#include "engine/core/Profiler.hpp"
+
 DECLARE_MODULE(Module_Renderer);
-DECLARE_MODULE(Module_TryEditor);
 
-inline void InitializeDaScriptModules() {
+inline void InitializeDaScriptModules(const std::function<void()>& register_extra_modules) {
     NEED_ALL_DEFAULT_MODULES;
     NEED_MODULE(Module_Renderer);
-    NEED_MODULE(Module_TryEditor);
+    if (register_extra_modules) {
+        register_extra_modules();
+    }
 }
 
 namespace tryengine::core {
 
+namespace {
+
+// Модули daslang — глобальное состояние процесса. У сервера по ScriptSystem на комнату,
+// поэтому модули поднимает первый экземпляр, а гасит последний
+std::mutex das_modules_mutex;
+uint32_t das_modules_users = 0;
+
+}  // namespace
+
 class TrackingFileAccess : public das::FsFileAccess {
 public:
     // Передаем скомпилированную программу проекта в базовый конструктор
@@ -34,9 +47,13 @@ public:
     std::set<std::string> tracked_files;
 };
 
-ScriptSystem::ScriptSystem() {
+ScriptSystem::ScriptSystem(const std::function<void()>& register_extra_modules) {
+    std::lock_guard lock(das_modules_mutex);
+    if (das_modules_users++ > 0)
+        return;
+
     das::setDasRoot(DAS_ROOT_DIR);
-    InitializeDaScriptModules();
+    InitializeDaScriptModules(register_extra_modules);
 
     das::TextPrinter tout;
     das::vector<das::string> load_modules;
@@ -67,7 +84,11 @@ ScriptSystem::~ScriptSystem() {
         delete das_ctx;
         das_ctx = nullptr;
     }
-    das::Module::Shutdown();
+
+    std::lock_guard lock(das_modules_mutex);
+    if (--das_modules_users == 0) {
+        das::Module::Shutdown();
+    }
 }
 
 bool ScriptSystem::LoadMainScript(const std::string& path) {
@@ -215,6 +236,8 @@ void ScriptSystem::InvokeStart() {
 
 
 void ScriptSystem::InvokeUpdate(float dt) {
+    TRYENGINE_PROFILE_ZONE("ScriptSystem::InvokeUpdate");
+
     // КРИТИЧЕСКИЙ МОМЕНТ: если система заморожена из-за ошибки компиляции, игнорируем тик обновления
     if (is_frozen_)
         return;
@@ -229,4 +252,10 @@ das::Context* ScriptSystem::GetContext() {
     return das_ctx;
 }
 
+size_t ScriptSystem::GetHeapBytes() const {
+    if (!das_ctx)
+        return 0;
+    return das_ctx->heap->bytesAllocated() + das_ctx->stringHeap->bytesAllocated();
+}
+
 }  // namespace tryengine::core
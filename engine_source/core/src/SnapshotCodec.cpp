@@ -0,0 +1,383 @@
+#include "engine/core/SnapshotCodec.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+#include "engine/core/ComponentRegistry.hpp"
+#include "engine/core/Profiler.hpp"
+
+namespace tryengine::core {
+
+namespace {
+
+const Snapshot kEmptySnapshot;
+const SnapshotPool kEmptyPool;
+
+const SnapshotPool& PoolAt(const Snapshot& snapshot, size_t index) {
+    return index < snapshot.pools.size() ? snapshot.pools[index] : kEmptyPool;
+}
+
+// Обход двух отсортированных списков сущностей: что ушло, что появилось, что есть в обоих
+template <typename OnRemoved, typename OnAdded, typename OnBoth>
+void MergeWalk(const std::vector<entt::entity>& before, const std::vector<entt::entity>& after, OnRemoved&& on_removed,
+               OnAdded&& on_added, OnBoth&& on_both) {
+    size_t i = 0;
+    size_t j = 0;
+    while (i < before.size() || j < after.size()) {
+        if (j == after.size() || (i < before.size() && before[i] < after[j])) {
+            on_removed(i++);
+        } else if (i == before.size() || after[j] < before[i]) {
+            on_added(j++);
+        } else {
+            on_both(i++, j++);
+        }
+    }
+}
+
+// Возрастающий список id — разностями с предыдущим
+class EntityDeltaWriter {
+public:
+    explicit EntityDeltaWriter(BitWriter& writer) : writer_(writer) {}
+
+    void Write(entt::entity entity) {
+        const uint32_t id = entt::to_integral(entity);
+        writer_.WriteVarUint(id - previous_);
+        previous_ = id;
+    }
+
+private:
+    BitWriter& writer_;
+    uint32_t previous_ = 0;
+};
+
+class EntityDeltaReader {
+public:
+    explicit EntityDeltaReader(BitReader& reader) : reader_(reader) {}
+
+    // false — список не возрастает или id вне диапазона
+    bool Read(entt::entity& out) {
+        const uint64_t delta = reader_.ReadVarUint();
+        if ((!first_ && delta == 0) || delta > UINT32_MAX || previous_ + delta > UINT32_MAX)
+            return false;
+
+        const uint64_t id = previous_ + delta;
+        first_ = false;
+        previous_ = id;
+        out = static_cast<entt::entity>(static_cast<uint32_t>(id));
+        return true;
+    }
+
+private:
+    BitReader& reader_;
+    uint64_t previous_ = 0;
+    bool first_ = true;
+};
+
+void WriteEntityList(BitWriter& writer, const std::vector<entt::entity>& entities) {
+    writer.WriteVarUint(entities.size());
+    EntityDeltaWriter deltas(writer);
+    for (const auto entity : entities) {
+        deltas.Write(entity);
+    }
+}
+
+// Каждый элемент — минимум 8 бит, так что count больше оставшихся байт — мусор (и не даем раздуть resize)
+bool ReadCount(BitReader& reader, size_t& count) {
+    count = static_cast<size_t>(reader.ReadVarUint());
+    return !reader.IsOverflowed() && count <= reader.GetBitsLeft() / 8;
+}
+
+bool ReadEntityList(BitReader& reader, std::vector<entt::entity>& entities) {
+    size_t count = 0;
+    if (!ReadCount(reader, count))
+        return false;
+
+    entities.resize(count);
+    EntityDeltaReader deltas(reader);
+    for (auto& entity : entities) {
+        if (!deltas.Read(entity))
+            return false;
+    }
+    return !reader.IsOverflowed();
+}
+
+bool Contains(const std::vector<entt::entity>& sorted, entt::entity entity) {
+    return std::binary_search(sorted.begin(), sorted.end(), entity);
+}
+
+// Значение сущности в пуле или nullptr
+const std::byte* FindValue(const SnapshotPool& pool, entt::entity entity, size_t size) {
+    const auto it = std::lower_bound(pool.entities.begin(), pool.entities.end(), entity);
+    if (it == pool.entities.end() || *it != entity)
+        return nullptr;
+    return pool.values.data() + static_cast<size_t>(it - pool.entities.begin()) * size;
+}
+
+}  // namespace
+
+SnapshotCodec::SnapshotCodec(const ComponentRegistry& registry) : registry_(registry) {}
+
+void SnapshotCodec::Capture(const entt::registry& reg, uint32_t sequence, Snapshot& out) const {
+    TRYENGINE_PROFILE_ZONE("SnapshotCodec::Capture");
+
+    const auto& types = registry_.GetReplicatedComponents();
+    out.sequence = sequence;
+    out.pools.resize(types.size());
+
+    out.entities.clear();
+    for (size_t t = 0; t < types.size(); ++t) {
+        SnapshotPool& pool = out.pools[t];
+        types[t].capture(reg, pool.entities, pool.values);
+        out.entities.insert(out.entities.end(), pool.entities.begin(), pool.entities.end());
+    }
+
+    std::sort(out.entities.begin(), out.entities.end());
+    out.entities.erase(std::unique(out.entities.begin(), out.entities.end()), out.entities.end());
+}
+
+void SnapshotCodec::Compose(const Snapshot& current, const Snapshot* baseline, std::span<const entt::entity> fresh,
+                            std::span<const entt::entity> stale, uint32_t sequence, Snapshot& out) const {
+    TRYENGINE_PROFILE_ZONE("SnapshotCodec::Compose");
+
+    const Snapshot& base = baseline ? *baseline : kEmptySnapshot;
+    const auto& types = registry_.GetReplicatedComponents();
+
+    out.sequence = sequence;
+    out.entities.resize(fresh.size() + stale.size());
+    std::merge(fresh.begin(), fresh.end(), stale.begin(), stale.end(), out.entities.begin());
+
+    out.pools.resize(types.size());
+    for (size_t t = 0; t < types.size(); ++t) {
+        const size_t size = types[t].size;
+        const SnapshotPool& current_pool = PoolAt(current, t);
+        const SnapshotPool& base_pool = PoolAt(base, t);
+        SnapshotPool& pool = out.pools[t];
+        pool.entities.clear();
+        pool.values.clear();
+
+        const auto push = [&](const SnapshotPool& source, entt::entity entity) {
+            if (const std::byte* value = FindValue(source, entity, size)) {
+                pool.entities.push_back(entity);
+                pool.values.insert(pool.values.end(), value, value + size);
+            }
+        };
+
+        size_t i = 0;
+        size_t j = 0;
+        while (i < fresh.size() || j < stale.size()) {
+            if (j == stale.size() || (i < fresh.size() && fresh[i] < stale[j])) {
+                push(current_pool, fresh[i++]);
+            } else {
+                push(base_pool, stale[j++]);
+            }
+        }
+    }
+}
+
+bool SnapshotCodec::EntityDiffers(const Snapshot& a, const Snapshot& b, entt::entity entity) const {
+    const auto& types = registry_.GetReplicatedComponents();
+    for (size_t t = 0; t < types.size(); ++t) {
+        const std::byte* value_a = FindValue(PoolAt(a, t), entity, types[t].size);
+        const std::byte* value_b = FindValue(PoolAt(b, t), entity, types[t].size);
+        if (!value_a || !value_b) {
+            if (value_a != value_b)
+                return true;
+            continue;
+        }
+        if (std::memcmp(value_a, value_b, types[t].size) != 0)
+            return true;
+    }
+    return false;
+}
+
+void SnapshotCodec::Encode(const Snapshot& current, const Snapshot* baseline, BitWriter& writer) const {
+    TRYENGINE_PROFILE_ZONE("SnapshotCodec::Encode");
+
+    const Snapshot& base = baseline ? *baseline : kEmptySnapshot;
+    writer.WriteVarUint(current.sequence);
+    writer.WriteVarUint(baseline ? baseline->sequence : 0);
+
+    std::vector<entt::entity> removed;
+    std::vector<entt::entity> added;
+    MergeWalk(
+        base.entities, current.entities, [&](size_t i) { removed.push_back(base.entities[i]); },
+        [&](size_t j) { added.push_back(current.entities[j]); }, [](size_t, size_t) {});
+    WriteEntityList(writer, removed);
+    WriteEntityList(writer, added);
+
+    const auto& types = registry_.GetReplicatedComponents();
+    std::vector<uint32_t> changed;
+    for (size_t t = 0; t < types.size(); ++t) {
+        const ReplicatedComponent& type = types[t];
+        const SnapshotPool& old_pool = PoolAt(base, t);
+        const SnapshotPool& pool = PoolAt(current, t);
+
+        changed.clear();
+        removed.clear();
+        MergeWalk(
+            old_pool.entities, pool.entities,
+            [&](size_t i) {
+                // Компоненты удаленных сущностей клиент снимет сам
+                if (Contains(current.entities, old_pool.entities[i])) {
+                    removed.push_back(old_pool.entities[i]);
+                }
+            },
+            [&](size_t j) { changed.push_back(static_cast<uint32_t>(j)); },
+            [&](size_t i, size_t j) {
+                if (std::memcmp(old_pool.values.data() + i * type.size, pool.values.data() + j * type.size,
+                                type.size) != 0) {
+                    changed.push_back(static_cast<uint32_t>(j));
+                }
+            });
+
+        writer.WriteVarUint(changed.size());
+        EntityDeltaWriter deltas(writer);
+        for (const uint32_t j : changed) {
+            deltas.Write(pool.entities[j]);
+            type.write(writer, pool.values.data() + j * type.size);
+        }
+        WriteEntityList(writer, removed);
+    }
+}
+
+SnapshotHeader SnapshotCodec::ReadHeader(BitReader& reader) {
+    SnapshotHeader header;
+    header.sequence = static_cast<uint32_t>(reader.ReadVarUint());
+    header.baseline = static_cast<uint32_t>(reader.ReadVarUint());
+    return header;
+}
+
+bool SnapshotCodec::Decode(BitReader& reader, const SnapshotHeader& header, const Snapshot* baseline,
+                           Snapshot& out) const {
+    TRYENGINE_PROFILE_ZONE("SnapshotCodec::Decode");
+
+    if (header.baseline != 0 && (!baseline || baseline->sequence != header.baseline))
+        return false;
+
+    const Snapshot& base = header.baseline != 0 ? *baseline : kEmptySnapshot;
+    out.sequence = header.sequence;
+
+    std::vector<entt::entity> removed_entities;
+    std::vector<entt::entity> added_entities;
+    if (!ReadEntityList(reader, removed_entities) || !ReadEntityList(reader, added_entities))
+        return false;
+
+    out.entities.clear();
+    out.entities.reserve(base.entities.size() + added_entities.size());
+    MergeWalk(
+        base.entities, added_entities,
+        [&](size_t i) {
+            if (!Contains(removed_entities, base.entities[i])) {
+                out.entities.push_back(base.entities[i]);
+            }
+        },
+        [&](size_t j) { out.entities.push_back(added_entities[j]); },
+        [&](size_t, size_t j) { out.entities.push_back(added_entities[j]); });
+
+    const auto& types = registry_.GetReplicatedComponents();
+    out.pools.resize(types.size());
+
+    std::vector<entt::entity> changed_entities;
+    std::vector<std::byte> changed_values;
+    std::vector<entt::entity> removed;
+    for (size_t t = 0; t < types.size(); ++t) {
+        const ReplicatedComponent& type = types[t];
+        const SnapshotPool& old_pool = PoolAt(base, t);
+        SnapshotPool& pool = out.pools[t];
+
+        size_t count = 0;
+        if (!ReadCount(reader, count))
+            return false;
+
+        changed_entities.resize(count);
+        changed_values.resize(count * type.size);
+        EntityDeltaReader deltas(reader);
+        for (size_t k = 0; k < count; ++k) {
+            // Компонент без сущности в снапшоте Apply не сможет применить
+            if (!deltas.Read(changed_entities[k]) || !Contains(out.entities, changed_entities[k]))
+                return false;
+            type.read(reader, changed_values.data() + k * type.size);
+        }
+        if (!ReadEntityList(reader, removed))
+            return false;
+
+        pool.entities.clear();
+        pool.values.clear();
+        pool.entities.reserve(old_pool.entities.size() + count);
+        pool.values.reserve((old_pool.entities.size() + count) * type.size);
+
+        const auto push = [&](entt::entity entity, const std::byte* value) {
+            pool.entities.push_back(entity);
+            pool.values.insert(pool.values.end(), value, value + type.size);
+        };
+        MergeWalk(
+            old_pool.entities, changed_entities,
+            [&](size_t i) {
+                const entt::entity entity = old_pool.entities[i];
+                if (!Contains(removed, entity) && !Contains(removed_entities, entity)) {
+                    push(entity, old_pool.values.data() + i * type.size);
+                }
+            },
+            [&](size_t j) { push(changed_entities[j], changed_values.data() + j * type.size); },
+            [&](size_t, size_t j) { push(changed_entities[j], changed_values.data() + j * type.size); });
+    }
+
+    return !reader.IsOverflowed();
+}
+
+void SnapshotCodec::Apply(entt::registry& reg, const Snapshot& snapshot, const Snapshot* applied) const {
+    TRYENGINE_PROFILE_ZONE("SnapshotCodec::Apply");
+
+    const Snapshot& previous = applied ? *applied : kEmptySnapshot;
+    const auto& types = registry_.GetReplicatedComponents();
+
+    // Сначала все удаления: сервер мог уничтожить сущность и получить тот же индекс со следующей версией.
+    // Пока у клиента жива прежняя версия, create(hint) подсказку проигнорирует
+    for (size_t t = 0; t < types.size(); ++t) {
+        const ReplicatedComponent& type = types[t];
+        const SnapshotPool& old_pool = PoolAt(previous, t);
+        MergeWalk(
+            old_pool.entities, PoolAt(snapshot, t).entities,
+            [&](size_t i) {
+                if (reg.valid(old_pool.entities[i])) {
+                    type.remove(reg, old_pool.entities[i]);
+                }
+            },
+            [](size_t) {}, [](size_t, size_t) {});
+    }
+
+    MergeWalk(
+        previous.entities, snapshot.entities,
+        [&](size_t i) {
+            if (reg.valid(previous.entities[i])) {
+                reg.destroy(previous.entities[i]);
+            }
+        },
+        [&](size_t j) {
+            const entt::entity entity = snapshot.entities[j];
+            if (!reg.valid(entity)) {
+                [[maybe_unused]] const entt::entity created = reg.create(entity);
+                assert(created == entity && "Replicated entity id is taken by a local entity");
+            }
+        },
+        [](size_t, size_t) {});
+
+    for (size_t t = 0; t < types.size(); ++t) {
+        const ReplicatedComponent& type = types[t];
+        const SnapshotPool& old_pool = PoolAt(previous, t);
+        const SnapshotPool& pool = PoolAt(snapshot, t);
+
+        MergeWalk(
+            old_pool.entities, pool.entities, [](size_t) {},
+            [&](size_t j) { type.assign(reg, pool.entities[j], pool.values.data() + j * type.size); },
+            [&](size_t i, size_t j) {
+                if (std::memcmp(old_pool.values.data() + i * type.size, pool.values.data() + j * type.size,
+                                type.size) != 0) {
+                    type.assign(reg, pool.entities[j], pool.values.data() + j * type.size);
+                }
+            });
+    }
+}
+
+}  // namespace tryengine::core
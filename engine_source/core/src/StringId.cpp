@@ -0,0 +1,142 @@
+#include "engine/core/StringId.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+
+namespace tryengine::core {
+
+namespace {
+
+constexpr size_t kBlockSize = 64 * 1024;
+constexpr size_t kMinSlots = 1024;
+
+std::string_view EntryText(const char* entry) {
+    uint32_t length = 0;
+    std::memcpy(&length, entry, sizeof(length));
+    return {entry + sizeof(length), length};
+}
+
+}  // namespace
+
+StringId::StringId(std::string_view str) : id_(StringTable::Get().Intern(str)) {}
+
+std::string_view StringId::View() const {
+    return StringTable::Get().Find(id_);
+}
+
+const char* StringId::CStr() const {
+    // Текст в арене завершен нулем
+    const auto text = View();
+    return text.empty() ? "" : text.data();
+}
+
+StringTable& StringTable::Get() {
+    static StringTable table;
+    return table;
+}
+
+uint64_t StringTable::Intern(std::string_view str) {
+    const uint64_t id = HashString(str);
+    if (id == 0)
+        return 0;
+
+    {
+        std::shared_lock lock(mutex_);
+        if (const Slot* slot = FindSlot(id)) {
+            if (EntryText(slot->entry) != str) {
+                std::cerr << "[StringTable] Hash collision: \"" << str << "\" and \"" << EntryText(slot->entry)
+                          << "\"" << std::endl;
+            }
+            return id;
+        }
+    }
+
+    std::unique_lock lock(mutex_);
+    // Другой поток мог успеть вставить ту же строку
+    if (FindSlot(id))
+        return id;
+
+    // Заполненность не выше половины — цепочки проб короткие
+    if ((count_ + 1) * 2 > slots_.size()) {
+        Grow();
+    }
+
+    const size_t mask = slots_.size() - 1;
+    size_t index = static_cast<size_t>(id) & mask;
+    while (slots_[index].entry) {
+        index = (index + 1) & mask;
+    }
+    slots_[index] = {id, Store(str)};
+    ++count_;
+    return id;
+}
+
+std::string_view StringTable::Find(uint64_t id) const {
+    if (id == 0)
+        return {};
+
+    std::shared_lock lock(mutex_);
+    const Slot* slot = FindSlot(id);
+    return slot ? EntryText(slot->entry) : std::string_view();
+}
+
+StringTable::Stats StringTable::GetStats() const {
+    std::shared_lock lock(mutex_);
+    return {count_, arena_bytes_, slots_.size() * sizeof(Slot)};
+}
+
+const StringTable::Slot* StringTable::FindSlot(uint64_t id) const {
+    if (slots_.empty())
+        return nullptr;
+
+    const size_t mask = slots_.size() - 1;
+    for (size_t index = static_cast<size_t>(id) & mask; slots_[index].entry; index = (index + 1) & mask) {
+        if (slots_[index].id == id)
+            return &slots_[index];
+    }
+    return nullptr;
+}
+
+const char* StringTable::Store(std::string_view str) {
+    const auto length = static_cast<uint32_t>(str.size());
+    const size_t size = sizeof(length) + str.size() + 1;
+
+    char* entry = nullptr;
+    if (size > kBlockSize / 4) {
+        // Длинная строка получает свой блок, текущий продолжает заполняться
+        entry = blocks_.emplace_back(std::make_unique<char[]>(size)).get();
+        arena_bytes_ += size;
+    } else {
+        if (!block_ || block_used_ + size > kBlockSize) {
+            block_ = blocks_.emplace_back(std::make_unique<char[]>(kBlockSize)).get();
+            block_used_ = 0;
+            arena_bytes_ += kBlockSize;
+        }
+        entry = block_ + block_used_;
+        block_used_ += size;
+    }
+
+    std::memcpy(entry, &length, sizeof(length));
+    std::memcpy(entry + sizeof(length), str.data(), str.size());
+    entry[size - 1] = '\0';
+    return entry;
+}
+
+void StringTable::Grow() {
+    std::vector<Slot> slots(std::max(kMinSlots, slots_.size() * 2));
+    const size_t mask = slots.size() - 1;
+    for (const Slot& slot : slots_) {
+        if (!slot.entry)
+            continue;
+        size_t index = static_cast<size_t>(slot.id) & mask;
+        while (slots[index].entry) {
+            index = (index + 1) & mask;
+        }
+        slots[index] = slot;
+    }
+    slots_ = std::move(slots);
+}
+
+}  // namespace tryengine::core
@@ -0,0 +1,180 @@
+#include "engine/core/SystemScheduler.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <sstream>
+
+#include "engine/core/JobSystem.hpp"
+#include "engine/core/Profiler.hpp"
+
+namespace tryengine::core {
+
+namespace {
+
+template <typename Entries>
+bool Intersects(const Entries& a, const Entries& b) {
+    return std::any_of(a.begin(), a.end(), [&](const auto& x) {
+        return std::any_of(b.begin(), b.end(), [&](const auto& y) { return x.id == y.id; });
+    });
+}
+
+template <typename Entries>
+void WriteNames(std::ostringstream& os, const char* label, const Entries& entries) {
+    if (entries.empty())
+        return;
+
+    os << "\\n" << label << ":";
+    for (const auto& entry : entries) {
+        // type_name дает полное имя с неймспейсами — для графа хватит последней части
+        const auto pos = entry.name.rfind("::");
+        os << ' ' << (pos == std::string_view::npos ? entry.name : entry.name.substr(pos + 2));
+    }
+}
+
+}  // namespace
+
+bool SystemAccess::ConflictsWith(const SystemAccess& other) const {
+    return Intersects(writes_, other.writes_) || Intersects(writes_, other.reads_) || Intersects(reads_, other.writes_);
+}
+
+SystemScheduler::SystemScheduler(JobSystem& jobs) : jobs_(jobs) {}
+
+SystemScheduler::~SystemScheduler() = default;
+
+void SystemScheduler::Add(std::string name, SystemAccess access, SystemFn fn) {
+    auto node = std::make_unique<Node>();
+    node->name = std::move(name);
+    node->access = std::move(access);
+    node->fn = std::move(fn);
+    node->zone = Profiler::Get().RegisterZone(HashZoneName(node->name), node->name);
+    nodes_.push_back(std::move(node));
+    dirty_ = true;
+}
+
+void SystemScheduler::Build() {
+    const auto count = static_cast<uint32_t>(nodes_.size());
+
+    // reachable[i][j] — j уже достижима из i; лишние транзитивные ребра не добавляем
+    std::vector<std::vector<bool>> reachable(count, std::vector<bool>(count, false));
+
+    for (auto& node : nodes_) {
+        node->successors.clear();
+        node->predecessor_count = 0;
+    }
+
+    for (uint32_t i = 0; i < count; ++i) {
+        // Идем от ближайших предшественников, чтобы транзитивные ребра отсеялись
+        for (uint32_t j = i; j-- > 0;) {
+            if (reachable[j][i] || !nodes_[j]->access.ConflictsWith(nodes_[i]->access))
+                continue;
+
+            nodes_[j]->successors.push_back(i);
+            ++nodes_[i]->predecessor_count;
+
+            for (uint32_t k = 0; k <= j; ++k) {
+                if (k == j || reachable[k][j]) {
+                    reachable[k][i] = true;
+                }
+            }
+        }
+    }
+
+    roots_.clear();
+    for (uint32_t i = 0; i < count; ++i) {
+        if (nodes_[i]->predecessor_count == 0) {
+            roots_.push_back(i);
+        }
+    }
+
+    dirty_ = false;
+}
+
+void SystemScheduler::Run(entt::registry& reg, float dt) {
+    if (dirty_) {
+        Build();
+    }
+
+    for (const auto& node : nodes_) {
+        for (const auto& prepare : node->access.prepare_) {
+            prepare(reg);
+        }
+        node->remaining.store(node->predecessor_count, std::memory_order_relaxed);
+    }
+
+    JobCounter frame;
+    for (const uint32_t root : roots_) {
+        Launch(root, reg, dt, frame);
+    }
+    jobs_.Wait(frame);
+}
+
+void SystemScheduler::Launch(uint32_t index, entt::registry& reg, float dt, JobCounter& frame) {
+    auto job = [this, index, &reg, dt, &frame] {
+        Node& node = *nodes_[index];
+
+        const auto start = std::chrono::steady_clock::now();
+        {
+            TRYENGINE_PROFILE_ZONE_ID(node.zone);
+            node.fn(reg, dt);
+        }
+        const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+        node.last_ms = elapsed.count();
+        node.average_ms = node.average_ms == 0.0 ? node.last_ms : node.average_ms * 0.95 + node.last_ms * 0.05;
+
+        // Последний завершившийся предшественник запускает преемника. Преемник встает в frame
+        // раньше, чем текущая задача из него выйдет, поэтому Wait(frame) не вернется раньше времени.
+        for (const uint32_t successor : node.successors) {
+            if (nodes_[successor]->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                Launch(successor, reg, dt, frame);
+            }
+        }
+    };
+
+    if (nodes_[index]->access.main_thread_) {
+        jobs_.RunOnMainThread(std::move(job), &frame);
+    } else {
+        jobs_.Run(std::move(job), &frame);
+    }
+}
+
+std::string SystemScheduler::DumpGraph() {
+    if (dirty_) {
+        Build();
+    }
+
+    std::ostringstream os;
+    os << "digraph Frame {\n";
+    os << "    node [shape=box];\n";
+
+    for (size_t i = 0; i < nodes_.size(); ++i) {
+        const Node& node = *nodes_[i];
+        os << "    s" << i << " [label=\"" << node.name;
+        if (node.access.main_thread_) {
+            os << " (main)";
+        }
+        WriteNames(os, "R", node.access.reads_);
+        WriteNames(os, "W", node.access.writes_);
+        os << "\\n" << node.average_ms << " ms\"];\n";
+    }
+
+    for (size_t i = 0; i < nodes_.size(); ++i) {
+        for (const uint32_t successor : nodes_[i]->successors) {
+            os << "    s" << i << " -> s" << successor << ";\n";
+        }
+    }
+
+    os << "}\n";
+    return os.str();
+}
+
+std::vector<SystemScheduler::SystemStats> SystemScheduler::GetStats() const {
+    std::vector<SystemStats> stats;
+    stats.reserve(nodes_.size());
+    for (const auto& node : nodes_) {
+        stats.push_back({node->name, node->last_ms, node->average_ms});
+    }
+    return stats;
+}
+
+}  // namespace tryengine::core
@@ -0,0 +1,145 @@
+#include "engine/core/TransformHierarchy.hpp"
+
+#include <algorithm>
+
+#include "engine/core/Components.hpp"
+#include "engine/core/SceneGraph.hpp"
+
+namespace tryengine::core {
+
+bool TransformHierarchy::RebuildIfDirty(const entt::registry& reg, const SceneGraph& graph) {
+    if (!dirty_)
+        return false;
+
+    Rebuild(reg, graph);
+    dirty_ = false;
+    return true;
+}
+
+uint32_t TransformHierarchy::IndexOf(entt::entity entity) const {
+    const auto slot = static_cast<size_t>(entt::to_entity(entity));
+    if (slot >= index_of_.size())
+        return kNoParent;
+
+    const uint32_t index = index_of_[slot];
+    // Слот мог достаться новой сущности с другой версией
+    return index != kNoParent && entities_[index] == entity ? index : kNoParent;
+}
+
+void TransformHierarchy::ResetDirtyFlags(bool value) {
+    std::fill(dirty_flags_.begin(), dirty_flags_.end(), static_cast<uint8_t>(value));
+}
+
+void TransformHierarchy::Rebuild(const entt::registry& reg, const SceneGraph& graph) {
+    entities_.clear();
+    parent_indices_.clear();
+    level_offsets_.clear();
+
+    const auto* transforms = reg.storage<Transform>();
+
+    level_offsets_.push_back(0);
+    if (!transforms) {
+        level_offsets_.push_back(0);
+        BuildIndex();
+        return;
+    }
+
+    // Уровень 0: сущности без родителя (или с родителем без Transform — для них считаем от identity)
+    for (const auto [entity, transform] : transforms->each()) {
+        const entt::entity parent = graph.GetParent(entity);
+        if (parent == entt::null || !transforms->contains(parent)) {
+            entities_.push_back(entity);
+            parent_indices_.push_back(kNoParent);
+        }
+    }
+
+    // BFS по непрерывным массивам детей SceneGraph: каждый следующий уровень — дети предыдущего
+    size_t level_begin = 0;
+    size_t level_end = entities_.size();
+    while (level_begin != level_end) {
+        level_offsets_.push_back(level_end);
+
+        for (size_t i = level_begin; i < level_end; ++i) {
+            for (const auto child : graph.GetChildren(entities_[i])) {
+                if (transforms->contains(child)) {
+                    entities_.push_back(child);
+                    parent_indices_.push_back(static_cast<uint32_t>(i));
+                }
+            }
+        }
+
+        level_begin = level_end;
+        level_end = entities_.size();
+    }
+
+    BuildIndex();
+}
+
+void TransformHierarchy::BuildIndex() {
+    index_of_.clear();
+    for (size_t i = 0; i < entities_.size(); ++i) {
+        const auto slot = static_cast<size_t>(entt::to_entity(entities_[i]));
+        if (slot >= index_of_.size()) {
+            index_of_.resize(slot + 1, kNoParent);
+        }
+        index_of_[slot] = static_cast<uint32_t>(i);
+    }
+
+    dirty_flags_.assign(entities_.size(), 0);
+}
+
+namespace {
+
+void EmplaceWorldMatrix(entt::registry& reg, entt::entity entity) {
+    reg.emplace_or_replace<WorldMatrix>(entity);
+}
+
+void RemoveWorldMatrix(entt::registry& reg, entt::entity entity) {
+    reg.remove<WorldMatrix>(entity);
+}
+
+}  // namespace
+
+TransformHierarchy& AcquireTransformHierarchy(entt::registry& reg) {
+    if (auto* hierarchy = reg.ctx().find<TransformHierarchy>()) {
+        return *hierarchy;
+    }
+
+    auto& hierarchy = reg.ctx().emplace<TransformHierarchy>();
+
+    // Пул создаем заранее: иначе он появится посреди обхода reg.storage() (например, при клонировании)
+    reg.storage<TransformDirty>();
+    reg.storage<WorldMatrix>();
+    reg.on_construct<Transform>().connect<&MarkTransformDirty>();
+    reg.on_update<Transform>().connect<&MarkTransformDirty>();
+    reg.on_construct<Transform>().connect<&EmplaceWorldMatrix>();
+    reg.on_destroy<Transform>().connect<&RemoveWorldMatrix>();
+
+    // Сущности, созданные до подписки (например, загруженные из сцены), получают матрицу здесь
+    std::vector<entt::entity> missing;
+    for (const auto entity : reg.view<Transform>(entt::exclude<WorldMatrix>)) {
+        missing.push_back(entity);
+    }
+    reg.insert<WorldMatrix>(missing.begin(), missing.end());
+
+    reg.on_construct<Transform>().connect<&MarkHierarchyDirty>();
+    reg.on_destroy<Transform>().connect<&MarkHierarchyDirty>();
+    reg.on_construct<Relationship>().connect<&MarkHierarchyDirty>();
+    reg.on_update<Relationship>().connect<&MarkHierarchyDirty>();
+    reg.on_destroy<Relationship>().connect<&MarkHierarchyDirty>();
+
+    hierarchy.MarkDirty();
+    return hierarchy;
+}
+
+void MarkTransformDirty(entt::registry& reg, entt::entity entity) {
+    reg.emplace_or_replace<TransformDirty>(entity);
+}
+
+void MarkHierarchyDirty(entt::registry& reg, entt::entity) {
+    if (auto* hierarchy = reg.ctx().find<TransformHierarchy>()) {
+        hierarchy->MarkDirty();
+    }
+}
+
+}  // namespace tryengine::core
@@ -0,0 +1,230 @@
+#include "engine/core/TransformMath.hpp"
+
+#include <algorithm>
+
+#include "engine/core/Components.hpp"
+
+#if defined(__AVX2__) && (defined(__FMA__) || defined(_MSC_VER))
+#define TRYENGINE_TRANSFORM_AVX2 1
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TRYENGINE_TRANSFORM_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace tryengine::core {
+
+namespace {
+
+#if defined(TRYENGINE_TRANSFORM_AVX2)
+constexpr size_t kLanes = 8;
+using Lane = __m256;
+
+inline Lane Load(const float* p) { return _mm256_load_ps(p); }
+inline void Store(float* p, Lane v) { _mm256_store_ps(p, v); }
+inline Lane Set1(float v) { return _mm256_set1_ps(v); }
+inline Lane Add(Lane a, Lane b) { return _mm256_add_ps(a, b); }
+inline Lane Sub(Lane a, Lane b) { return _mm256_sub_ps(a, b); }
+inline Lane Mul(Lane a, Lane b) { return _mm256_mul_ps(a, b); }
+#elif defined(TRYENGINE_TRANSFORM_SSE2)
+constexpr size_t kLanes = 4;
+using Lane = __m128;
+
+inline Lane Load(const float* p) { return _mm_load_ps(p); }
+inline void Store(float* p, Lane v) { _mm_store_ps(p, v); }
+inline Lane Set1(float v) { return _mm_set1_ps(v); }
+inline Lane Add(Lane a, Lane b) { return _mm_add_ps(a, b); }
+inline Lane Sub(Lane a, Lane b) { return _mm_sub_ps(a, b); }
+inline Lane Mul(Lane a, Lane b) { return _mm_mul_ps(a, b); }
+#else
+// Скалярная версия с тем же интерфейсом — компилятор волен ее векторизовать сам
+constexpr size_t kLanes = 4;
+struct Lane {
+    float v[kLanes];
+};
+
+inline Lane Load(const float* p) {
+    Lane r;
+    std::copy_n(p, kLanes, r.v);
+    return r;
+}
+inline void Store(float* p, const Lane& a) { std::copy_n(a.v, kLanes, p); }
+inline Lane Set1(float x) {
+    Lane r;
+    std::fill_n(r.v, kLanes, x);
+    return r;
+}
+template <class Op>
+inline Lane Apply(const Lane& a, const Lane& b, Op op) {
+    Lane r;
+    for (size_t i = 0; i < kLanes; ++i) {
+        r.v[i] = op(a.v[i], b.v[i]);
+    }
+    return r;
+}
+inline Lane Add(const Lane& a, const Lane& b) { return Apply(a, b, [](float x, float y) { return x + y; }); }
+inline Lane Sub(const Lane& a, const Lane& b) { return Apply(a, b, [](float x, float y) { return x - y; }); }
+inline Lane Mul(const Lane& a, const Lane& b) { return Apply(a, b, [](float x, float y) { return x * y; }); }
+#endif
+
+// Входы пачки в SoA: qx, qy, qz, qw, sx, sy, sz
+struct TrsLanes {
+    alignas(32) float v[7][kLanes];
+};
+
+// Столбцы R * S (3x3) в SoA: [столбец * 3 + строка][дорожка]
+struct RotationScaleLanes {
+    alignas(32) float v[9][kLanes];
+};
+
+void GatherTrs(const Transform* const* transforms, size_t count, TrsLanes& in) {
+    for (size_t lane = 0; lane < kLanes; ++lane) {
+        if (lane < count) {
+            const Transform& t = *transforms[lane];
+            in.v[0][lane] = t.rotation.x;
+            in.v[1][lane] = t.rotation.y;
+            in.v[2][lane] = t.rotation.z;
+            in.v[3][lane] = t.rotation.w;
+            in.v[4][lane] = t.scale.x;
+            in.v[5][lane] = t.scale.y;
+            in.v[6][lane] = t.scale.z;
+        } else {
+            // Хвост пачки заполняем единичным трансформом, результат просто не используется
+            in.v[0][lane] = in.v[1][lane] = in.v[2][lane] = 0.0f;
+            in.v[3][lane] = 1.0f;
+            in.v[4][lane] = in.v[5][lane] = in.v[6][lane] = 1.0f;
+        }
+    }
+}
+
+// То же, что glm::mat3_cast(q) с масштабом по столбцам, но для kLanes кватернионов сразу
+void ComputeRotationScale(const TrsLanes& in, RotationScaleLanes& out) {
+    const Lane x = Load(in.v[0]);
+    const Lane y = Load(in.v[1]);
+    const Lane z = Load(in.v[2]);
+    const Lane w = Load(in.v[3]);
+    const Lane sx = Load(in.v[4]);
+    const Lane sy = Load(in.v[5]);
+    const Lane sz = Load(in.v[6]);
+
+    const Lane one = Set1(1.0f);
+    const Lane two = Set1(2.0f);
+
+    const Lane xx = Mul(x, x);
+    const Lane yy = Mul(y, y);
+    const Lane zz = Mul(z, z);
+    const Lane xy = Mul(x, y);
+    const Lane xz = Mul(x, z);
+    const Lane yz = Mul(y, z);
+    const Lane wx = Mul(w, x);
+    const Lane wy = Mul(w, y);
+    const Lane wz = Mul(w, z);
+
+    Store(out.v[0], Mul(Sub(one, Mul(two, Add(yy, zz))), sx));
+    Store(out.v[1], Mul(Mul(two, Add(xy, wz)), sx));
+    Store(out.v[2], Mul(Mul(two, Sub(xz, wy)), sx));
+
+    Store(out.v[3], Mul(Mul(two, Sub(xy, wz)), sy));
+    Store(out.v[4], Mul(Sub(one, Mul(two, Add(xx, zz))), sy));
+    Store(out.v[5], Mul(Mul(two, Add(yz, wx)), sy));
+
+    Store(out.v[6], Mul(Mul(two, Add(xz, wy)), sz));
+    Store(out.v[7], Mul(Mul(two, Sub(yz, wx)), sz));
+    Store(out.v[8], Mul(Sub(one, Mul(two, Add(xx, yy))), sz));
+}
+
+void StoreLocal(const float* rs, const glm::vec3& p, glm::mat4& out) {
+    out[0] = glm::vec4(rs[0], rs[1], rs[2], 0.0f);
+    out[1] = glm::vec4(rs[3], rs[4], rs[5], 0.0f);
+    out[2] = glm::vec4(rs[6], rs[7], rs[8], 0.0f);
+    out[3] = glm::vec4(p, 1.0f);
+}
+
+// out = parent * local. У local нижняя строка (0, 0, 0, 1), поэтому на столбец нужно 3 умножения, а не 4
+void StoreWithParent(const glm::mat4& parent, const float* rs, const glm::vec3& p, glm::mat4& out) {
+#if defined(TRYENGINE_TRANSFORM_AVX2)
+    // Два столбца результата за одну операцию: в нижней половине регистра столбец j, в верхней j + 1
+    const __m256 p0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(&parent[0][0]));
+    const __m256 p1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(&parent[1][0]));
+    const __m256 p2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(&parent[2][0]));
+    const __m128 p3 = _mm_loadu_ps(&parent[3][0]);
+
+    const auto pair = [](float lo, float hi) { return _mm256_set_m128(_mm_set1_ps(hi), _mm_set1_ps(lo)); };
+
+    __m256 c01 = _mm256_mul_ps(p0, pair(rs[0], rs[3]));
+    c01 = _mm256_fmadd_ps(p1, pair(rs[1], rs[4]), c01);
+    c01 = _mm256_fmadd_ps(p2, pair(rs[2], rs[5]), c01);
+
+    __m256 c23 = _mm256_insertf128_ps(_mm256_setzero_ps(), p3, 1);
+    c23 = _mm256_fmadd_ps(p0, pair(rs[6], p.x), c23);
+    c23 = _mm256_fmadd_ps(p1, pair(rs[7], p.y), c23);
+    c23 = _mm256_fmadd_ps(p2, pair(rs[8], p.z), c23);
+
+    _mm256_storeu_ps(&out[0][0], c01);
+    _mm256_storeu_ps(&out[2][0], c23);
+#elif defined(TRYENGINE_TRANSFORM_SSE2)
+    const __m128 p0 = _mm_loadu_ps(&parent[0][0]);
+    const __m128 p1 = _mm_loadu_ps(&parent[1][0]);
+    const __m128 p2 = _mm_loadu_ps(&parent[2][0]);
+    const __m128 p3 = _mm_loadu_ps(&parent[3][0]);
+
+    const auto column = [&](float a, float b, float c) {
+        return _mm_add_ps(_mm_add_ps(_mm_mul_ps(p0, _mm_set1_ps(a)), _mm_mul_ps(p1, _mm_set1_ps(b))),
+                          _mm_mul_ps(p2, _mm_set1_ps(c)));
+    };
+
+    _mm_storeu_ps(&out[0][0], column(rs[0], rs[1], rs[2]));
+    _mm_storeu_ps(&out[1][0], column(rs[3], rs[4], rs[5]));
+    _mm_storeu_ps(&out[2][0], column(rs[6], rs[7], rs[8]));
+    _mm_storeu_ps(&out[3][0], _mm_add_ps(column(p.x, p.y, p.z), p3));
+#else
+    const glm::vec4 p0 = parent[0];
+    const glm::vec4 p1 = parent[1];
+    const glm::vec4 p2 = parent[2];
+    const glm::vec4 p3 = parent[3];
+
+    out[0] = p0 * rs[0] + p1 * rs[1] + p2 * rs[2];
+    out[1] = p0 * rs[3] + p1 * rs[4] + p2 * rs[5];
+    out[2] = p0 * rs[6] + p1 * rs[7] + p2 * rs[8];
+    out[3] = p0 * p.x + p1 * p.y + p2 * p.z + p3;
+#endif
+}
+
+}  // namespace
+
+void ComposeWorldMatrices(size_t count, const Transform* const* transforms, const glm::mat4* const* parents,
+                          glm::mat4* const* out) {
+    TrsLanes in;
+    RotationScaleLanes rs;
+
+    for (size_t base = 0; base < count; base += kLanes) {
+        const size_t lanes = std::min(kLanes, count - base);
+
+        GatherTrs(transforms + base, lanes, in);
+        ComputeRotationScale(in, rs);
+
+        for (size_t lane = 0; lane < lanes; ++lane) {
+            const size_t i = base + lane;
+            const float local[9] = {rs.v[0][lane], rs.v[1][lane], rs.v[2][lane], rs.v[3][lane], rs.v[4][lane],
+                                    rs.v[5][lane], rs.v[6][lane], rs.v[7][lane], rs.v[8][lane]};
+
+            if (parents[i]) {
+                StoreWithParent(*parents[i], local, transforms[i]->position, *out[i]);
+            } else {
+                StoreLocal(local, transforms[i]->position, *out[i]);
+            }
+        }
+    }
+}
+
+const char* GetTransformKernelName() {
+#if defined(TRYENGINE_TRANSFORM_AVX2)
+    return "AVX2";
+#elif defined(TRYENGINE_TRANSFORM_SSE2)
+    return "SSE2";
+#else
+    return "Scalar";
+#endif
+}
+
+}  // namespace tryengine::core
@@ -0,0 +1,420 @@
+#include "engine/core/WorldPartition.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+
+#include "engine/core/ComponentRegistry.hpp"
+#include "engine/core/Components.hpp"
+#include "engine/core/Profiler.hpp"
+#include "engine/core/ResourceManager.hpp"
+#include "engine/core/SceneFormat.hpp"
+#include "engine/core/SceneManager.hpp"
+
+namespace tryengine::core {
+
+namespace {
+
+// Имя файла ячейки не длиннее — иначе манифест считается битым
+constexpr uint32_t kMaxFileName = 4096;
+
+template <typename T>
+void WritePod(std::ostream& os, const T& value) {
+    os.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+bool ReadPod(std::istream& is, T& value) {
+    return static_cast<bool>(is.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+// FNV-1a, 64 бита: id сцены ячейки в AssetDatabase по ее пути
+uint64_t HashPath(const std::string& path) {
+    uint64_t hash = 14695981039346656037ull;
+    for (const char c : path) {
+        hash ^= static_cast<uint8_t>(c);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+int32_t CellCoord(float value, float cell_size) { return static_cast<int32_t>(std::floor(value / cell_size)); }
+
+bool WriteManifest(const std::filesystem::path& path, const WorldPartitionManifest& manifest) {
+    std::ofstream os(path, std::ios::binary | std::ios::trunc);
+    if (!os.is_open()) {
+        std::cerr << "[WorldPartition] Failed to open " << path << std::endl;
+        return false;
+    }
+
+    os.write("TWPM", 4);
+    WritePod(os, kWorldPartitionVersion);
+    WritePod(os, manifest.cell_size);
+    WritePod(os, static_cast<uint32_t>(manifest.cells.size()));
+    for (const WorldCell& cell : manifest.cells) {
+        WritePod(os, cell.x);
+        WritePod(os, cell.z);
+        WritePod(os, static_cast<uint32_t>(cell.persistent ? 1 : 0));
+        WritePod(os, static_cast<uint32_t>(cell.file.size()));
+        WritePod(os, cell.bytes);
+        WritePod(os, cell.entity_count);
+        os.write(cell.file.data(), static_cast<std::streamsize>(cell.file.size()));
+    }
+    return static_cast<bool>(os);
+}
+
+}  // namespace
+
+bool CookWorldPartition(const entt::registry& level, const ComponentRegistry& components, const float cell_size,
+                        const std::filesystem::path& directory) {
+    TRYENGINE_PROFILE_ZONE("CookWorldPartition");
+
+    if (!(cell_size > 0.0f)) {
+        std::cerr << "[WorldPartition] Cell size must be positive" << std::endl;
+        return false;
+    }
+
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    if (error) {
+        std::cerr << "[WorldPartition] Failed to create " << directory << ": " << error.message() << std::endl;
+        return false;
+    }
+
+    std::vector<entt::entity> alive;
+    if (const auto* storage = level.storage<entt::entity>()) {
+        alive.assign(storage->data(), storage->data() + storage->free_list());
+    }
+    const auto* relationships = level.storage<Relationship>();
+    const auto* transforms = level.storage<Transform>();
+
+    // По (x, z): порядок ячеек в манифесте не зависит от порядка сущностей
+    std::map<std::pair<int32_t, int32_t>, std::vector<entt::entity>> cells;
+    std::vector<entt::entity> persistent;
+    size_t max_index = 0;
+    for (const auto entity : alive) {
+        if (level.orphan(entity))
+            continue;
+        max_index = std::max(max_index, static_cast<size_t>(entt::to_entity(entity)));
+
+        // Шагов не больше числа сущностей — на случай цикла в битой иерархии
+        entt::entity root = entity;
+        for (size_t steps = 0; relationships && relationships->contains(root) && steps < alive.size(); ++steps) {
+            const entt::entity parent = relationships->get(root).parent;
+            if (parent == entt::null || !level.valid(parent))
+                break;
+            root = parent;
+        }
+
+        if (transforms && transforms->contains(root)) {
+            const glm::vec3& position = transforms->get(root).position;
+            cells[{CellCoord(position.x, cell_size), CellCoord(position.z, cell_size)}].push_back(entity);
+        } else {
+            persistent.push_back(entity);
+        }
+    }
+
+    WorldPartitionManifest manifest;
+    manifest.cell_size = cell_size;
+
+    // Ячейка — отдельный реестр: сущности получают идентификаторы подряд, ссылки наружу ячейки — null
+    EntityRemap remap;
+    remap.table.assign(max_index + 1, entt::null);
+    const auto cook = [&](WorldCell cell, const std::vector<entt::entity>& entities) {
+        entt::registry out;
+        std::vector<entt::entity> created(entities.size());
+        out.create(created.begin(), created.end());
+        for (size_t i = 0; i < entities.size(); ++i) {
+            remap.table[entt::to_entity(entities[i])] = created[i];
+        }
+        for (const auto& component : components.GetCookedComponents()) {
+            component.merge(level, out, entities, remap);
+        }
+        for (const auto entity : entities) {
+            remap.table[entt::to_entity(entity)] = entt::null;
+        }
+
+        const auto path = directory / cell.file;
+        if (!WriteCookedScene(path, out, components))
+            return false;
+
+        cell.bytes = std::filesystem::file_size(path, error);
+        cell.entity_count = entities.size();
+        manifest.cells.push_back(std::move(cell));
+        return true;
+    };
+
+    if (!persistent.empty() && !cook({0, 0, true, 0, 0, "persistent.scene"}, persistent))
+        return false;
+    for (const auto& [coord, entities] : cells) {
+        const auto [x, z] = coord;
+        const std::string file = "cell_" + std::to_string(x) + "_" + std::to_string(z) + ".scene";
+        if (!cook({x, z, false, 0, 0, file}, entities))
+            return false;
+    }
+
+    return WriteManifest(directory / kWorldPartitionManifest, manifest);
+}
+
+bool ReadWorldPartition(const std::filesystem::path& manifest_path, WorldPartitionManifest& manifest) {
+    std::ifstream is(manifest_path, std::ios::binary);
+    if (!is.is_open()) {
+        std::cerr << "[WorldPartition] Failed to open " << manifest_path << std::endl;
+        return false;
+    }
+
+    char magic[4] = {};
+    uint32_t version = 0;
+    uint32_t count = 0;
+    if (!is.read(magic, sizeof(magic)) || std::memcmp(magic, "TWPM", 4) != 0 || !ReadPod(is, version) ||
+        !ReadPod(is, manifest.cell_size) || !ReadPod(is, count)) {
+        std::cerr << "[WorldPartition] Not a world partition manifest: " << manifest_path << std::endl;
+        return false;
+    }
+    if (version != kWorldPartitionVersion || !(manifest.cell_size > 0.0f)) {
+        std::cerr << "[WorldPartition] Manifest version " << version << ", expected " << kWorldPartitionVersion
+                  << ": re-cook the level" << std::endl;
+        return false;
+    }
+
+    manifest.cells.clear();
+    for (uint32_t i = 0; i < count; ++i) {
+        WorldCell cell;
+        uint32_t flags = 0;
+        uint32_t name_length = 0;
+        if (!ReadPod(is, cell.x) || !ReadPod(is, cell.z) || !ReadPod(is, flags) || !ReadPod(is, name_length) ||
+            !ReadPod(is, cell.bytes) || !ReadPod(is, cell.entity_count) || name_length > kMaxFileName) {
+            std::cerr << "[WorldPartition] Corrupted manifest: " << manifest_path << std::endl;
+            return false;
+        }
+        cell.persistent = (flags & 1u) != 0;
+        cell.file.resize(name_length);
+        if (!is.read(cell.file.data(), name_length)) {
+            std::cerr << "[WorldPartition] Corrupted manifest: " << manifest_path << std::endl;
+            return false;
+        }
+        manifest.cells.push_back(std::move(cell));
+    }
+    return true;
+}
+
+WorldStreamer::WorldStreamer(SceneManager& scenes, ResourceManager& resources, WorldStreamerConfig config)
+    : scenes_(scenes), resources_(resources), config_(config) {
+    config_.unload_radius = std::max(config_.unload_radius, config_.load_radius);
+    config_.max_loads_in_flight = std::max(config_.max_loads_in_flight, 1u);
+}
+
+bool WorldStreamer::Open(const std::filesystem::path& manifest_path) {
+    WorldPartitionManifest manifest;
+    if (!ReadWorldPartition(manifest_path, manifest))
+        return false;
+
+    manifest_ = std::move(manifest);
+    cells_.assign(manifest_.cells.size(), Cell{});
+    grid_.clear();
+    resident_.clear();
+    stats_ = {};
+    purge_pending_ = false;
+    min_x_ = min_z_ = 0;
+    max_x_ = max_z_ = -1;
+
+    const auto directory = manifest_path.parent_path();
+    bool first = true;
+    for (size_t i = 0; i < cells_.size(); ++i) {
+        const WorldCell& cell = manifest_.cells[i];
+        const auto path = (directory / cell.file).lexically_normal();
+        cells_[i].scene_id = HashPath(path.string());
+        resources_.GetAssetDatabase().Register(cells_[i].scene_id, path);
+
+        if (cell.persistent)
+            continue;
+        grid_[Key(cell.x, cell.z)] = i;
+        min_x_ = first ? cell.x : std::min(min_x_, cell.x);
+        max_x_ = first ? cell.x : std::max(max_x_, cell.x);
+        min_z_ = first ? cell.z : std::min(min_z_, cell.z);
+        max_z_ = first ? cell.z : std::max(max_z_, cell.z);
+        first = false;
+    }
+
+    for (size_t i = 0; i < cells_.size(); ++i) {
+        if (manifest_.cells[i].persistent) {
+            Load(i);
+        }
+    }
+    return true;
+}
+
+float WorldStreamer::Distance(const size_t index, const glm::vec3& point) const {
+    const WorldCell& cell = manifest_.cells[index];
+    const float size = manifest_.cell_size;
+    const float min_x = static_cast<float>(cell.x) * size;
+    const float min_z = static_cast<float>(cell.z) * size;
+    const float dx = std::max({min_x - point.x, 0.0f, point.x - (min_x + size)});
+    const float dz = std::max({min_z - point.z, 0.0f, point.z - (min_z + size)});
+    return std::sqrt(dx * dx + dz * dz);
+}
+
+void WorldStreamer::Update() {
+    if (scenes_.HasActiveScene()) {
+        const auto& reg = scenes_.GetActiveScene().GetRegistry();
+        for (const auto entity : reg.view<MainCameraTag, Transform>()) {
+            // Мировая матрица учитывает родителя камеры; она отстает на кадр, для стриминга это неважно
+            const auto* world = reg.try_get<WorldMatrix>(entity);
+            focus_ = world ? glm::vec3(world->value[3]) : reg.get<Transform>(entity).position;
+            break;
+        }
+    }
+    Update(focus_);
+}
+
+void WorldStreamer::Update(const glm::vec3& focus) {
+    TRYENGINE_PROFILE_ZONE("WorldStreamer::Update");
+
+    focus_ = focus;
+    Poll();
+
+    for (size_t i = resident_.size(); i-- > 0;) {
+        const size_t index = resident_[i];
+        if (cells_[index].state == CellState::Loaded && !manifest_.cells[index].persistent &&
+            Distance(index, focus) > config_.unload_radius) {
+            Unload(index);
+        }
+    }
+
+    // Кандидаты — только клетки сетки в квадрате вокруг точки, ближайшие первыми
+    candidates_.clear();
+    if (!cells_.empty() && max_x_ >= min_x_) {
+        const float size = manifest_.cell_size;
+        const float radius = config_.load_radius;
+        const auto clamp_x = [&](float value) {
+            return static_cast<int32_t>(std::clamp(std::floor(value / size), static_cast<float>(min_x_),
+                                                   static_cast<float>(max_x_)));
+        };
+        const auto clamp_z = [&](float value) {
+            return static_cast<int32_t>(std::clamp(std::floor(value / size), static_cast<float>(min_z_),
+                                                   static_cast<float>(max_z_)));
+        };
+        const int32_t x_end = clamp_x(focus.x + radius);
+        const int32_t z_end = clamp_z(focus.z + radius);
+        for (int32_t x = clamp_x(focus.x - radius); x <= x_end; ++x) {
+            for (int32_t z = clamp_z(focus.z - radius); z <= z_end; ++z) {
+                const auto it = grid_.find(Key(x, z));
+                if (it == grid_.end())
+                    continue;
+                const Cell& cell = cells_[it->second];
+                if (cell.state != CellState::Unloaded || cell.failed)
+                    continue;
+                const float distance = Distance(it->second, focus);
+                if (distance <= radius) {
+                    candidates_.emplace_back(distance, it->second);
+                }
+            }
+        }
+        std::sort(candidates_.begin(), candidates_.end());
+    }
+
+    auto in_flight = static_cast<uint32_t>(std::count_if(
+        resident_.begin(), resident_.end(), [&](size_t index) { return cells_[index].state == CellState::Loading; }));
+    for (const auto& [distance, index] : candidates_) {
+        if (in_flight >= config_.max_loads_in_flight)
+            break;
+
+        const uint64_t bytes = manifest_.cells[index].bytes;
+        if (config_.memory_budget > 0 && stats_.resident_bytes + bytes > config_.memory_budget &&
+            !Evict(bytes, distance, focus)) {
+            ++stats_.budget_skips;
+            break;
+        }
+        Load(index);
+        ++in_flight;
+    }
+
+    // Кэш отпускает ресурс, только когда на него никто не ссылается: ждем, пока сущности ячеек удалятся
+    if (purge_pending_ && !scenes_.IsUnloading()) {
+        resources_.UpdatePurge();
+        purge_pending_ = false;
+        ++stats_.purges;
+    }
+
+    stats_.loading = in_flight;
+    stats_.loaded = static_cast<uint32_t>(resident_.size()) - in_flight;
+    stats_.peak_resident_bytes = std::max(stats_.peak_resident_bytes, stats_.resident_bytes);
+}
+
+bool WorldStreamer::IsLoadedAt(const glm::vec3& point) const {
+    if (cells_.empty())
+        return true;
+    const auto it = grid_.find(Key(CellCoord(point.x, manifest_.cell_size), CellCoord(point.z, manifest_.cell_size)));
+    return it == grid_.end() || cells_[it->second].state == CellState::Loaded;
+}
+
+void WorldStreamer::Poll() {
+    for (size_t i = resident_.size(); i-- > 0;) {
+        const size_t index = resident_[i];
+        Cell& cell = cells_[index];
+        if (cell.state != CellState::Loading || !cell.operation->IsDone())
+            continue;
+
+        if (cell.operation->GetState() == SceneLoadOperation::State::Done) {
+            cell.state = CellState::Loaded;
+        } else {
+            std::cerr << "[WorldPartition] Failed to load cell " << manifest_.cells[index].file << std::endl;
+            cell.state = CellState::Unloaded;
+            cell.failed = true;
+            stats_.resident_bytes -= manifest_.cells[index].bytes;
+            resident_.erase(resident_.begin() + static_cast<std::ptrdiff_t>(i));
+        }
+        cell.operation.reset();
+    }
+}
+
+void WorldStreamer::Load(const size_t index) {
+    Cell& cell = cells_[index];
+    cell.operation = scenes_.LoadSceneAsync(cell.scene_id, SceneLoadMode::Additive);
+    cell.state = CellState::Loading;
+    resident_.push_back(index);
+    stats_.resident_bytes += manifest_.cells[index].bytes;
+    stats_.peak_resident_bytes = std::max(stats_.peak_resident_bytes, stats_.resident_bytes);
+    ++stats_.loads;
+}
+
+void WorldStreamer::Unload(const size_t index) {
+    // false — сцену уже сняли в обход стримера, сущностей ячейки в мире нет
+    scenes_.UnloadScene(cells_[index].scene_id);
+    cells_[index].state = CellState::Unloaded;
+    resident_.erase(std::find(resident_.begin(), resident_.end(), index));
+    stats_.resident_bytes -= manifest_.cells[index].bytes;
+    ++stats_.unloads;
+    purge_pending_ = true;
+}
+
+bool WorldStreamer::Evict(const uint64_t needed, const float distance, const glm::vec3& focus) {
+    std::vector<std::pair<float, size_t>> victims;
+    uint64_t freed = 0;
+    for (const size_t index : resident_) {
+        if (cells_[index].state != CellState::Loaded || manifest_.cells[index].persistent)
+            continue;
+        const float victim_distance = Distance(index, focus);
+        if (victim_distance > distance) {
+            victims.emplace_back(victim_distance, index);
+            freed += manifest_.cells[index].bytes;
+        }
+    }
+    // Не влезет и после вытеснения всех дальних — ничего не трогаем
+    if (stats_.resident_bytes - freed + needed > config_.memory_budget)
+        return false;
+    std::sort(victims.begin(), victims.end(), std::greater<>());
+
+    for (const auto& [victim_distance, index] : victims) {
+        if (stats_.resident_bytes + needed <= config_.memory_budget)
+            break;
+        Unload(index);
+    }
+    return true;
+}
+
+}  // namespace tryengine::core
@@ -1,9 +1,20 @@
 #pragma once
 #include <entt/entity/registry.hpp>
+#include <vector>
+
+#include "engine/graphics/RenderCommon.hpp"
 
 namespace tryengine::graphics {
 class RenderSystem;
 
+// Точечные источники кадра в формате GPU. Переменная контекста реестра, заполняется ExtractSceneLights
+struct SceneLights {
+    std::vector<PointLightGPU> lights;
+};
+
 void SubmitSceneFromEnTT(entt::registry& reg, entt::entity camera_entity,
                          tryengine::graphics::RenderSystem& render_system);
+
+// Читает Transform + LightComponent, пишет SceneLights (переменная контекста должна уже существовать)
+void ExtractSceneLights(entt::registry& reg);
 }
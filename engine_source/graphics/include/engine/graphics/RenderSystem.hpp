@@ -2,8 +2,9 @@
 
 #include <SDL3/SDL_gpu.h>
 #include <memory>
-#include <vector>
+#include <span>
 
+#include "engine/core/FrameArena.hpp"
 #include "engine/graphics/PipelineManager.hpp"
 #include "engine/graphics/RenderTarget.hpp"
 #include "engine/graphics/RenderCommon.hpp" // Тут лежат наши новые структуры
@@ -12,12 +13,14 @@ namespace tryengine::graphics {
 
 class RenderSystem {
 public:
-    RenderSystem(SDL_GPUDevice* device);
+    // Очередь команд живет в арене кадра: арена должна пережить RenderSystem
+    RenderSystem(SDL_GPUDevice* device, core::FrameArena& frame_arena);
     ~RenderSystem();
 
     AmbientSettings ambient;
 
-    // 1. Очистка очереди перед кадром
+    // 1. Очистка очереди перед кадром. Новая очередь берется из арены текущего кадра,
+    // поэтому ClearQueue нужно звать каждый кадр до Submit
     void ClearQueue();
 
     // 2. Интерфейс для внешних систем (C++, daslang через C-binding и т.д.)
@@ -27,7 +30,7 @@ public:
     void ExecuteCommands(SDL_GPUCommandBuffer* cmd_buffer,
                          RenderTarget& target,
                          const CameraData& camera,
-                         const std::vector<PointLightGPU>& lights);
+                         std::span<const PointLightGPU> lights);
 
     PipelineManager* GetPipelineManager() { return pipeline_manager_.get(); }
 
@@ -35,11 +38,17 @@ private:
     SDL_GPUDevice* device_ = nullptr;
     std::unique_ptr<PipelineManager> pipeline_manager_;
 
+    core::FrameArena& frame_arena_;
+
     // Внутренний буфер команд на кадр
-    std::vector<DrawCommand> draw_queue_;
+    core::ArenaVector<DrawCommand> draw_queue_;
+    // Максимум команд за кадр — резервируем сразу, чтобы очередь не переезжала внутри арены
+    size_t draw_queue_hint_ = 0;
 
     // В приватную секцию класса RenderSystem:
     SDL_GPUBuffer* light_storage_buffer_ = nullptr;
+    // Постоянный буфер загрузки ламп, перезаливается с cycle вместо создания каждый кадр
+    SDL_GPUTransferBuffer* light_transfer_buffer_ = nullptr;
     size_t current_buffer_capacity_ = 0; // Трекаем текущий размер буфера ламп
 };
 
@@ -3,6 +3,9 @@
 #include <SDL3/SDL_gpu.h>
 #include <cereal/cereal.hpp>
 #include <memory>
+#include <unordered_map>
+
+#include "engine/core/StringId.hpp"
 
 namespace tryengine::graphics {
 
@@ -79,7 +82,7 @@ struct ShaderAsset {
 };
 
 struct ShaderParamInfo {
-    std::string name;
+    core::StringId name;
     ShaderParamType type;
     uint32_t offset;
     uint32_t size;
@@ -87,11 +90,13 @@ struct ShaderParamInfo {
 
 struct ShaderLayout {
     std::vector<ShaderParamInfo> params;
-    std::unordered_map<std::string, uint32_t> texture_slots;
+    // Ключ — id имени текстуры (StringId::GetId)
+    std::unordered_map<uint64_t, uint32_t> texture_slots;
     uint32_t uniform_buffer_size = 0;
     uint32_t uniform_binding_slot = 1;
 
-    const ShaderParamInfo* FindParam(const std::string& name) const {
+    // Имена параметров и текстур — StringId: поиск сравнивает числа, для литерала id считается при компиляции
+    const ShaderParamInfo* FindParam(core::StringId name) const {
         for (const auto& p : params) {
             if (p.name == name)
                 return &p;
@@ -99,12 +104,12 @@ struct ShaderLayout {
         return nullptr;
     }
 
-    int32_t FindTextureSlot(const std::string& name) const {
-        auto it = texture_slots.find(name);
+    int32_t FindTextureSlot(core::StringId name) const {
+        auto it = texture_slots.find(name.GetId());
         return (it != texture_slots.end()) ? static_cast<int32_t>(it->second) : -1;
     }
 
-    void AddParam(const std::string& name, ShaderParamType type) {
+    void AddParam(core::StringId name, ShaderParamType type) {
         uint32_t size = GetTypeSize(type);
         uint32_t alignment = (size > 4) ? 16 : 4;
         uniform_buffer_size = (uniform_buffer_size + alignment - 1) & ~(alignment - 1);
@@ -157,7 +162,7 @@ struct Material {
         textures.push_back({slot, tex});
     }
 
-    void SetTexture(const std::string& name, const Texture& tex) {
+    void SetTexture(core::StringId name, const Texture& tex) {
         if (!shader)
             return;
         int32_t slot = shader->layout.FindTextureSlot(name);
@@ -167,7 +172,7 @@ struct Material {
     }
 
     template <typename T>
-    void SetParam(const std::string& name, const T& value) {
+    void SetParam(core::StringId name, const T& value) {
         if (!shader)
             return;
         const auto* param = shader->layout.FindParam(name);
@@ -179,7 +184,7 @@ struct Material {
         }
     }
 
-    void SetParamRaw(const std::string& name, const void* data_ptr, uint32_t data_size) {
+    void SetParamRaw(core::StringId name, const void* data_ptr, uint32_t data_size) {
         if (!shader)
             return;
         const auto* param = shader->layout.FindParam(name);
@@ -3,6 +3,7 @@
 #include <cereal/archives/binary.hpp>
 #include <fstream>
 
+#include "engine/core/Profiler.hpp"
 #include "engine/core/ResourceManager.hpp"
 #include "engine/graphics/Types.hpp"
 #include "engine/resources/MaterialAssetData.hpp"
@@ -16,6 +17,8 @@ public:
     explicit MaterialLoader(core::ResourceManager& rm) : resource_manager_(rm) {}
 
     result_type operator()(uint64_t id, const std::string& path) const {
+        TRYENGINE_PROFILE_ZONE("MaterialLoader");
+
         std::ifstream is(path, std::ios::binary);
         if (!is.is_open())
             return nullptr;
@@ -41,7 +44,7 @@ public:
 
         // 3. Накатываем значения из ассета поверх дефолтных
         for (auto const& [name, values] : asset_data.scalar_params) {
-            material->SetParamRaw(name, values.data(), values.size() * sizeof(float));
+            material->SetParamRaw(core::StringId::Hash(name), values.data(), values.size() * sizeof(float));
         }
 
         // 4. Загружаем текстуры
@@ -52,7 +55,7 @@ public:
             // Здесь нужен твой метод загрузки текстур и получения сэмплера
             auto tex_res = resource_manager_.Get<Texture>(tex_id);
             if (tex_res) {
-                material->SetTexture(name, tex_res);
+                material->SetTexture(core::StringId::Hash(name), tex_res);
             }
         }
 
@@ -2,6 +2,7 @@
 
 #include <memory>
 
+#include "engine/core/Profiler.hpp"
 #include "engine/core/ResourceManager.hpp"
 #include "engine/graphics/Types.hpp"
 #include "engine/resources/Types.hpp"
@@ -14,6 +15,8 @@ public:
     explicit MeshLoader(core::ResourceManager& res, SDL_GPUDevice* device) : res_manager(&res), device(device) {}
 
     result_type operator()(uint64_t id, const std::string& path) const {
+        TRYENGINE_PROFILE_ZONE("MeshLoader");
+
         const auto mesh = res_manager->Get<resources::MeshData>(id);
 
         auto gpu_mesh = std::shared_ptr<Mesh>(new Mesh(), [device = this->device](const Mesh* m) {
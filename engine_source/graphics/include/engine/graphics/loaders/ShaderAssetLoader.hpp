@@ -9,6 +9,7 @@
 #include <memory>
 #include <string>
 
+#include "engine/core/Profiler.hpp"
 #include "engine/core/ResourceManager.hpp"
 #include "engine/graphics/Types.hpp"
 
@@ -22,6 +23,8 @@ public:
         : device_(device), resource_manager_(rm) {}
 
     result_type operator()(uint64_t id, const std::string& path) const {
+        TRYENGINE_PROFILE_ZONE("ShaderAssetLoader");
+
         std::ifstream is(path, std::ios::binary);  // Обязательно binary мода
         if (!is.is_open()) {
             SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "ShaderLoader: cannot open %s", path.c_str());
@@ -84,17 +87,17 @@ public:
 
         // 2. Формируем Runtime Layout
         for (const auto& p : asset.params) {
-            shader->layout.AddParam(p.name, p.type);
+            shader->layout.AddParam(core::StringId(p.name), p.type);
         }
         for (const auto& t : asset.textures) {
-            shader->layout.texture_slots[t.name] = t.slot;
+            shader->layout.texture_slots[core::StringId(t.name).GetId()] = t.slot;
         }
 
         // 3. Подготавливаем дефолтный буфер
         shader->default_uniform_data.assign(shader->layout.uniform_buffer_size, 0);
         for (const auto& p : asset.params) {
             auto it = std::find_if(shader->layout.params.begin(), shader->layout.params.end(),
-                                   [&](auto& info) { return info.name == p.name; });
+                                   [&](auto& info) { return info.name == core::StringId::Hash(p.name); });
             if (it != shader->layout.params.end() && !p.default_values.empty()) {
                 std::memcpy(shader->default_uniform_data.data() + it->offset, p.default_values.data(),
                             std::min((size_t) it->size, p.default_values.size() * sizeof(float)));
@@ -1,5 +1,8 @@
 #include <entt/entity/registry.hpp>
 #include "engine/core/Components.hpp"
+#include "engine/core/Prefab.hpp"
+#include "engine/core/Profiler.hpp"
+#include "engine/graphics/May.hpp"
 #include "engine/graphics/RenderSystem.hpp"
 
 inline uint64_t MakeSortingKey(uint8_t pass_layer, uint16_t pipeline_id, uint16_t material_id, uint16_t mesh_id, uint16_t depth = 0) {
@@ -13,28 +16,37 @@ inline uint64_t MakeSortingKey(uint8_t pass_layer, uint16_t pipeline_id, uint16_
 namespace tryengine::graphics {
 
 void SubmitSceneFromEnTT(entt::registry& reg, entt::entity camera_entity, RenderSystem& render_system) {
+    TRYENGINE_PROFILE_ZONE("SubmitSceneFromEnTT");
     render_system.ClearQueue();
 
-    // Проходим по рендер-сущностям и формируем команды отрисовки
-    auto renderable_view = reg.view<Transform, MeshFilter, MeshRenderer>();
-    for (auto entity : renderable_view) {
-        auto& transform = renderable_view.get<Transform>(entity);
-        auto& mesh_filter = renderable_view.get<MeshFilter>(entity);
-        auto& mesh_renderer = renderable_view.get<MeshRenderer>(entity);
+    // Владеющая группа: матрицы, фильтры и рендереры лежат в начале своих пулов в одном порядке,
+    // цикл идет по трем плотным массивам без поиска по sparse set
+    auto renderables = reg.group<WorldMatrix, MeshFilter, MeshRenderer>();
 
+    // Соседние сущности обычно делят шейдер — дескриптор (memset + хеш) строим только при его смене
+    const Shader* last_shader = nullptr;
+    SDL_GPUGraphicsPipeline* pipeline = nullptr;
+    uint16_t pipeline_id = 0;
+
+    const auto submit = [&](const glm::mat4& model_matrix, const MeshFilter& mesh_filter,
+                            const MeshRenderer& mesh_renderer) {
         if (!mesh_renderer.material || !mesh_renderer.material->shader || !mesh_filter.mesh)
-            continue;
+            return;
 
-        // Конструируем дескриптор пайплайна для кэша
-        PipelineDescriptor desc;
-        desc.fragment_shader = mesh_renderer.material->shader->fragment_shader;
-        desc.vertex_shader = mesh_renderer.material->shader->vertex_shader;
-        auto* pipeline = render_system.GetPipelineManager()->GetOrCreatePipeline(desc);
+        const Shader* shader = mesh_renderer.material->shader;
+        if (shader != last_shader) {
+            // Конструируем дескриптор пайплайна для кэша
+            PipelineDescriptor desc;
+            desc.fragment_shader = shader->fragment_shader;
+            desc.vertex_shader = shader->vertex_shader;
+            pipeline = render_system.GetPipelineManager()->GetOrCreatePipeline(desc);
+            // Генерируем уникальные ID для ключа сортировки (в реальном движке это индексы в менеджерах ресурсов)
+            pipeline_id = desc.GetHashCode() & 0xFFFF;
+            last_shader = shader;
+        }
 
-        if (!pipeline) continue;
+        if (!pipeline) return;
 
-        // Генерируем уникальные ID для ключа сортировки (в реальном движке это индексы в менеджерах ресурсов)
-        uint16_t pipeline_id = desc.GetHashCode() & 0xFFFF;
         uint16_t material_id = reinterpret_cast<uintptr_t>(mesh_renderer.material.handle().get()) & 0xFFFF;
         uint16_t mesh_id     = reinterpret_cast<uintptr_t>(mesh_filter.mesh.handle().get()) & 0xFFFF;
 
@@ -47,9 +59,32 @@ void SubmitSceneFromEnTT(entt::registry& reg, entt::entity camera_entity, Render
         cmd.num_indices = mesh_filter.mesh->num_indices;
         cmd.pipeline = pipeline;
         cmd.material = mesh_renderer.material.handle().get();
-        cmd.model_matrix = transform.world_matrix;
+        cmd.model_matrix = model_matrix;
 
         render_system.Submit(cmd);
+    };
+
+    for (auto [entity, world, mesh_filter, mesh_renderer] : renderables.each()) {
+        submit(world.value, mesh_filter, mesh_renderer);
+    }
+
+    // Экземпляры префабов: недостающее на сущности берется из общего шаблона
+    core::ForEachPrefabMesh(reg, submit);
+}
+
+void ExtractSceneLights(entt::registry& reg) {
+    auto& scene_lights = reg.ctx().get<SceneLights>().lights;
+    scene_lights.clear();
+
+    auto light_view = reg.view<Transform, LightComponent>();
+    for (auto [entity, transform, light] : light_view.each()) {
+        PointLightGPU render_light;
+        // Упаковываем радиус в позицию
+        render_light.position_radius = glm::vec4(transform.position, light.radius);
+        // Упаковываем интенсивность в цвет
+        render_light.color_intensity = glm::vec4(light.color, light.intensity);
+
+        scene_lights.push_back(render_light);
     }
 }
 
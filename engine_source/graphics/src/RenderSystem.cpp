@@ -3,9 +3,12 @@
 #include <algorithm>
 #include <cstring> // Для std::memcpy
 
+#include "engine/core/Profiler.hpp"
+
 namespace tryengine::graphics {
 
-RenderSystem::RenderSystem(SDL_GPUDevice* device) : device_(device) {
+RenderSystem::RenderSystem(SDL_GPUDevice* device, core::FrameArena& frame_arena)
+    : device_(device), frame_arena_(frame_arena), draw_queue_(frame_arena.MakeVector<DrawCommand>()) {
     pipeline_manager_ = std::make_unique<PipelineManager>(device);
 }
 
@@ -13,10 +16,15 @@ RenderSystem::~RenderSystem() {
     if (light_storage_buffer_) {
         SDL_ReleaseGPUBuffer(device_, light_storage_buffer_);
     }
+    if (light_transfer_buffer_) {
+        SDL_ReleaseGPUTransferBuffer(device_, light_transfer_buffer_);
+    }
 }
 
 void RenderSystem::ClearQueue() {
-    draw_queue_.clear();
+    // Старая очередь могла остаться в уже сброшенном буфере арены — не трогаем ее, а заменяем
+    draw_queue_ = frame_arena_.MakeVector<DrawCommand>();
+    draw_queue_.reserve(draw_queue_hint_);
 }
 
 void RenderSystem::Submit(const DrawCommand& cmd) {
@@ -26,38 +34,43 @@ void RenderSystem::Submit(const DrawCommand& cmd) {
 void RenderSystem::ExecuteCommands(SDL_GPUCommandBuffer* cmd_buffer,
                                    RenderTarget& target,
                                    const CameraData& camera,
-                                   const std::vector<PointLightGPU>& lights) {
+                                   std::span<const PointLightGPU> lights) {
+    TRYENGINE_PROFILE_ZONE("RenderSystem::ExecuteCommands");
 
     if (!lights.empty()) {
         if (!light_storage_buffer_ || current_buffer_capacity_ < lights.size()) {
             if (light_storage_buffer_) {
                 SDL_ReleaseGPUBuffer(device_, light_storage_buffer_);
             }
+            if (light_transfer_buffer_) {
+                SDL_ReleaseGPUTransferBuffer(device_, light_transfer_buffer_);
+            }
             current_buffer_capacity_ = std::max(static_cast<size_t>(64), lights.size());
 
             SDL_GPUBufferCreateInfo buffer_info{};
             buffer_info.usage = SDL_GPU_BUFFERUSAGE_GRAPHICS_STORAGE_READ;
             buffer_info.size = sizeof(PointLightGPU) * current_buffer_capacity_;
             light_storage_buffer_ = SDL_CreateGPUBuffer(device_, &buffer_info);
+
+            SDL_GPUTransferBufferCreateInfo xfer_info{};
+            xfer_info.usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD;
+            xfer_info.size = buffer_info.size;
+            light_transfer_buffer_ = SDL_CreateGPUTransferBuffer(device_, &xfer_info);
         }
 
-        SDL_GPUTransferBufferCreateInfo xfer_info{};
-        xfer_info.usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD;
-        xfer_info.size = sizeof(PointLightGPU) * lights.size();
-        SDL_GPUTransferBuffer* xfer_buffer = SDL_CreateGPUTransferBuffer(device_, &xfer_info);
+        const auto upload_size = static_cast<Uint32>(lights.size_bytes());
 
-        void* mapped_data = SDL_MapGPUTransferBuffer(device_, xfer_buffer, false);
-        std::memcpy(mapped_data, lights.data(), xfer_info.size);
-        SDL_UnmapGPUTransferBuffer(device_, xfer_buffer);
+        // cycle = true: если GPU еще читает прошлую заливку, SDL подставит свежую копию буфера
+        void* mapped_data = SDL_MapGPUTransferBuffer(device_, light_transfer_buffer_, true);
+        std::memcpy(mapped_data, lights.data(), upload_size);
+        SDL_UnmapGPUTransferBuffer(device_, light_transfer_buffer_);
 
         SDL_GPUCopyPass* copy_pass = SDL_BeginGPUCopyPass(cmd_buffer);
-        SDL_GPUTransferBufferLocation src{ xfer_buffer, 0 };
-        SDL_GPUBufferRegion dst{ light_storage_buffer_, 0, static_cast<Uint32>(xfer_info.size) };
+        SDL_GPUTransferBufferLocation src{ light_transfer_buffer_, 0 };
+        SDL_GPUBufferRegion dst{ light_storage_buffer_, 0, upload_size };
 
         SDL_UploadToGPUBuffer(copy_pass, &src, &dst, true);
         SDL_EndGPUCopyPass(copy_pass);
-
-        SDL_ReleaseGPUTransferBuffer(device_, xfer_buffer);
     }
 
     auto& clear_color = ambient.clear_color;
@@ -80,6 +93,8 @@ void RenderSystem::ExecuteCommands(SDL_GPUCommandBuffer* cmd_buffer,
         return;
     }
 
+    draw_queue_hint_ = std::max(draw_queue_hint_, draw_queue_.size());
+
     std::sort(draw_queue_.begin(), draw_queue_.end(), [](const DrawCommand& a, const DrawCommand& b) {
         return a.sorting_key < b.sorting_key;
     });
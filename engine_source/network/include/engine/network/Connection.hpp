@@ -0,0 +1,158 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "engine/network/UdpSocket.hpp"
+
+namespace tryengine::network {
+
+enum class Channel : uint8_t {
+    // Может потеряться, прийти дважды или не по порядку
+    Unreliable = 0,
+    // Может потеряться, но устаревшее (старше уже доставленного) отбрасывается
+    UnreliableSequenced = 1,
+    // Доставляется ровно один раз и по порядку
+    ReliableOrdered = 2,
+};
+
+using ConnectionId = uint32_t;
+// Connect не смог завести соединение (достигнут TransportConfig::max_connections)
+inline constexpr ConnectionId kInvalidConnection = ~ConnectionId{0};
+
+// Доставленное сообщение; байты лежат в общем буфере приема транспорта
+struct ReceivedMessage {
+    ConnectionId connection = 0;
+    Channel channel = Channel::Unreliable;
+    uint32_t offset = 0;
+    uint32_t size = 0;
+};
+
+// Состояние одного собеседника: склейка сообщений в пакеты до MTU, подтверждения, повторы надежного канала.
+// Сокетов не знает — пакеты собираются в буфер и разбираются из него, поэтому проверяется и без сети.
+//
+// Пакет: protocol_id u32, sequence u16, ack u16, ack_bits u32, затем сообщения
+// (channel u8, id u16, size u16, данные). ack_bits — какие из 32 пакетов перед ack получены.
+// Пакет без сообщений (только подтверждения) сам подтверждения не требует.
+class Connection {
+public:
+    using TimePoint = std::chrono::steady_clock::time_point;
+
+    static constexpr size_t kPacketHeaderSize = 12;
+    static constexpr size_t kMessageHeaderSize = 5;
+    // Надежных сообщений в полете; Queue откажет, пока старые не подтверждены
+    static constexpr uint16_t kReliableWindow = 256;
+    // Сколько последних пакетов еще можно подтвердить; должно перекрывать все, что уходит за RTT
+    static constexpr uint32_t kPacketHistory = 1024;
+    static constexpr uint32_t kMaxReliablePerPacket = 64;
+    // Кольцо номеров надежных сообщений по отправленным пакетам
+    static constexpr uint32_t kReliableIdRing = 4096;
+
+    Connection(ConnectionId id, const Address& peer, uint32_t protocol_id, size_t mtu);
+
+    // Наибольшее сообщение, которое влезает в пакет при данном MTU
+    static size_t MaxMessageSize(size_t mtu);
+    // Начинается ли датаграмма с нашего protocol_id — до того, как заводить под нее соединение
+    static bool HasProtocol(std::span<const std::byte> packet, uint32_t protocol_id);
+
+    // false — сообщение больше GetMaxMessageSize или окно надежного канала заполнено
+    bool Queue(Channel channel, std::span<const std::byte> data);
+
+    // Собирает в out все пакеты, которые пора отправить, sizes — их размеры подряд.
+    // Если есть неподтвержденные входящие, а данных нет — добавляет пакет только с подтверждениями
+    void WritePackets(TimePoint now, std::vector<std::byte>& out, std::vector<uint32_t>& sizes);
+
+    // Разбирает входящий пакет, доставленные сообщения дописываются в payloads/messages.
+    // false — пакет чужой или битый
+    bool ReadPacket(std::span<const std::byte> packet, TimePoint now, std::vector<std::byte>& payloads,
+                    std::vector<ReceivedMessage>& messages);
+
+    [[nodiscard]] ConnectionId GetId() const { return id_; }
+    [[nodiscard]] const Address& GetPeer() const { return peer_; }
+    [[nodiscard]] size_t GetMaxMessageSize() const { return MaxMessageSize(mtu_); }
+    // Сглаженный RTT по подтверждениям, секунды
+    [[nodiscard]] double GetRtt() const { return rtt_; }
+    // Надежных сообщений, еще не подтвержденных получателем
+    [[nodiscard]] uint32_t GetReliableBacklog() const { return static_cast<uint16_t>(reliable_next_ - reliable_oldest_); }
+    [[nodiscard]] uint64_t GetResentCount() const { return resent_; }
+    // До первого пакета — время создания соединения
+    [[nodiscard]] TimePoint GetLastReceiveTime() const { return last_receive_; }
+
+private:
+    struct SentPacket {
+        uint16_t sequence = 0;
+        bool valid = false;
+        bool acked = false;
+        uint16_t reliable_count = 0;
+        // Позиция первого номера в sent_reliable_ids_ (счетчик, без взятия по модулю)
+        uint32_t reliable_begin = 0;
+        TimePoint time;
+    };
+
+    struct OutgoingReliable {
+        uint16_t id = 0;
+        bool pending = false;
+        bool sent = false;
+        TimePoint last_sent;
+        std::vector<std::byte> data;
+    };
+
+    struct IncomingReliable {
+        uint16_t id = 0;
+        bool received = false;
+        std::vector<std::byte> data;
+    };
+
+    void BeginPacket(std::vector<std::byte>& out);
+    void EndPacket(std::vector<std::byte>& out, std::vector<uint32_t>& sizes, TimePoint now);
+    void WriteAckHeader(std::byte* header);
+    void ProcessAck(uint16_t sequence, TimePoint now);
+    void Deliver(Channel channel, std::span<const std::byte> data, std::vector<std::byte>& payloads,
+                 std::vector<ReceivedMessage>& messages) const;
+
+    ConnectionId id_;
+    Address peer_;
+    uint32_t protocol_id_;
+    size_t mtu_;
+
+    // Отправка
+    uint16_t local_sequence_ = 0;
+    std::array<SentPacket, kPacketHistory> sent_packets_{};
+    std::vector<uint16_t> sent_reliable_ids_;
+    uint32_t sent_reliable_end_ = 0;
+    std::vector<OutgoingReliable> outgoing_;
+    uint16_t reliable_next_ = 0;
+    uint16_t reliable_oldest_ = 0;
+    uint16_t sequenced_next_ = 0;
+    // Уже закодированные ненадежные сообщения до ближайшего WritePackets
+    std::vector<std::byte> unreliable_;
+    std::vector<uint16_t> due_;
+
+    // Открытый пакет в WritePackets
+    size_t packet_begin_ = 0;
+    uint32_t packet_reliable_begin_ = 0;
+    uint16_t packet_reliable_ = 0;
+    bool packet_has_messages_ = false;
+
+    // Прием
+    bool has_remote_ = false;
+    uint16_t remote_sequence_ = 0;
+    // Номер пакета по слоту sequence % kPacketHistory; 0xFFFFFFFF — пусто
+    std::array<uint32_t, kPacketHistory> received_{};
+    // Входящие пакеты с сообщениями, еще ни разу не подтвержденные
+    std::vector<uint16_t> pending_acks_;
+    std::vector<IncomingReliable> incoming_;
+    uint16_t reliable_expected_ = 0;
+    bool has_sequenced_ = false;
+    uint16_t sequenced_last_ = 0;
+
+    double rtt_ = 0.1;
+    uint64_t resent_ = 0;
+    TimePoint last_receive_;
+};
+
+}  // namespace tryengine::network
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <span>
+#include <vector>
+
+#include "engine/network/UdpSocket.hpp"
+
+namespace tryengine::network {
+
+// Условия канала для проверки на 127.0.0.1. Применяются к исходящим пакетам
+struct LinkConditions {
+    double latency_ms = 0.0;
+    // Задержка каждого пакета равномерно в latency ± jitter, поэтому пакеты еще и переставляются
+    double jitter_ms = 0.0;
+    // Доля потерянных пакетов, 0..1
+    double loss = 0.0;
+
+    [[nodiscard]] bool IsPerfect() const { return latency_ms <= 0.0 && jitter_ms <= 0.0 && loss <= 0.0; }
+};
+
+// Очередь задержанных пакетов. Буферы переиспользуются, в установившемся режиме куча не трогается
+class LinkSimulator {
+public:
+    using TimePoint = std::chrono::steady_clock::time_point;
+
+    LinkSimulator(const LinkConditions& conditions, uint32_t seed);
+
+    // Копирует пакет в очередь. false — пакет потерян
+    bool Push(const Address& to, std::span<const std::byte> data, TimePoint now);
+
+    // Дописывает в out пакеты, срок которых наступил. Данные живут до следующего Collect
+    void Collect(TimePoint now, std::vector<OutDatagram>& out);
+
+    [[nodiscard]] size_t GetPendingCount() const { return pending_.size(); }
+
+private:
+    struct Delayed {
+        TimePoint due;
+        Address to;
+        std::vector<std::byte> data;
+    };
+
+    LinkConditions conditions_;
+    std::minstd_rand rng_;
+    std::vector<Delayed> pending_;
+    std::vector<Delayed> ready_;
+    std::vector<std::vector<std::byte>> free_;
+};
+
+}  // namespace tryengine::network
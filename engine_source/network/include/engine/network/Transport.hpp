@@ -0,0 +1,119 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include "engine/network/Connection.hpp"
+#include "engine/network/LinkSimulator.hpp"
+#include "engine/network/UdpSocket.hpp"
+
+namespace tryengine::network {
+
+struct TransportConfig {
+    // Порт 0 — выбрать свободный (клиент)
+    Address bind = Address::Loopback(0);
+    uint32_t protocol_id = 0x54525931;  // "TRY1"
+    // Полезная нагрузка UDP-датаграммы; 1200 проходит почти любой путь без фрагментации IP
+    size_t mtu = 1200;
+    // Датаграмм на один sendmmsg/recvmmsg
+    uint32_t batch_size = UdpSocket::kMaxBatchSize;
+    size_t socket_buffer_bytes = 4 * 1024 * 1024;
+    // Соединение держит историю пакетов и окна надежного канала (сотни КБ): чужие датаграммы с нашим
+    // protocol_id сверх лимита отбрасываются
+    uint32_t max_connections = 1024;
+    // Соединение, от которого столько секунд ничего не приходило, закрывается в Update
+    double idle_timeout = 10.0;
+    // Имитация плохого канала на исходящих пакетах
+    LinkConditions link;
+    uint32_t link_seed = 1;
+};
+
+struct TransportStats {
+    uint64_t packets_sent = 0;
+    uint64_t packets_received = 0;
+    uint64_t bytes_sent = 0;
+    uint64_t bytes_received = 0;
+    uint64_t messages_received = 0;
+    uint64_t packets_lost_by_link = 0;
+    // Сокет не принял (буфер отправки полон)
+    uint64_t packets_dropped = 0;
+    uint64_t packets_invalid = 0;
+    // Новый собеседник не принят: соединений уже max_connections
+    uint64_t connections_refused = 0;
+    uint64_t connections_timed_out = 0;
+    uint64_t syscalls = 0;
+};
+
+// UDP-транспорт с тремя каналами (см. Channel). Сообщения копятся до Update, там склеиваются в пакеты до MTU
+// по каждому собеседнику и уходят пачкой. Соединения без рукопожатия: собеседник появляется при первом
+// пакете с нашим protocol_id и закрывается по idle_timeout или Disconnect. Идентификатор закрытого соединения
+// переиспользуется. Однопоточный: Send/Update/GetReceived с одного потока
+class Transport {
+public:
+    explicit Transport(const TransportConfig& config);
+
+    bool Open();
+    void Close();
+
+    [[nodiscard]] Address GetLocalAddress() const { return socket_.GetLocalAddress(); }
+
+    // Существующее соединение с адресом или новое; kInvalidConnection — достигнут max_connections
+    ConnectionId Connect(const Address& peer);
+    // Забывает собеседника вместе с неотправленным и неподтвержденным
+    void Disconnect(ConnectionId connection);
+
+    // false — сообщение больше GetMaxMessageSize или окно надежного канала заполнено (повторить позже)
+    bool Send(ConnectionId connection, Channel channel, std::span<const std::byte> data);
+
+    // Раз в тик: прием всего, что пришло, подтверждения и повторы, отправка накопленного
+    void Update();
+
+    // Сообщения, доставленные последним Update; живут до следующего Update
+    [[nodiscard]] const std::vector<ReceivedMessage>& GetReceived() const { return received_; }
+    [[nodiscard]] std::span<const std::byte> GetPayload(const ReceivedMessage& message) const {
+        return {payloads_.data() + message.offset, message.size};
+    }
+
+    // Соединения, закрытые последним Update по idle_timeout; живут до следующего Update
+    [[nodiscard]] const std::vector<ConnectionId>& GetTimedOut() const { return timed_out_; }
+
+    [[nodiscard]] bool IsConnected(ConnectionId connection) const {
+        return connection < connections_.size() && connections_[connection];
+    }
+    [[nodiscard]] size_t GetConnectionCount() const { return connections_.size() - free_ids_.size(); }
+    [[nodiscard]] const Connection& GetConnection(ConnectionId connection) const { return *connections_[connection]; }
+    [[nodiscard]] size_t GetMaxMessageSize() const;
+    [[nodiscard]] const TransportStats& GetStats() const { return stats_; }
+
+private:
+    void ReceiveAll(Connection::TimePoint now);
+    void SendAll(Connection::TimePoint now);
+    void DropIdle(Connection::TimePoint now);
+
+    TransportConfig config_;
+    UdpSocket socket_;
+    DatagramBatch batch_;
+    std::unique_ptr<LinkSimulator> link_;
+
+    // Индекс — ConnectionId; закрытые слоты пусты и лежат в free_ids_
+    std::vector<std::unique_ptr<Connection>> connections_;
+    std::vector<ConnectionId> free_ids_;
+    std::unordered_map<uint64_t, ConnectionId> by_address_;
+    std::vector<ConnectionId> timed_out_;
+
+    std::vector<ReceivedMessage> received_;
+    std::vector<std::byte> payloads_;
+
+    // Буферы отправки, переиспользуются между Update
+    std::vector<std::byte> out_bytes_;
+    std::vector<uint32_t> out_sizes_;
+    std::vector<uint32_t> out_packet_counts_;
+    std::vector<OutDatagram> out_datagrams_;
+
+    TransportStats stats_;
+};
+
+}  // namespace tryengine::network
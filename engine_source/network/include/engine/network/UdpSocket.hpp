@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace tryengine::network {
+
+// IPv4-адрес и порт в порядке байт хоста
+struct Address {
+    uint32_t ip = 0;
+    uint16_t port = 0;
+
+    static Address Loopback(uint16_t port) { return {0x7F000001u, port}; }
+    // "a.b.c.d:port"
+    static bool Parse(std::string_view text, Address& out);
+
+    [[nodiscard]] std::string ToString() const;
+    [[nodiscard]] uint64_t GetKey() const { return (static_cast<uint64_t>(ip) << 16) | port; }
+
+    bool operator==(const Address&) const = default;
+};
+
+// Исходящая датаграмма. Данные принадлежат вызывающему и должны жить до конца SendBatch
+struct OutDatagram {
+    Address to;
+    const std::byte* data = nullptr;
+    size_t size = 0;
+};
+
+// Входящие датаграммы одного ReceiveBatch. Память выделяется один раз в конструкторе
+class DatagramBatch {
+public:
+    static constexpr size_t kMaxDatagramSize = 1500;
+
+    explicit DatagramBatch(uint32_t capacity);
+
+    [[nodiscard]] uint32_t GetCapacity() const { return static_cast<uint32_t>(sizes_.size()); }
+    [[nodiscard]] uint32_t GetCount() const { return count_; }
+    [[nodiscard]] const Address& GetAddress(uint32_t index) const { return addresses_[index]; }
+    [[nodiscard]] std::span<const std::byte> GetData(uint32_t index) const {
+        return {buffer_.data() + index * kMaxDatagramSize, sizes_[index]};
+    }
+
+private:
+    friend class UdpSocket;
+
+    std::vector<std::byte> buffer_;
+    std::vector<Address> addresses_;
+    std::vector<uint32_t> sizes_;
+    uint32_t count_ = 0;
+};
+
+// Неблокирующий UDP-сокет (IPv4, POSIX). На Linux пачка уходит и приходит через sendmmsg/recvmmsg —
+// один системный вызов на batch_size датаграмм; на остальных системах по одной
+class UdpSocket {
+public:
+    static constexpr uint32_t kMaxBatchSize = 64;
+
+    UdpSocket() = default;
+    ~UdpSocket();
+
+    UdpSocket(const UdpSocket&) = delete;
+    UdpSocket& operator=(const UdpSocket&) = delete;
+
+    // Порт 0 — выбрать свободный. buffer_bytes — SO_SNDBUF/SO_RCVBUF (ядро может урезать)
+    bool Open(const Address& bind_address, size_t buffer_bytes);
+    void Close();
+
+    [[nodiscard]] bool IsOpen() const { return fd_ >= 0; }
+    [[nodiscard]] Address GetLocalAddress() const;
+
+    // Датаграмм на один системный вызов, 1..kMaxBatchSize
+    void SetBatchSize(uint32_t batch_size);
+
+    // Сколько датаграмм принял сокет. Остаток отбрасывается (буфер полон) — для UDP это обычная потеря
+    uint32_t SendBatch(std::span<const OutDatagram> datagrams);
+    // Забирает из сокета до batch.GetCapacity() датаграмм, 0 — очередь пуста
+    uint32_t ReceiveBatch(DatagramBatch& batch);
+
+    [[nodiscard]] uint64_t GetSyscallCount() const { return syscalls_; }
+
+private:
+    int fd_ = -1;
+    uint32_t batch_size_ = kMaxBatchSize;
+    uint64_t syscalls_ = 0;
+};
+
+}  // namespace tryengine::network
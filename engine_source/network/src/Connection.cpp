@@ -0,0 +1,319 @@
+#include "engine/network/Connection.hpp"
+
+#include <algorithm>
+
+namespace tryengine::network {
+
+namespace {
+
+// Повтор надежного сообщения не раньше чем через столько, даже при RTT около нуля (петля)
+constexpr double kMinResendSeconds = 0.02;
+constexpr double kRttSmoothing = 0.1;
+constexpr uint32_t kEmptySlot = 0xFFFFFFFFu;
+
+void Put16(std::byte* out, uint16_t value) {
+    out[0] = static_cast<std::byte>(value);
+    out[1] = static_cast<std::byte>(value >> 8);
+}
+
+void Put32(std::byte* out, uint32_t value) {
+    Put16(out, static_cast<uint16_t>(value));
+    Put16(out + 2, static_cast<uint16_t>(value >> 16));
+}
+
+uint16_t Get16(const std::byte* in) {
+    return static_cast<uint16_t>(static_cast<uint16_t>(in[0]) | (static_cast<uint16_t>(in[1]) << 8));
+}
+
+uint32_t Get32(const std::byte* in) { return Get16(in) | (static_cast<uint32_t>(Get16(in + 2)) << 16); }
+
+// a новее b с учетом переполнения
+bool SequenceGreater(uint16_t a, uint16_t b) { return a != b && static_cast<uint16_t>(a - b) < 0x8000; }
+
+void AppendMessage(std::vector<std::byte>& out, Channel channel, uint16_t id, std::span<const std::byte> data) {
+    const size_t begin = out.size();
+    out.resize(begin + Connection::kMessageHeaderSize + data.size());
+    out[begin] = static_cast<std::byte>(channel);
+    Put16(out.data() + begin + 1, id);
+    Put16(out.data() + begin + 3, static_cast<uint16_t>(data.size()));
+    std::copy(data.begin(), data.end(), out.begin() + static_cast<std::ptrdiff_t>(begin + Connection::kMessageHeaderSize));
+}
+
+size_t ClampMtu(size_t mtu) {
+    return std::clamp<size_t>(mtu, Connection::kPacketHeaderSize + Connection::kMessageHeaderSize + 1,
+                              DatagramBatch::kMaxDatagramSize);
+}
+
+}  // namespace
+
+Connection::Connection(ConnectionId id, const Address& peer, uint32_t protocol_id, size_t mtu)
+    : id_(id),
+      peer_(peer),
+      protocol_id_(protocol_id),
+      mtu_(ClampMtu(mtu)),
+      sent_reliable_ids_(kReliableIdRing),
+      outgoing_(kReliableWindow),
+      incoming_(kReliableWindow),
+      last_receive_(TimePoint::clock::now()) {
+    received_.fill(kEmptySlot);
+}
+
+size_t Connection::MaxMessageSize(size_t mtu) { return ClampMtu(mtu) - kPacketHeaderSize - kMessageHeaderSize; }
+
+bool Connection::HasProtocol(std::span<const std::byte> packet, uint32_t protocol_id) {
+    return packet.size() >= kPacketHeaderSize && Get32(packet.data()) == protocol_id;
+}
+
+bool Connection::Queue(Channel channel, std::span<const std::byte> data) {
+    if (data.size() > GetMaxMessageSize())
+        return false;
+
+    if (channel == Channel::ReliableOrdered) {
+        if (static_cast<uint16_t>(reliable_next_ - reliable_oldest_) >= kReliableWindow)
+            return false;
+
+        OutgoingReliable& message = outgoing_[reliable_next_ % kReliableWindow];
+        message.id = reliable_next_++;
+        message.pending = true;
+        message.sent = false;
+        message.data.assign(data.begin(), data.end());
+        return true;
+    }
+
+    const uint16_t id = channel == Channel::UnreliableSequenced ? sequenced_next_++ : 0;
+    AppendMessage(unreliable_, channel, id, data);
+    return true;
+}
+
+void Connection::BeginPacket(std::vector<std::byte>& out) {
+    packet_begin_ = out.size();
+    packet_reliable_begin_ = sent_reliable_end_;
+    packet_reliable_ = 0;
+    packet_has_messages_ = false;
+    out.resize(packet_begin_ + kPacketHeaderSize);
+}
+
+void Connection::EndPacket(std::vector<std::byte>& out, std::vector<uint32_t>& sizes, TimePoint now) {
+    std::byte* header = out.data() + packet_begin_;
+    Put32(header, protocol_id_);
+    Put16(header + 4, local_sequence_);
+    WriteAckHeader(header + 6);
+
+    // Пакет только с подтверждениями подтверждать не нужно — в историю не попадает
+    SentPacket& sent = sent_packets_[local_sequence_ % kPacketHistory];
+    sent = {local_sequence_, packet_has_messages_, false, packet_reliable_, packet_reliable_begin_, now};
+
+    sizes.push_back(static_cast<uint32_t>(out.size() - packet_begin_));
+    ++local_sequence_;
+}
+
+void Connection::WriteAckHeader(std::byte* header) {
+    // ack — следующий после последнего подтверждаемого, бит i — пакет ack - 1 - i.
+    // Сначала подтверждаем то, что еще не подтверждали ни разу, иначе — последние полученные (повтор на случай потерь)
+    uint16_t last = remote_sequence_;
+    if (!pending_acks_.empty()) {
+        last = pending_acks_.front();
+        for (const uint16_t sequence : pending_acks_) {
+            if (SequenceGreater(sequence, last)) {
+                last = sequence;
+            }
+        }
+        std::erase_if(pending_acks_,
+                      [last](uint16_t sequence) { return static_cast<uint16_t>(last - sequence) < 32; });
+    }
+
+    uint32_t bits = 0;
+    if (has_remote_) {
+        for (uint32_t i = 0; i < 32; ++i) {
+            const auto sequence = static_cast<uint16_t>(last - i);
+            if (received_[sequence % kPacketHistory] == sequence) {
+                bits |= 1u << i;
+            }
+        }
+    }
+
+    Put16(header, static_cast<uint16_t>(last + 1));
+    Put32(header + 2, bits);
+}
+
+void Connection::WritePackets(TimePoint now, std::vector<std::byte>& out, std::vector<uint32_t>& sizes) {
+    const auto resend_after = std::chrono::duration<double>(std::max(kMinResendSeconds, rtt_ * 1.5));
+
+    due_.clear();
+    for (uint16_t id = reliable_oldest_; id != reliable_next_; ++id) {
+        const OutgoingReliable& message = outgoing_[id % kReliableWindow];
+        if (message.pending && (!message.sent || now - message.last_sent >= resend_after)) {
+            due_.push_back(id);
+        }
+    }
+
+    bool open = false;
+    const auto reserve = [&](size_t bytes, bool reliable) {
+        const bool fits = open && out.size() - packet_begin_ + bytes <= mtu_ &&
+                          (!reliable || packet_reliable_ < kMaxReliablePerPacket);
+        if (fits)
+            return;
+        if (open) {
+            EndPacket(out, sizes, now);
+        }
+        BeginPacket(out);
+        open = true;
+    };
+
+    // Сначала надежные (повторы в том числе), потом ненадежные этого тика
+    for (const uint16_t id : due_) {
+        OutgoingReliable& message = outgoing_[id % kReliableWindow];
+        reserve(kMessageHeaderSize + message.data.size(), true);
+        AppendMessage(out, Channel::ReliableOrdered, id, message.data);
+
+        sent_reliable_ids_[sent_reliable_end_++ % kReliableIdRing] = id;
+        ++packet_reliable_;
+        packet_has_messages_ = true;
+
+        if (message.sent) {
+            ++resent_;
+        }
+        message.sent = true;
+        message.last_sent = now;
+    }
+
+    for (size_t pos = 0; pos < unreliable_.size();) {
+        const size_t size = kMessageHeaderSize + Get16(unreliable_.data() + pos + 3);
+        reserve(size, false);
+        out.insert(out.end(), unreliable_.begin() + static_cast<std::ptrdiff_t>(pos),
+                   unreliable_.begin() + static_cast<std::ptrdiff_t>(pos + size));
+        packet_has_messages_ = true;
+        pos += size;
+    }
+    unreliable_.clear();
+
+    if (open) {
+        EndPacket(out, sizes, now);
+    }
+
+    // Данных нет, а входящие ждут подтверждения
+    while (!pending_acks_.empty()) {
+        BeginPacket(out);
+        EndPacket(out, sizes, now);
+    }
+}
+
+void Connection::ProcessAck(uint16_t sequence, TimePoint now) {
+    SentPacket& packet = sent_packets_[sequence % kPacketHistory];
+    if (!packet.valid || packet.acked || packet.sequence != sequence)
+        return;
+
+    packet.acked = true;
+    rtt_ += (std::chrono::duration<double>(now - packet.time).count() - rtt_) * kRttSmoothing;
+
+    // Кольцо номеров уже перезаписано — сообщения этого пакета уйдут повтором
+    if (sent_reliable_end_ - packet.reliable_begin > kReliableIdRing)
+        return;
+
+    for (uint16_t i = 0; i < packet.reliable_count; ++i) {
+        const uint16_t id = sent_reliable_ids_[(packet.reliable_begin + i) % kReliableIdRing];
+        OutgoingReliable& message = outgoing_[id % kReliableWindow];
+        if (message.pending && message.id == id) {
+            message.pending = false;
+        }
+    }
+
+    while (reliable_oldest_ != reliable_next_ && !outgoing_[reliable_oldest_ % kReliableWindow].pending) {
+        ++reliable_oldest_;
+    }
+}
+
+void Connection::Deliver(Channel channel, std::span<const std::byte> data, std::vector<std::byte>& payloads,
+                         std::vector<ReceivedMessage>& messages) const {
+    messages.push_back({id_, channel, static_cast<uint32_t>(payloads.size()), static_cast<uint32_t>(data.size())});
+    payloads.insert(payloads.end(), data.begin(), data.end());
+}
+
+bool Connection::ReadPacket(std::span<const std::byte> packet, TimePoint now, std::vector<std::byte>& payloads,
+                            std::vector<ReceivedMessage>& messages) {
+    if (!HasProtocol(packet, protocol_id_))
+        return false;
+
+    // Проверяем разметку целиком до того, как что-то менять
+    for (size_t pos = kPacketHeaderSize; pos < packet.size();) {
+        if (packet.size() - pos < kMessageHeaderSize ||
+            static_cast<uint8_t>(packet[pos]) > static_cast<uint8_t>(Channel::ReliableOrdered))
+            return false;
+        pos += kMessageHeaderSize + Get16(packet.data() + pos + 3);
+        if (pos > packet.size())
+            return false;
+    }
+
+    const uint16_t sequence = Get16(packet.data() + 4);
+    const uint16_t ack = Get16(packet.data() + 6);
+    const uint32_t ack_bits = Get32(packet.data() + 8);
+
+    // Дубликат или пакет старше окна истории — без него обойдемся
+    if (received_[sequence % kPacketHistory] == sequence)
+        return true;
+    if (has_remote_ && !SequenceGreater(sequence, remote_sequence_) &&
+        static_cast<uint16_t>(remote_sequence_ - sequence) >= kPacketHistory)
+        return true;
+
+    received_[sequence % kPacketHistory] = sequence;
+    if (!has_remote_ || SequenceGreater(sequence, remote_sequence_)) {
+        remote_sequence_ = sequence;
+        has_remote_ = true;
+    }
+    last_receive_ = now;
+
+    for (uint32_t i = 0; i < 32; ++i) {
+        if (ack_bits & (1u << i)) {
+            ProcessAck(static_cast<uint16_t>(ack - 1 - i), now);
+        }
+    }
+
+    if (packet.size() > kPacketHeaderSize) {
+        pending_acks_.push_back(sequence);
+    }
+
+    for (size_t pos = kPacketHeaderSize; pos < packet.size();) {
+        const auto channel = static_cast<Channel>(packet[pos]);
+        const uint16_t id = Get16(packet.data() + pos + 1);
+        const auto data = packet.subspan(pos + kMessageHeaderSize, Get16(packet.data() + pos + 3));
+        pos += kMessageHeaderSize + data.size();
+
+        if (channel == Channel::Unreliable) {
+            Deliver(channel, data, payloads, messages);
+        } else if (channel == Channel::UnreliableSequenced) {
+            if (!has_sequenced_ || SequenceGreater(id, sequenced_last_)) {
+                has_sequenced_ = true;
+                sequenced_last_ = id;
+                Deliver(channel, data, payloads, messages);
+            }
+        } else {
+            // Уже доставленное или дальше окна (отправитель так не шлет) — пропускаем
+            if (static_cast<uint16_t>(id - reliable_expected_) >= kReliableWindow)
+                continue;
+
+            IncomingReliable& slot = incoming_[id % kReliableWindow];
+            if (slot.received)
+                continue;
+
+            if (id == reliable_expected_) {
+                Deliver(channel, data, payloads, messages);
+                ++reliable_expected_;
+            } else {
+                slot.id = id;
+                slot.received = true;
+                slot.data.assign(data.begin(), data.end());
+            }
+
+            // Дыра закрылась — отдаем накопленное по порядку
+            for (IncomingReliable* next = &incoming_[reliable_expected_ % kReliableWindow]; next->received;
+                 next = &incoming_[reliable_expected_ % kReliableWindow]) {
+                Deliver(channel, next->data, payloads, messages);
+                next->received = false;
+                ++reliable_expected_;
+            }
+        }
+    }
+    return true;
+}
+
+}  // namespace tryengine::network
@@ -0,0 +1,47 @@
+#include "engine/network/LinkSimulator.hpp"
+
+#include <algorithm>
+#include <iterator>
+
+namespace tryengine::network {
+
+LinkSimulator::LinkSimulator(const LinkConditions& conditions, uint32_t seed) : conditions_(conditions), rng_(seed) {}
+
+bool LinkSimulator::Push(const Address& to, std::span<const std::byte> data, TimePoint now) {
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    if (conditions_.loss > 0.0 && unit(rng_) < conditions_.loss)
+        return false;
+
+    const double delay_ms = std::max(0.0, conditions_.latency_ms + (unit(rng_) * 2.0 - 1.0) * conditions_.jitter_ms);
+
+    std::vector<std::byte> buffer;
+    if (!free_.empty()) {
+        buffer = std::move(free_.back());
+        free_.pop_back();
+    }
+    buffer.assign(data.begin(), data.end());
+
+    const auto delay = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double, std::milli>(delay_ms));
+    pending_.push_back({now + delay, to, std::move(buffer)});
+    return true;
+}
+
+void LinkSimulator::Collect(TimePoint now, std::vector<OutDatagram>& out) {
+    for (auto& packet : ready_) {
+        free_.push_back(std::move(packet.data));
+    }
+    ready_.clear();
+
+    // Уходят в порядке срока: так и получается перестановка при jitter
+    const auto due = std::partition(pending_.begin(), pending_.end(), [&](const Delayed& p) { return p.due > now; });
+    std::move(due, pending_.end(), std::back_inserter(ready_));
+    pending_.erase(due, pending_.end());
+    std::sort(ready_.begin(), ready_.end(), [](const Delayed& a, const Delayed& b) { return a.due < b.due; });
+
+    for (const auto& packet : ready_) {
+        out.push_back({packet.to, packet.data.data(), packet.data.size()});
+    }
+}
+
+}  // namespace tryengine::network
@@ -0,0 +1,166 @@
+#include "engine/network/Transport.hpp"
+
+#include "engine/core/Profiler.hpp"
+
+namespace tryengine::network {
+
+Transport::Transport(const TransportConfig& config) : config_(config), batch_(UdpSocket::kMaxBatchSize) {
+    if (!config_.link.IsPerfect()) {
+        link_ = std::make_unique<LinkSimulator>(config_.link, config_.link_seed);
+    }
+}
+
+bool Transport::Open() {
+    socket_.SetBatchSize(config_.batch_size);
+    return socket_.Open(config_.bind, config_.socket_buffer_bytes);
+}
+
+void Transport::Close() { socket_.Close(); }
+
+ConnectionId Transport::Connect(const Address& peer) {
+    if (const auto it = by_address_.find(peer.GetKey()); it != by_address_.end())
+        return it->second;
+    if (GetConnectionCount() >= config_.max_connections)
+        return kInvalidConnection;
+
+    ConnectionId id = static_cast<ConnectionId>(connections_.size());
+    if (free_ids_.empty()) {
+        connections_.emplace_back();
+    } else {
+        id = free_ids_.back();
+        free_ids_.pop_back();
+    }
+    connections_[id] = std::make_unique<Connection>(id, peer, config_.protocol_id, config_.mtu);
+    by_address_.emplace(peer.GetKey(), id);
+    return id;
+}
+
+void Transport::Disconnect(ConnectionId connection) {
+    if (!IsConnected(connection))
+        return;
+
+    by_address_.erase(connections_[connection]->GetPeer().GetKey());
+    connections_[connection].reset();
+    free_ids_.push_back(connection);
+}
+
+bool Transport::Send(ConnectionId connection, Channel channel, std::span<const std::byte> data) {
+    return IsConnected(connection) && connections_[connection]->Queue(channel, data);
+}
+
+size_t Transport::GetMaxMessageSize() const { return Connection::MaxMessageSize(config_.mtu); }
+
+void Transport::Update() {
+    TRYENGINE_PROFILE_ZONE("Transport::Update");
+
+    const auto now = Connection::TimePoint::clock::now();
+    ReceiveAll(now);
+    DropIdle(now);
+    SendAll(now);
+    stats_.syscalls = socket_.GetSyscallCount();
+}
+
+void Transport::ReceiveAll(Connection::TimePoint now) {
+    received_.clear();
+    payloads_.clear();
+    if (!socket_.IsOpen())
+        return;
+
+    while (socket_.ReceiveBatch(batch_) > 0) {
+        for (uint32_t i = 0; i < batch_.GetCount(); ++i) {
+            const auto data = batch_.GetData(i);
+            ++stats_.packets_received;
+            stats_.bytes_received += data.size();
+
+            // Чужие датаграммы не заводят соединений
+            const auto it = by_address_.find(batch_.GetAddress(i).GetKey());
+            Connection* connection = it != by_address_.end() ? connections_[it->second].get() : nullptr;
+            if (!connection) {
+                if (!Connection::HasProtocol(data, config_.protocol_id)) {
+                    ++stats_.packets_invalid;
+                    continue;
+                }
+                const ConnectionId id = Connect(batch_.GetAddress(i));
+                if (id == kInvalidConnection) {
+                    ++stats_.connections_refused;
+                    continue;
+                }
+                connection = connections_[id].get();
+            }
+
+            if (!connection->ReadPacket(data, now, payloads_, received_)) {
+                ++stats_.packets_invalid;
+            }
+        }
+
+        if (batch_.GetCount() < batch_.GetCapacity())
+            break;
+    }
+
+    stats_.messages_received += received_.size();
+}
+
+void Transport::DropIdle(Connection::TimePoint now) {
+    timed_out_.clear();
+    const std::chrono::duration<double> timeout(config_.idle_timeout);
+    for (const auto& connection : connections_) {
+        if (connection && now - connection->GetLastReceiveTime() > timeout) {
+            timed_out_.push_back(connection->GetId());
+        }
+    }
+
+    for (const ConnectionId id : timed_out_) {
+        Disconnect(id);
+    }
+    stats_.connections_timed_out += timed_out_.size();
+}
+
+void Transport::SendAll(Connection::TimePoint now) {
+    out_bytes_.clear();
+    out_sizes_.clear();
+    out_packet_counts_.clear();
+    out_datagrams_.clear();
+
+    for (const auto& connection : connections_) {
+        if (!connection) {
+            out_packet_counts_.push_back(0);
+            continue;
+        }
+        const size_t before = out_sizes_.size();
+        connection->WritePackets(now, out_bytes_, out_sizes_);
+        out_packet_counts_.push_back(static_cast<uint32_t>(out_sizes_.size() - before));
+    }
+
+    // Адреса расставляем после сборки: out_bytes_ мог переехать
+    size_t offset = 0;
+    size_t packet = 0;
+    for (size_t c = 0; c < connections_.size(); ++c) {
+        for (uint32_t i = 0; i < out_packet_counts_[c]; ++i, ++packet) {
+            const std::span<const std::byte> data(out_bytes_.data() + offset, out_sizes_[packet]);
+            offset += data.size();
+
+            if (link_) {
+                if (!link_->Push(connections_[c]->GetPeer(), data, now)) {
+                    ++stats_.packets_lost_by_link;
+                }
+            } else {
+                out_datagrams_.push_back({connections_[c]->GetPeer(), data.data(), data.size()});
+            }
+        }
+    }
+
+    if (link_) {
+        link_->Collect(now, out_datagrams_);
+    }
+    if (out_datagrams_.empty() || !socket_.IsOpen())
+        return;
+
+    const uint32_t sent = socket_.SendBatch(out_datagrams_);
+    for (uint32_t i = 0; i < sent; ++i) {
+        stats_.bytes_sent += out_datagrams_[i].size;
+    }
+    stats_.packets_sent += sent;
+    stats_.packets_dropped += out_datagrams_.size() - sent;
+}
+
+}  // namespace tryengine::network
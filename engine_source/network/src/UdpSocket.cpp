@@ -0,0 +1,211 @@
+#include "engine/network/UdpSocket.hpp"
+
+#include <algorithm>
+#include <arpa/inet.h>
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace tryengine::network {
+
+namespace {
+
+sockaddr_in ToSockaddr(const Address& address) {
+    sockaddr_in result{};
+    result.sin_family = AF_INET;
+    result.sin_addr.s_addr = htonl(address.ip);
+    result.sin_port = htons(address.port);
+    return result;
+}
+
+Address FromSockaddr(const sockaddr_in& address) { return {ntohl(address.sin_addr.s_addr), ntohs(address.sin_port)}; }
+
+bool WouldBlock(int error) { return error == EAGAIN || error == EWOULDBLOCK; }
+
+}  // namespace
+
+bool Address::Parse(std::string_view text, Address& out) {
+    const auto colon = text.rfind(':');
+    if (colon == std::string_view::npos)
+        return false;
+
+    const std::string host(text.substr(0, colon));
+    in_addr ip{};
+    if (inet_pton(AF_INET, host.c_str(), &ip) != 1)
+        return false;
+
+    const auto port_text = text.substr(colon + 1);
+    uint16_t port = 0;
+    const auto [end, error] = std::from_chars(port_text.data(), port_text.data() + port_text.size(), port);
+    if (error != std::errc() || end != port_text.data() + port_text.size())
+        return false;
+
+    out = {ntohl(ip.s_addr), port};
+    return true;
+}
+
+std::string Address::ToString() const {
+    return std::to_string(ip >> 24) + '.' + std::to_string((ip >> 16) & 0xFF) + '.' + std::to_string((ip >> 8) & 0xFF) +
+           '.' + std::to_string(ip & 0xFF) + ':' + std::to_string(port);
+}
+
+DatagramBatch::DatagramBatch(uint32_t capacity)
+    : buffer_(static_cast<size_t>(capacity) * kMaxDatagramSize), addresses_(capacity), sizes_(capacity) {}
+
+UdpSocket::~UdpSocket() { Close(); }
+
+bool UdpSocket::Open(const Address& bind_address, size_t buffer_bytes) {
+    Close();
+
+    fd_ = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (fd_ < 0) {
+        std::cerr << "[UdpSocket] socket: " << std::strerror(errno) << "\n";
+        return false;
+    }
+
+    const int buffer = static_cast<int>(buffer_bytes);
+    setsockopt(fd_, SOL_SOCKET, SO_SNDBUF, &buffer, sizeof(buffer));
+    setsockopt(fd_, SOL_SOCKET, SO_RCVBUF, &buffer, sizeof(buffer));
+
+    const sockaddr_in address = ToSockaddr(bind_address);
+    if (bind(fd_, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+        std::cerr << "[UdpSocket] bind " << bind_address.ToString() << ": " << std::strerror(errno) << "\n";
+        Close();
+        return false;
+    }
+
+    const int flags = fcntl(fd_, F_GETFL, 0);
+    if (flags < 0 || fcntl(fd_, F_SETFL, flags | O_NONBLOCK) != 0) {
+        std::cerr << "[UdpSocket] O_NONBLOCK: " << std::strerror(errno) << "\n";
+        Close();
+        return false;
+    }
+    return true;
+}
+
+void UdpSocket::Close() {
+    if (fd_ >= 0) {
+        close(fd_);
+        fd_ = -1;
+    }
+}
+
+Address UdpSocket::GetLocalAddress() const {
+    sockaddr_in address{};
+    socklen_t length = sizeof(address);
+    if (fd_ < 0 || getsockname(fd_, reinterpret_cast<sockaddr*>(&address), &length) != 0)
+        return {};
+    return FromSockaddr(address);
+}
+
+void UdpSocket::SetBatchSize(uint32_t batch_size) { batch_size_ = std::clamp(batch_size, 1u, kMaxBatchSize); }
+
+uint32_t UdpSocket::SendBatch(std::span<const OutDatagram> datagrams) {
+    uint32_t sent = 0;
+
+#if defined(__linux__)
+    sockaddr_in addresses[kMaxBatchSize];
+    iovec vectors[kMaxBatchSize];
+    mmsghdr messages[kMaxBatchSize];
+
+    while (sent < datagrams.size()) {
+        const auto count = static_cast<uint32_t>(std::min<size_t>(batch_size_, datagrams.size() - sent));
+        for (uint32_t i = 0; i < count; ++i) {
+            const OutDatagram& datagram = datagrams[sent + i];
+            addresses[i] = ToSockaddr(datagram.to);
+            vectors[i] = {const_cast<std::byte*>(datagram.data), datagram.size};
+            messages[i] = {};
+            messages[i].msg_hdr.msg_name = &addresses[i];
+            messages[i].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+            messages[i].msg_hdr.msg_iov = &vectors[i];
+            messages[i].msg_hdr.msg_iovlen = 1;
+        }
+
+        ++syscalls_;
+        const int result = sendmmsg(fd_, messages, count, 0);
+        if (result <= 0) {
+            if (result < 0 && !WouldBlock(errno)) {
+                std::cerr << "[UdpSocket] sendmmsg: " << std::strerror(errno) << "\n";
+            }
+            break;
+        }
+        sent += static_cast<uint32_t>(result);
+    }
+#else
+    for (; sent < datagrams.size(); ++sent) {
+        const OutDatagram& datagram = datagrams[sent];
+        const sockaddr_in address = ToSockaddr(datagram.to);
+        ++syscalls_;
+        if (sendto(fd_, datagram.data, datagram.size, 0, reinterpret_cast<const sockaddr*>(&address),
+                   sizeof(address)) < 0)
+            break;
+    }
+#endif
+
+    return sent;
+}
+
+uint32_t UdpSocket::ReceiveBatch(DatagramBatch& batch) {
+    batch.count_ = 0;
+    const uint32_t capacity = batch.GetCapacity();
+
+#if defined(__linux__)
+    sockaddr_in addresses[kMaxBatchSize];
+    iovec vectors[kMaxBatchSize];
+    mmsghdr messages[kMaxBatchSize];
+
+    while (batch.count_ < capacity) {
+        const uint32_t first = batch.count_;
+        const uint32_t count = std::min(batch_size_, capacity - first);
+        for (uint32_t i = 0; i < count; ++i) {
+            vectors[i] = {batch.buffer_.data() + (first + i) * DatagramBatch::kMaxDatagramSize,
+                          DatagramBatch::kMaxDatagramSize};
+            messages[i] = {};
+            messages[i].msg_hdr.msg_name = &addresses[i];
+            messages[i].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+            messages[i].msg_hdr.msg_iov = &vectors[i];
+            messages[i].msg_hdr.msg_iovlen = 1;
+        }
+
+        ++syscalls_;
+        const int result = recvmmsg(fd_, messages, count, MSG_DONTWAIT, nullptr);
+        if (result <= 0) {
+            if (result < 0 && !WouldBlock(errno)) {
+                std::cerr << "[UdpSocket] recvmmsg: " << std::strerror(errno) << "\n";
+            }
+            break;
+        }
+
+        for (int i = 0; i < result; ++i) {
+            batch.addresses_[first + i] = FromSockaddr(addresses[i]);
+            batch.sizes_[first + i] = messages[i].msg_len;
+        }
+        batch.count_ += static_cast<uint32_t>(result);
+        if (static_cast<uint32_t>(result) < count)
+            break;
+    }
+#else
+    while (batch.count_ < capacity) {
+        sockaddr_in address{};
+        socklen_t length = sizeof(address);
+        ++syscalls_;
+        const ssize_t result =
+            recvfrom(fd_, batch.buffer_.data() + batch.count_ * DatagramBatch::kMaxDatagramSize,
+                     DatagramBatch::kMaxDatagramSize, 0, reinterpret_cast<sockaddr*>(&address), &length);
+        if (result < 0)
+            break;
+        batch.addresses_[batch.count_] = FromSockaddr(address);
+        batch.sizes_[batch.count_] = static_cast<uint32_t>(result);
+        ++batch.count_;
+    }
+#endif
+
+    return batch.count_;
+}
+
+}  // namespace tryengine::network
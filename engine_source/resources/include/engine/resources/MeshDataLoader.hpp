@@ -2,6 +2,7 @@
 
 #include <fstream>
 
+#include "engine/core/Profiler.hpp"
 #include "engine/core/ResourceManager.hpp"
 #include "engine/resources/Types.hpp"
 
@@ -14,6 +15,8 @@ public:
     explicit MeshDataLoader(core::ResourceManager& resM) : res(&resM) {}
 
     result_type operator()(uint64_t id, const std::string& path) const {
+        TRYENGINE_PROFILE_ZONE("MeshDataLoader");
+
         std::ifstream is(path, std::ios::binary);
         if (!is.is_open())
             return nullptr;
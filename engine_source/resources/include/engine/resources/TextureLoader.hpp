@@ -7,6 +7,7 @@
 #include <memory>
 #include <vector>
 
+#include "engine/core/Profiler.hpp"
 #include "engine/core/ResourceManager.hpp"
 #include "engine/graphics/Types.hpp"
 #include "engine/resources/Types.hpp"
@@ -21,6 +22,8 @@ public:
         : resource_manager_(&res), device_(device) {}
 
     result_type operator()(uint64_t id, const std::string& path) const {
+        TRYENGINE_PROFILE_ZONE("TextureLoader");
+
         // 1. Читаем бинарный артефакт (.tex)
         std::ifstream is(path, std::ios::binary);
         if (!is.is_open()) {
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <vector>
+
+#include "engine/core/SnapshotCodec.hpp"
+#include "server/InterestGrid.hpp"
+
+namespace tryserver {
+
+struct InterestConfig {
+    float radius = 100.0f;
+    // Байт снапшота на клиента за тик (≈ MTU)
+    uint32_t byte_budget = 1200;
+};
+
+// Что видит и что получает один клиент. Видимость — сущности сетки в радиусе. Обновления — по приоритету:
+// у каждой изменившейся видимой сущности копится аккумулятор (ближе — быстрее), в пакет попадают самые
+// "голодные", пока оценка размера влезает в бюджет; остальные остаются у клиента со старыми значениями.
+class ClientInterest {
+public:
+    // Снапшотов в истории клиента: базой может быть только подтвержденный и еще не вытесненный
+    static constexpr uint32_t kHistorySize = 16;
+
+    explicit ClientInterest(const InterestConfig& config) : config_(config) {}
+
+    void SetPosition(const glm::vec3& position) { position_ = position; }
+    [[nodiscard]] const glm::vec3& GetPosition() const { return position_; }
+
+    // Снапшот клиента на тик current.sequence. Результат лежит в истории до вытеснения
+    const tryengine::core::Snapshot& Build(const InterestGrid& grid, const tryengine::core::SnapshotCodec& codec,
+                                           const tryengine::core::Snapshot& current);
+
+    // База для кодирования последнего Build; nullptr — слать полный
+    [[nodiscard]] const tryengine::core::Snapshot* GetBaseline() const;
+
+    // Собранный для клиента снапшот, если он еще в истории
+    [[nodiscard]] const tryengine::core::Snapshot* GetSent(uint32_t sequence) const;
+
+    // Клиент подтвердил получение снапшота
+    void Acknowledge(uint32_t sequence);
+
+    // Фактический размер закодированного пакета — уточняет оценку стоимости сущности
+    void ReportEncoded(size_t bytes);
+
+    [[nodiscard]] uint32_t GetVisibleCount() const { return visible_count_; }
+    [[nodiscard]] uint32_t GetUpdatedCount() const { return updated_count_; }
+    [[nodiscard]] uint32_t GetDeferredCount() const { return deferred_count_; }
+
+private:
+    struct Accumulator {
+        entt::entity entity;
+        float value;
+    };
+
+    InterestConfig config_;
+    glm::vec3 position_{0.0f};
+
+    std::array<tryengine::core::Snapshot, kHistorySize> history_;
+    uint32_t acked_ = 0;
+    // База последнего Build
+    uint32_t baseline_ = 0;
+
+    // По возрастанию сущности; только видимые на прошлом тике
+    std::vector<Accumulator> accumulators_;
+    // Оценка байт на сущность в пакете, скользящее среднее
+    float bytes_per_entity_ = 16.0f;
+
+    // Рабочие буферы — без аллокаций на каждом тике
+    std::vector<InterestCandidate> candidates_;
+    std::vector<Accumulator> next_accumulators_;
+    std::vector<uint32_t> pending_;
+    std::vector<entt::entity> fresh_;
+    std::vector<entt::entity> stale_;
+
+    uint32_t visible_count_ = 0;
+    uint32_t updated_count_ = 0;
+    uint32_t deferred_count_ = 0;
+};
+
+}  // namespace tryserver
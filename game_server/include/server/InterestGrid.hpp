@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstdint>
+#include <entt/entity/registry.hpp>
+#include <glm/glm.hpp>
+#include <unordered_map>
+#include <vector>
+
+namespace tryserver {
+
+struct InterestCandidate {
+    entt::entity entity = entt::null;
+    float distance_sq = 0.0f;
+};
+
+// Разреженная равномерная сетка по мировым позициям (плоскость XZ). Хранятся только непустые ячейки.
+// Обновляется инкрементально: после UpdateTransformSystem перекладываются только сущности с пересчитанной
+// матрицей, и только если они сменили ячейку.
+class InterestGrid {
+public:
+    explicit InterestGrid(float cell_size);
+    ~InterestGrid();
+
+    InterestGrid(const InterestGrid&) = delete;
+    InterestGrid& operator=(const InterestGrid&) = delete;
+
+    // Подписывается на удаление WorldMatrix. Один реестр на сетку
+    void Attach(entt::registry& reg);
+    void Detach();
+
+    // Звать после UpdateTransformSystem
+    void Update(entt::registry& reg);
+
+    // Сущности не дальше radius от center (по XZ). out дополняется, порядок произвольный
+    void Query(const glm::vec3& center, float radius, std::vector<InterestCandidate>& out) const;
+
+    [[nodiscard]] size_t GetCellCount() const { return cells_.size(); }
+    [[nodiscard]] size_t GetEntityCount() const { return entity_count_; }
+    // Сколько сущностей сменило ячейку за последний Update
+    [[nodiscard]] uint32_t GetMovedCount() const { return moved_count_; }
+
+private:
+    struct Slot {
+        entt::entity entity = entt::null;
+        uint64_t cell = 0;
+        // Индекс в векторе ячейки — удаление без поиска (swap с последним)
+        uint32_t index = 0;
+    };
+
+    struct CellEntry {
+        entt::entity entity;
+        glm::vec2 position;
+    };
+
+    [[nodiscard]] uint64_t CellKey(const glm::vec2& position) const;
+    void Insert(entt::entity entity, const glm::vec2& position);
+    void Remove(entt::entity entity);
+    void OnDestroy(entt::registry& reg, entt::entity entity);
+
+    float cell_size_;
+    float inv_cell_size_;
+    entt::registry* registry_ = nullptr;
+
+    std::unordered_map<uint64_t, std::vector<CellEntry>> cells_;
+    // По entt::to_entity
+    std::vector<Slot> slots_;
+    size_t entity_count_ = 0;
+    uint32_t moved_count_ = 0;
+};
+
+}  // namespace tryserver
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <entt/entity/registry.hpp>
+#include <glm/glm.hpp>
+#include <vector>
+
+namespace tryserver {
+
+// Хитбокс для проверки попаданий в прошлом: AABB вокруг мировой позиции (WorldMatrix), без поворота
+struct LagCompensated {
+    glm::vec3 half_extents{0.5f, 1.0f, 0.5f};
+};
+
+struct LagCompensationConfig {
+    // Глубина истории: 32 тика на 60 Гц — пинг до ~500 мс
+    uint32_t history_ticks = 32;
+    // Потолок сущностей в кадре; лишние не пишутся (см. GetOverflowCount)
+    uint32_t max_entities = 4096;
+    float cell_size = 8.0f;
+    // Корзин пространственного индекса на кадр, степень двойки
+    uint32_t buckets = 1024;
+};
+
+struct RewindHit {
+    entt::entity entity = entt::null;
+    float distance = 0.0f;
+};
+
+// История хитбоксов по тикам для проверки попаданий "как видел клиент". Кадр — SoA массивы границ,
+// уже разложенные по корзинам хешированной сетки XZ (сортировка подсчетом по ячейке центра), так что
+// запрос читает подряд только ячейки вдоль луча или объема. Память кадров растет до max_entities и
+// дальше переиспользуется кольцом. Запросы const и потокобезопасны между Record
+class LagCompensation {
+public:
+    explicit LagCompensation(const LagCompensationConfig& config = {});
+
+    // Звать в конце тика, после UpdateTransformSystem. Пишет сущности с WorldMatrix и LagCompensated
+    void Record(const entt::registry& reg, uint64_t tick);
+
+    [[nodiscard]] bool Contains(uint64_t tick) const;
+    // Диапазон доступных тиков; без записей оба 0 и Contains(0) == false
+    [[nodiscard]] uint64_t GetOldestTick() const;
+    [[nodiscard]] uint64_t GetNewestTick() const { return newest_tick_; }
+
+    // Ближайшее попадание луча на тике tick. ignore — обычно сам стрелок
+    bool Raycast(uint64_t tick, const glm::vec3& origin, const glm::vec3& direction, float max_distance,
+                 entt::entity ignore, RewindHit& hit) const;
+
+    // Хитбоксы, пересекающие объем, дописываются в out. false — тика нет в истории
+    bool OverlapBox(uint64_t tick, const glm::vec3& min, const glm::vec3& max, std::vector<entt::entity>& out) const;
+    bool OverlapSphere(uint64_t tick, const glm::vec3& center, float radius, std::vector<entt::entity>& out) const;
+
+    // Выделено под историю (емкость всех кадров)
+    [[nodiscard]] size_t GetMemoryBytes() const;
+    // Сколько сущностей не влезло в max_entities за все время
+    [[nodiscard]] uint64_t GetOverflowCount() const { return overflow_; }
+
+private:
+    struct Frame {
+        uint64_t tick = 0;
+        bool valid = false;
+        uint32_t count = 0;
+        // Наибольшая полуширина по X/Z в кадре — на столько расширяем запрос в ячейках
+        float max_extent = 0.0f;
+
+        std::vector<entt::entity> entities;
+        std::vector<float> min_x, min_y, min_z;
+        std::vector<float> max_x, max_y, max_z;
+        // Сущности корзины b — [bucket_begin[b], bucket_begin[b + 1])
+        std::vector<uint32_t> bucket_begin;
+    };
+
+    [[nodiscard]] const Frame* Find(uint64_t tick) const;
+    [[nodiscard]] uint32_t Bucket(int32_t x, int32_t z) const;
+    [[nodiscard]] int32_t Cell(float value) const;
+    // Корзины прямоугольника ячеек; если он больше всей сетки — все корзины
+    void GatherBuckets(const Frame& frame, float min_x, float min_z, float max_x, float max_z,
+                       std::vector<uint32_t>& buckets) const;
+
+    LagCompensationConfig config_;
+    float inv_cell_size_;
+    std::vector<Frame> frames_;
+    uint64_t newest_tick_ = 0;
+    uint64_t overflow_ = 0;
+
+    // Промежуточный буфер Record: сущность, корзина, центр и полуширины до раскладки по корзинам
+    struct Staged {
+        entt::entity entity;
+        uint32_t bucket;
+        glm::vec3 center;
+        glm::vec3 half_extents;
+    };
+    std::vector<Staged> staged_;
+};
+
+}  // namespace tryserver
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <entt/entity/registry.hpp>
+#include <glm/glm.hpp>
+#include <memory>
+#include <vector>
+
+#include "engine/core/BitStream.hpp"
+#include "engine/core/SnapshotCodec.hpp"
+#include "engine/network/Transport.hpp"
+#include "server/ClientInterest.hpp"
+#include "server/InterestGrid.hpp"
+
+namespace tryengine::core {
+class ComponentRegistry;
+class JobSystem;
+}  // namespace tryengine::core
+
+namespace tryserver {
+
+struct ReplicationConfig {
+    // UDP-порт комнаты на всех интерфейсах; 0 — комната без сети
+    uint16_t port = 0;
+    uint32_t max_clients = 256;
+    float cell_size = 32.0f;
+    // byte_budget ограничивается сверху наибольшим сообщением транспорта
+    InterestConfig interest;
+};
+
+// Клиент -> сервер, Unreliable, раз в тик: последний декодированный снапшот и позиция для видимости.
+// Первый отчет с нового адреса заводит клиента
+struct ClientReport {
+    static constexpr float kPositionStep = 0.01f;
+
+    uint32_t acked = 0;
+    glm::vec3 position{0.0f};
+
+    void Write(tryengine::core::BitWriter& writer) const;
+    // false — отчет битый
+    bool Read(tryengine::core::BitReader& reader);
+};
+
+struct ReplicationStats {
+    uint32_t clients = 0;
+    uint64_t snapshots_sent = 0;
+    // Не ушли: больше наибольшего сообщения транспорта. Клиент получит разницу к старой базе следующим
+    uint64_t snapshots_dropped = 0;
+    uint64_t reports_invalid = 0;
+};
+
+// Отправка мира клиентам комнаты. Каждый тик: сетка видимости обновляется по пересчитанным матрицам,
+// с реестра снимается снапшот, для каждого клиента ClientInterest собирает свой по радиусу и бюджету и
+// кодирует разницей к подтвержденному; пакет уходит по UnreliableSequenced. Потерянный пакет ничего не
+// ломает: следующий кодируется к той же подтвержденной базе. Тикает вместе с комнатой, в одном потоке за раз
+class Replication {
+public:
+    Replication(const ReplicationConfig& config, const tryengine::core::ComponentRegistry& components);
+    ~Replication();
+
+    Replication(const Replication&) = delete;
+    Replication& operator=(const Replication&) = delete;
+
+    // Открывает сокет и подписывает сетку на реестр — до первого UpdateTransformSystem, иначе сетка
+    // не увидит уже расставленные сущности
+    bool Open(entt::registry& reg);
+    void Close();
+
+    // Звать в конце тика, после UpdateTransformSystem. sequence — с 1, растет на 1 за тик.
+    // jobs — сборка и кодирование по клиентам параллельно; отправка всегда с текущего потока
+    void Tick(entt::registry& reg, uint32_t sequence, tryengine::core::JobSystem* jobs);
+
+    [[nodiscard]] const ReplicationStats& GetStats() const { return stats_; }
+    [[nodiscard]] const tryengine::network::TransportStats& GetTransportStats() const {
+        return transport_.GetStats();
+    }
+
+private:
+    struct Client {
+        explicit Client(const InterestConfig& config) : interest(config) {}
+
+        ClientInterest interest;
+        tryengine::core::BitWriter writer;
+    };
+
+    void Receive();
+
+    ReplicationConfig config_;
+    tryengine::core::SnapshotCodec codec_;
+    tryengine::network::Transport transport_;
+    InterestGrid grid_;
+
+    tryengine::core::Snapshot current_;
+    // Индекс — ConnectionId; пусто, пока с соединения не пришел отчет
+    std::vector<std::unique_ptr<Client>> clients_;
+    // Заведенные соединения подряд — для ParallelFor
+    std::vector<tryengine::network::ConnectionId> active_;
+
+    ReplicationStats stats_;
+};
+
+}  // namespace tryserver
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "server/LagCompensation.hpp"
+#include "server/Replication.hpp"
+#include "server/TickStats.hpp"
+
+namespace tryengine::core {
+class JobSystem;
+class Scene;
+class SceneManager;
+class ScriptSystem;
+}  // namespace tryengine::core
+
+namespace tryserver {
+
+using SteadyClock = std::chrono::steady_clock;
+
+struct RoomConfig {
+    std::string name;
+    // Адрес сцены в Addressables; пусто — пустая сцена
+    std::string scene;
+    // Главный скрипт daslang; пусто — без скриптов
+    std::string script;
+
+    uint32_t tick_rate = 60;
+    // 0 — без ограничения
+    uint64_t max_ticks = 0;
+    // Сколько тиков подряд можно догонять после задержки, прежде чем простить отставание
+    uint32_t max_catch_up = 5;
+    // Синтетическая нагрузка: N сущностей (корни по 3 ребенка), корни крутятся каждый тик.
+    // Корни — хитбоксы LagCompensated
+    uint32_t stress_entities = 0;
+
+    LagCompensationConfig lag_compensation;
+    // Отправка снапшотов клиентам; port == 0 — без сети
+    ReplicationConfig replication;
+};
+
+// Оценка памяти комнаты. Компоненты считаются по емкости пулов EnTT (упакованный массив, sparse и
+// данные известных типов); память, на которую компоненты ссылаются (строки, ресурсы), не учитывается
+struct RoomMemory {
+    size_t entities = 0;
+    size_t registry_bytes = 0;
+    size_t script_bytes = 0;
+    size_t lag_history_bytes = 0;
+
+    [[nodiscard]] size_t Total() const { return registry_bytes + script_bytes + lag_history_bytes; }
+};
+
+// Независимый матч: своя сцена (свой entt::registry), свой контекст скриптов и свой фиксированный тик.
+// Advance вызывается из задачи JobSystem; одна комната в каждый момент тикает только в одном потоке.
+class Room {
+public:
+    explicit Room(RoomConfig config);
+    ~Room();
+
+    Room(const Room&) = delete;
+    Room& operator=(const Room&) = delete;
+
+    // jobs — для параллельного пересчета трансформов внутри комнаты; nullptr, если параллелим по комнатам
+    bool Init(const tryengine::core::SceneManager& scene_manager, tryengine::core::JobSystem* jobs);
+
+    // Отрабатывает задолженные тики (не больше max_catch_up), затем прощает оставшееся отставание
+    void Advance();
+
+    [[nodiscard]] const std::string& GetName() const { return config_.name; }
+    [[nodiscard]] SteadyClock::time_point GetNextTick() const { return next_tick_; }
+    [[nodiscard]] bool IsFinished() const { return config_.max_ticks != 0 && tick_index_ >= config_.max_ticks; }
+    [[nodiscard]] double GetBudgetMs() const { return 1000.0 / config_.tick_rate; }
+
+    [[nodiscard]] uint64_t GetTickIndex() const { return tick_index_; }
+    [[nodiscard]] uint64_t GetDroppedTicks() const { return dropped_ticks_; }
+
+    // Окно отчета: времена тиков и суммарное занятое время потока
+    [[nodiscard]] const TickStats& GetWindowStats() const { return window_; }
+    [[nodiscard]] double GetWindowBusyMs() const { return window_busy_ms_; }
+    void ResetWindow();
+
+    // Весь прогон; копится только при max_ticks != 0
+    [[nodiscard]] const TickStats& GetTotalStats() const { return total_; }
+
+    // История хитбоксов для проверки попаданий; тик в ней — GetTickIndex на момент тика
+    [[nodiscard]] const LagCompensation& GetLagCompensation() const { return lag_compensation_; }
+
+    // nullptr — комната без сети
+    [[nodiscard]] const Replication* GetReplication() const { return replication_.get(); }
+
+    // Обходит пулы реестра — звать между тиками
+    [[nodiscard]] RoomMemory MeasureMemory() const;
+
+private:
+    void Tick(float dt);
+
+    RoomConfig config_;
+    std::unique_ptr<tryengine::core::Scene> scene_;
+    std::unique_ptr<tryengine::core::ScriptSystem> script_system_;
+    tryengine::core::JobSystem* jobs_ = nullptr;
+    LagCompensation lag_compensation_;
+    // После scene_: сетка видимости отписывается от реестра сцены в деструкторе
+    std::unique_ptr<Replication> replication_;
+
+    SteadyClock::duration tick_duration_{};
+    SteadyClock::time_point next_tick_{};
+    float dt_ = 0.0f;
+
+    TickStats window_;
+    TickStats total_;
+    double window_busy_ms_ = 0.0;
+
+    uint64_t tick_index_ = 0;
+    uint64_t dropped_ticks_ = 0;
+};
+
+}  // namespace tryserver
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "engine/core/Engine.hpp"
+#include "server/Room.hpp"
+
+namespace tryengine::core {
+class JobSystem;
+class SceneManager;
+}  // namespace tryengine::core
+
+namespace tryserver {
+
+struct ServerConfig {
+    // Адрес сцены в Addressables; пусто — пустая сцена. Одна и та же для всех комнат
+    std::string scene;
+    // Главный скрипт daslang; пусто — без скриптов. У каждой комнаты свой контекст
+    std::string script;
+    uint32_t rooms = 1;
+
+    uint32_t tick_rate = 60;
+    // Тиков на комнату; 0 — пока не остановят сигналом
+    uint64_t max_ticks = 0;
+    // Сколько тиков подряд можно догонять после задержки, прежде чем простить отставание
+    uint32_t max_catch_up = 5;
+    double report_interval = 5.0;
+    // 1 — все на главном потоке, иначе главный + (threads - 1) воркеров
+    uint32_t threads = 1;
+
+    // Синтетическая нагрузка на комнату, см. RoomConfig::stress_entities
+    uint32_t stress_entities = 0;
+    // UDP-порт комнаты 0, комната i слушает port + i; 0 — без сети
+    uint16_t port = 0;
+    // Код возврата 1, если p99 тика по всем комнатам за прогон вышел за бюджет (для CI)
+    bool strict = false;
+};
+
+// Headless-сервер без engine_graphics: много комнат (Room) в одном процессе. Комнаты, у которых подошел
+// тик, раздаются задачами в JobSystem; между тиками главный поток спит до ближайшей комнаты
+class ServerApp {
+public:
+    ServerApp() = default;
+    ServerApp(const ServerApp&) = delete;
+    ServerApp& operator=(const ServerApp&) = delete;
+
+    bool Init(const ServerConfig& config);
+    // Возвращает код выхода процесса
+    int Run();
+    void Shutdown();
+
+    // Можно звать из обработчика сигнала
+    void RequestStop() { running_.store(false, std::memory_order_relaxed); }
+
+private:
+    // Тикает все комнаты, у которых подошло время; false — все комнаты отработали max_ticks
+    bool Step();
+    // wall_ms — длина окна: по ней занятое время переводится в загрузку ядер
+    void ReportWindow(double wall_ms) const;
+    void ReportTotal(const TickStats& total) const;
+
+    ServerConfig config_;
+    std::unique_ptr<tryengine::core::Engine> engine_;
+    std::atomic<bool> running_{false};
+
+    // Резолвятся один раз в Init
+    tryengine::core::SceneManager* scene_manager_ = nullptr;
+    tryengine::core::JobSystem* job_system_ = nullptr;
+
+    std::vector<std::unique_ptr<Room>> rooms_;
+};
+
+}  // namespace tryserver
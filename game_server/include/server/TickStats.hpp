@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace tryserver {
+
+// Времена тиков за окно отчета
+class TickStats {
+public:
+    struct Summary {
+        size_t count = 0;
+        double mean_ms = 0.0;
+        double p50_ms = 0.0;
+        double p90_ms = 0.0;
+        double p99_ms = 0.0;
+        double max_ms = 0.0;
+        // Тики дольше бюджета
+        size_t overruns = 0;
+    };
+
+    explicit TickStats(double budget_ms) : budget_ms_(budget_ms) {}
+
+    void Add(double tick_ms) { samples_.push_back(tick_ms); }
+    // Сводная статистика по нескольким комнатам
+    void Append(const TickStats& other) { samples_.insert(samples_.end(), other.samples_.begin(), other.samples_.end()); }
+    void Reserve(size_t count) { samples_.reserve(count); }
+
+    [[nodiscard]] Summary Summarize() const;
+    void Reset() { samples_.clear(); }
+
+private:
+    double budget_ms_;
+    std::vector<double> samples_;
+};
+
+}  // namespace tryserver
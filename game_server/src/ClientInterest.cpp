@@ -0,0 +1,131 @@
+#include "server/ClientInterest.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "engine/core/Profiler.hpp"
+
+namespace tryserver {
+
+using namespace tryengine;
+
+namespace {
+
+// Приоритет на краю радиуса относительно сущности вплотную к клиенту
+constexpr float kEdgePriority = 0.25f;
+// Заголовок пакета и списки удалений — грубо, чтобы бюджет не превышался систематически
+constexpr uint32_t kPacketOverhead = 8;
+
+}  // namespace
+
+const core::Snapshot* ClientInterest::GetSent(uint32_t sequence) const {
+    if (sequence == 0)
+        return nullptr;
+
+    const core::Snapshot& snapshot = history_[sequence % kHistorySize];
+    return snapshot.sequence == sequence ? &snapshot : nullptr;
+}
+
+const core::Snapshot* ClientInterest::GetBaseline() const { return GetSent(baseline_); }
+
+void ClientInterest::Acknowledge(uint32_t sequence) {
+    // Подтверждения могут прийти не по порядку
+    if (sequence > acked_ && GetSent(sequence)) {
+        acked_ = sequence;
+    }
+}
+
+const core::Snapshot& ClientInterest::Build(const InterestGrid& grid, const core::SnapshotCodec& codec,
+                                            const core::Snapshot& current) {
+    TRYENGINE_PROFILE_ZONE("ClientInterest::Build");
+
+    // Слот нового снапшота совпадает со слотом базы, если она старше истории — тогда шлем полный
+    baseline_ = current.sequence - acked_ < kHistorySize ? acked_ : 0;
+    const core::Snapshot* baseline = GetSent(baseline_);
+    if (!baseline) {
+        baseline_ = 0;
+    }
+
+    candidates_.clear();
+    grid.Query(position_, config_.radius, candidates_);
+
+    // В сетке все сущности с трансформом, реплицируются только попавшие в снапшот
+    std::erase_if(candidates_, [&](const InterestCandidate& candidate) {
+        return !std::binary_search(current.entities.begin(), current.entities.end(), candidate.entity);
+    });
+    std::sort(candidates_.begin(), candidates_.end(),
+              [](const InterestCandidate& a, const InterestCandidate& b) { return a.entity < b.entity; });
+
+    next_accumulators_.clear();
+    pending_.clear();
+    fresh_.clear();
+    stale_.clear();
+
+    const float inv_radius = 1.0f / config_.radius;
+    size_t previous = 0;
+    for (const InterestCandidate& candidate : candidates_) {
+        while (previous < accumulators_.size() && accumulators_[previous].entity < candidate.entity) {
+            ++previous;
+        }
+        float accumulator = previous < accumulators_.size() && accumulators_[previous].entity == candidate.entity
+                                ? accumulators_[previous].value
+                                : 0.0f;
+
+        const bool known =
+            baseline && std::binary_search(baseline->entities.begin(), baseline->entities.end(), candidate.entity);
+        if (known && !codec.EntityDiffers(current, *baseline, candidate.entity)) {
+            // У клиента уже актуальное значение
+            stale_.push_back(candidate.entity);
+            next_accumulators_.push_back({candidate.entity, 0.0f});
+            continue;
+        }
+
+        const float distance = std::sqrt(candidate.distance_sq) * inv_radius;
+        accumulator += 1.0f - (1.0f - kEdgePriority) * distance;
+        pending_.push_back(static_cast<uint32_t>(next_accumulators_.size()));
+        next_accumulators_.push_back({candidate.entity, accumulator});
+    }
+
+    std::sort(pending_.begin(), pending_.end(),
+              [&](uint32_t a, uint32_t b) { return next_accumulators_[a].value > next_accumulators_[b].value; });
+
+    updated_count_ = 0;
+    deferred_count_ = 0;
+    float spent = kPacketOverhead;
+    for (const uint32_t index : pending_) {
+        Accumulator& entry = next_accumulators_[index];
+        if (spent + bytes_per_entity_ <= static_cast<float>(config_.byte_budget)) {
+            spent += bytes_per_entity_;
+            entry.value = 0.0f;
+            fresh_.push_back(entry.entity);
+            ++updated_count_;
+            continue;
+        }
+
+        // Не влезла: известная клиенту остается со старым значением, новая подождет следующего тика
+        ++deferred_count_;
+        if (baseline && std::binary_search(baseline->entities.begin(), baseline->entities.end(), entry.entity)) {
+            stale_.push_back(entry.entity);
+        }
+    }
+
+    std::sort(fresh_.begin(), fresh_.end());
+    std::sort(stale_.begin(), stale_.end());
+    accumulators_.swap(next_accumulators_);
+    visible_count_ = static_cast<uint32_t>(fresh_.size() + stale_.size());
+
+    core::Snapshot& out = history_[current.sequence % kHistorySize];
+    codec.Compose(current, baseline, fresh_, stale_, current.sequence, out);
+    return out;
+}
+
+void ClientInterest::ReportEncoded(size_t bytes) {
+    if (updated_count_ == 0)
+        return;
+
+    const float sample = static_cast<float>(bytes > kPacketOverhead ? bytes - kPacketOverhead : 0) /
+                         static_cast<float>(updated_count_);
+    bytes_per_entity_ = std::max(2.0f, bytes_per_entity_ * 0.9f + sample * 0.1f);
+}
+
+}  // namespace tryserver
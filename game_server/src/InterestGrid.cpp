@@ -0,0 +1,146 @@
+#include "server/InterestGrid.hpp"
+
+#include <cmath>
+
+#include "engine/core/BaseSystem.hpp"
+#include "engine/core/Components.hpp"
+#include "engine/core/Profiler.hpp"
+#include "engine/core/TransformHierarchy.hpp"
+
+namespace tryserver {
+
+using namespace tryengine;
+
+namespace {
+
+uint64_t PackCell(int32_t x, int32_t z) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(z);
+}
+
+}  // namespace
+
+InterestGrid::InterestGrid(float cell_size) : cell_size_(cell_size), inv_cell_size_(1.0f / cell_size) {}
+
+InterestGrid::~InterestGrid() { Detach(); }
+
+void InterestGrid::Attach(entt::registry& reg) {
+    Detach();
+    registry_ = &reg;
+    reg.on_destroy<WorldMatrix>().connect<&InterestGrid::OnDestroy>(*this);
+}
+
+void InterestGrid::Detach() {
+    if (registry_) {
+        registry_->on_destroy<WorldMatrix>().disconnect<&InterestGrid::OnDestroy>(*this);
+        registry_ = nullptr;
+    }
+}
+
+uint64_t InterestGrid::CellKey(const glm::vec2& position) const {
+    return PackCell(static_cast<int32_t>(std::floor(position.x * inv_cell_size_)),
+                    static_cast<int32_t>(std::floor(position.y * inv_cell_size_)));
+}
+
+void InterestGrid::Insert(entt::entity entity, const glm::vec2& position) {
+    const auto slot_index = static_cast<size_t>(entt::to_entity(entity));
+    if (slot_index >= slots_.size()) {
+        slots_.resize(slot_index + 1);
+    }
+
+    const uint64_t key = CellKey(position);
+    auto& cell = cells_[key];
+    Slot& slot = slots_[slot_index];
+    slot.entity = entity;
+    slot.cell = key;
+    slot.index = static_cast<uint32_t>(cell.size());
+    cell.push_back({entity, position});
+    ++entity_count_;
+}
+
+void InterestGrid::Remove(entt::entity entity) {
+    const auto slot_index = static_cast<size_t>(entt::to_entity(entity));
+    if (slot_index >= slots_.size() || slots_[slot_index].entity != entity)
+        return;
+
+    Slot& slot = slots_[slot_index];
+    const auto it = cells_.find(slot.cell);
+    auto& cell = it->second;
+
+    // Последний элемент ячейки встает на место удаляемого
+    cell[slot.index] = cell.back();
+    slots_[static_cast<size_t>(entt::to_entity(cell[slot.index].entity))].index = slot.index;
+    cell.pop_back();
+    if (cell.empty()) {
+        cells_.erase(it);
+    }
+
+    slot.entity = entt::null;
+    --entity_count_;
+}
+
+void InterestGrid::OnDestroy(entt::registry&, entt::entity entity) { Remove(entity); }
+
+void InterestGrid::Update(entt::registry& reg) {
+    TRYENGINE_PROFILE_ZONE("InterestGrid::Update");
+
+    moved_count_ = 0;
+    if (core::GetUpdatedTransformCount(reg) == 0)
+        return;
+
+    // Флаги иерархии после UpdateTransformSystem — ровно те сущности, чьи матрицы пересчитаны
+    auto& hierarchy = core::AcquireTransformHierarchy(reg);
+    const auto entities = hierarchy.GetEntities();
+    const auto dirty = hierarchy.GetDirtyFlags();
+    const auto& world_matrices = reg.storage<WorldMatrix>();
+
+    for (size_t i = 0; i < entities.size(); ++i) {
+        if (!dirty[i])
+            continue;
+
+        const entt::entity entity = entities[i];
+        const glm::vec4& translation = world_matrices.get(entity).value[3];
+        const glm::vec2 position(translation.x, translation.z);
+        const uint64_t key = CellKey(position);
+
+        const auto slot_index = static_cast<size_t>(entt::to_entity(entity));
+        if (slot_index < slots_.size() && slots_[slot_index].entity == entity) {
+            Slot& slot = slots_[slot_index];
+            if (slot.cell == key) {
+                cells_[key][slot.index].position = position;
+                continue;
+            }
+            Remove(entity);
+        }
+
+        Insert(entity, position);
+        ++moved_count_;
+    }
+}
+
+void InterestGrid::Query(const glm::vec3& center, float radius, std::vector<InterestCandidate>& out) const {
+    const glm::vec2 origin(center.x, center.z);
+    const float radius_sq = radius * radius;
+
+    const auto min_x = static_cast<int32_t>(std::floor((origin.x - radius) * inv_cell_size_));
+    const auto max_x = static_cast<int32_t>(std::floor((origin.x + radius) * inv_cell_size_));
+    const auto min_z = static_cast<int32_t>(std::floor((origin.y - radius) * inv_cell_size_));
+    const auto max_z = static_cast<int32_t>(std::floor((origin.y + radius) * inv_cell_size_));
+
+    for (int32_t x = min_x; x <= max_x; ++x) {
+        for (int32_t z = min_z; z <= max_z; ++z) {
+            const auto it = cells_.find(PackCell(x, z));
+            if (it == cells_.end())
+                continue;
+
+            for (const CellEntry& entry : it->second) {
+                const glm::vec2 offset = entry.position - origin;
+                const float distance_sq = glm::dot(offset, offset);
+                if (distance_sq <= radius_sq) {
+                    out.push_back({entry.entity, distance_sq});
+                }
+            }
+        }
+    }
+}
+
+}  // namespace tryserver
@@ -0,0 +1,299 @@
+#include "server/LagCompensation.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+
+#include "engine/core/Components.hpp"
+#include "engine/core/Profiler.hpp"
+
+namespace tryserver {
+
+using namespace tryengine;
+
+namespace {
+
+// Буфер корзин запроса; свой у каждого потока, запросы идут параллельно
+thread_local std::vector<uint32_t> tls_buckets;
+
+bool IntersectRay(const glm::vec3& origin, const glm::vec3& inv_direction, const glm::vec3& min, const glm::vec3& max,
+                  float max_distance, float& distance) {
+    float t_near = 0.0f;
+    float t_far = max_distance;
+    for (int axis = 0; axis < 3; ++axis) {
+        float t0 = (min[axis] - origin[axis]) * inv_direction[axis];
+        float t1 = (max[axis] - origin[axis]) * inv_direction[axis];
+        if (inv_direction[axis] < 0.0f) {
+            std::swap(t0, t1);
+        }
+        // NaN (луч параллелен грани и лежит на ней) не сужает отрезок
+        t_near = std::max(t_near, t0);
+        t_far = std::min(t_far, t1);
+        if (t_near > t_far)
+            return false;
+    }
+    distance = t_near;
+    return true;
+}
+
+}  // namespace
+
+LagCompensation::LagCompensation(const LagCompensationConfig& config)
+    : config_(config), inv_cell_size_(1.0f / config.cell_size), frames_(std::max(config.history_ticks, 1u)) {
+    // Маска корзины — степень двойки
+    config_.buckets = std::bit_ceil(std::max(config_.buckets, 1u));
+}
+
+int32_t LagCompensation::Cell(float value) const { return static_cast<int32_t>(std::floor(value * inv_cell_size_)); }
+
+uint32_t LagCompensation::Bucket(int32_t x, int32_t z) const {
+    return (static_cast<uint32_t>(x) * 73856093u ^ static_cast<uint32_t>(z) * 19349663u) & (config_.buckets - 1);
+}
+
+void LagCompensation::Record(const entt::registry& reg, uint64_t tick) {
+    TRYENGINE_PROFILE_ZONE("LagCompensation::Record");
+
+    staged_.clear();
+    float max_extent = 0.0f;
+
+    const auto view = reg.view<const WorldMatrix, const LagCompensated>();
+    for (const auto entity : view) {
+        if (staged_.size() >= config_.max_entities) {
+            ++overflow_;
+            continue;
+        }
+
+        const auto& [world, box] = view.get(entity);
+        const glm::vec3 center(world.value[3]);
+        staged_.push_back({entity, Bucket(Cell(center.x), Cell(center.z)), center, box.half_extents});
+        max_extent = std::max({max_extent, box.half_extents.x, box.half_extents.z});
+    }
+
+    Frame& frame = frames_[tick % frames_.size()];
+    frame.tick = tick;
+    frame.valid = true;
+    frame.count = static_cast<uint32_t>(staged_.size());
+    frame.max_extent = max_extent;
+
+    frame.entities.resize(frame.count);
+    frame.min_x.resize(frame.count);
+    frame.min_y.resize(frame.count);
+    frame.min_z.resize(frame.count);
+    frame.max_x.resize(frame.count);
+    frame.max_y.resize(frame.count);
+    frame.max_z.resize(frame.count);
+
+    // Сортировка подсчетом: сначала размеры корзин, потом начала, потом раскладка
+    auto& begin = frame.bucket_begin;
+    begin.assign(config_.buckets + 1, 0);
+    for (const auto& staged : staged_) {
+        ++begin[staged.bucket + 1];
+    }
+    for (uint32_t b = 1; b <= config_.buckets; ++b) {
+        begin[b] += begin[b - 1];
+    }
+
+    for (const auto& staged : staged_) {
+        const uint32_t i = begin[staged.bucket]++;
+        const glm::vec3 min = staged.center - staged.half_extents;
+        const glm::vec3 max = staged.center + staged.half_extents;
+        frame.entities[i] = staged.entity;
+        frame.min_x[i] = min.x;
+        frame.min_y[i] = min.y;
+        frame.min_z[i] = min.z;
+        frame.max_x[i] = max.x;
+        frame.max_y[i] = max.y;
+        frame.max_z[i] = max.z;
+    }
+
+    // После раскладки begin[b] указывает на конец корзины b — сдвигаем обратно на начало
+    for (uint32_t b = config_.buckets - 1; b > 0; --b) {
+        begin[b] = begin[b - 1];
+    }
+    begin[0] = 0;
+
+    newest_tick_ = std::max(newest_tick_, tick);
+}
+
+const LagCompensation::Frame* LagCompensation::Find(uint64_t tick) const {
+    const Frame& frame = frames_[tick % frames_.size()];
+    return frame.valid && frame.tick == tick ? &frame : nullptr;
+}
+
+bool LagCompensation::Contains(uint64_t tick) const { return Find(tick) != nullptr; }
+
+uint64_t LagCompensation::GetOldestTick() const {
+    const uint64_t depth = frames_.size() - 1;
+    uint64_t tick = newest_tick_ > depth ? newest_tick_ - depth : 0;
+    while (tick < newest_tick_ && !Contains(tick)) {
+        ++tick;
+    }
+    return tick;
+}
+
+void LagCompensation::GatherBuckets(const Frame& frame, float min_x, float min_z, float max_x, float max_z,
+                                    std::vector<uint32_t>& buckets) const {
+    buckets.clear();
+
+    // Сущность лежит в ячейке центра, а хитбокс может выступать в соседние — расширяем на max_extent
+    const int32_t x0 = Cell(min_x - frame.max_extent);
+    const int32_t z0 = Cell(min_z - frame.max_extent);
+    const int32_t x1 = Cell(max_x + frame.max_extent);
+    const int32_t z1 = Cell(max_z + frame.max_extent);
+
+    const auto cells = (static_cast<int64_t>(x1) - x0 + 1) * (static_cast<int64_t>(z1) - z0 + 1);
+    if (cells >= static_cast<int64_t>(config_.buckets)) {
+        for (uint32_t b = 0; b < config_.buckets; ++b) {
+            buckets.push_back(b);
+        }
+        return;
+    }
+
+    for (int32_t x = x0; x <= x1; ++x) {
+        for (int32_t z = z0; z <= z1; ++z) {
+            buckets.push_back(Bucket(x, z));
+        }
+    }
+    std::sort(buckets.begin(), buckets.end());
+    buckets.erase(std::unique(buckets.begin(), buckets.end()), buckets.end());
+}
+
+bool LagCompensation::Raycast(uint64_t tick, const glm::vec3& origin, const glm::vec3& direction, float max_distance,
+                              entt::entity ignore, RewindHit& hit) const {
+    const Frame* frame = Find(tick);
+    const float length = glm::length(direction);
+    if (!frame || frame->count == 0 || length <= 0.0f || max_distance <= 0.0f)
+        return false;
+
+    const glm::vec3 dir = direction / length;
+    const glm::vec3 end = origin + dir * max_distance;
+    auto& buckets = tls_buckets;
+    buckets.clear();
+
+    // Ячейки вдоль луча по XZ (DDA), каждая с соседями на радиус выступа хитбоксов
+    const auto reach = static_cast<int32_t>(std::ceil(frame->max_extent * inv_cell_size_));
+    int32_t x = Cell(origin.x);
+    int32_t z = Cell(origin.z);
+    const int32_t end_x = Cell(end.x);
+    const int32_t end_z = Cell(end.z);
+    const int64_t steps = std::abs(static_cast<int64_t>(end_x) - x) + std::abs(static_cast<int64_t>(end_z) - z) + 1;
+
+    if (steps * (2 * reach + 1) * (2 * reach + 1) >= static_cast<int64_t>(config_.buckets)) {
+        GatherBuckets(*frame, std::min(origin.x, end.x), std::min(origin.z, end.z), std::max(origin.x, end.x),
+                      std::max(origin.z, end.z), buckets);
+    } else {
+        constexpr float kInfinity = std::numeric_limits<float>::infinity();
+        const float cell = config_.cell_size;
+        const int32_t step_x = dir.x > 0.0f ? 1 : -1;
+        const int32_t step_z = dir.z > 0.0f ? 1 : -1;
+        // Расстояние по лучу до первой границы ячейки по каждой оси
+        float t_max_x = dir.x != 0.0f ? (static_cast<float>(x + (dir.x > 0.0f)) * cell - origin.x) / dir.x : kInfinity;
+        float t_max_z = dir.z != 0.0f ? (static_cast<float>(z + (dir.z > 0.0f)) * cell - origin.z) / dir.z : kInfinity;
+        const float t_delta_x = dir.x != 0.0f ? cell / std::abs(dir.x) : kInfinity;
+        const float t_delta_z = dir.z != 0.0f ? cell / std::abs(dir.z) : kInfinity;
+
+        const auto add_cell = [&](int32_t cx, int32_t cz) {
+            for (int32_t dx = -reach; dx <= reach; ++dx) {
+                for (int32_t dz = -reach; dz <= reach; ++dz) {
+                    buckets.push_back(Bucket(cx + dx, cz + dz));
+                }
+            }
+        };
+
+        for (int64_t i = 0; i < steps && (x != end_x || z != end_z); ++i) {
+            add_cell(x, z);
+            if (t_max_x < t_max_z) {
+                x += step_x;
+                t_max_x += t_delta_x;
+            } else {
+                z += step_z;
+                t_max_z += t_delta_z;
+            }
+        }
+        // Конечная ячейка — отдельно: ошибка округления DDA не должна ее потерять
+        add_cell(end_x, end_z);
+
+        std::sort(buckets.begin(), buckets.end());
+        buckets.erase(std::unique(buckets.begin(), buckets.end()), buckets.end());
+    }
+
+    const glm::vec3 inv_direction = 1.0f / dir;
+    float best = max_distance;
+    hit.entity = entt::null;
+
+    for (const uint32_t b : buckets) {
+        for (uint32_t i = frame->bucket_begin[b]; i < frame->bucket_begin[b + 1]; ++i) {
+            if (frame->entities[i] == ignore)
+                continue;
+
+            float distance = 0.0f;
+            const glm::vec3 min(frame->min_x[i], frame->min_y[i], frame->min_z[i]);
+            const glm::vec3 max(frame->max_x[i], frame->max_y[i], frame->max_z[i]);
+            if (IntersectRay(origin, inv_direction, min, max, best, distance) &&
+                (hit.entity == entt::null || distance < best)) {
+                best = distance;
+                hit.entity = frame->entities[i];
+                hit.distance = distance;
+            }
+        }
+    }
+    return hit.entity != entt::null;
+}
+
+bool LagCompensation::OverlapBox(uint64_t tick, const glm::vec3& min, const glm::vec3& max,
+                                 std::vector<entt::entity>& out) const {
+    const Frame* frame = Find(tick);
+    if (!frame)
+        return false;
+
+    auto& buckets = tls_buckets;
+    GatherBuckets(*frame, min.x, min.z, max.x, max.z, buckets);
+
+    for (const uint32_t b : buckets) {
+        for (uint32_t i = frame->bucket_begin[b]; i < frame->bucket_begin[b + 1]; ++i) {
+            if (frame->min_x[i] <= max.x && frame->max_x[i] >= min.x && frame->min_y[i] <= max.y &&
+                frame->max_y[i] >= min.y && frame->min_z[i] <= max.z && frame->max_z[i] >= min.z) {
+                out.push_back(frame->entities[i]);
+            }
+        }
+    }
+    return true;
+}
+
+bool LagCompensation::OverlapSphere(uint64_t tick, const glm::vec3& center, float radius,
+                                    std::vector<entt::entity>& out) const {
+    const Frame* frame = Find(tick);
+    if (!frame)
+        return false;
+
+    auto& buckets = tls_buckets;
+    GatherBuckets(*frame, center.x - radius, center.z - radius, center.x + radius, center.z + radius, buckets);
+
+    const float radius_sq = radius * radius;
+    for (const uint32_t b : buckets) {
+        for (uint32_t i = frame->bucket_begin[b]; i < frame->bucket_begin[b + 1]; ++i) {
+            // Ближайшая к центру точка хитбокса
+            const float dx = center.x - std::clamp(center.x, frame->min_x[i], frame->max_x[i]);
+            const float dy = center.y - std::clamp(center.y, frame->min_y[i], frame->max_y[i]);
+            const float dz = center.z - std::clamp(center.z, frame->min_z[i], frame->max_z[i]);
+            if (dx * dx + dy * dy + dz * dz <= radius_sq) {
+                out.push_back(frame->entities[i]);
+            }
+        }
+    }
+    return true;
+}
+
+size_t LagCompensation::GetMemoryBytes() const {
+    size_t bytes = staged_.capacity() * sizeof(Staged);
+    for (const auto& frame : frames_) {
+        bytes += frame.entities.capacity() * sizeof(entt::entity);
+        bytes += (frame.min_x.capacity() + frame.min_y.capacity() + frame.min_z.capacity()) * sizeof(float);
+        bytes += (frame.max_x.capacity() + frame.max_y.capacity() + frame.max_z.capacity()) * sizeof(float);
+        bytes += frame.bucket_begin.capacity() * sizeof(uint32_t);
+    }
+    return bytes;
+}
+
+}  // namespace tryserver
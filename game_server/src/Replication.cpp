@@ -0,0 +1,138 @@
+#include "server/Replication.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <span>
+
+#include "engine/core/JobSystem.hpp"
+#include "engine/core/Profiler.hpp"
+
+namespace tryserver {
+
+using namespace tryengine;
+
+namespace {
+
+// Сборка снапшота клиента — десятки микросекунд, мельче дробить на задачи нет смысла
+constexpr size_t kClientsPerJob = 16;
+
+network::TransportConfig MakeTransportConfig(const ReplicationConfig& config) {
+    network::TransportConfig transport;
+    transport.bind = network::Address{0, config.port};
+    transport.max_connections = config.max_clients;
+    return transport;
+}
+
+}  // namespace
+
+void ClientReport::Write(core::BitWriter& writer) const {
+    writer.WriteVarUint(acked);
+    writer.WriteQuantized(position.x, kPositionStep);
+    writer.WriteQuantized(position.y, kPositionStep);
+    writer.WriteQuantized(position.z, kPositionStep);
+}
+
+bool ClientReport::Read(core::BitReader& reader) {
+    const uint64_t sequence = reader.ReadVarUint();
+    position.x = reader.ReadQuantized(kPositionStep);
+    position.y = reader.ReadQuantized(kPositionStep);
+    position.z = reader.ReadQuantized(kPositionStep);
+    acked = static_cast<uint32_t>(sequence);
+    return !reader.IsOverflowed() && sequence <= std::numeric_limits<uint32_t>::max();
+}
+
+Replication::Replication(const ReplicationConfig& config, const core::ComponentRegistry& components)
+    : config_(config), codec_(components), transport_(MakeTransportConfig(config)), grid_(config.cell_size) {
+    // Снапшот уходит одним сообщением. Размер пакета ClientInterest только оценивает — запас 1/8
+    const auto max_message = static_cast<uint32_t>(transport_.GetMaxMessageSize());
+    config_.interest.byte_budget = std::min(config_.interest.byte_budget, max_message - max_message / 8);
+}
+
+Replication::~Replication() = default;
+
+bool Replication::Open(entt::registry& reg) {
+    if (!transport_.Open())
+        return false;
+
+    grid_.Attach(reg);
+    return true;
+}
+
+void Replication::Close() {
+    grid_.Detach();
+    transport_.Close();
+    clients_.clear();
+    active_.clear();
+    stats_.clients = 0;
+}
+
+void Replication::Tick(entt::registry& reg, uint32_t sequence, core::JobSystem* jobs) {
+    TRYENGINE_PROFILE_ZONE("Replication::Tick");
+
+    grid_.Update(reg);
+    codec_.Capture(reg, sequence, current_);
+
+    const auto build = [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            Client& client = *clients_[active_[i]];
+            const core::Snapshot& built = client.interest.Build(grid_, codec_, current_);
+            client.writer.Clear();
+            codec_.Encode(built, client.interest.GetBaseline(), client.writer);
+        }
+    };
+    if (jobs && active_.size() > kClientsPerJob) {
+        jobs->ParallelFor(active_.size(), kClientsPerJob, build);
+    } else {
+        build(0, active_.size());
+    }
+
+    // Транспорт однопоточный: отправка подряд
+    for (const network::ConnectionId id : active_) {
+        Client& client = *clients_[id];
+        const auto packet = client.writer.Finish();
+        client.interest.ReportEncoded(packet.size());
+
+        if (transport_.Send(id, network::Channel::UnreliableSequenced, std::as_bytes(packet))) {
+            ++stats_.snapshots_sent;
+        } else {
+            ++stats_.snapshots_dropped;
+        }
+    }
+
+    transport_.Update();
+    Receive();
+}
+
+void Replication::Receive() {
+    for (const network::ConnectionId id : transport_.GetTimedOut()) {
+        if (id < clients_.size() && clients_[id]) {
+            clients_[id].reset();
+            std::erase(active_, id);
+        }
+    }
+
+    for (const network::ReceivedMessage& message : transport_.GetReceived()) {
+        const auto payload = transport_.GetPayload(message);
+        core::BitReader reader({reinterpret_cast<const uint8_t*>(payload.data()), payload.size()});
+        ClientReport report;
+        if (!report.Read(reader)) {
+            ++stats_.reports_invalid;
+            continue;
+        }
+
+        if (message.connection >= clients_.size()) {
+            clients_.resize(message.connection + 1);
+        }
+        auto& client = clients_[message.connection];
+        if (!client) {
+            client = std::make_unique<Client>(config_.interest);
+            active_.push_back(message.connection);
+        }
+        client->interest.SetPosition(report.position);
+        client->interest.Acknowledge(report.acked);
+    }
+
+    stats_.clients = static_cast<uint32_t>(active_.size());
+}
+
+}  // namespace tryserver
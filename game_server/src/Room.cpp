@@ -0,0 +1,230 @@
+#include "server/Room.hpp"
+
+#include <iostream>
+#include <type_traits>
+#include <unordered_map>
+
+#include "engine/core/BaseSystem.hpp"
+#include "engine/core/ComponentRegistry.hpp"
+#include "engine/core/Components.hpp"
+#include "engine/core/Profiler.hpp"
+#include "engine/core/SceneGraph.hpp"
+#include "engine/core/SceneManager.hpp"
+#include "engine/core/ScriptSystem.hpp"
+
+namespace tryserver {
+
+using namespace tryengine;
+
+namespace {
+
+// Корень и три ребенка — двухуровневая иерархия, как у персонажа с оружием и эффектами
+constexpr uint32_t kStressChildren = 3;
+
+struct StressRoot {};
+
+void SpawnStressEntities(entt::registry& reg, uint32_t count) {
+    auto& graph = core::AcquireSceneGraph(reg);
+
+    for (uint32_t spawned = 0, index = 0; spawned < count; ++index) {
+        const auto root = reg.create();
+        const glm::vec3 position(static_cast<float>(index % 1000) * 2.0f, 0.0f, static_cast<float>(index / 1000) * 2.0f);
+        reg.emplace<Transform>(root, Transform{position, glm::quat(1.0f, 0.0f, 0.0f, 0.0f), glm::vec3(1.0f)});
+        reg.emplace<Relationship>(root);
+        reg.emplace<StressRoot>(root);
+        reg.emplace<LagCompensated>(root);
+        ++spawned;
+
+        for (uint32_t child_index = 0; child_index < kStressChildren && spawned < count; ++child_index, ++spawned) {
+            const auto child = reg.create();
+            reg.emplace<Transform>(child, Transform{glm::vec3(static_cast<float>(child_index + 1), 0.0f, 0.0f),
+                                                    glm::quat(1.0f, 0.0f, 0.0f, 0.0f), glm::vec3(0.5f)});
+            reg.emplace<Relationship>(child);
+            graph.SetParent(reg, child, root);
+        }
+    }
+}
+
+// Все корни поворачиваются — каждый тик пересчитываются все мировые матрицы
+void UpdateStressEntities(entt::registry& reg, float dt) {
+    const glm::quat spin = glm::angleAxis(dt, glm::vec3(0.0f, 1.0f, 0.0f));
+    for (const auto entity : reg.view<StressRoot>()) {
+        reg.patch<Transform>(entity, [&](Transform& transform) { transform.rotation = spin * transform.rotation; });
+    }
+}
+
+template <typename T>
+void AddPayloadSize(std::unordered_map<entt::id_type, size_t>& sizes) {
+    // Пустые типы EnTT хранит без данных
+    sizes.emplace(entt::type_hash<T>::value(), std::is_empty_v<T> ? 0 : sizeof(T));
+}
+
+// Размер элемента для пулов, тип которых известен серверу. Прочие пулы учитываются без данных
+size_t GetPayloadSize(entt::id_type type) {
+    static const auto sizes = [] {
+        std::unordered_map<entt::id_type, size_t> result;
+        AddPayloadSize<Tag>(result);
+        AddPayloadSize<Transform>(result);
+        AddPayloadSize<WorldMatrix>(result);
+        AddPayloadSize<TransformDirty>(result);
+        AddPayloadSize<Relationship>(result);
+        AddPayloadSize<Camera>(result);
+        AddPayloadSize<MainCameraTag>(result);
+        AddPayloadSize<MeshFilter>(result);
+        AddPayloadSize<MeshRenderer>(result);
+        AddPayloadSize<LightComponent>(result);
+        AddPayloadSize<StressRoot>(result);
+        AddPayloadSize<LagCompensated>(result);
+        return result;
+    }();
+
+    const auto it = sizes.find(type);
+    return it != sizes.end() ? it->second : 0;
+}
+
+}  // namespace
+
+Room::Room(RoomConfig config)
+    : config_(std::move(config)),
+      lag_compensation_(config_.lag_compensation),
+      window_(1000.0 / config_.tick_rate),
+      total_(1000.0 / config_.tick_rate) {
+    tick_duration_ =
+        std::chrono::duration_cast<SteadyClock::duration>(std::chrono::duration<double>(1.0 / config_.tick_rate));
+    dt_ = 1.0f / static_cast<float>(config_.tick_rate);
+}
+
+Room::~Room() = default;
+
+bool Room::Init(const core::SceneManager& scene_manager, core::JobSystem* jobs) {
+    jobs_ = jobs;
+
+    if (config_.scene.empty()) {
+        scene_ = std::make_unique<core::Scene>(config_.name);
+    } else {
+        core::SceneLoadStats stats;
+        scene_ = scene_manager.InstantiateScene(config_.scene, &stats);
+        if (!scene_) {
+            std::cerr << "[Server] " << config_.name << ": failed to load scene " << config_.scene << std::endl;
+            return false;
+        }
+        if (!stats.pools.empty()) {
+            std::cout << "[Server] " << config_.name << ": scene loaded in " << stats.total_ms << " ms:";
+            for (const auto& pool : stats.pools) {
+                std::cout << ' ' << pool.name << ' ' << pool.count << " (" << pool.ms << " ms)";
+            }
+            std::cout << std::endl;
+        }
+        scene_->Rename(config_.name);
+    }
+
+    if (config_.stress_entities > 0) {
+        SpawnStressEntities(scene_->GetRegistry(), config_.stress_entities);
+    }
+
+    if (config_.replication.port != 0) {
+        replication_ = std::make_unique<Replication>(config_.replication, scene_manager.GetComponentRegistry());
+        if (!replication_->Open(scene_->GetRegistry())) {
+            std::cerr << "[Server] " << config_.name << ": failed to open UDP port " << config_.replication.port
+                      << std::endl;
+            return false;
+        }
+    }
+
+    if (!config_.script.empty()) {
+        script_system_ = std::make_unique<core::ScriptSystem>();
+        if (!script_system_->LoadMainScript(config_.script)) {
+            std::cerr << "[Server] " << config_.name << ": failed to compile " << config_.script << std::endl;
+            return false;
+        }
+        script_system_->InvokeStart();
+    }
+
+    if (config_.max_ticks != 0) {
+        total_.Reserve(config_.max_ticks);
+    }
+
+    next_tick_ = SteadyClock::now();
+    return true;
+}
+
+void Room::Advance() {
+    uint32_t steps = 0;
+    while (!IsFinished() && steps < config_.max_catch_up && SteadyClock::now() >= next_tick_) {
+        const auto start = SteadyClock::now();
+        Tick(dt_);
+        const std::chrono::duration<double, std::milli> elapsed = SteadyClock::now() - start;
+
+        window_.Add(elapsed.count());
+        window_busy_ms_ += elapsed.count();
+        if (config_.max_ticks != 0) {
+            total_.Add(elapsed.count());
+        }
+
+        next_tick_ += tick_duration_;
+        ++steps;
+        ++tick_index_;
+    }
+
+    // Догонка исчерпана, а комната все еще позади: прощаем долг, иначе опоздает и каждый следующий тик
+    const auto now = SteadyClock::now();
+    if (steps == config_.max_catch_up && now >= next_tick_) {
+        const auto behind = (now - next_tick_) / tick_duration_ + 1;
+        dropped_ticks_ += static_cast<uint64_t>(behind);
+        next_tick_ += behind * tick_duration_;
+    }
+}
+
+void Room::Tick(float dt) {
+    TRYENGINE_PROFILE_ZONE("Room::Tick");
+
+    auto& reg = scene_->GetRegistry();
+
+    if (script_system_) {
+        script_system_->InvokeUpdate(dt);
+    }
+    if (config_.stress_entities > 0) {
+        UpdateStressEntities(reg, dt);
+    }
+
+    if (jobs_) {
+        core::UpdateTransformSystem(reg, *jobs_);
+    } else {
+        core::UpdateTransformSystem(reg);
+    }
+
+    lag_compensation_.Record(reg, tick_index_);
+
+    // Снапшоты нумеруются с 1: 0 в заголовке — "без базы"
+    if (replication_) {
+        replication_->Tick(reg, static_cast<uint32_t>(tick_index_ + 1), jobs_);
+    }
+}
+
+void Room::ResetWindow() {
+    window_.Reset();
+    window_busy_ms_ = 0.0;
+}
+
+RoomMemory Room::MeasureMemory() const {
+    RoomMemory memory;
+    const auto& reg = scene_->GetRegistry();
+
+    if (const auto* entities = reg.storage<entt::entity>()) {
+        // В пуле сущностей лежат и освобожденные (для переиспользования), живые — первые free_list()
+        memory.entities = entities->free_list();
+    }
+
+    for (const auto [id, pool] : reg.storage()) {
+        memory.registry_bytes += (pool.capacity() + pool.extent()) * sizeof(entt::entity);
+        memory.registry_bytes += pool.capacity() * GetPayloadSize(pool.type().hash());
+    }
+
+    if (script_system_) {
+        memory.script_bytes = script_system_->GetHeapBytes();
+    }
+    memory.lag_history_bytes = lag_compensation_.GetMemoryBytes();
+    return memory;
+}
+
+}  // namespace tryserver
@@ -0,0 +1,229 @@
+#include "server/ServerApp.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+#include <thread>
+
+#include "engine/core/ComponentRegistry.hpp"
+#include "engine/core/JobSystem.hpp"
+#include "engine/core/Profiler.hpp"
+#include "engine/core/ResourceManager.hpp"
+#include "engine/core/SceneManager.hpp"
+
+namespace tryserver {
+
+using namespace tryengine;
+
+bool ServerApp::Init(const ServerConfig& config) {
+    config_ = config;
+    engine_ = std::make_unique<core::Engine>();
+
+    auto& resource_manager = engine_->RegisterSystem<core::ResourceManager>();
+    auto& component_registry = engine_->RegisterSystem<core::ComponentRegistry>();
+    core::RegisterEngineComponents(component_registry);
+    scene_manager_ = &engine_->RegisterSystem<core::SceneManager>(component_registry, resource_manager);
+
+    // Лоадеров GPU-ресурсов нет: MeshFilter/MeshRenderer после загрузки сцены остаются с пустыми хэндлами
+    resource_manager.GetAssetDatabase().Refresh();
+
+    if (config_.threads > 1) {
+        job_system_ = &engine_->RegisterSystem<core::JobSystem>(config_.threads - 1);
+        scene_manager_->SetJobSystem(job_system_);
+    }
+
+    // Одна комната может занять все потоки сама; если комнат несколько, параллелим по комнатам
+    core::JobSystem* room_jobs = config_.rooms == 1 ? job_system_ : nullptr;
+
+    rooms_.reserve(config_.rooms);
+    for (uint32_t i = 0; i < config_.rooms; ++i) {
+        RoomConfig room_config;
+        room_config.name = "room " + std::to_string(i);
+        room_config.scene = config_.scene;
+        room_config.script = config_.script;
+        room_config.tick_rate = config_.tick_rate;
+        room_config.max_ticks = config_.max_ticks;
+        room_config.max_catch_up = config_.max_catch_up;
+        room_config.stress_entities = config_.stress_entities;
+        room_config.replication.port = config_.port == 0 ? 0 : static_cast<uint16_t>(config_.port + i);
+
+        auto& room = rooms_.emplace_back(std::make_unique<Room>(std::move(room_config)));
+        if (!room->Init(*scene_manager_, room_jobs))
+            return false;
+    }
+
+    TRYENGINE_PROFILE_THREAD("Main");
+
+    size_t memory = 0;
+    for (const auto& room : rooms_) {
+        memory += room->MeasureMemory().Total();
+    }
+    std::cout << "[Server] " << config_.rooms << " room(s) at " << config_.tick_rate << " Hz, " << config_.threads
+              << " thread(s), " << memory / 1024 << " KiB" << std::endl;
+    if (config_.port != 0) {
+        std::cout << "[Server] replicating on UDP ports " << config_.port << "-" << config_.port + config_.rooms - 1
+                  << std::endl;
+    }
+
+    running_.store(true, std::memory_order_relaxed);
+    return true;
+}
+
+bool ServerApp::Step() {
+    TRYENGINE_PROFILE_ZONE("ServerApp::Step");
+
+    const auto now = SteadyClock::now();
+    bool any_active = false;
+
+    core::JobCounter counter;
+    for (const auto& room : rooms_) {
+        if (room->IsFinished())
+            continue;
+
+        any_active = true;
+        if (room->GetNextTick() > now)
+            continue;
+
+        if (job_system_ && rooms_.size() > 1) {
+            job_system_->Run([&room = *room] { room.Advance(); }, &counter);
+        } else {
+            room->Advance();
+        }
+    }
+
+    if (job_system_) {
+        job_system_->Wait(counter);
+    }
+    return any_active;
+}
+
+int ServerApp::Run() {
+    using namespace std::chrono;
+
+    const auto report_interval = duration_cast<SteadyClock::duration>(duration<double>(config_.report_interval));
+    auto window_begin = SteadyClock::now();
+
+    while (running_.load(std::memory_order_relaxed)) {
+        if (!Step())
+            break;
+
+        TRYENGINE_PROFILE_FRAME();
+
+        const auto now = SteadyClock::now();
+        if (now - window_begin >= report_interval) {
+            ReportWindow(duration<double, std::milli>(now - window_begin).count());
+            for (const auto& room : rooms_) {
+                room->ResetWindow();
+            }
+            window_begin = now;
+        }
+
+        auto next_tick = SteadyClock::time_point::max();
+        for (const auto& room : rooms_) {
+            if (!room->IsFinished()) {
+                next_tick = std::min(next_tick, room->GetNextTick());
+            }
+        }
+        if (next_tick != SteadyClock::time_point::max() && running_.load(std::memory_order_relaxed)) {
+            std::this_thread::sleep_until(next_tick);
+        }
+    }
+
+    if (config_.max_ticks == 0)
+        return 0;
+
+    // Итог за весь прогон копится только для ограниченного числа тиков, иначе память растет бесконечно
+    TickStats total(1000.0 / config_.tick_rate);
+    for (const auto& room : rooms_) {
+        total.Append(room->GetTotalStats());
+    }
+    ReportTotal(total);
+    return config_.strict && total.Summarize().p99_ms > 1000.0 / config_.tick_rate ? 1 : 0;
+}
+
+void ServerApp::Shutdown() {
+    uint64_t ticks = 0;
+    for (const auto& room : rooms_) {
+        ticks += room->GetTickIndex();
+    }
+    std::cout << "[Server] Shutting down after " << ticks << " room ticks" << std::endl;
+
+    // Комнаты держат указатель на JobSystem из движка
+    rooms_.clear();
+    engine_.reset();
+}
+
+void ServerApp::ReportWindow(double wall_ms) const {
+    TickStats window(1000.0 / config_.tick_rate);
+    double busy_ms = 0.0;
+    uint64_t dropped = 0;
+    size_t memory = 0;
+    size_t max_room_memory = 0;
+    size_t max_lag_history = 0;
+    const Room* slowest = nullptr;
+    double slowest_p99 = 0.0;
+    ReplicationStats replication;
+    uint64_t bytes_sent = 0;
+
+    for (const auto& room : rooms_) {
+        window.Append(room->GetWindowStats());
+        busy_ms += room->GetWindowBusyMs();
+        dropped += room->GetDroppedTicks();
+
+        const RoomMemory room_memory = room->MeasureMemory();
+        memory += room_memory.Total();
+        max_room_memory = std::max(max_room_memory, room_memory.Total());
+        max_lag_history = std::max(max_lag_history, room_memory.lag_history_bytes);
+
+        if (const Replication* room_replication = room->GetReplication()) {
+            replication.clients += room_replication->GetStats().clients;
+            replication.snapshots_sent += room_replication->GetStats().snapshots_sent;
+            replication.snapshots_dropped += room_replication->GetStats().snapshots_dropped;
+            bytes_sent += room_replication->GetTransportStats().bytes_sent;
+        }
+
+        const double p99 = room->GetWindowStats().Summarize().p99_ms;
+        if (!slowest || p99 > slowest_p99) {
+            slowest = room.get();
+            slowest_p99 = p99;
+        }
+    }
+
+    const auto summary = window.Summarize();
+    // Сколько ядер заняли тики комнат; отсюда — сколько таких комнат влезает в одно ядро на этой частоте
+    const double cores = wall_ms > 0.0 ? busy_ms / wall_ms : 0.0;
+    const double rooms_per_core = cores > 0.0 ? static_cast<double>(rooms_.size()) / cores : 0.0;
+
+    std::printf("[Server] window: %zu ticks, mean %.3f ms, p50 %.3f, p90 %.3f, p99 %.3f, max %.3f, "
+                "over budget %zu, dropped %llu\n",
+                summary.count, summary.mean_ms, summary.p50_ms, summary.p90_ms, summary.p99_ms, summary.max_ms,
+                summary.overruns, static_cast<unsigned long long>(dropped));
+    std::printf("[Server] load %.2f cores, %.1f rooms/core at %u Hz, slowest %s (p99 %.3f ms), memory %zu KiB "
+                "(max room %zu KiB, of it lag history up to %zu KiB)\n",
+                cores, rooms_per_core, config_.tick_rate, slowest ? slowest->GetName().c_str() : "-", slowest_p99,
+                memory / 1024, max_room_memory / 1024, max_lag_history / 1024);
+    if (config_.port != 0) {
+        // Счетчики за весь прогон, не за окно
+        std::printf("[Server] replication: %u clients, %llu snapshots sent (%llu KiB), %llu dropped as oversized\n",
+                    replication.clients, static_cast<unsigned long long>(replication.snapshots_sent),
+                    static_cast<unsigned long long>(bytes_sent / 1024),
+                    static_cast<unsigned long long>(replication.snapshots_dropped));
+    }
+    std::fflush(stdout);
+}
+
+void ServerApp::ReportTotal(const TickStats& total) const {
+    uint64_t dropped = 0;
+    for (const auto& room : rooms_) {
+        dropped += room->GetDroppedTicks();
+    }
+
+    const auto summary = total.Summarize();
+    std::printf("[Server] total: %zu ticks, mean %.3f ms, p50 %.3f, p90 %.3f, p99 %.3f, max %.3f, "
+                "over budget %zu, dropped %llu\n",
+                summary.count, summary.mean_ms, summary.p50_ms, summary.p90_ms, summary.p99_ms, summary.max_ms,
+                summary.overruns, static_cast<unsigned long long>(dropped));
+    std::fflush(stdout);
+}
+
+}  // namespace tryserver
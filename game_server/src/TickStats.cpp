@@ -0,0 +1,34 @@
+#include "server/TickStats.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace tryserver {
+
+TickStats::Summary TickStats::Summarize() const {
+    Summary summary;
+    summary.count = samples_.size();
+    if (samples_.empty())
+        return summary;
+
+    std::vector<double> sorted = samples_;
+    std::sort(sorted.begin(), sorted.end());
+
+    // Nearest-rank
+    const auto percentile = [&](double p) {
+        const auto rank = static_cast<size_t>(std::ceil(p * static_cast<double>(sorted.size())));
+        return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+    };
+
+    summary.mean_ms = std::accumulate(sorted.begin(), sorted.end(), 0.0) / static_cast<double>(sorted.size());
+    summary.p50_ms = percentile(0.50);
+    summary.p90_ms = percentile(0.90);
+    summary.p99_ms = percentile(0.99);
+    summary.max_ms = sorted.back();
+    summary.overruns = static_cast<size_t>(
+        sorted.end() - std::upper_bound(sorted.begin(), sorted.end(), budget_ms_));
+    return summary;
+}
+
+}  // namespace tryserver
@@ -0,0 +1,112 @@
+#include <csignal>
+#include <cstdlib>
+#include <iostream>
+#include <string_view>
+
+#include "server/ServerApp.hpp"
+
+namespace {
+
+tryserver::ServerApp* g_server = nullptr;
+
+void HandleSignal(int) {
+    if (g_server) {
+        g_server->RequestStop();
+    }
+}
+
+void PrintUsage(const char* program) {
+    std::cout << "Usage: " << program << " [options]\n"
+              << "  --scene <address>     scene from Addressables (default: empty scene)\n"
+              << "  --script <path>       main daslang script\n"
+              << "  --rooms <n>           independent rooms in this process (default 1)\n"
+              << "  --hz <n>              tick rate of every room (default 60)\n"
+              << "  --ticks <n>           stop after n ticks per room and print totals (default: run until SIGINT)\n"
+              << "  --max-catch-up <n>    ticks to catch up in a row before dropping the backlog (default 5)\n"
+              << "  --report <seconds>    stats window (default 5)\n"
+              << "  --threads <n>         threads including main (default 1)\n"
+              << "  --stress <n>          spawn n synthetic entities in every room\n"
+              << "  --port <n>            send snapshots over UDP, room i listens on port n + i (default: off)\n"
+              << "  --strict              exit with 1 if total p99 exceeds the tick budget\n";
+}
+
+bool ParseArgs(int argc, char** argv, tryserver::ServerConfig& config) {
+    unsigned long port = 0;
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+        const auto next = [&]() -> const char* {
+            ++i;
+            return value;
+        };
+
+        if (arg == "--strict") {
+            config.strict = true;
+        } else if (arg == "--help" || arg == "-h") {
+            return false;
+        } else if (!value) {
+            std::cerr << "Missing value for " << arg << std::endl;
+            return false;
+        } else if (arg == "--scene") {
+            config.scene = next();
+        } else if (arg == "--script") {
+            config.script = next();
+        } else if (arg == "--rooms") {
+            config.rooms = static_cast<uint32_t>(std::strtoul(next(), nullptr, 10));
+        } else if (arg == "--hz") {
+            config.tick_rate = static_cast<uint32_t>(std::strtoul(next(), nullptr, 10));
+        } else if (arg == "--ticks") {
+            config.max_ticks = std::strtoull(next(), nullptr, 10);
+        } else if (arg == "--max-catch-up") {
+            config.max_catch_up = static_cast<uint32_t>(std::strtoul(next(), nullptr, 10));
+        } else if (arg == "--report") {
+            config.report_interval = std::strtod(next(), nullptr);
+        } else if (arg == "--threads") {
+            config.threads = static_cast<uint32_t>(std::strtoul(next(), nullptr, 10));
+        } else if (arg == "--stress") {
+            config.stress_entities = static_cast<uint32_t>(std::strtoul(next(), nullptr, 10));
+        } else if (arg == "--port") {
+            port = std::strtoul(next(), nullptr, 10);
+        } else {
+            std::cerr << "Unknown option " << arg << std::endl;
+            return false;
+        }
+    }
+
+    if (config.rooms == 0 || config.tick_rate == 0 || config.max_catch_up == 0 || config.threads == 0) {
+        std::cerr << "--rooms, --hz, --max-catch-up and --threads must be positive" << std::endl;
+        return false;
+    }
+    if (port != 0 && port + config.rooms - 1 > 65535) {
+        std::cerr << "--port: ports of all rooms must fit below 65536" << std::endl;
+        return false;
+    }
+    config.port = static_cast<uint16_t>(port);
+    return true;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    tryserver::ServerConfig config;
+    if (!ParseArgs(argc, argv, config)) {
+        PrintUsage(argv[0]);
+        return 2;
+    }
+
+    tryserver::ServerApp server;
+    if (!server.Init(config)) {
+        server.Shutdown();
+        return 1;
+    }
+
+    g_server = &server;
+    std::signal(SIGINT, HandleSignal);
+    std::signal(SIGTERM, HandleSignal);
+
+    const int exit_code = server.Run();
+
+    g_server = nullptr;
+    server.Shutdown();
+    return exit_code;
+}